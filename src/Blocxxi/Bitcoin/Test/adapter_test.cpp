@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -168,6 +169,103 @@ auto WriteMerkleRoot(
   std::copy(bytes.begin(), bytes.end(), header.begin() + 36U);
 }
 
+// A distinct hash that is never null, for tests that only check continuity.
+[[nodiscard]] auto TestHash(std::uint8_t value) -> BlockHash
+{
+  auto bytes = BlockHash::Bytes {};
+  bytes[0] = value;
+  bytes[1] = 0x01;
+  return BlockHash(bytes);
+}
+
+using RawHeader = std::array<std::uint8_t, 80>;
+
+// `count` headers without proof of work, each linked to the one before it and
+// the first to `previous`.
+[[nodiscard]] auto MakeHeaderChain(std::size_t count, BlockHash const& previous)
+  -> std::vector<RawHeader>
+{
+  auto chain = std::vector<RawHeader> {};
+  chain.reserve(count);
+  auto link = previous.Data();
+  for (auto index = std::size_t { 0 }; index < count; ++index) {
+    auto const nonce = static_cast<std::uint32_t>(index);
+    auto header = MakeHeaderBytes(4U, nonce, 1598918400U + nonce, 0U);
+    std::copy(link.begin(), link.end(), header.begin() + 4U);
+    link = DoubleSha256(header);
+    chain.push_back(header);
+  }
+  return chain;
+}
+
+[[nodiscard]] auto EncodeHeadersPayload(std::span<RawHeader const> headers)
+  -> std::vector<std::uint8_t>
+{
+  auto payload = std::vector<std::uint8_t> {};
+  AppendCompactSize(payload, headers.size());
+  for (auto const& header : headers) {
+    payload.insert(payload.end(), header.begin(), header.end());
+    payload.push_back(0U);
+  }
+  return payload;
+}
+
+// A block with one empty transaction, its merkle root left unset.
+[[nodiscard]] auto MakeBlockPayload(std::uint32_t nonce) -> std::vector<std::uint8_t>
+{
+  auto const header = MakeHeaderBytes(4U, nonce, 1598918400U + nonce);
+  auto payload = std::vector<std::uint8_t>(header.begin(), header.end());
+  payload.push_back(1U); // tx count
+  AppendLittleEndian(payload, 1U, 4U); // tx version
+  payload.push_back(0U); // vin count
+  payload.push_back(0U); // vout count
+  AppendLittleEndian(payload, 0U, 4U); // locktime
+  return payload;
+}
+
+// Appends a record to the client's block cache under `state_root`, keyed by
+// the hash of `block`'s header.
+auto AppendCacheRecord(std::filesystem::path const& state_root,
+  std::span<std::uint8_t const> block, std::span<std::uint8_t const> payload) -> void
+{
+  std::filesystem::create_directories(state_root / "bitcoin-signet-blocks");
+  auto record = std::vector<std::uint8_t> {};
+  auto const hash = DoubleSha256(block.first(80U));
+  record.insert(record.end(), hash.begin(), hash.end());
+  AppendLittleEndian(record, payload.size(), 4U);
+  record.insert(record.end(), payload.begin(), payload.end());
+  auto output = std::ofstream(state_root / "bitcoin-signet-blocks" / "blocks.pack",
+    std::ios::binary | std::ios::app);
+  output.write(reinterpret_cast<char const*>(record.data()),
+    static_cast<std::streamsize>(record.size()));
+}
+
+// Plays the peer side of the version handshake.
+auto AcceptHandshake(asio::ip::tcp::socket& socket) -> void
+{
+  (void)ReadMessage(socket); // version
+  auto version_reply = std::vector<std::uint8_t> {};
+  AppendLittleEndian(version_reply, 70016U, 4U);
+  asio::write(socket, asio::buffer(EncodeMessage("version", version_reply)));
+  asio::write(socket,
+    asio::buffer(EncodeMessage("verack", std::span<std::uint8_t const> {})));
+  (void)ReadMessage(socket); // verack
+}
+
+// Reads a getheaders request and returns its locator.
+[[nodiscard]] auto ReadLocator(asio::ip::tcp::socket& socket) -> std::vector<BlockHash>
+{
+  auto const [command, payload] = ReadMessage(socket);
+  EXPECT_EQ(command, "getheaders");
+  auto locator = std::vector<BlockHash> {};
+  auto const count = static_cast<std::size_t>(payload[4]);
+  for (auto index = std::size_t { 0 }; index < count; ++index) {
+    locator.push_back(*BlockHash::FromBytes(
+      std::span(payload).subspan(5U + (index * BlockHash::kSize), BlockHash::kSize)));
+  }
+  return locator;
+}
+
 } // namespace
 
 TEST(BitcoinAdapterTest, HeaderSyncAdapterUsesPublicNodeApi)
@@ -188,8 +286,8 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterUsesPublicNodeApi)
 
   auto const status = adapter.SubmitHeader({
     .height = 1,
-    .hash_hex = "0001",
-    .previous_hash_hex = "0000",
+    .hash = TestHash(1),
+    .previous_hash = TestHash(0),
     .version = 0x20000000,
   });
 
@@ -221,20 +319,20 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterImportsOrderedHeaderBatch)
   auto const headers = std::array {
     Header {
       .height = 1,
-      .hash_hex = "0001",
-      .previous_hash_hex = "0000",
+      .hash = TestHash(1),
+      .previous_hash = TestHash(0),
       .version = 0x20000000,
     },
     Header {
       .height = 2,
-      .hash_hex = "0002",
-      .previous_hash_hex = "0001",
+      .hash = TestHash(2),
+      .previous_hash = TestHash(1),
       .version = 0x20000000,
     },
     Header {
       .height = 3,
-      .hash_hex = "0003",
-      .previous_hash_hex = "0002",
+      .hash = TestHash(3),
+      .previous_hash = TestHash(2),
       .version = 0x20000000,
     },
   };
@@ -258,8 +356,8 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterRejectsUnboundOrIncompleteHeaders)
 
   auto status = adapter.SubmitHeader({
     .height = 1,
-    .hash_hex = "01",
-    .previous_hash_hex = "00",
+    .hash = TestHash(1),
+    .previous_hash = TestHash(0),
     .version = 1,
   });
   EXPECT_EQ(status.code, blocxxi::core::StatusCode::Rejected);
@@ -270,16 +368,16 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterRejectsUnboundOrIncompleteHeaders)
 
   status = adapter.SubmitHeader({
     .height = 1,
-    .hash_hex = "",
-    .previous_hash_hex = "00",
+    .hash = {},
+    .previous_hash = TestHash(0),
     .version = 1,
   });
   EXPECT_EQ(status.code, blocxxi::core::StatusCode::InvalidArgument);
 
   status = adapter.SubmitHeader({
     .height = 2,
-    .hash_hex = "02",
-    .previous_hash_hex = "",
+    .hash = TestHash(2),
+    .previous_hash = {},
     .version = 1,
   });
   EXPECT_EQ(status.code, blocxxi::core::StatusCode::InvalidArgument);
@@ -299,14 +397,14 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterRejectsBrokenHeaderBatch)
   auto const headers = std::array {
     Header {
       .height = 1,
-      .hash_hex = "0001",
-      .previous_hash_hex = "0000",
+      .hash = TestHash(1),
+      .previous_hash = TestHash(0),
       .version = 1,
     },
     Header {
       .height = 3,
-      .hash_hex = "0003",
-      .previous_hash_hex = "0001",
+      .hash = TestHash(3),
+      .previous_hash = TestHash(1),
       .version = 1,
     },
   };
@@ -373,10 +471,10 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesHeadersFromBoundedPeer)
   ASSERT_EQ(result.headers.size(), 2U);
   EXPECT_EQ(result.headers.front().height, 1U);
   EXPECT_EQ(result.headers.back().height, 2U);
-  EXPECT_EQ(result.header_hashes.front(), expected1);
-  EXPECT_EQ(result.header_hashes.back(), expected2);
-  EXPECT_EQ(result.headers.front().hash_hex, expected1);
-  EXPECT_EQ(result.headers.back().hash_hex, expected2);
+  EXPECT_EQ(result.header_hashes.front().ToHex(), expected1);
+  EXPECT_EQ(result.header_hashes.back().ToHex(), expected2);
+  EXPECT_EQ(result.headers.front().hash.ToHex(), expected1);
+  EXPECT_EQ(result.headers.back().hash.ToHex(), expected2);
   EXPECT_EQ(result.headers.front().bits, 0x1e0377aeU);
   EXPECT_EQ(result.headers.back().nonce, 12U);
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "version"),
@@ -437,7 +535,7 @@ TEST(BitcoinAdapterTest, SignetLiveClientRespondsToPingDuringHandshakeAndHeaderF
 
   ASSERT_TRUE(status.ok());
   ASSERT_EQ(result.headers.size(), 1U);
-  EXPECT_EQ(result.headers.front().hash_hex, expected);
+  EXPECT_EQ(result.headers.front().hash.ToHex(), expected);
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "ping"),
     result.command_trace.end());
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "headers"),
@@ -456,9 +554,9 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterRejectsHeaderWhosePowExceedsTarget)
 
   auto const status = adapter.SubmitHeader({
     .height = 1,
-    .hash_hex = "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
-    .previous_hash_hex =
-      "00000008819873e925422c1ff0f99f7cc9bbb232af63a077a480a3633bee1ef6",
+    .hash = *BlockHash::FromHex(
+      "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"),
+    .previous_hash = SignetGenesisHash(),
     .version = 4,
     .timestamp = 1598918401U,
     .bits = 0x1e0377aeU,
@@ -475,7 +573,8 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterImportsLiveHeadersIntoKernel)
     = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
   auto const port = acceptor.local_endpoint().port();
 
-  auto const header1 = MakeHeaderBytes(4U, 21U, 1598918403U, 0U);
+  auto header1 = MakeHeaderBytes(4U, 21U, 1598918403U, 0U);
+  WritePreviousHash(header1, SignetGenesisHash().ToHex());
   auto header2 = MakeHeaderBytes(4U, 22U, 1598918404U, 0U);
   auto const expected1 = HeaderHashHex(header1);
   WritePreviousHash(header2, expected1);
@@ -534,8 +633,8 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterImportsLiveHeadersIntoKernel)
   EXPECT_NE(node.Blocks()[1].transactions.front().PayloadText().find(expected1),
     std::string::npos);
   EXPECT_EQ(live_result.headers.size(), 2U);
-  EXPECT_EQ(live_result.headers.front().hash_hex, expected1);
-  EXPECT_EQ(live_result.headers.back().hash_hex, expected2);
+  EXPECT_EQ(live_result.headers.front().hash.ToHex(), expected1);
+  EXPECT_EQ(live_result.headers.back().hash.ToHex(), expected2);
 }
 
 TEST(BitcoinAdapterTest, HeaderSyncAdapterResumesLiveImportFromPersistedLocator)
@@ -549,7 +648,8 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterResumesLiveImportFromPersistedLocator)
     first_io, { asio::ip::make_address("127.0.0.1"), 0 });
   auto const first_port = first_acceptor.local_endpoint().port();
 
-  auto const header1 = MakeHeaderBytes(4U, 31U, 1598918405U, 0U);
+  auto header1 = MakeHeaderBytes(4U, 31U, 1598918405U, 0U);
+  WritePreviousHash(header1, SignetGenesisHash().ToHex());
   auto header2 = MakeHeaderBytes(4U, 32U, 1598918406U, 0U);
   auto const expected1 = HeaderHashHex(header1);
   WritePreviousHash(header2, expected1);
@@ -650,7 +750,7 @@ TEST(BitcoinAdapterTest, HeaderSyncAdapterResumesLiveImportFromPersistedLocator)
   EXPECT_EQ(observed_locator, expected2);
   EXPECT_EQ(second_result.headers.size(), 1U);
   EXPECT_EQ(second_result.headers.front().height, 3U);
-  EXPECT_EQ(second_result.headers.front().hash_hex, expected3);
+  EXPECT_EQ(second_result.headers.front().hash.ToHex(), expected3);
   EXPECT_EQ(node.Snapshot().height, 3U);
   ASSERT_EQ(node.Blocks().size(), 4U);
 
@@ -723,7 +823,6 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesBoundedBlockBodiesFromPeer)
   block_payload.push_back(0U);
   block_payload.push_back(0U);
   block_payload.push_back(0U);
-  block_payload.push_back(0U);
   block_payload.push_back(0U); // vin count
   block_payload.push_back(0U); // vout count
   block_payload.push_back(0U); // locktime
@@ -744,7 +843,6 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesBoundedBlockBodiesFromPeer)
   block_payload.push_back(0U);
   block_payload.push_back(0U);
   block_payload.push_back(0U);
-  block_payload.push_back(0U);
   block_payload.push_back(0U); // vin count
   block_payload.push_back(0U); // vout count
   block_payload.push_back(0U); // locktime
@@ -777,7 +875,7 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesBoundedBlockBodiesFromPeer)
   });
   auto result = SignetBlocksResult {};
   auto const status = client.FetchBlocks(
-    std::span<std::string const>(&expected_hash, 1U), result);
+    std::array { *BlockHash::FromHex(expected_hash) }, result);
 
   server.join();
 
@@ -785,15 +883,15 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesBoundedBlockBodiesFromPeer)
   EXPECT_EQ(result.peer_address, "127.0.0.1");
   EXPECT_EQ(result.protocol_version, 70016);
   ASSERT_EQ(result.blocks.size(), 1U);
-  EXPECT_EQ(result.blocks.front().block_hash_hex, expected_hash);
+  EXPECT_EQ(result.blocks.front().block_hash.ToHex(), expected_hash);
   EXPECT_GT(result.blocks.front().payload.size(), 80U);
   ASSERT_EQ(result.metadata.size(), 1U);
-  EXPECT_EQ(result.metadata.front().block_hash_hex, expected_hash);
+  EXPECT_EQ(result.metadata.front().block_hash.ToHex(), expected_hash);
   EXPECT_EQ(result.metadata.front().version, 4U);
   EXPECT_EQ(result.metadata.front().nonce, 41U);
   EXPECT_EQ(result.metadata.front().transaction_count, 1U);
   EXPECT_EQ(result.metadata.front().total_output_value, 0U);
-  EXPECT_EQ(result.metadata.front().merkle_root_hex, expected_txid);
+  EXPECT_EQ(result.metadata.front().merkle_root.ToHex(), expected_txid);
   EXPECT_TRUE(result.metadata.front().merkle_root_matches);
   ASSERT_EQ(result.metadata.front().transaction_sizes.size(), 1U);
   EXPECT_EQ(result.metadata.front().transaction_sizes.front(), 10U);
@@ -809,8 +907,8 @@ TEST(BitcoinAdapterTest, SignetLiveClientFetchesBoundedBlockBodiesFromPeer)
   EXPECT_FALSE(result.metadata.front().transaction_has_witness.front());
   ASSERT_EQ(result.metadata.front().transaction_ids.size(), 1U);
   ASSERT_EQ(result.metadata.front().transaction_witness_ids.size(), 1U);
-  EXPECT_EQ(result.metadata.front().transaction_ids.front(), expected_txid);
-  EXPECT_EQ(result.metadata.front().transaction_witness_ids.front(), expected_txid);
+  EXPECT_EQ(result.metadata.front().transaction_ids.front().ToHex(), expected_txid);
+  EXPECT_EQ(result.metadata.front().transaction_witness_ids.front().ToHex(), expected_txid);
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "block"),
     result.command_trace.end());
 }
@@ -867,13 +965,13 @@ TEST(BitcoinAdapterTest, SignetLiveClientRespondsToPingBeforeReceivingBlockPaylo
   });
   auto result = SignetBlocksResult {};
   auto const status = client.FetchBlocks(
-    std::span<std::string const>(&expected_hash, 1U), result);
+    std::array { *BlockHash::FromHex(expected_hash) }, result);
 
   server.join();
 
   ASSERT_TRUE(status.ok());
   ASSERT_EQ(result.blocks.size(), 1U);
-  EXPECT_EQ(result.blocks.front().block_hash_hex, expected_hash);
+  EXPECT_EQ(result.blocks.front().block_hash.ToHex(), expected_hash);
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "ping"),
     result.command_trace.end());
   EXPECT_NE(std::find(result.command_trace.begin(), result.command_trace.end(), "block"),
@@ -885,30 +983,10 @@ TEST(BitcoinAdapterTest, SignetLiveClientReusesCachedBlocksWhenAvailable)
   auto const state_root
     = std::filesystem::temp_directory_path() / "blocxxi-bitcoin-block-cache";
   std::filesystem::remove_all(state_root);
-  std::filesystem::create_directories(state_root / "bitcoin-signet-blocks");
-
-  auto const header = MakeHeaderBytes(4U, 61U, 1598918410U);
-  auto const expected_hash = HeaderHashHex(header);
-  auto block_payload = std::vector<std::uint8_t>(header.begin(), header.end());
-  block_payload.push_back(1U);
-  block_payload.push_back(1U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
-  block_payload.push_back(0U);
 
-  {
-    auto output = std::ofstream(
-      state_root / "bitcoin-signet-blocks" / (expected_hash + ".blk"),
-      std::ios::binary | std::ios::trunc);
-    output.write(reinterpret_cast<char const*>(block_payload.data()),
-      static_cast<std::streamsize>(block_payload.size()));
-  }
+  auto const block_payload = MakeBlockPayload(61U);
+  auto const expected_hash = HeaderHashHex(std::span(block_payload).first(80U));
+  AppendCacheRecord(state_root, block_payload, block_payload);
 
   auto client = SignetLiveClient({
     .host = "127.0.0.1",
@@ -917,14 +995,15 @@ TEST(BitcoinAdapterTest, SignetLiveClientReusesCachedBlocksWhenAvailable)
   });
   auto result = SignetBlocksResult {};
   auto const status = client.FetchBlocks(
-    std::span<std::string const>(&expected_hash, 1U), result);
+    std::array { *BlockHash::FromHex(expected_hash) }, result);
 
   ASSERT_TRUE(status.ok());
   EXPECT_EQ(result.peer_address, "cache");
   ASSERT_EQ(result.blocks.size(), 1U);
-  EXPECT_EQ(result.blocks.front().block_hash_hex, expected_hash);
+  EXPECT_EQ(result.blocks.front().block_hash.ToHex(), expected_hash);
+  EXPECT_EQ(result.blocks.front().payload, block_payload);
   ASSERT_EQ(result.metadata.size(), 1U);
-  EXPECT_EQ(result.metadata.front().block_hash_hex, expected_hash);
+  EXPECT_EQ(result.metadata.front().block_hash.ToHex(), expected_hash);
   EXPECT_EQ(result.metadata.front().version, 4U);
   EXPECT_EQ(result.metadata.front().nonce, 61U);
   EXPECT_EQ(result.metadata.front().transaction_count, 1U);
@@ -935,6 +1014,84 @@ TEST(BitcoinAdapterTest, SignetLiveClientReusesCachedBlocksWhenAvailable)
   std::filesystem::remove_all(state_root);
 }
 
+TEST(BitcoinAdapterTest, SignetLiveClientFetchesOnlyBlocksMissingFromCache)
+{
+  auto const state_root
+    = std::filesystem::temp_directory_path() / "blocxxi-bitcoin-partial-cache";
+  std::filesystem::remove_all(state_root);
+
+  auto const cached_payload = MakeBlockPayload(71U);
+  auto const fetched_payload = MakeBlockPayload(72U);
+  auto const cached_hash
+    = *BlockHash::FromHex(HeaderHashHex(std::span(cached_payload).first(80U)));
+  auto const fetched_hash
+    = *BlockHash::FromHex(HeaderHashHex(std::span(fetched_payload).first(80U)));
+  AppendCacheRecord(state_root, cached_payload, cached_payload);
+  // A damaged copy of the second block is fetched again, not trusted.
+  AppendCacheRecord(state_root, fetched_payload, std::vector<std::uint8_t>(12U, 0xFFU));
+  // A record cut short, as a crash while appending would leave it.
+  {
+    auto output = std::ofstream(state_root / "bitcoin-signet-blocks" / "blocks.pack",
+      std::ios::binary | std::ios::app);
+    output.write("torn", 4);
+  }
+
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+  auto requested = std::vector<BlockHash> {};
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    AcceptHandshake(socket);
+    auto const [command, payload] = ReadMessage(socket);
+    EXPECT_EQ(command, "getdata");
+    for (auto index = std::size_t { 0 }; index < payload[0]; ++index) {
+      requested.push_back(*BlockHash::FromBytes(
+        std::span(payload).subspan(5U + (index * 36U), BlockHash::kSize)));
+    }
+    asio::write(socket, asio::buffer(EncodeMessage("block", fetched_payload)));
+  });
+
+  auto const hashes = std::array { cached_hash, fetched_hash };
+  auto client = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = port,
+    .state_root = state_root,
+  });
+  auto result = SignetBlocksResult {};
+  auto const status = client.FetchBlocks(hashes, result);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(requested, std::vector<BlockHash> { fetched_hash });
+  EXPECT_EQ(result.peer_address, "127.0.0.1");
+  ASSERT_EQ(result.blocks.size(), 2U);
+  EXPECT_EQ(result.blocks[0].payload, cached_payload);
+  EXPECT_EQ(result.blocks[1].payload, fetched_payload);
+  ASSERT_EQ(result.metadata.size(), 2U);
+  EXPECT_EQ(result.metadata[0].nonce, 71U);
+  EXPECT_EQ(result.metadata[1].nonce, 72U);
+  EXPECT_EQ(result.command_trace.front(), "cache");
+
+  // The fetched block was appended past the torn record, and is served from
+  // the cache from now on.
+  auto offline = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = 1,
+    .state_root = state_root,
+  });
+  auto cached = SignetBlocksResult {};
+  ASSERT_TRUE(offline.FetchBlocks(hashes, cached).ok());
+  EXPECT_EQ(cached.peer_address, "cache");
+  ASSERT_EQ(cached.blocks.size(), 2U);
+  EXPECT_EQ(cached.blocks[1].payload, fetched_payload);
+
+  std::filesystem::remove_all(state_root);
+}
+
 TEST(BitcoinAdapterTest, WitnessTransactionsProduceDistinctTxidAndWtxid)
 {
   auto io_context = asio::io_context {};
@@ -1011,7 +1168,7 @@ TEST(BitcoinAdapterTest, WitnessTransactionsProduceDistinctTxidAndWtxid)
   });
   auto result = SignetBlocksResult {};
   auto const status = client.FetchBlocks(
-    std::span<std::string const>(&expected_block_hash, 1U), result);
+    std::array { *BlockHash::FromHex(expected_block_hash) }, result);
 
   server.join();
 
@@ -1021,9 +1178,296 @@ TEST(BitcoinAdapterTest, WitnessTransactionsProduceDistinctTxidAndWtxid)
   ASSERT_EQ(result.metadata.front().transaction_witness_ids.size(), 1U);
   ASSERT_EQ(result.metadata.front().transaction_has_witness.size(), 1U);
   EXPECT_TRUE(result.metadata.front().transaction_has_witness.front());
-  EXPECT_EQ(result.metadata.front().transaction_witness_ids.front(), expected_wtxid);
-  EXPECT_NE(result.metadata.front().transaction_ids.front(),
-    result.metadata.front().transaction_witness_ids.front());
+  EXPECT_EQ(result.metadata.front().transaction_witness_ids.front().ToHex(), expected_wtxid);
+  EXPECT_NE(result.metadata.front().transaction_ids.front().Data(),
+    result.metadata.front().transaction_witness_ids.front().Data());
+}
+
+TEST(BitcoinAdapterTest, BuildBlockLocatorStepsBackExponentially)
+{
+  auto chain = std::vector<BlockHash> {};
+  for (auto index = 0U; index < 100U; ++index) {
+    chain.push_back(TestHash(static_cast<std::uint8_t>(index)));
+  }
+
+  auto expected = std::vector<BlockHash> {};
+  for (auto const index : { 99U, 98U, 97U, 96U, 95U, 94U, 93U, 92U, 91U, 90U, 89U,
+         87U, 83U, 75U, 59U, 27U, 0U }) {
+    expected.push_back(chain[index]);
+  }
+  EXPECT_EQ(BuildBlockLocator(chain), expected);
+  EXPECT_EQ(BuildBlockLocator(std::span(chain).first(1U)),
+    (std::vector<BlockHash> { chain.front() }));
+  EXPECT_TRUE(BuildBlockLocator({}).empty());
+}
+
+TEST(BitcoinAdapterTest, HeaderSyncAdapterPipelinesBatchesAndCheckpoints)
+{
+  auto const state_root
+    = std::filesystem::temp_directory_path() / "blocxxi-bitcoin-header-sync";
+  std::filesystem::remove_all(state_root);
+
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto const headers = MakeHeaderChain(2005U, SignetGenesisHash());
+  auto const first_tip = BlockHash(DoubleSha256(headers[1999]));
+  auto const tip = BlockHash(DoubleSha256(headers.back()));
+  auto first_locator = std::vector<BlockHash> {};
+  auto second_locator = std::vector<BlockHash> {};
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    AcceptHandshake(socket);
+
+    first_locator = ReadLocator(socket);
+    asio::write(socket, asio::buffer(EncodeMessage("headers",
+                          EncodeHeadersPayload(std::span(headers).first(2000U)))));
+    // The follow-up request arrives for a full batch without further prompting.
+    second_locator = ReadLocator(socket);
+    asio::write(socket, asio::buffer(EncodeMessage("headers",
+                          EncodeHeadersPayload(std::span(headers).subspan(2000U)))));
+  });
+
+  auto node = node::Node();
+  ASSERT_TRUE(node.Start().ok());
+  auto adapter = HeaderSyncAdapter({
+    .network = Network::Signet,
+    .header_sync_only = true,
+  });
+  ASSERT_TRUE(adapter.Bind(node).ok());
+
+  auto result = SignetHeaderSyncResult {};
+  auto const status = adapter.SyncLiveSignetHeaders({
+      .host = "127.0.0.1",
+      .port = port,
+      .state_root = state_root,
+    },
+    {}, &result);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(first_locator, (std::vector<BlockHash> { SignetGenesisHash() }));
+  ASSERT_FALSE(second_locator.empty());
+  EXPECT_EQ(second_locator.front(), first_tip);
+  EXPECT_EQ(second_locator.back(), SignetGenesisHash());
+  EXPECT_EQ(result.batches, 2U);
+  EXPECT_EQ(result.headers_received, 2005U);
+  EXPECT_EQ(result.reconnects, 0U);
+  ASSERT_TRUE(result.tip.has_value());
+  EXPECT_EQ(result.tip->height, 2005U);
+  EXPECT_EQ(result.tip->hash, tip);
+  EXPECT_EQ(node.Snapshot().height, 2005U);
+
+  auto checkpoint = std::ifstream(state_root / "bitcoin-signet-import.txt");
+  auto contents = std::stringstream {};
+  contents << checkpoint.rdbuf();
+  EXPECT_EQ(contents.str(), "height=2005\nhash=" + tip.ToHex() + "\n");
+
+  std::filesystem::remove_all(state_root);
+}
+
+TEST(BitcoinAdapterTest, SignetLiveClientResumesHeaderSyncAfterDroppedConnection)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto const headers = MakeHeaderChain(2000U, SignetGenesisHash());
+  auto chain = std::vector<BlockHash> { SignetGenesisHash() };
+  for (auto const& header : headers) {
+    chain.emplace_back(DoubleSha256(header));
+  }
+  auto resumed_locator = std::vector<BlockHash> {};
+
+  auto server = std::thread([&]() {
+    {
+      auto socket = asio::ip::tcp::socket(io_context);
+      acceptor.accept(socket);
+      AcceptHandshake(socket);
+      (void)ReadLocator(socket);
+      asio::write(socket,
+        asio::buffer(EncodeMessage("headers", EncodeHeadersPayload(headers))));
+      (void)ReadLocator(socket);
+    }
+
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    AcceptHandshake(socket);
+    resumed_locator = ReadLocator(socket);
+    auto empty = std::vector<std::uint8_t> {};
+    AppendCompactSize(empty, 0U);
+    asio::write(socket, asio::buffer(EncodeMessage("headers", empty)));
+  });
+
+  auto batch_sizes = std::vector<std::size_t> {};
+  auto client = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = port,
+  });
+  auto result = SignetHeaderSyncResult {};
+  auto const status = client.SyncHeaders({},
+    [&](std::span<Header const> batch) {
+      batch_sizes.push_back(batch.size());
+      return blocxxi::core::Status::Success();
+    },
+    result);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(batch_sizes, (std::vector<std::size_t> { 2000U }));
+  EXPECT_EQ(result.reconnects, 1U);
+  EXPECT_EQ(result.headers_received, 2000U);
+  ASSERT_TRUE(result.tip.has_value());
+  EXPECT_EQ(result.tip->hash, chain.back());
+  // The new session locates the validated tip with a full locator.
+  EXPECT_EQ(resumed_locator, BuildBlockLocator(chain));
+  EXPECT_GT(resumed_locator.size(), 11U);
+}
+
+TEST(BitcoinAdapterTest, SignetLiveClientKeepsOneConnectionAcrossRequests)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto const headers = MakeHeaderChain(2U, SignetGenesisHash());
+  auto pong_payload = std::vector<std::uint8_t> {};
+  auto connections = 0;
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    ++connections;
+    AcceptHandshake(socket);
+
+    (void)ReadLocator(socket);
+    asio::write(socket, asio::buffer(EncodeMessage("headers",
+                          EncodeHeadersPayload(std::span(headers).first(1U)))));
+    // Answered by the session while no request is outstanding.
+    auto const ping_payload = std::vector<std::uint8_t> { 8U, 7U, 6U, 5U, 4U, 3U, 2U, 1U };
+    asio::write(socket, asio::buffer(EncodeMessage("ping", ping_payload)));
+    // The pong and the next request may arrive in either order.
+    for (auto message = 0; message < 2; ++message) {
+      auto const [command, payload] = ReadMessage(socket);
+      if (command == "pong") {
+        pong_payload = payload;
+      } else {
+        EXPECT_EQ(command, "getheaders");
+      }
+    }
+    asio::write(socket, asio::buffer(EncodeMessage("headers",
+                          EncodeHeadersPayload(std::span(headers).subspan(1U)))));
+  });
+
+  auto client = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = port,
+  });
+  auto first = SignetHeadersResult {};
+  ASSERT_TRUE(client.FetchHeaders(first).ok());
+  auto second = SignetHeadersResult {};
+  auto const status = client.FetchHeaders(second);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(connections, 1);
+  EXPECT_EQ(pong_payload, (std::vector<std::uint8_t> { 8U, 7U, 6U, 5U, 4U, 3U, 2U, 1U }));
+  EXPECT_EQ(second.peer_address, "127.0.0.1");
+  EXPECT_EQ(second.protocol_version, 70016);
+  ASSERT_EQ(second.headers.size(), 1U);
+  EXPECT_EQ(second.headers.front().nonce, 1U);
+  // The second request did not wait for a handshake.
+  EXPECT_EQ(std::find(second.command_trace.begin(), second.command_trace.end(), "version"),
+    second.command_trace.end());
+}
+
+TEST(BitcoinAdapterTest, SignetLiveClientReconnectsAfterIdleConnectionDrops)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto const headers = MakeHeaderChain(1U, SignetGenesisHash());
+
+  auto server = std::thread([&]() {
+    for (auto connection = 0; connection < 2; ++connection) {
+      auto socket = asio::ip::tcp::socket(io_context);
+      acceptor.accept(socket);
+      AcceptHandshake(socket);
+      (void)ReadLocator(socket);
+      asio::write(
+        socket, asio::buffer(EncodeMessage("headers", EncodeHeadersPayload(headers))));
+    }
+  });
+
+  auto client = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = port,
+  });
+  auto first = SignetHeadersResult {};
+  ASSERT_TRUE(client.FetchHeaders(first).ok());
+  // Let the first connection close before the next request.
+  std::this_thread::sleep_for(std::chrono::milliseconds { 50 });
+  auto second = SignetHeadersResult {};
+  auto const status = client.FetchHeaders(second);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(second.headers.size(), 1U);
+  EXPECT_NE(std::find(second.command_trace.begin(), second.command_trace.end(), "version"),
+    second.command_trace.end());
+}
+
+TEST(BitcoinAdapterTest, SignetLiveClientFramesMessagesSplitAcrossReads)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto const headers = MakeHeaderChain(3U, SignetGenesisHash());
+  auto pong_payload = std::vector<std::uint8_t> {};
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    AcceptHandshake(socket);
+    (void)ReadLocator(socket);
+
+    // A ping and the start of the headers message in one write, and the rest
+    // of the headers, cut inside its payload, in a later one.
+    auto const ping_payload = std::vector<std::uint8_t> { 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U };
+    auto bytes = EncodeMessage("ping", ping_payload);
+    auto const headers_message = EncodeMessage("headers", EncodeHeadersPayload(headers));
+    auto const split = headers_message.begin() + 100;
+    bytes.insert(bytes.end(), headers_message.begin(), split);
+    asio::write(socket, asio::buffer(bytes));
+    auto const [command, payload] = ReadMessage(socket);
+    EXPECT_EQ(command, "pong");
+    pong_payload = payload;
+    asio::write(socket,
+      asio::buffer(&*split, static_cast<std::size_t>(headers_message.end() - split)));
+  });
+
+  auto client = SignetLiveClient({
+    .host = "127.0.0.1",
+    .port = port,
+  });
+  auto result = SignetHeadersResult {};
+  auto const status = client.FetchHeaders(result);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(pong_payload, (std::vector<std::uint8_t> { 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U }));
+  ASSERT_EQ(result.headers.size(), 3U);
+  EXPECT_EQ(result.headers.back().nonce, 2U);
 }
 
 } // namespace blocxxi::bitcoin
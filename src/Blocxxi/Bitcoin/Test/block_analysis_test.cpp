@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+#include <Blocxxi/Bitcoin/block_analysis.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+// One input and one output; every third transaction carries a witness and
+// the script sizes vary so that transactions straddle hash block boundaries.
+auto MakeBlock(std::size_t transaction_count) -> Bytes
+{
+  auto block = Bytes(kBlockHeaderSize, 0x00);
+  block.push_back(0xFD);
+  block.push_back(static_cast<std::uint8_t>(transaction_count & 0xFFU));
+  block.push_back(static_cast<std::uint8_t>(transaction_count >> 8U));
+  for (auto index = std::size_t { 0 }; index < transaction_count; ++index) {
+    auto const has_witness = (index % 3U) == 1U;
+    auto const tag = static_cast<std::uint8_t>(index);
+    block.insert(block.end(), { 0x02, 0x00, 0x00, 0x00 });
+    if (has_witness) {
+      block.insert(block.end(), { 0x00, 0x01 });
+    }
+    block.push_back(1U);
+    block.insert(block.end(), 32U, tag);
+    block.insert(block.end(), { 0x00, 0x00, 0x00, 0x00 });
+    auto const script_size = static_cast<std::uint8_t>(index % 61U);
+    block.push_back(script_size);
+    block.insert(block.end(), script_size, 0x51);
+    block.insert(block.end(), { 0xFF, 0xFF, 0xFF, 0xFF });
+    block.push_back(1U);
+    block.insert(block.end(), { tag, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 });
+    block.insert(block.end(), { 0x01, 0x51 });
+    if (has_witness) {
+      block.insert(block.end(), { 0x01, 0x01, tag });
+    }
+    block.insert(block.end(), { 0x00, 0x00, 0x00, 0x00 });
+  }
+  return block;
+}
+
+// Straightforward level-by-level reference, pairing an odd node with itself.
+auto ReferenceMerkleRoot(std::vector<nova::Sha256Digest> layer)
+  -> nova::Sha256Digest
+{
+  while (layer.size() > 1U) {
+    if ((layer.size() % 2U) != 0U) {
+      layer.push_back(layer.back());
+    }
+    auto next = std::vector<nova::Sha256Digest> {};
+    for (auto index = std::size_t { 0 }; index < layer.size(); index += 2U) {
+      auto pair = std::array<std::byte, 64> {};
+      std::memcpy(pair.data(), layer[index].data(), 32U);
+      std::memcpy(pair.data() + 32U, layer[index + 1U].data(), 32U);
+      next.push_back(nova::ComputeSha256d(pair));
+    }
+    layer = std::move(next);
+  }
+  return layer.front();
+}
+
+auto MakeLeaves(std::size_t count) -> std::vector<nova::Sha256Digest>
+{
+  auto leaves = std::vector<nova::Sha256Digest>(count);
+  for (auto index = std::size_t { 0 }; index < count; ++index) {
+    auto const seed = static_cast<std::uint32_t>(index);
+    leaves[index] = nova::ComputeSha256(std::as_bytes(std::span(&seed, 1U)));
+  }
+  return leaves;
+}
+
+} // namespace
+
+TEST(BlockAnalysisTest, ParallelMerkleRootMatchesReference)
+{
+  auto const leaves = MakeLeaves(70);
+  for (auto count = std::size_t { 1 }; count <= leaves.size(); ++count) {
+    auto const prefix = std::span(leaves).first(count);
+    auto const expected
+      = ReferenceMerkleRoot(std::vector<nova::Sha256Digest>(prefix.begin(), prefix.end()));
+    for (auto const workers : { 1U, 2U, 3U, 5U, 8U }) {
+      auto const options = BlockAnalysisOptions {
+        .worker_count = workers,
+        .min_transactions_per_worker = 1,
+      };
+      ASSERT_EQ(ComputeBlockMerkleRoot(prefix, options), expected)
+        << count << " leaves, " << workers << " workers";
+    }
+  }
+  EXPECT_EQ(ComputeBlockMerkleRoot({}), nova::Sha256Digest {});
+}
+
+TEST(BlockAnalysisTest, ParallelAnalysisMatchesSerialParse)
+{
+  auto const block = MakeBlock(1000);
+  auto transactions = std::vector<TransactionView> {};
+  ASSERT_TRUE(ParseBlockTransactions(block, transactions));
+  ASSERT_EQ(transactions.size(), 1000U);
+
+  auto expected_txids = std::vector<nova::Sha256Digest> {};
+  auto expected_value = std::uint64_t { 0 };
+  auto expected_weight = std::uint64_t { 0 };
+  for (auto const& transaction : transactions) {
+    expected_txids.push_back(ComputeTxid(block, transaction));
+    expected_value += transaction.output_value;
+    expected_weight += TransactionWeight(transaction);
+  }
+  auto const expected_root = ReferenceMerkleRoot(expected_txids);
+
+  for (auto const workers : { 1U, 4U }) {
+    auto analysis = BlockAnalysis {};
+    ASSERT_TRUE(AnalyzeBlock(block, analysis,
+      { .worker_count = workers, .min_transactions_per_worker = 16 }));
+    EXPECT_EQ(analysis.transactions, transactions);
+    EXPECT_EQ(analysis.txids, expected_txids);
+    for (auto index = std::size_t { 0 }; index < transactions.size(); ++index) {
+      ASSERT_EQ(analysis.wtxids[index], ComputeWtxid(block, transactions[index]));
+    }
+    EXPECT_EQ(analysis.merkle_root, expected_root);
+    EXPECT_EQ(analysis.total_output_value, expected_value);
+    EXPECT_EQ(analysis.total_weight, expected_weight);
+    EXPECT_EQ(analysis.witness_transaction_count, 333U);
+  }
+}
+
+TEST(BlockAnalysisTest, RejectsBlockWithoutTransactions)
+{
+  auto analysis = BlockAnalysis {};
+  EXPECT_FALSE(AnalyzeBlock(MakeBlock(0), analysis));
+  EXPECT_TRUE(AnalyzeBlock(MakeBlock(1), analysis));
+}
+
+TEST(BlockAnalysisTest, WeightCountsWitnessBytesOnce)
+{
+  auto const block = MakeBlock(2);
+  auto transactions = std::vector<TransactionView> {};
+  ASSERT_TRUE(ParseBlockTransactions(block, transactions));
+  ASSERT_EQ(transactions.size(), 2U);
+
+  EXPECT_EQ(TransactionWeight(transactions[0]), transactions[0].bytes.size * 4U);
+  // Marker, flag and the three witness bytes are only counted once.
+  auto const base_size = transactions[1].bytes.size - 5U;
+  EXPECT_EQ(TransactionWeight(transactions[1]),
+    (base_size * 3U) + transactions[1].bytes.size);
+}
+
+} // namespace blocxxi::bitcoin
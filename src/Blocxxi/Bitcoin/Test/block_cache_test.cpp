@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/block_cache.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+[[nodiscard]] auto MakeBlock(std::uint8_t tag, std::size_t size) -> BlockBody
+{
+  auto hash_bytes = std::array<std::uint8_t, BlockHash::kSize> {};
+  hash_bytes.fill(tag);
+  return BlockBody {
+    .block_hash = *BlockHash::FromBytes(hash_bytes),
+    .payload = std::vector<std::uint8_t>(size, tag),
+  };
+}
+
+[[nodiscard]] auto Payload(BlockCacheView const& view, BlockBody const& block)
+  -> std::vector<std::uint8_t>
+{
+  auto const found = view.Find(block.block_hash);
+  return found.has_value() ? std::vector<std::uint8_t>(found->begin(), found->end())
+                           : std::vector<std::uint8_t> {};
+}
+
+} // namespace
+
+TEST(BlockCacheTest, AppendsKeepRecordsOfAnotherCacheOnTheSameFile)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-block-cache-shared";
+  std::filesystem::remove_all(root);
+  auto const path = root / "blocks.pack";
+  auto const first = MakeBlock(1U, 100U);
+  auto const second = MakeBlock(2U, 200U);
+  auto const third = MakeBlock(3U, 300U);
+
+  auto writer = BlockCache(path);
+  auto stale = BlockCache(path);
+  // Taken while the file is empty, so its idea of where the records end is
+  // out of date once the other cache appends.
+  EXPECT_EQ(stale.Snapshot()->Size(), 0U);
+
+  ASSERT_TRUE(writer.Append(std::array { first }));
+  auto const held = writer.Snapshot();
+  ASSERT_TRUE(stale.Append(std::array { second }));
+  // A record cut short, as a crash while appending would leave it.
+  {
+    auto output = std::ofstream(path, std::ios::binary | std::ios::app);
+    output.write("torn", 4);
+  }
+  ASSERT_TRUE(writer.Append(std::array { third }));
+
+  // The view taken before the other appends still serves its block.
+  EXPECT_EQ(Payload(*held, first), first.payload);
+  auto const view = BlockCache(path).Snapshot();
+  EXPECT_EQ(view->Size(), 3U);
+  EXPECT_EQ(Payload(*view, first), first.payload);
+  EXPECT_EQ(Payload(*view, second), second.payload);
+  EXPECT_EQ(Payload(*view, third), third.payload);
+  EXPECT_EQ(std::filesystem::file_size(path), 3U * (BlockHash::kSize + 4U) + 600U);
+
+  std::filesystem::remove_all(root);
+}
+
+TEST(BlockCacheTest, AppendsOverTornRecordWhileSnapshotIsHeld)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-block-cache-torn";
+  std::filesystem::remove_all(root);
+  auto const path = root / "blocks.pack";
+  auto const first = MakeBlock(1U, 100U);
+  auto const second = MakeBlock(2U, 50U);
+  auto const third = MakeBlock(3U, 10U);
+
+  auto cache = BlockCache(path);
+  ASSERT_TRUE(cache.Append(std::array { first }));
+  // A record that claims 1000 bytes but got only 200 of them written.
+  {
+    auto torn = std::vector<char>(BlockHash::kSize + 4U + 200U, '\x09');
+    auto const claimed = std::uint32_t { 1000 };
+    std::memcpy(torn.data() + BlockHash::kSize, &claimed, sizeof(claimed));
+    auto output = std::ofstream(path, std::ios::binary | std::ios::app);
+    output.write(torn.data(), static_cast<std::streamsize>(torn.size()));
+  }
+  // Maps the torn bytes too, which on Windows keeps the file from shrinking.
+  auto const held = cache.Snapshot();
+  ASSERT_EQ(held->Size(), 1U);
+
+  ASSERT_TRUE(cache.Append(std::array { second }));
+  ASSERT_TRUE(cache.Append(std::array { third }));
+
+  EXPECT_EQ(Payload(*held, first), first.payload);
+  auto const view = BlockCache(path).Snapshot();
+  EXPECT_EQ(view->Size(), 3U);
+  EXPECT_EQ(Payload(*view, first), first.payload);
+  EXPECT_EQ(Payload(*view, second), second.payload);
+  EXPECT_EQ(Payload(*view, third), third.payload);
+  // The second block and padding take the place of the torn record.
+  EXPECT_EQ(std::filesystem::file_size(path),
+    (BlockHash::kSize + 4U + 100U) + (BlockHash::kSize + 4U + 200U)
+      + (BlockHash::kSize + 4U + 10U));
+
+  std::filesystem::remove_all(root);
+}
+
+} // namespace blocxxi::bitcoin
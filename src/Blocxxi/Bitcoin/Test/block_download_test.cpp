@@ -0,0 +1,383 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Bitcoin/block_download.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+constexpr auto kSignetMagic = std::array<std::uint8_t, 4> { 0x0a, 0x03, 0xcf, 0x40 };
+
+auto AppendLittleEndian(Bytes& out, std::uint64_t value, std::size_t width) -> void
+{
+  for (auto index = std::size_t { 0 }; index < width; ++index) {
+    out.push_back(static_cast<std::uint8_t>((value >> (index * 8U)) & 0xFFU));
+  }
+}
+
+[[nodiscard]] auto EncodeMessage(std::string_view command, std::span<std::uint8_t const> payload)
+  -> Bytes
+{
+  auto message = Bytes(kSignetMagic.begin(), kSignetMagic.end());
+  auto padded_command = std::array<std::uint8_t, 12> {};
+  std::copy(command.begin(), command.end(), padded_command.begin());
+  message.insert(message.end(), padded_command.begin(), padded_command.end());
+  AppendLittleEndian(message, payload.size(), 4U);
+  auto const checksum = nova::ComputeSha256d(std::as_bytes(payload));
+  message.insert(message.end(), checksum.begin(), checksum.begin() + 4U);
+  message.insert(message.end(), payload.begin(), payload.end());
+  return message;
+}
+
+[[nodiscard]] auto ReadMessage(asio::ip::tcp::socket& socket) -> std::pair<std::string, Bytes>
+{
+  auto header = Bytes(24U);
+  asio::read(socket, asio::buffer(header));
+  auto command = std::string {};
+  for (auto index = std::size_t { 4U }; index < 16U && header[index] != 0U; ++index) {
+    command.push_back(static_cast<char>(header[index]));
+  }
+  auto payload_size = std::uint32_t { 0 };
+  std::memcpy(&payload_size, header.data() + 16U, sizeof(payload_size));
+  auto payload = Bytes(payload_size);
+  asio::read(socket, asio::buffer(payload));
+  return { std::move(command), std::move(payload) };
+}
+
+// A block holding a single one-input, one-output transaction; `tag` makes
+// the block and so its hash unique.
+[[nodiscard]] auto MakeBlock(std::uint32_t tag) -> Bytes
+{
+  auto block = Bytes(80U, 0x00);
+  std::memcpy(block.data() + 76U, &tag, sizeof(tag));
+  block.push_back(1U);
+  block.insert(block.end(), { 0x02, 0x00, 0x00, 0x00, 0x01 });
+  block.insert(block.end(), 32U, 0x11);
+  block.insert(block.end(), { 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF });
+  block.push_back(1U);
+  AppendLittleEndian(block, tag, 8U);
+  block.insert(block.end(), { 0x01, 0x51, 0x00, 0x00, 0x00, 0x00 });
+  // The merkle root of a lone transaction is its txid.
+  auto const txid = nova::ComputeSha256d(std::as_bytes(std::span(block)).subspan(81U));
+  std::memcpy(block.data() + 36U, txid.data(), txid.size());
+  return block;
+}
+
+[[nodiscard]] auto HashOf(Bytes const& block) -> BlockHash
+{
+  return BlockHash(nova::ComputeSha256d80(
+    std::as_bytes(std::span(block)).first<nova::kSha256dHeaderSize>()));
+}
+
+// A local peer that completes the handshake and answers getdata from
+// `blocks`. After `serve_limit` blocks it either stops answering while
+// keeping the connection open, keeps sending inv instead of blocks, or hangs
+// up.
+class ScriptedPeer {
+public:
+  enum class AfterLimit { Stall, Chatter, Disconnect };
+
+  ScriptedPeer(std::unordered_map<BlockHash, Bytes> const& blocks, std::size_t serve_limit,
+    AfterLimit after_limit = AfterLimit::Stall)
+    : blocks_(blocks)
+    , serve_limit_(serve_limit)
+    , after_limit_(after_limit)
+  {
+    thread_ = std::thread([this] { Serve(); });
+  }
+
+  ScriptedPeer(ScriptedPeer const&) = delete;
+  auto operator=(ScriptedPeer const&) -> ScriptedPeer& = delete;
+
+  ~ScriptedPeer()
+  {
+    thread_.join();
+  }
+
+  [[nodiscard]] auto Endpoint() const -> PeerEndpoint
+  {
+    return { .host = "127.0.0.1", .port = acceptor_.local_endpoint().port() };
+  }
+
+private:
+  auto Serve() -> void
+  {
+    auto socket = asio::ip::tcp::socket(io_context_);
+    acceptor_.accept(socket);
+    (void)ReadMessage(socket); // version
+    auto version_reply = Bytes {};
+    AppendLittleEndian(version_reply, 70016U, 4U);
+    asio::write(socket, asio::buffer(EncodeMessage("version", version_reply)));
+    asio::write(socket, asio::buffer(EncodeMessage("verack", {})));
+
+    // Runs until the client hangs up.
+    try {
+      while (true) {
+        auto const [command, payload] = ReadMessage(socket);
+        if (command != "getdata") {
+          continue;
+        }
+        for (auto offset = std::size_t { 1 }; offset + 36U <= payload.size();
+             offset += 36U) {
+          if (served_ == serve_limit_) {
+            if (after_limit_ == AfterLimit::Disconnect) {
+              return;
+            }
+            if (after_limit_ == AfterLimit::Chatter) {
+              Chatter(socket);
+            }
+            continue;
+          }
+          auto const hash = *BlockHash::FromBytes(
+            std::span(payload).subspan(offset + 4U, BlockHash::kSize));
+          asio::write(socket, asio::buffer(EncodeMessage("block", blocks_.at(hash))));
+          ++served_;
+        }
+      }
+    } catch (std::exception const&) {
+    }
+  }
+
+  // Announces a block every 20ms until the client hangs up, which ends the
+  // peer by throwing.
+  static auto Chatter(asio::ip::tcp::socket& socket) -> void
+  {
+    auto inv = Bytes { 1U };
+    AppendLittleEndian(inv, 2U, 4U); // MSG_BLOCK
+    inv.insert(inv.end(), BlockHash::kSize, 0xAB);
+    while (true) {
+      asio::write(socket, asio::buffer(EncodeMessage("inv", inv)));
+      std::this_thread::sleep_for(std::chrono::milliseconds { 20 });
+    }
+  }
+
+  std::unordered_map<BlockHash, Bytes> const& blocks_;
+  std::size_t serve_limit_;
+  AfterLimit after_limit_;
+  std::atomic<std::size_t> served_ { 0 };
+  asio::io_context io_context_ {};
+  asio::ip::tcp::acceptor acceptor_ { io_context_,
+    { asio::ip::make_address("127.0.0.1"), 0 } };
+  std::thread thread_ {};
+};
+
+struct Chain {
+  std::vector<BlockHash> hashes {};
+  std::unordered_map<BlockHash, Bytes> blocks {};
+};
+
+[[nodiscard]] auto MakeChain(std::uint32_t count) -> Chain
+{
+  auto chain = Chain {};
+  for (auto tag = std::uint32_t { 0 }; tag < count; ++tag) {
+    auto block = MakeBlock(tag);
+    chain.hashes.push_back(HashOf(block));
+    chain.blocks.emplace(chain.hashes.back(), std::move(block));
+  }
+  return chain;
+}
+
+} // namespace
+
+TEST(BlockDownloadTest, SpreadsRequestsAcrossPeersAndDeliversInHeightOrder)
+{
+  auto const chain = MakeChain(60U);
+  auto const limit = chain.hashes.size();
+  auto peers = std::array {
+    std::make_unique<ScriptedPeer>(chain.blocks, limit),
+    std::make_unique<ScriptedPeer>(chain.blocks, limit),
+    std::make_unique<ScriptedPeer>(chain.blocks, limit),
+  };
+
+  auto manager = BlockDownloadManager({
+    .peers = { peers[0]->Endpoint(), peers[1]->Endpoint(), peers[2]->Endpoint() },
+    .max_in_flight_per_peer = 4,
+    .window_size = 16,
+  });
+  auto heights = std::vector<std::uint32_t> {};
+  auto const status = manager.Download(100U, chain.hashes, [&](DownloadedBlock&& block) {
+    EXPECT_EQ(block.body.block_hash, chain.hashes[block.height - 100U]);
+    EXPECT_EQ(block.body.payload, chain.blocks.at(block.body.block_hash));
+    EXPECT_TRUE(block.metadata.merkle_root_matches);
+    heights.push_back(block.height);
+    return blocxxi::core::Status::Success();
+  });
+  peers = {};
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(heights.size(), 60U);
+  EXPECT_TRUE(std::ranges::is_sorted(heights));
+  EXPECT_EQ(heights.front(), 100U);
+  auto const& stats = manager.Stats();
+  EXPECT_EQ(stats.blocks_delivered, 60U);
+  EXPECT_EQ(stats.re_requests, 0U);
+  EXPECT_EQ(stats.blocks_per_peer[0] + stats.blocks_per_peer[1] + stats.blocks_per_peer[2],
+    60U);
+  EXPECT_GE(std::ranges::count_if(
+              stats.blocks_per_peer, [](std::uint64_t blocks) { return blocks > 0U; }),
+    2);
+}
+
+TEST(BlockDownloadTest, ReRequestsBlocksOfStalledPeer)
+{
+  auto const chain = MakeChain(24U);
+  auto stalling = std::make_unique<ScriptedPeer>(chain.blocks, 2U);
+  auto healthy = std::make_unique<ScriptedPeer>(chain.blocks, chain.hashes.size());
+
+  auto manager = BlockDownloadManager({
+    .peers = { stalling->Endpoint(), healthy->Endpoint() },
+    .max_in_flight_per_peer = 4,
+    .window_size = 8,
+    .stall_timeout = std::chrono::milliseconds { 200 },
+  });
+  auto heights = std::vector<std::uint32_t> {};
+  auto const status = manager.Download(0U, chain.hashes, [&](DownloadedBlock&& block) {
+    heights.push_back(block.height);
+    return blocxxi::core::Status::Success();
+  });
+  stalling.reset();
+  healthy.reset();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(heights.size(), 24U);
+  EXPECT_TRUE(std::ranges::is_sorted(heights));
+  EXPECT_EQ(manager.Stats().stalled_peers, 1U);
+  EXPECT_GT(manager.Stats().re_requests, 0U);
+}
+
+TEST(BlockDownloadTest, ReRequestsBlocksOfPeerThatSendsAnythingButThem)
+{
+  auto const chain = MakeChain(24U);
+  auto chatty = std::make_unique<ScriptedPeer>(
+    chain.blocks, 2U, ScriptedPeer::AfterLimit::Chatter);
+  auto healthy = std::make_unique<ScriptedPeer>(chain.blocks, chain.hashes.size());
+
+  auto manager = BlockDownloadManager({
+    .peers = { chatty->Endpoint(), healthy->Endpoint() },
+    .max_in_flight_per_peer = 4,
+    .window_size = 8,
+    .stall_timeout = std::chrono::milliseconds { 200 },
+  });
+  auto heights = std::vector<std::uint32_t> {};
+  auto const status = manager.Download(0U, chain.hashes, [&](DownloadedBlock&& block) {
+    heights.push_back(block.height);
+    return blocxxi::core::Status::Success();
+  });
+  chatty.reset();
+  healthy.reset();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(heights.size(), 24U);
+  EXPECT_EQ(manager.Stats().stalled_peers, 1U);
+  EXPECT_GT(manager.Stats().re_requests, 0U);
+}
+
+TEST(BlockDownloadTest, FailsWhenEveryPeerDisconnects)
+{
+  auto const chain = MakeChain(10U);
+  auto peer = std::make_unique<ScriptedPeer>(
+    chain.blocks, 3U, ScriptedPeer::AfterLimit::Disconnect);
+
+  auto manager = BlockDownloadManager({
+    .peers = { peer->Endpoint() },
+    .max_in_flight_per_peer = 2,
+  });
+  auto heights = std::vector<std::uint32_t> {};
+  auto const status = manager.Download(0U, chain.hashes, [&](DownloadedBlock&& block) {
+    heights.push_back(block.height);
+    return blocxxi::core::Status::Success();
+  });
+  peer.reset();
+
+  EXPECT_EQ(status.code, blocxxi::core::StatusCode::IOError);
+  EXPECT_EQ(heights, (std::vector<std::uint32_t> { 0U, 1U, 2U }));
+}
+
+TEST(BlockDownloadTest, GivesUpOnPeerThatNeverCompletesHandshake)
+{
+  auto const chain = MakeChain(4U);
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+  // Accepts, then reads without ever answering until the client hangs up.
+  auto silent = std::thread([&] {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    auto sink = std::array<std::uint8_t, 256> {};
+    auto error = std::error_code {};
+    while (!error) {
+      (void)socket.read_some(asio::buffer(sink), error);
+    }
+  });
+
+  auto manager = BlockDownloadManager({
+    .peers = { { .host = "127.0.0.1", .port = port } },
+    .connect_timeout = std::chrono::milliseconds { 100 },
+  });
+  auto const started = std::chrono::steady_clock::now();
+  auto const status = manager.Download(
+    0U, chain.hashes, [](DownloadedBlock&&) { return blocxxi::core::Status::Success(); });
+  auto const elapsed = std::chrono::steady_clock::now() - started;
+  silent.join();
+
+  EXPECT_EQ(status.code, blocxxi::core::StatusCode::IOError);
+  EXPECT_LT(elapsed, std::chrono::seconds { 5 });
+}
+
+TEST(BlockDownloadTest, CancelStopsDownloadFromAnotherThread)
+{
+  auto const chain = MakeChain(8U);
+  auto peer = std::make_unique<ScriptedPeer>(chain.blocks, 2U);
+
+  auto manager = BlockDownloadManager({
+    .peers = { peer->Endpoint() },
+    .stall_timeout = std::chrono::milliseconds { 60000 },
+  });
+  auto delivered = std::atomic<std::size_t> { 0 };
+  auto canceller = std::thread([&] {
+    while (delivered.load() < 2U) {
+      std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+    manager.Cancel();
+  });
+  auto const status = manager.Download(0U, chain.hashes, [&](DownloadedBlock&&) {
+    ++delivered;
+    return blocxxi::core::Status::Success();
+  });
+  canceller.join();
+  peer.reset();
+
+  EXPECT_EQ(status.code, blocxxi::core::StatusCode::IOError);
+  EXPECT_EQ(status.message, "block download cancelled");
+  EXPECT_EQ(delivered.load(), 2U);
+}
+
+} // namespace blocxxi::bitcoin
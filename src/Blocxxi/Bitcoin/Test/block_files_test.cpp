@@ -0,0 +1,198 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/block_files.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+constexpr auto kMainnetMagic = std::array<std::uint8_t, 4> { 0xF9U, 0xBEU, 0xB4U, 0xD9U };
+
+// A block with one empty transaction.
+[[nodiscard]] auto MakeBlock(std::uint32_t nonce) -> std::vector<std::uint8_t>
+{
+  auto block = std::vector<std::uint8_t>(80U);
+  auto const version = std::uint32_t { 4 };
+  std::memcpy(block.data(), &version, sizeof(version));
+  std::memcpy(block.data() + 76U, &nonce, sizeof(nonce));
+  block.push_back(1U); // tx count
+  block.insert(block.end(), { 1U, 0U, 0U, 0U }); // tx version
+  block.push_back(0U); // vin count
+  block.push_back(0U); // vout count
+  block.insert(block.end(), { 0U, 0U, 0U, 0U }); // locktime
+  return block;
+}
+
+auto AppendFramed(std::vector<std::uint8_t>& file, std::span<std::uint8_t const> block)
+  -> void
+{
+  file.insert(file.end(), kMainnetMagic.begin(), kMainnetMagic.end());
+  auto const size = static_cast<std::uint32_t>(block.size());
+  for (auto index = 0U; index < 4U; ++index) {
+    file.push_back(static_cast<std::uint8_t>(size >> (index * 8U)));
+  }
+  file.insert(file.end(), block.begin(), block.end());
+}
+
+// Writes blocks/<name> under `root`, obfuscated with `key` the way
+// the node stores it.
+auto WriteBlockFile(std::filesystem::path const& root, std::string const& name,
+  std::vector<std::uint8_t> bytes, std::array<std::uint8_t, 8> const& key = {}) -> void
+{
+  for (auto index = std::size_t { 0 }; index < bytes.size(); ++index) {
+    bytes[index] ^= key[index % key.size()];
+  }
+  std::filesystem::create_directories(root / "blocks");
+  auto output = std::ofstream(root / "blocks" / name, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<char const*>(bytes.data()),
+    static_cast<std::streamsize>(bytes.size()));
+}
+
+struct Delivered {
+  std::uint32_t file_number { 0 };
+  std::uint64_t file_offset { 0 };
+  std::vector<std::uint8_t> payload {};
+  std::uint32_t nonce { 0 };
+};
+
+[[nodiscard]] auto Collect(std::vector<Delivered>& delivered) -> FileBlockSink
+{
+  return [&delivered](FileBlock&& block) {
+    delivered.push_back(Delivered {
+      .file_number = block.file_number,
+      .file_offset = block.file_offset,
+      .payload = { block.payload.begin(), block.payload.end() },
+      .nonce = block.metadata.nonce,
+    });
+    return core::Status::Success();
+  };
+}
+
+} // namespace
+
+TEST(BitcoinBlockFilesTest, ReadsBlocksAcrossFilesInStoredOrder)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-block-files";
+  std::filesystem::remove_all(root);
+
+  auto first = std::vector<std::uint8_t> {};
+  AppendFramed(first, MakeBlock(1U));
+  // Bytes that are not a block are skipped up to the next magic.
+  first.insert(first.end(), { 0xAAU, 0xBBU, 0xCCU });
+  AppendFramed(first, MakeBlock(2U));
+  AppendFramed(first, MakeBlock(3U));
+  auto second = std::vector<std::uint8_t> {};
+  AppendFramed(second, MakeBlock(4U));
+  // Space the node preallocated and has not written yet.
+  second.resize(second.size() + 64U, 0U);
+  WriteBlockFile(root, "blk00000.dat", first);
+  WriteBlockFile(root, "blk00001.dat", second);
+
+  auto ingestion = BlockFileIngestion({
+    .data_directory = root,
+    .worker_count = 3,
+    .blocks_in_flight = 2,
+  });
+  auto delivered = std::vector<Delivered> {};
+  auto const status = ingestion.Run(Collect(delivered));
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(delivered.size(), 4U);
+  for (auto index = std::size_t { 0 }; index < delivered.size(); ++index) {
+    EXPECT_EQ(delivered[index].nonce, index + 1U);
+    EXPECT_EQ(delivered[index].payload, MakeBlock(static_cast<std::uint32_t>(index + 1U)));
+  }
+  EXPECT_EQ(delivered[0].file_number, 0U);
+  EXPECT_EQ(delivered[0].file_offset, 8U);
+  EXPECT_EQ(delivered[1].file_offset, 8U + 91U + 3U + 8U);
+  EXPECT_EQ(delivered[3].file_number, 1U);
+  EXPECT_EQ(ingestion.Stats().files_read, 2U);
+  EXPECT_EQ(ingestion.Stats().blocks_delivered, 4U);
+  EXPECT_EQ(ingestion.Stats().bytes_read, first.size() + second.size());
+  EXPECT_EQ(ingestion.Stats().skipped_bytes, 3U + 64U);
+  EXPECT_EQ(ingestion.Stats().malformed_blocks, 0U);
+
+  std::filesystem::remove_all(root);
+}
+
+TEST(BitcoinBlockFilesTest, DeobfuscatesFilesWithXorKey)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-block-files-xor";
+  std::filesystem::remove_all(root);
+
+  auto const key = std::array<std::uint8_t, 8> { 0x11U, 0x22U, 0x33U, 0x44U, 0x55U,
+    0x66U, 0x77U, 0x88U };
+  auto bytes = std::vector<std::uint8_t> {};
+  AppendFramed(bytes, MakeBlock(7U));
+  // Framed, but too short for its transaction count.
+  auto truncated = MakeBlock(8U);
+  truncated.resize(81U);
+  truncated.back() = 5U;
+  AppendFramed(bytes, truncated);
+  // Odd sizes put the next block at an offset the key does not align to.
+  bytes.push_back(0U);
+  AppendFramed(bytes, MakeBlock(9U));
+  WriteBlockFile(root, "blk00000.dat", bytes, key);
+  {
+    auto output = std::ofstream(root / "blocks" / "xor.dat", std::ios::binary);
+    output.write(reinterpret_cast<char const*>(key.data()), key.size());
+  }
+
+  auto ingestion = BlockFileIngestion({
+    .data_directory = root,
+  });
+  auto delivered = std::vector<Delivered> {};
+  auto const status = ingestion.Run(Collect(delivered));
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(delivered.size(), 2U);
+  EXPECT_EQ(delivered[0].payload, MakeBlock(7U));
+  EXPECT_EQ(delivered[1].payload, MakeBlock(9U));
+  EXPECT_EQ(delivered[1].nonce, 9U);
+  EXPECT_EQ(ingestion.Stats().malformed_blocks, 1U);
+  EXPECT_EQ(ingestion.Stats().skipped_bytes, 1U);
+
+  std::filesystem::remove_all(root);
+}
+
+TEST(BitcoinBlockFilesTest, StopsWhenSinkFails)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-block-files-stop";
+  std::filesystem::remove_all(root);
+
+  auto bytes = std::vector<std::uint8_t> {};
+  AppendFramed(bytes, MakeBlock(1U));
+  AppendFramed(bytes, MakeBlock(2U));
+  WriteBlockFile(root, "blk00000.dat", bytes);
+
+  auto ingestion = BlockFileIngestion({ .data_directory = root });
+  auto calls = 0;
+  auto const status = ingestion.Run([&calls](FileBlock&&) {
+    ++calls;
+    return core::Status::Failure(core::StatusCode::Rejected, "stop");
+  });
+
+  EXPECT_EQ(status.code, core::StatusCode::Rejected);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(ingestion.Stats().blocks_delivered, 0U);
+
+  std::filesystem::remove_all(root);
+  auto delivered = std::vector<Delivered> {};
+  EXPECT_EQ(ingestion.Run(Collect(delivered)).code, core::StatusCode::NotFound);
+}
+
+} // namespace blocxxi::bitcoin
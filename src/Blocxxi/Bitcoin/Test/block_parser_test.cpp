@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+#include <Blocxxi/Bitcoin/block_parser.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+auto Append(Bytes& out, Bytes const& bytes) -> void
+{
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+// Version 2, one input spending output 1 of an all-0x11 txid, one output of
+// `value` satoshis, lock time 0.
+auto MakeLegacyTransaction(std::uint8_t value) -> Bytes
+{
+  auto tx = Bytes { 0x02, 0x00, 0x00, 0x00 };
+  tx.push_back(1U); // input count
+  tx.insert(tx.end(), 32U, 0x11); // prevout hash
+  Append(tx, { 0x01, 0x00, 0x00, 0x00 }); // prevout index
+  Append(tx, { 0x02, 0xAB, 0xCD }); // scriptSig
+  Append(tx, { 0xFF, 0xFF, 0xFF, 0xFF }); // sequence
+  tx.push_back(1U); // output count
+  Append(tx, { value, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 });
+  Append(tx, { 0x01, 0x51 }); // scriptPubKey
+  Append(tx, { 0x00, 0x00, 0x00, 0x00 }); // lock time
+  return tx;
+}
+
+// The legacy transaction above with a marker, flag and one witness item.
+auto MakeWitnessTransaction(std::uint8_t value) -> Bytes
+{
+  auto const legacy = MakeLegacyTransaction(value);
+  auto tx = Bytes(legacy.begin(), legacy.begin() + 4);
+  Append(tx, { 0x00, 0x01 }); // marker and flag
+  tx.insert(tx.end(), legacy.begin() + 4, legacy.end() - 4);
+  Append(tx, { 0x01, 0x02, 0x42, 0x43 }); // one stack item of two bytes
+  tx.insert(tx.end(), legacy.end() - 4, legacy.end());
+  return tx;
+}
+
+auto MakeBlock(std::vector<Bytes> const& transactions) -> Bytes
+{
+  auto block = Bytes(kBlockHeaderSize, 0x00);
+  block.push_back(static_cast<std::uint8_t>(transactions.size()));
+  for (auto const& tx : transactions) {
+    Append(block, tx);
+  }
+  return block;
+}
+
+auto DoubleSha256(Bytes const& bytes) -> nova::Sha256Digest
+{
+  return nova::ComputeSha256d(std::as_bytes(std::span(bytes)));
+}
+
+} // namespace
+
+TEST(BlockParserTest, LocatesTransactionPartsInPlace)
+{
+  auto const legacy = MakeLegacyTransaction(7U);
+  auto const witness = MakeWitnessTransaction(9U);
+  auto const block = MakeBlock({ legacy, witness });
+
+  auto transactions = std::vector<TransactionView> {};
+  ASSERT_TRUE(ParseBlockTransactions(block, transactions));
+  ASSERT_EQ(transactions.size(), 2U);
+
+  auto const& first = transactions[0];
+  EXPECT_EQ(first.bytes, (ByteRange { .offset = 81U, .size = legacy.size() }));
+  EXPECT_EQ(first.inputs, (ByteRange { .offset = 85U, .size = 1U + 36U + 3U + 4U }));
+  EXPECT_EQ(first.outputs.offset, first.inputs.End());
+  EXPECT_EQ(first.outputs.size, 1U + 8U + 2U);
+  EXPECT_EQ(first.witness.size, 0U);
+  EXPECT_FALSE(first.has_witness);
+  EXPECT_EQ(first.version, 2U);
+  EXPECT_EQ(first.input_count, 1U);
+  EXPECT_EQ(first.output_count, 1U);
+  EXPECT_EQ(first.output_value, 7U);
+
+  auto const& second = transactions[1];
+  EXPECT_EQ(second.bytes.offset, first.bytes.End());
+  EXPECT_EQ(second.bytes.End(), block.size());
+  EXPECT_TRUE(second.has_witness);
+  EXPECT_EQ(second.inputs.offset, second.bytes.offset + 6U);
+  EXPECT_EQ(second.witness, (ByteRange { .offset = second.outputs.End(), .size = 4U }));
+  EXPECT_EQ(second.output_value, 9U);
+}
+
+TEST(BlockParserTest, TxidSkipsWitnessDataWithoutCopying)
+{
+  auto const legacy = MakeLegacyTransaction(7U);
+  auto const witness = MakeWitnessTransaction(7U);
+  auto const block = MakeBlock({ legacy, witness });
+
+  auto transactions = std::vector<TransactionView> {};
+  ASSERT_TRUE(ParseBlockTransactions(block, transactions));
+  ASSERT_EQ(transactions.size(), 2U);
+
+  EXPECT_EQ(ComputeTxid(block, transactions[0]), DoubleSha256(legacy));
+  EXPECT_EQ(ComputeWtxid(block, transactions[0]), DoubleSha256(legacy));
+  // Stripping the witness of the second transaction yields the first.
+  EXPECT_EQ(ComputeTxid(block, transactions[1]), DoubleSha256(legacy));
+  EXPECT_EQ(ComputeWtxid(block, transactions[1]), DoubleSha256(witness));
+}
+
+TEST(BlockParserTest, RejectsTruncatedBlocksAndImpossibleCounts)
+{
+  auto const block = MakeBlock({ MakeLegacyTransaction(1U), MakeWitnessTransaction(2U) });
+  auto transactions = std::vector<TransactionView> {};
+  for (auto size = std::size_t { 0 }; size < block.size(); ++size) {
+    EXPECT_FALSE(
+      ParseBlockTransactions(std::span(block).first(size), transactions))
+      << size;
+  }
+
+  auto reader = BlockReader::Open(block);
+  ASSERT_TRUE(reader.has_value());
+  EXPECT_EQ(reader->TransactionCount(), 2U);
+  EXPECT_TRUE(reader->Next().has_value());
+  EXPECT_TRUE(reader->Next().has_value());
+  EXPECT_FALSE(reader->Next().has_value());
+  EXPECT_FALSE(reader->Failed());
+
+  // A count no payload of this size could hold is refused up front.
+  auto huge = Bytes(kBlockHeaderSize, 0x00);
+  Append(huge, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F });
+  EXPECT_FALSE(ParseBlockTransactions(huge, transactions));
+}
+
+TEST(BlockParserTest, RejectsTrailingBytesAndOverflowingOutputValues)
+{
+  auto transactions = std::vector<TransactionView> {};
+  auto trailing = MakeBlock({ MakeLegacyTransaction(1U) });
+  ASSERT_TRUE(ParseBlockTransactions(trailing, transactions));
+  trailing.push_back(0x00);
+  EXPECT_FALSE(ParseBlockTransactions(trailing, transactions));
+
+  // Two outputs of 2^64 - 1 satoshis each.
+  auto const legacy = MakeLegacyTransaction(0U);
+  auto tx = Bytes(legacy.begin(), legacy.begin() + 48);
+  tx.push_back(2U); // output count
+  for (auto output = 0; output < 2; ++output) {
+    tx.insert(tx.end(), 8U, 0xFF);
+    Append(tx, { 0x01, 0x51 });
+  }
+  Append(tx, { 0x00, 0x00, 0x00, 0x00 });
+  EXPECT_FALSE(ParseBlockTransactions(MakeBlock({ tx }), transactions));
+  // The second output worth nothing fits.
+  std::fill_n(tx.begin() + 48 + 1 + 8 + 2, 8, 0x00);
+  EXPECT_TRUE(ParseBlockTransactions(MakeBlock({ tx }), transactions));
+}
+
+} // namespace blocxxi::bitcoin
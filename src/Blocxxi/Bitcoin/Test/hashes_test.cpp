@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <unordered_set>
+
+#include <Blocxxi/Bitcoin/hashes.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+constexpr auto kGenesisHex
+  = "00000008819873e925422c1ff0f99f7cc9bbb232af63a077a480a3633bee1ef6";
+
+} // namespace
+
+TEST(HashesTest, HexIsTheByteReversedDisplayForm)
+{
+  auto const hash = BlockHash::FromHex(kGenesisHex);
+  ASSERT_TRUE(hash.has_value());
+  EXPECT_EQ(hash->Data().front(), 0xF6U);
+  EXPECT_EQ(hash->Data().back(), 0x00U);
+  EXPECT_EQ(hash->ToHex(), kGenesisHex);
+  EXPECT_EQ(BlockHash::FromBytes(hash->Span()), hash);
+
+  EXPECT_FALSE(BlockHash::FromHex("00").has_value());
+  EXPECT_FALSE(BlockHash::FromHex(
+    "zz000008819873e925422c1ff0f99f7cc9bbb232af63a077a480a3633bee1ef6")
+                 .has_value());
+  EXPECT_FALSE(BlockHash::FromBytes(std::array<std::uint8_t, 31> {}).has_value());
+}
+
+TEST(HashesTest, ComparesAsLittleEndianNumber)
+{
+  auto low = BlockHash::Bytes {};
+  low[31] = 0x01;
+  auto high = BlockHash::Bytes {};
+  high[0] = 0xFF;
+  // The last wire byte is the most significant.
+  EXPECT_EQ(BlockHash(low).CompareAsNumber(BlockHash(high)),
+    std::strong_ordering::greater);
+  EXPECT_EQ(BlockHash(high).CompareAsNumber(BlockHash(high)),
+    std::strong_ordering::equal);
+
+  EXPECT_TRUE(BlockHash {}.IsNull());
+  EXPECT_FALSE(BlockHash(high).IsNull());
+
+  auto const set = std::unordered_set<Txid> { Txid(low), Txid(high), Txid(low) };
+  EXPECT_EQ(set.size(), 2U);
+}
+
+} // namespace blocxxi::bitcoin
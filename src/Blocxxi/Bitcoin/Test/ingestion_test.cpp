@@ -6,22 +6,44 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
 
 #include <Blocxxi/Bitcoin/ingestion.h>
 
 namespace blocxxi::bitcoin {
 namespace {
 
+// Entries are told apart by their txid, every other response by its method.
+[[nodiscard]] auto ResponseKey(std::string_view method, std::string_view params_json)
+  -> std::string
+{
+  return method == "getmempoolentry" ? std::string(method) + std::string(params_json)
+                                     : std::string(method);
+}
+
 class ScriptedTransport final : public RpcTransport {
 public:
-  auto Call(std::string_view method, std::string_view, std::string& response_json)
-    -> core::Status override
+  auto Call(std::string_view method, std::string_view params_json,
+    std::string& response_json) -> core::Status override
   {
-    auto const found = responses_.find(std::string(method));
+    if (method == "getmempoolentry") {
+      entry_requests_.emplace_back(params_json);
+    }
+    auto const found = responses_.find(ResponseKey(method, params_json));
     if (found == responses_.end()) {
       return core::Status::Failure(core::StatusCode::NotFound, "missing rpc method");
     }
@@ -29,6 +51,13 @@ public:
     return core::Status::Success();
   }
 
+  auto CallBatch(std::span<RpcCall const> calls, std::vector<std::string>& responses_json)
+    -> core::Status override
+  {
+    batch_sizes_.push_back(calls.size());
+    return RpcTransport::CallBatch(calls, responses_json);
+  }
+
   std::map<std::string, std::string> responses_ {
     { "getblockcount", R"({"result":101})" },
     { "getbestblockhash", R"({"result":"000000abc"})" },
@@ -36,12 +65,102 @@ public:
     { "getnetworkinfo",
       R"({"result":{"connections":8,"relayfee":0.00001000,"warnings":"ok"}})" },
     { "getblockchaininfo", R"({"result":{"initialblockdownload":false}})" },
-    { "getrawmempool",
-      R"({"result":{"tx1":{"vsize":200,"weight":800,"fees":{"base":0.00020000}},"tx2":{"vsize":300,"weight":1200,"fees":{"base":0.00030000}}}})" },
+    { "getrawmempool", R"({"result":["tx1","tx2"]})" },
+    { R"(getmempoolentry["tx1"])",
+      R"({"result":{"vsize":200,"weight":800,"fees":{"base":0.00020000}}})" },
+    { R"(getmempoolentry["tx2"])",
+      R"({"result":{"vsize":300,"weight":1200,"fees":{"base":0.00030000}}})" },
+    { R"(getmempoolentry["tx3"])",
+      R"({"result":{"vsize":150,"weight":600,"fees":{"base":0.00001000}}})" },
     { "getblockstats", R"({"result":{"txs":10,"totalfee":0.00150000}})" },
   };
+  std::vector<std::string> entry_requests_ {};
+  std::vector<std::size_t> batch_sizes_ {};
 };
 
+// Reads one HTTP request and returns its body, or nothing once the client
+// has closed the connection.
+auto ReadHttpRequest(asio::ip::tcp::socket& socket, std::string& pending)
+  -> std::optional<std::string>
+{
+  auto error = std::error_code {};
+  auto const header_size
+    = asio::read_until(socket, asio::dynamic_buffer(pending), "\r\n\r\n", error);
+  if (error) {
+    return std::nullopt;
+  }
+  auto const length_at = pending.find("Content-Length: ");
+  auto const length
+    = static_cast<std::size_t>(std::stoul(pending.substr(length_at + 16U)));
+  if (pending.size() < header_size + length) {
+    asio::read(socket, asio::dynamic_buffer(pending),
+      asio::transfer_exactly(header_size + length - pending.size()), error);
+  }
+  auto body = pending.substr(header_size, length);
+  pending.erase(0U, header_size + length);
+  return body;
+}
+
+[[nodiscard]] auto RequestedMethod(std::string const& body) -> std::string
+{
+  auto const begin = body.find(R"("method":")") + 10U;
+  return body.substr(begin, body.find('"', begin) - begin);
+}
+
+[[nodiscard]] auto RequestedParams(std::string const& body) -> std::string
+{
+  auto const begin = body.find(R"("params":)") + 9U;
+  return body.substr(begin, body.find('}', begin) - begin);
+}
+
+// The response to each call in `body`, a single call or a batch. Batch
+// replies come back last call first, the way the node is free to order them.
+[[nodiscard]] auto AnswerRpcRequest(
+  std::string const& body, std::map<std::string, std::string> const& responses)
+  -> std::string
+{
+  if (!body.starts_with("[")) {
+    return responses.at(ResponseKey(RequestedMethod(body), RequestedParams(body)));
+  }
+  auto replies = std::vector<std::string> {};
+  for (auto at = body.find(R"("id":)"); at != std::string::npos;
+       at = body.find(R"("id":)", at + 1U)) {
+    auto const id = body.substr(at + 5U, body.find(',', at) - at - 5U);
+    auto const call = body.substr(at);
+    auto reply = responses.at(ResponseKey(RequestedMethod(call), RequestedParams(call)));
+    reply.insert(reply.size() - 1U, R"(,"error":null,"id":)" + id);
+    replies.push_back(std::move(reply));
+  }
+  auto answer = std::string { "[" };
+  for (auto reply = replies.rbegin(); reply != replies.rend(); ++reply) {
+    answer += (reply == replies.rbegin() ? "" : ",") + *reply;
+  }
+  return answer + "]";
+}
+
+// Answers with a Content-Length body, or with the body cut into chunks.
+auto WriteHttpResponse(asio::ip::tcp::socket& socket, std::string const& body,
+  bool chunked) -> void
+{
+  auto response
+    = std::string { "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n" };
+  if (!chunked) {
+    response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+  } else {
+    response += "Transfer-Encoding: chunked\r\n\r\n";
+    for (auto offset = std::size_t { 0 }; offset < body.size(); offset += 7U) {
+      auto const piece = body.substr(offset, 7U);
+      auto size = std::array<char, 8> {};
+      auto const end
+        = std::to_chars(size.data(), size.data() + size.size(), piece.size(), 16).ptr;
+      response.append(size.data(), end);
+      response += ";ext=1\r\n" + piece + "\r\n";
+    }
+    response += "0\r\nX-Trailer: done\r\n\r\n";
+  }
+  asio::write(socket, asio::buffer(response));
+}
+
 } // namespace
 
 TEST(BitcoinIngestionTest, CoreRpcAdapterNormalizesMempoolAndNetworkObservations)
@@ -69,10 +188,72 @@ TEST(BitcoinIngestionTest, CoreRpcAdapterNormalizesMempoolAndNetworkObservations
   EXPECT_EQ(batch.network_health->mempool_bytes, 512U);
   EXPECT_FALSE(batch.network_health->initial_block_download);
 
-  ASSERT_EQ(batch.mempool_transactions.size(), 2U);
-  EXPECT_EQ(batch.mempool_transactions[0].txid, "tx1");
-  EXPECT_EQ(batch.mempool_transactions[0].vsize, 200U);
-  EXPECT_DOUBLE_EQ(batch.mempool_transactions[1].base_fee_btc, 0.0003);
+  ASSERT_EQ(batch.added_transactions.size(), 2U);
+  EXPECT_EQ(batch.added_transactions[0].txid, "tx1");
+  EXPECT_EQ(batch.added_transactions[0].vsize, 200U);
+  EXPECT_EQ(batch.added_transactions[0].weight, 800U);
+  EXPECT_DOUBLE_EQ(batch.added_transactions[1].base_fee_btc, 0.0003);
+  EXPECT_TRUE(batch.removed_txids.empty());
+  EXPECT_EQ(adapter.Mempool().Size(), 2U);
+}
+
+TEST(BitcoinIngestionTest, CoreRpcAdapterSyncsMempoolByDifference)
+{
+  auto transport = std::make_shared<ScriptedTransport>();
+  auto adapter = BitcoinCoreRpcAdapter(BitcoinCoreRpcConfig {}, transport);
+  auto first = ObservationBatch {};
+  ASSERT_TRUE(adapter.Poll(first).ok());
+
+  transport->responses_["getrawmempool"] = R"({"result":["tx2","tx3"]})";
+  transport->entry_requests_.clear();
+  auto second = ObservationBatch {};
+  ASSERT_TRUE(adapter.Poll(second).ok());
+
+  EXPECT_EQ(transport->entry_requests_, std::vector<std::string> { R"(["tx3"])" });
+  ASSERT_EQ(second.added_transactions.size(), 1U);
+  EXPECT_EQ(second.added_transactions[0].txid, "tx3");
+  EXPECT_EQ(second.removed_txids, std::vector<std::string> { "tx1" });
+  EXPECT_EQ(adapter.Mempool().Size(), 2U);
+  EXPECT_EQ(adapter.Mempool().Find("tx1"), nullptr);
+  ASSERT_NE(adapter.Mempool().Find("tx3"), nullptr);
+  EXPECT_EQ(adapter.Mempool().Find("tx3")->vsize, 150U);
+
+  // Nothing changed, so nothing is looked up.
+  transport->entry_requests_.clear();
+  auto third = ObservationBatch {};
+  ASSERT_TRUE(adapter.Poll(third).ok());
+  EXPECT_TRUE(transport->entry_requests_.empty());
+  EXPECT_TRUE(third.added_transactions.empty());
+  EXPECT_TRUE(third.removed_txids.empty());
+}
+
+TEST(BitcoinIngestionTest, CoreRpcAdapterLooksUpNewTransactionsInBoundedBatches)
+{
+  auto transport = std::make_shared<ScriptedTransport>();
+  // tx4 leaves the mempool between the txid list and its lookup.
+  transport->responses_["getrawmempool"]
+    = R"({"result":["tx1","tx2","tx3","tx4","tx5"]})";
+  transport->responses_[R"(getmempoolentry["tx5"])"]
+    = R"({"result":{"vsize":100,"weight":400,"fees":{"base":0.00001000}}})";
+  auto adapter = BitcoinCoreRpcAdapter(
+    BitcoinCoreRpcConfig { .max_mempool_transactions = 2 }, transport);
+
+  auto first = ObservationBatch {};
+  auto const status = adapter.Poll(first);
+  ASSERT_TRUE(status.ok()) << status.message;
+  // The snapshot calls, then the entries two at a time.
+  EXPECT_EQ(transport->batch_sizes_, (std::vector<std::size_t> { 5U, 2U, 2U, 1U }));
+  ASSERT_EQ(first.added_transactions.size(), 4U);
+  EXPECT_EQ(first.added_transactions[2].txid, "tx3");
+  EXPECT_EQ(first.added_transactions[3].txid, "tx5");
+  EXPECT_EQ(adapter.Mempool().Size(), 4U);
+
+  // Only the transaction that had no entry is asked about again.
+  transport->entry_requests_.clear();
+  auto second = ObservationBatch {};
+  ASSERT_TRUE(adapter.Poll(second).ok());
+  EXPECT_EQ(transport->entry_requests_, std::vector<std::string> { R"(["tx4"])" });
+  EXPECT_TRUE(second.added_transactions.empty());
 }
 
 TEST(BitcoinIngestionTest, CoreRpcAdapterRejectsMissingResponses)
@@ -87,6 +268,196 @@ TEST(BitcoinIngestionTest, CoreRpcAdapterRejectsMissingResponses)
   EXPECT_EQ(status.code, core::StatusCode::NotFound);
 }
 
+TEST(BitcoinIngestionTest, HttpRpcTransportKeepsOneConnectionAcrossPoll)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+  auto const responses = ScriptedTransport {}.responses_;
+  auto connections = 0;
+  auto requests = std::vector<std::string> {};
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    ++connections;
+    auto pending = std::string {};
+    while (auto const body = ReadHttpRequest(socket, pending)) {
+      WriteHttpResponse(
+        socket, AnswerRpcRequest(*body, responses), requests.size() % 2U == 1U);
+      requests.push_back(*body);
+    }
+  });
+
+  auto first = ObservationBatch {};
+  auto second = ObservationBatch {};
+  auto status = core::Status {};
+  {
+    auto adapter = BitcoinCoreRpcAdapter(BitcoinCoreRpcConfig {
+      .network = Network::Mainnet,
+      .connection = {
+        .host = "127.0.0.1",
+        .port = port,
+        .username = "blocxxi",
+        .password = "secret",
+      },
+    });
+    status = adapter.Poll(first);
+    if (status.ok()) {
+      status = adapter.Poll(second);
+    }
+    // Dropping the adapter closes the connection, which ends the server.
+  }
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(connections, 1);
+  // A batch, the txids, a batch of their entries and the stats of the new
+  // tip. By the second poll neither the mempool nor the tip has changed, so
+  // it skips the entries and the stats.
+  ASSERT_EQ(requests.size(), 6U);
+  EXPECT_TRUE(requests[0].starts_with("["));
+  EXPECT_EQ(RequestedMethod(requests[1]), "getrawmempool");
+  EXPECT_NE(requests[1].find(R"("params":[false])"), std::string::npos);
+  EXPECT_TRUE(requests[2].starts_with("["));
+  EXPECT_EQ(RequestedMethod(requests[2]), "getmempoolentry");
+  EXPECT_EQ(RequestedMethod(requests[3]), "getblockstats");
+  EXPECT_NE(requests[3].find(R"("params":["000000abc",)"), std::string::npos);
+  EXPECT_TRUE(requests[4].starts_with("["));
+  EXPECT_EQ(RequestedMethod(requests[5]), "getrawmempool");
+
+  ASSERT_EQ(first.added_transactions.size(), 2U);
+  EXPECT_DOUBLE_EQ(first.added_transactions[1].base_fee_btc, 0.0003);
+  EXPECT_TRUE(second.added_transactions.empty());
+  EXPECT_TRUE(second.removed_txids.empty());
+  for (auto const* batch : { &first, &second }) {
+    ASSERT_TRUE(batch->latest_block.has_value());
+    EXPECT_EQ(batch->latest_block->height, 101U);
+    EXPECT_EQ(batch->latest_block->block_hash_hex, "000000abc");
+    EXPECT_EQ(batch->latest_block->transaction_count, 10U);
+    EXPECT_EQ(batch->latest_block->total_fee_satoshis, 150000U);
+    ASSERT_TRUE(batch->network_health.has_value());
+    EXPECT_EQ(batch->network_health->connection_count, 8U);
+    EXPECT_EQ(batch->network_health->warning, "ok");
+  }
+}
+
+TEST(BitcoinIngestionTest, HttpRpcTransportRejectsBatchWithFailedCall)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    auto pending = std::string {};
+    (void)ReadHttpRequest(socket, pending);
+    WriteHttpResponse(socket,
+      R"([{"result":null,"error":{"code":-32601,"message":"Method not found"},"id":1},)"
+      R"({"result":101,"error":null,"id":0}])",
+      false);
+  });
+
+  auto transport = HttpRpcTransport({
+    .host = "127.0.0.1",
+    .port = port,
+    .username = "blocxxi",
+    .password = "secret",
+  });
+  auto const calls = std::array {
+    RpcCall { .method = "getblockcount", .params_json = "[]" },
+    RpcCall { .method = "getnosuchthing", .params_json = "[]" },
+  };
+  auto responses = std::vector<std::string> {};
+  auto const status = transport.CallBatch(calls, responses);
+  server.join();
+
+  EXPECT_EQ(status.code, core::StatusCode::Rejected);
+  EXPECT_NE(status.message.find("getnosuchthing"), std::string::npos);
+}
+
+TEST(BitcoinIngestionTest, HttpRpcTransportKeepsErrorOfCallThatMayFail)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+
+  auto server = std::thread([&]() {
+    auto socket = asio::ip::tcp::socket(io_context);
+    acceptor.accept(socket);
+    auto pending = std::string {};
+    (void)ReadHttpRequest(socket, pending);
+    WriteHttpResponse(socket,
+      R"([{"result":null,"error":{"code":-5,"message":"Transaction not in mempool"},"id":1},)"
+      R"({"result":{"vsize":200},"error":null,"id":0}])",
+      false);
+  });
+
+  auto transport = HttpRpcTransport({
+    .host = "127.0.0.1",
+    .port = port,
+    .username = "blocxxi",
+    .password = "secret",
+  });
+  auto const calls = std::array {
+    RpcCall { .method = "getmempoolentry", .params_json = R"(["tx1"])", .may_fail = true },
+    RpcCall { .method = "getmempoolentry", .params_json = R"(["tx2"])", .may_fail = true },
+  };
+  auto responses = std::vector<std::string> {};
+  auto const status = transport.CallBatch(calls, responses);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  ASSERT_EQ(responses.size(), 2U);
+  EXPECT_NE(responses[0].find(R"("vsize":200)"), std::string::npos);
+  EXPECT_NE(responses[1].find("Transaction not in mempool"), std::string::npos);
+}
+
+TEST(BitcoinIngestionTest, HttpRpcTransportReconnectsAfterServerClosesIdleConnection)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+  auto connections = 0;
+
+  auto server = std::thread([&]() {
+    // Each connection answers one call and is then closed, as the node does
+    // with a connection that stays idle past its timeout.
+    for (auto call = 0; call < 2; ++call) {
+      auto socket = asio::ip::tcp::socket(io_context);
+      acceptor.accept(socket);
+      ++connections;
+      auto pending = std::string {};
+      (void)ReadHttpRequest(socket, pending);
+      WriteHttpResponse(socket, R"({"result":101})", call == 1);
+    }
+  });
+
+  auto transport = HttpRpcTransport({
+    .host = "127.0.0.1",
+    .port = port,
+    .username = "blocxxi",
+    .password = "secret",
+  });
+  auto first = std::string {};
+  ASSERT_TRUE(transport.Call("getblockcount", "[]", first).ok());
+  // Let the server close the first connection.
+  std::this_thread::sleep_for(std::chrono::milliseconds { 50 });
+  auto second = std::string {};
+  auto const status = transport.Call("getblockcount", "[]", second);
+  server.join();
+
+  ASSERT_TRUE(status.ok()) << status.message;
+  EXPECT_EQ(connections, 2);
+  EXPECT_EQ(first, R"({"result":101})");
+  EXPECT_EQ(second, R"({"result":101})");
+}
+
 TEST(BitcoinIngestionTest, ResolveBitcoinCoreRpcConfigReadsBitcoinConf)
 {
   auto const root
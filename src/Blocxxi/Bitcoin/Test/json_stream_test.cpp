@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/json_stream.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// Writes each event down as a line.
+class RecordingHandler final : public JsonHandler {
+public:
+  auto StartObject() -> bool override { return Record("{"); }
+  auto EndObject() -> bool override { return Record("}"); }
+  auto StartArray() -> bool override { return Record("["); }
+  auto EndArray() -> bool override { return Record("]"); }
+  auto Key(std::string_view key) -> bool override
+  {
+    return Record("key " + std::string(key));
+  }
+  auto String(std::string_view value) -> bool override
+  {
+    return Record("string " + std::string(value));
+  }
+  auto Number(std::string_view value) -> bool override
+  {
+    return Record("number " + std::string(value));
+  }
+  auto Bool(bool value) -> bool override { return Record(value ? "true" : "false"); }
+  auto Null() -> bool override { return Record("null"); }
+
+  std::vector<std::string> events {};
+
+private:
+  auto Record(std::string event) -> bool
+  {
+    events.push_back(std::move(event));
+    return true;
+  }
+};
+
+// Feeds `document` in pieces of `piece_size`.
+[[nodiscard]] auto Parse(std::string_view document, std::size_t piece_size,
+  RecordingHandler& handler) -> bool
+{
+  auto parser = JsonStreamParser(handler);
+  for (auto offset = std::size_t { 0 }; offset < document.size(); offset += piece_size) {
+    if (!parser.Feed(document.substr(offset, piece_size))) {
+      return false;
+    }
+  }
+  return parser.Finish();
+}
+
+} // namespace
+
+TEST(BitcoinJsonStreamTest, ReportsTheSameEventsWhereverInputIsSplit)
+{
+  constexpr auto kDocument = std::string_view {
+    R"( {"result":{"tx\"1":{"vsize":-2.5e3,"fees":{"base":0.0002}},)"
+    R"("tx2":{"depends":[],"bip125":true}},"error":null,)"
+    R"("id":"aé😀\n","ok":[false,12]} )"
+  };
+  auto const expected = std::vector<std::string> {
+    "{",
+    "key result",
+    "{",
+    "key tx\"1",
+    "{",
+    "key vsize",
+    "number -2.5e3",
+    "key fees",
+    "{",
+    "key base",
+    "number 0.0002",
+    "}",
+    "}",
+    "key tx2",
+    "{",
+    "key depends",
+    "[",
+    "]",
+    "key bip125",
+    "true",
+    "}",
+    "}",
+    "key error",
+    "null",
+    "key id",
+    "string a\xC3\xA9\xF0\x9F\x98\x80\n",
+    "key ok",
+    "[",
+    "false",
+    "number 12",
+    "]",
+    "}",
+  };
+
+  for (auto piece_size = std::size_t { 1 }; piece_size <= kDocument.size(); ++piece_size) {
+    auto handler = RecordingHandler {};
+    ASSERT_TRUE(Parse(kDocument, piece_size, handler)) << piece_size;
+    EXPECT_EQ(handler.events, expected) << piece_size;
+  }
+
+  auto scalar = RecordingHandler {};
+  ASSERT_TRUE(Parse("101", 2U, scalar));
+  EXPECT_EQ(scalar.events, std::vector<std::string> { "number 101" });
+}
+
+TEST(BitcoinJsonStreamTest, RejectsMalformedDocuments)
+{
+  for (auto const* document : { R"({"a":})", R"([1,])", R"({"a" 1})", R"([1 2])",
+         R"({"a":1)", R"(["\x"])", R"(["\ud83d"])", R"([tru])", R"({} {})", R"(])",
+         R"(["\{"])", R"(["\u12"])", R"(["\udc00"])", "[\"a\tb\"]", "{\"\x01\":1}" }) {
+    auto handler = RecordingHandler {};
+    EXPECT_FALSE(Parse(document, 1U, handler)) << document;
+  }
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/json_tape.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// The structural index worked out one byte at a time.
+[[nodiscard]] auto ByteByByteIndex(std::string_view text) -> std::vector<std::uint32_t>
+{
+  auto index = std::vector<std::uint32_t> {};
+  auto in_string = false;
+  auto escaped = false;
+  auto in_literal = false;
+  for (auto position = std::size_t { 0 }; position < text.size(); ++position) {
+    auto const current = text[position];
+    if (in_string) {
+      if (static_cast<unsigned char>(current) < 0x20U) {
+        index.push_back(static_cast<std::uint32_t>(position));
+      }
+      if (escaped) {
+        escaped = false;
+      } else if (current == '\\') {
+        escaped = true;
+      } else if (current == '"') {
+        in_string = false;
+        index.push_back(static_cast<std::uint32_t>(position));
+      }
+      continue;
+    }
+    auto const delimiter = std::string_view("{}[]:,\" \t\r\n").find(current)
+      != std::string_view::npos;
+    if (delimiter) {
+      in_literal = false;
+      if (current == '"') {
+        in_string = true;
+      }
+      if (current != ' ' && current != '\t' && current != '\r' && current != '\n') {
+        index.push_back(static_cast<std::uint32_t>(position));
+      }
+    } else if (!in_literal) {
+      in_literal = true;
+      index.push_back(static_cast<std::uint32_t>(position));
+    }
+  }
+  return index;
+}
+
+} // namespace
+
+TEST(BitcoinJsonTapeTest, StructuralIndexMatchesByteByByteScan)
+{
+  // Runs of backslashes of every parity, control characters in strings,
+  // and values long enough to cross the 64-byte blocks the index is built
+  // from.
+  auto const body = std::string {
+    R"({"a\\":"x\"y","b\\\"c":[1,-2.5e3,true,false,null],"long":")"
+    + std::string(70U, 'z') + "\t\\\x01\x1f" + R"(\\\\","tail":{"n":12345678901234567890}})"
+  };
+  for (auto shift = std::size_t { 0 }; shift < 70U; ++shift) {
+    auto const text = std::string(shift, ' ') + body;
+    EXPECT_EQ(BuildStructuralIndex(text), ByteByByteIndex(text)) << shift;
+  }
+}
+
+TEST(BitcoinJsonTapeTest, FindsValuesByKey)
+{
+  constexpr auto kResponse = std::string_view {
+    R"( {"result":{"size":2,"name":"a\"b","fees":{"base":0.0002},)"
+    R"("list":[{"id":1},[],"x"],"esc\"key":7},"error":null,"id":"blocxxi"} )"
+  };
+  auto const tape = JsonTape::Parse(kResponse);
+  ASSERT_TRUE(tape.has_value());
+
+  auto const result = tape->Find(tape->Root(), "result");
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(tape->Node(*result).kind, JsonKind::Object);
+  EXPECT_EQ(tape->FindText(*result, "size"), "2");
+  EXPECT_EQ(tape->FindText(*result, "name"), R"("a\"b")");
+  EXPECT_EQ(tape->FindText(*result, "esc\"key"), "7");
+  EXPECT_FALSE(tape->Find(*result, "base").has_value());
+  EXPECT_EQ(tape->FindText(tape->Root(), "error"), "null");
+  EXPECT_EQ(tape->FindText(tape->Root(), "id"), R"("blocxxi")");
+
+  auto const fees = tape->Find(*result, "fees");
+  ASSERT_TRUE(fees.has_value());
+  EXPECT_EQ(tape->FindText(*fees, "base"), "0.0002");
+
+  auto const list = tape->Find(*result, "list");
+  ASSERT_TRUE(list.has_value());
+  EXPECT_EQ(tape->Text(*list), R"([{"id":1},[],"x"])");
+  auto const elements = tape->Children(*list);
+  ASSERT_EQ(elements.size(), 3U);
+  EXPECT_EQ(tape->FindText(elements[0], "id"), "1");
+  EXPECT_EQ(tape->Node(elements[1]).kind, JsonKind::Array);
+  EXPECT_EQ(tape->Text(elements[2]), R"("x")");
+
+  auto const scalar = JsonTape::Parse("101");
+  ASSERT_TRUE(scalar.has_value());
+  EXPECT_EQ(scalar->Text(scalar->Root()), "101");
+}
+
+TEST(BitcoinJsonTapeTest, RejectsMalformedDocuments)
+{
+  for (auto const* document : { "", R"({"a":})", R"([1,])", R"({"a" 1})", R"([1 2])",
+         R"({"a":1)", R"(["x)", R"([tru])", R"({} {})", R"(])", R"({"a":1]})",
+         R"({1:2})", R"(["\1"])", R"(["\{"])", R"(["\u12"])", R"(["\u12g4"])",
+         R"(["\ud800"])", R"(["\ud800x"])", R"(["\ud800\n"])", R"(["\udc00"])", "[\"a\tb\"]",
+         "{\"\x01\":1}", "[\"\\\x1f\"]" }) {
+    EXPECT_FALSE(JsonTape::Parse(document).has_value()) << document;
+  }
+  for (auto const* document : { R"(["\"\\\/\b\f\n\r\t"])", R"(["\u00e9\u00E9"])",
+         R"(["\ud83d\ude00"])", "[\"\x7f\"]" }) {
+    EXPECT_TRUE(JsonTape::Parse(document).has_value()) << document;
+  }
+}
+
+} // namespace blocxxi::bitcoin
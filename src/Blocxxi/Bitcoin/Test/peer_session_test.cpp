@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Bitcoin/peer_session.h>
+#include <Blocxxi/Bitcoin/wire.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// Accepts every connection and never sends a byte, so no handshake ever
+// completes.
+class SilentPeer {
+public:
+  SilentPeer()
+  {
+    Accept();
+    thread_ = std::thread([this] { io_context_.run(); });
+  }
+
+  ~SilentPeer()
+  {
+    io_context_.stop();
+    thread_.join();
+    // The sockets go before the io_context they belong to.
+    connections_.clear();
+  }
+
+  SilentPeer(SilentPeer const&) = delete;
+  auto operator=(SilentPeer const&) -> SilentPeer& = delete;
+
+  [[nodiscard]] auto Port() const -> std::uint16_t
+  {
+    return acceptor_.local_endpoint().port();
+  }
+
+  // Read from the test thread only once the peer has stopped.
+  std::vector<std::shared_ptr<asio::ip::tcp::socket>> connections_ {};
+
+private:
+  auto Accept() -> void
+  {
+    auto socket = std::make_shared<asio::ip::tcp::socket>(io_context_);
+    acceptor_.async_accept(*socket, [this, socket](std::error_code const& error) {
+      if (!error) {
+        connections_.push_back(socket);
+        Accept();
+      }
+    });
+  }
+
+  asio::io_context io_context_ {};
+  asio::ip::tcp::acceptor acceptor_ {
+    io_context_, { asio::ip::make_address("127.0.0.1"), 0 }
+  };
+  std::thread thread_ {};
+};
+
+} // namespace
+
+TEST(PeerSessionTest, AwaitGivesUpOnPeerThatNeverCompletesHandshake)
+{
+  auto peer = std::make_unique<SilentPeer>();
+  auto const locator = std::array<BlockHash, 1> {};
+  auto const started = std::chrono::steady_clock::now();
+  auto reply = std::optional<PeerReply> {};
+  {
+    auto session = PeerSession({
+      .host = "127.0.0.1",
+      .port = peer->Port(),
+      .request_timeout = std::chrono::milliseconds { 100 },
+      .max_resends = 1,
+    });
+    auto future = session.RequestHeaders(locator);
+    reply = session.Await(future);
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - started;
+  peer.reset();
+
+  EXPECT_EQ(reply->status.code, core::StatusCode::IOError);
+  EXPECT_LT(elapsed, std::chrono::seconds { 5 });
+}
+
+TEST(PeerSessionTest, DestructorStopsHandshakeWithSilentPeer)
+{
+  auto peer = SilentPeer {};
+  auto const locator = std::array<BlockHash, 1> {};
+  auto future = std::future<PeerReply> {};
+  auto const started = std::chrono::steady_clock::now();
+  {
+    // Long enough that only the destructor can end the handshake.
+    auto session = PeerSession({
+      .host = "127.0.0.1",
+      .port = peer.Port(),
+      .request_timeout = std::chrono::milliseconds { 60000 },
+    });
+    future = session.RequestHeaders(locator);
+    std::this_thread::sleep_for(std::chrono::milliseconds { 50 });
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - started;
+
+  EXPECT_EQ(future.get().status.code, core::StatusCode::IOError);
+  EXPECT_LT(elapsed, std::chrono::seconds { 5 });
+}
+
+TEST(PeerSessionTest, RequestsDoNotWaitForPeerThatStopsReading)
+{
+  auto io_context = asio::io_context {};
+  auto acceptor
+    = asio::ip::tcp::acceptor(io_context, { asio::ip::make_address("127.0.0.1"), 0 });
+  auto const port = acceptor.local_endpoint().port();
+  auto const locator = std::array<BlockHash, 1> {};
+  auto futures = std::vector<std::future<PeerReply>> {};
+  auto peer = TcpSocket(io_context);
+  auto elapsed = std::chrono::steady_clock::duration {};
+  {
+    auto session = PeerSession({
+      .host = "127.0.0.1",
+      .port = port,
+      .request_timeout = std::chrono::milliseconds { 60000 },
+    });
+    futures.push_back(session.RequestHeaders(locator));
+
+    // Completes the handshake and waits for the first request, then
+    // reads nothing more.
+    acceptor.accept(peer);
+    auto buffer = ReceiveBuffer {};
+    auto saw_version = false;
+    while (auto message = ReadMessage(peer, buffer)) {
+      if (message->command == "version") {
+        saw_version = true;
+        ASSERT_TRUE(SendMessage(peer, "version", EncodeVersionPayload("127.0.0.1", port)));
+        ASSERT_TRUE(SendMessage(peer, "verack", {}));
+      }
+      if (message->command == "getheaders") {
+        break;
+      }
+    }
+    ASSERT_TRUE(saw_version);
+
+    // Far more than the socket buffers hold, so writing them on the
+    // calling thread would block.
+    auto const long_locator = std::vector<BlockHash>(2000);
+    auto const started = std::chrono::steady_clock::now();
+    for (auto index = 0; index < 200; ++index) {
+      futures.push_back(session.RequestHeaders(long_locator));
+    }
+    elapsed = std::chrono::steady_clock::now() - started;
+  }
+
+  EXPECT_LT(elapsed, std::chrono::seconds { 5 });
+  for (auto& future : futures) {
+    EXPECT_EQ(future.get().status.code, core::StatusCode::IOError);
+  }
+}
+
+} // namespace blocxxi::bitcoin
@@ -13,8 +13,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <ctime>
 #include <fstream>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <span>
@@ -22,219 +22,40 @@
 #include <utility>
 #include <vector>
 
-#include <asio.hpp>
-
+#include <Blocxxi/Bitcoin/block_analysis.h>
+#include <Blocxxi/Bitcoin/block_cache.h>
+#include <Blocxxi/Bitcoin/peer_session.h>
+#include <Blocxxi/Bitcoin/wire.h>
 #include <Blocxxi/Core/primitives.h>
 
 namespace blocxxi::bitcoin {
 namespace {
 
-constexpr auto kProtocolVersion = std::int32_t { 70016 };
-constexpr auto kSignetMagic = std::array<std::uint8_t, 4> { 0x0a, 0x03, 0xcf, 0x40 };
 constexpr auto kSignetPowLimitHex = std::string_view {
   "00000377ae000000000000000000000000000000000000000000000000000000"
 };
 
-using TcpSocket = asio::ip::tcp::socket;
-using TcpEndpoints = asio::ip::tcp::resolver::results_type;
-
-[[nodiscard]] auto ToBytes(std::string_view text) -> std::vector<std::uint8_t>
-{
-  return std::vector<std::uint8_t>(text.begin(), text.end());
-}
-
-[[nodiscard]] auto ToHex(std::span<std::uint8_t const> bytes) -> std::string
-{
-  constexpr auto kHexDigits = std::string_view { "0123456789abcdef" };
-  auto encoded = std::string {};
-  encoded.reserve(bytes.size() * 2U);
-  for (auto const byte : bytes) {
-    encoded.push_back(kHexDigits[(byte >> 4U) & 0x0FU]);
-    encoded.push_back(kHexDigits[byte & 0x0FU]);
-  }
-  return encoded;
-}
-
-[[nodiscard]] auto WireHashToHex(std::span<std::uint8_t const> bytes) -> std::string
-{
-  auto reversed = std::vector<std::uint8_t>(bytes.rbegin(), bytes.rend());
-  return ToHex(reversed);
-}
-
-[[nodiscard]] auto HexToBytes(std::string const& hex)
-  -> std::optional<std::vector<std::uint8_t>>
+// Reads the 32-byte hash stored at `offset`, in wire order.
+template <typename Hash>
+[[nodiscard]] auto ReadWireHash(std::span<std::uint8_t const> bytes, std::size_t offset)
+  -> Hash
 {
-  if ((hex.size() % 2U) != 0U) {
-    return std::nullopt;
-  }
-  auto bytes = std::vector<std::uint8_t>(hex.size() / 2U);
-  for (auto index = std::size_t { 0 }; index < bytes.size(); ++index) {
-    auto const chunk = hex.substr(index * 2U, 2U);
-    auto parsed = std::uint32_t { 0 };
-    auto stream = std::stringstream {};
-    stream << std::hex << chunk;
-    stream >> parsed;
-    if (stream.fail()) {
-      return std::nullopt;
-    }
-    bytes[index] = static_cast<std::uint8_t>(parsed);
-  }
-  return bytes;
+  auto raw = typename Hash::Bytes {};
+  std::memcpy(raw.data(), bytes.data() + offset, raw.size());
+  return Hash(raw);
 }
 
-[[nodiscard]] auto DoubleSha256(std::span<std::uint8_t const> payload)
+[[nodiscard]] auto HeaderHash(std::span<std::uint8_t const> header)
   -> std::array<std::uint8_t, 32>
 {
-  auto const bytes
-    = std::span<std::byte const>(reinterpret_cast<std::byte const*>(payload.data()), payload.size());
-  auto first = nova::ComputeSha256(bytes);
-  auto second = nova::ComputeSha256(
-    std::span<std::byte const>(reinterpret_cast<std::byte const*>(first.data()), first.size()));
-  return second;
-}
-
-[[nodiscard]] auto ComputeMerkleRootHex(std::span<std::string const> txids)
-  -> std::optional<std::string>
-{
-  if (txids.empty()) {
-    return std::nullopt;
-  }
-
-  auto layer = std::vector<std::vector<std::uint8_t>> {};
-  layer.reserve(txids.size());
-  for (auto const& txid : txids) {
-    auto bytes = HexToBytes(txid);
-    if (!bytes.has_value() || bytes->size() != 32U) {
-      return std::nullopt;
-    }
-    std::reverse(bytes->begin(), bytes->end());
-    layer.push_back(std::move(*bytes));
-  }
-
-  while (layer.size() > 1U) {
-    if ((layer.size() % 2U) != 0U) {
-      layer.push_back(layer.back());
-    }
-    auto next = std::vector<std::vector<std::uint8_t>> {};
-    next.reserve(layer.size() / 2U);
-    for (auto index = std::size_t { 0 }; index < layer.size(); index += 2U) {
-      auto concatenated = std::vector<std::uint8_t> {};
-      concatenated.reserve(64U);
-      concatenated.insert(
-        concatenated.end(), layer[index].begin(), layer[index].end());
-      concatenated.insert(concatenated.end(), layer[index + 1U].begin(),
-        layer[index + 1U].end());
-      auto const hash = DoubleSha256(concatenated);
-      next.emplace_back(hash.begin(), hash.end());
-    }
-    layer = std::move(next);
-  }
-
-  std::reverse(layer.front().begin(), layer.front().end());
-  return ToHex(layer.front());
-}
-
-auto AppendLittleEndian(
-  std::vector<std::uint8_t>& out, std::uint64_t value, std::size_t width) -> void
-{
-  for (auto index = std::size_t { 0 }; index < width; ++index) {
-    out.push_back(static_cast<std::uint8_t>((value >> (index * 8U)) & 0xFFU));
-  }
-}
-
-auto AppendCompactSize(std::vector<std::uint8_t>& out, std::uint64_t value)
-  -> void
-{
-  if (value < 253U) {
-    out.push_back(static_cast<std::uint8_t>(value));
-    return;
-  }
-  if (value <= 0xFFFFU) {
-    out.push_back(0xFD);
-    AppendLittleEndian(out, value, 2U);
-    return;
-  }
-  if (value <= 0xFFFFFFFFU) {
-    out.push_back(0xFE);
-    AppendLittleEndian(out, value, 4U);
-    return;
-  }
-  out.push_back(0xFF);
-  AppendLittleEndian(out, value, 8U);
-}
-
-[[nodiscard]] auto ReadCompactSize(
-  std::span<std::uint8_t const> payload, std::size_t& offset) -> std::optional<std::uint64_t>
-{
-  if (offset >= payload.size()) {
-    return std::nullopt;
-  }
-
-  auto const first = payload[offset++];
-  if (first < 253U) {
-    return first;
-  }
-
-  auto const width = first == 0xFD ? 2U : first == 0xFE ? 4U : 8U;
-  if (offset + width > payload.size()) {
-    return std::nullopt;
-  }
-
-  auto value = std::uint64_t { 0 };
-  for (auto index = std::size_t { 0 }; index < width; ++index) {
-    value |= static_cast<std::uint64_t>(payload[offset + index]) << (index * 8U);
-  }
-  offset += width;
-  return value;
-}
-
-[[nodiscard]] auto WireHashFromHex(std::string const& hash_hex)
-  -> std::optional<std::array<std::uint8_t, 32>>
-{
-  if (hash_hex.size() != 64U) {
-    return std::nullopt;
-  }
-
-  auto bytes = std::array<std::uint8_t, 32> {};
-  for (auto index = std::size_t { 0 }; index < 32U; ++index) {
-    auto const chunk = hash_hex.substr(index * 2U, 2U);
-    auto parsed = std::uint32_t { 0 };
-    auto stream = std::stringstream {};
-    stream << std::hex << chunk;
-    stream >> parsed;
-    if (stream.fail()) {
-      return std::nullopt;
-    }
-    bytes[31U - index] = static_cast<std::uint8_t>(parsed);
-  }
-  return bytes;
-}
-
-[[nodiscard]] auto HashBytesFromHex(std::string const& hash_hex)
-  -> std::optional<std::array<std::uint8_t, 32>>
-{
-  if (hash_hex.size() != 64U) {
-    return std::nullopt;
-  }
-
-  auto bytes = std::array<std::uint8_t, 32> {};
-  for (auto index = std::size_t { 0 }; index < 32U; ++index) {
-    auto const chunk = hash_hex.substr(index * 2U, 2U);
-    auto parsed = std::uint32_t { 0 };
-    auto stream = std::stringstream {};
-    stream << std::hex << chunk;
-    stream >> parsed;
-    if (stream.fail()) {
-      return std::nullopt;
-    }
-    bytes[index] = static_cast<std::uint8_t>(parsed);
-  }
-  return bytes;
+  return nova::ComputeSha256d80(
+    std::as_bytes(header).first<nova::kSha256dHeaderSize>());
 }
 
+// The target is returned in wire order, so that it compares against block
+// hashes with WireHash::CompareAsNumber().
 [[nodiscard]] auto TargetFromCompact(
-  std::uint32_t bits, std::string_view pow_limit_hex)
-  -> std::optional<std::array<std::uint8_t, 32>>
+  std::uint32_t bits, std::string_view pow_limit_hex) -> std::optional<BlockHash>
 {
   auto const exponent = static_cast<std::uint8_t>((bits >> 24U) & 0xFFU);
   auto mantissa = bits & 0x007FFFFFU;
@@ -260,272 +81,51 @@ auto AppendCompactSize(std::vector<std::uint8_t>& out, std::uint64_t value)
     target[32U - offset - 1U] = static_cast<std::uint8_t>(mantissa & 0xFFU);
   }
 
-  auto const pow_limit = HashBytesFromHex(std::string(pow_limit_hex));
-  if (!pow_limit.has_value()) {
-    return std::nullopt;
-  }
-  if (target > *pow_limit) {
-    return std::nullopt;
-  }
-  return target;
-}
-
-[[nodiscard]] auto EncodeMessage(
-  std::string_view command, std::span<std::uint8_t const> payload) -> std::vector<std::uint8_t>
-{
-  auto message = std::vector<std::uint8_t> {};
-  message.insert(message.end(), kSignetMagic.begin(), kSignetMagic.end());
-
-  auto padded_command = std::array<std::uint8_t, 12> {};
-  auto const command_bytes = ToBytes(command);
-  std::copy(command_bytes.begin(), command_bytes.end(), padded_command.begin());
-  message.insert(message.end(), padded_command.begin(), padded_command.end());
-
-  AppendLittleEndian(message, payload.size(), 4U);
-  auto const checksum = DoubleSha256(payload);
-  message.insert(message.end(), checksum.begin(), checksum.begin() + 4U);
-  message.insert(message.end(), payload.begin(), payload.end());
-  return message;
-}
-
-[[nodiscard]] auto EncodeVersionPayload(std::string const& remote_address,
-  std::uint16_t remote_port) -> std::vector<std::uint8_t>
-{
-  auto payload = std::vector<std::uint8_t> {};
-  auto const now = static_cast<std::uint64_t>(std::time(nullptr));
-  auto const user_agent = std::string_view { "/blocxxi:0.1.0/" };
-
-  AppendLittleEndian(payload, static_cast<std::uint32_t>(kProtocolVersion), 4U);
-  AppendLittleEndian(payload, 0U, 8U);
-  AppendLittleEndian(payload, now, 8U);
-
-  auto append_network_address =
-    [&](std::string const& host, std::uint16_t port) {
-      AppendLittleEndian(payload, 0U, 8U);
-      auto const address = asio::ip::make_address(host);
-      if (address.is_v4()) {
-        payload.insert(payload.end(), 10U, 0U);
-        payload.push_back(0xFF);
-        payload.push_back(0xFF);
-        auto const bytes = address.to_v4().to_bytes();
-        payload.insert(payload.end(), bytes.begin(), bytes.end());
-      } else {
-        auto const bytes = address.to_v6().to_bytes();
-        payload.insert(payload.end(), bytes.begin(), bytes.end());
-      }
-      payload.push_back(static_cast<std::uint8_t>((port >> 8U) & 0xFFU));
-      payload.push_back(static_cast<std::uint8_t>(port & 0xFFU));
-    };
-
-  append_network_address(remote_address, remote_port);
-  append_network_address("0.0.0.0", 0U);
-  AppendLittleEndian(payload, 0x12345678ABCDEF00ULL, 8U);
-  AppendCompactSize(payload, user_agent.size());
-  payload.insert(payload.end(), user_agent.begin(), user_agent.end());
-  AppendLittleEndian(payload, 0U, 4U);
-  payload.push_back(0U);
-  return payload;
-}
-
-[[nodiscard]] auto EncodeGetHeadersPayload(std::string const& locator_hash_hex)
-  -> std::optional<std::vector<std::uint8_t>>
-{
-  auto locator = WireHashFromHex(locator_hash_hex);
-  if (!locator.has_value()) {
-    return std::nullopt;
-  }
-
-  auto payload = std::vector<std::uint8_t> {};
-  AppendLittleEndian(payload, static_cast<std::uint32_t>(kProtocolVersion), 4U);
-  AppendCompactSize(payload, 1U);
-  payload.insert(payload.end(), locator->begin(), locator->end());
-  payload.insert(payload.end(), 32U, 0U);
-  return payload;
-}
-
-[[nodiscard]] auto EncodeGetDataPayload(std::span<std::string const> block_hashes)
-  -> std::optional<std::vector<std::uint8_t>>
-{
-  auto payload = std::vector<std::uint8_t> {};
-  AppendCompactSize(payload, block_hashes.size());
-  for (auto const& hash_hex : block_hashes) {
-    auto hash = WireHashFromHex(hash_hex);
-    if (!hash.has_value()) {
-      return std::nullopt;
-    }
-    AppendLittleEndian(payload, 2U, 4U); // MSG_BLOCK
-    payload.insert(payload.end(), hash->begin(), hash->end());
-  }
-  return payload;
-}
-
-auto ReadExact(TcpSocket& socket, std::size_t size) -> std::optional<std::vector<std::uint8_t>>
-{
-  auto buffer = std::vector<std::uint8_t>(size);
-  auto offset = std::size_t { 0 };
-  while (offset < size) {
-    auto error = std::error_code {};
-    auto const transferred = socket.read_some(
-      asio::buffer(buffer.data() + offset, size - offset), error);
-    if (error) {
-      return std::nullopt;
-    }
-    offset += transferred;
-  }
-  return buffer;
-}
-
-struct DecodedMessage {
-  std::string command {};
-  std::vector<std::uint8_t> payload {};
-};
-
-auto ReadMessage(TcpSocket& socket) -> std::optional<DecodedMessage>
-{
-  auto header = ReadExact(socket, 24U);
-  if (!header.has_value()) {
-    return std::nullopt;
-  }
-  if (!std::equal(kSignetMagic.begin(), kSignetMagic.end(), header->begin())) {
-    return std::nullopt;
-  }
-
-  auto command = std::string {};
-  for (auto index = std::size_t { 4U }; index < 16U && (*header)[index] != 0U; ++index) {
-    command.push_back(static_cast<char>((*header)[index]));
-  }
-
-  auto payload_size = std::uint32_t { 0 };
-  std::memcpy(&payload_size, header->data() + 16U, sizeof(payload_size));
-  auto payload = ReadExact(socket, payload_size);
-  if (!payload.has_value()) {
-    return std::nullopt;
-  }
-
-  auto checksum = DoubleSha256(*payload);
-  if (!std::equal(checksum.begin(), checksum.begin() + 4U, header->begin() + 20U)) {
-    return std::nullopt;
-  }
-
-  return DecodedMessage { std::move(command), std::move(*payload) };
-}
-
-auto SendMessage(
-  TcpSocket& socket, std::string_view command, std::span<std::uint8_t const> payload)
-  -> bool
-{
-  auto const message = EncodeMessage(command, payload);
-  auto error = std::error_code {};
-  asio::write(socket, asio::buffer(message), error);
-  return !error;
-}
-
-auto ResolveEndpoints(asio::io_context& io_context, std::string const& host,
-  std::uint16_t port) -> std::optional<TcpEndpoints>
-{
-  auto resolver = asio::ip::tcp::resolver(io_context);
-  auto error = std::error_code {};
-  auto endpoints
-    = resolver.resolve(host, std::to_string(static_cast<unsigned int>(port)), error);
-  if (error) {
+  std::ranges::reverse(target);
+  auto const wire_target = BlockHash(target);
+  auto const pow_limit = BlockHash::FromHex(pow_limit_hex);
+  if (!pow_limit.has_value() || wire_target.CompareAsNumber(*pow_limit) > 0) {
     return std::nullopt;
   }
-  return endpoints;
-}
-
-auto ReadTrackedMessage(
-  TcpSocket& socket, std::vector<std::string>& command_trace) -> std::optional<DecodedMessage>
-{
-  auto message = ReadMessage(socket);
-  if (message.has_value()) {
-    command_trace.push_back(message->command);
-  }
-  return message;
-}
-
-auto ReadNextNonPingMessage(
-  TcpSocket& socket, std::vector<std::string>& command_trace) -> std::optional<DecodedMessage>
-{
-  while (true) {
-    auto message = ReadTrackedMessage(socket, command_trace);
-    if (!message.has_value()) {
-      return std::nullopt;
-    }
-    if (message->command != "ping") {
-      return message;
-    }
-    if (!SendMessage(socket, "pong", message->payload)) {
-      return std::nullopt;
-    }
-  }
-}
-
-auto CompleteVersionHandshake(TcpSocket& socket, std::string const& remote_address,
-  std::uint16_t port, std::int32_t& protocol_version,
-  std::vector<std::string>& command_trace) -> bool
-{
-  auto const version = EncodeVersionPayload(remote_address, port);
-  if (!SendMessage(socket, "version", version)) {
-    return false;
-  }
-
-  auto saw_version = false;
-  auto saw_verack = false;
-  while (!(saw_version && saw_verack)) {
-    auto message = ReadTrackedMessage(socket, command_trace);
-    if (!message.has_value()) {
-      return false;
-    }
-
-    if (message->command == "version") {
-      if (message->payload.size() >= sizeof(protocol_version)) {
-        std::memcpy(&protocol_version, message->payload.data(), sizeof(protocol_version));
-      }
-      saw_version = true;
-      if (!SendMessage(socket, "verack", std::span<std::uint8_t const> {})) {
-        return false;
-      }
-      continue;
-    }
-    if (message->command == "ping") {
-      if (!SendMessage(socket, "pong", message->payload)) {
-        return false;
-      }
-      continue;
-    }
-    if (message->command == "verack") {
-      saw_verack = true;
-    }
-  }
-  return true;
+  return wire_target;
 }
 
 auto ParseHeadersPayload(std::span<std::uint8_t const> payload,
   std::uint32_t locator_height,
-  std::vector<std::string>& header_hashes,
+  std::vector<BlockHash>& header_hashes,
   std::vector<Header>& headers) -> core::Status
 {
   auto offset = std::size_t { 0 };
   auto const count = ReadCompactSize(payload, offset);
-  if (!count.has_value() || *count == 0U) {
+  if (!count.has_value() || *count > kMaxHeadersPerMessage) {
     return core::Status::Failure(
-      core::StatusCode::Rejected, "headers response is empty");
+      core::StatusCode::Rejected, "headers response has an invalid count");
   }
 
+  // Validate the framing first so that all headers can be hashed in one batch.
+  auto raw_headers = std::vector<std::span<std::byte const, nova::kSha256dHeaderSize>> {};
   for (auto index = std::uint64_t { 0 }; index < *count; ++index) {
     if (offset + 80U > payload.size()) {
       return core::Status::Failure(
         core::StatusCode::Rejected, "headers payload is truncated");
     }
 
-    auto const header = std::span<std::uint8_t const>(payload.data() + offset, 80U);
+    raw_headers.push_back(
+      std::as_bytes(payload.subspan(offset).first<nova::kSha256dHeaderSize>()));
     offset += 80U;
     auto const txn_count = ReadCompactSize(payload, offset);
     if (!txn_count.has_value() || *txn_count != 0U) {
       return core::Status::Failure(
         core::StatusCode::Rejected, "headers payload contains invalid txn count");
     }
+  }
+
+  auto hashes = std::vector<nova::Sha256Digest>(raw_headers.size());
+  nova::ComputeSha256d80Many(raw_headers, hashes);
 
+  for (auto index = std::size_t { 0 }; index < raw_headers.size(); ++index) {
+    auto const header = std::span<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(raw_headers[index].data()), 80U);
     auto version = std::uint32_t { 0 };
     std::memcpy(&version, header.data(), sizeof(version));
     auto timestamp = std::uint32_t { 0 };
@@ -534,18 +134,13 @@ auto ParseHeadersPayload(std::span<std::uint8_t const> payload,
     std::memcpy(&bits, header.data() + 72U, sizeof(bits));
     auto nonce = std::uint32_t { 0 };
     std::memcpy(&nonce, header.data() + 76U, sizeof(nonce));
-    auto const hash = DoubleSha256(header);
-    auto reversed = std::array<std::uint8_t, 32> {};
-    std::reverse_copy(hash.begin(), hash.end(), reversed.begin());
-    auto const hash_hex = ToHex(reversed);
-    header_hashes.push_back(hash_hex);
+    auto const hash = BlockHash(hashes[index]);
+    header_hashes.push_back(hash);
     headers.push_back(Header {
       .height = locator_height + static_cast<std::uint32_t>(index) + 1U,
-      .hash_hex = hash_hex,
-      .previous_hash_hex = WireHashToHex(
-        std::span<std::uint8_t const>(header.data() + 4U, 32U)),
-      .merkle_root_hex = WireHashToHex(
-        std::span<std::uint8_t const>(header.data() + 36U, 32U)),
+      .hash = hash,
+      .previous_hash = ReadWireHash<BlockHash>(header, 4U),
+      .merkle_root = ReadWireHash<MerkleRoot>(header, 36U),
       .version = version,
       .timestamp = timestamp,
       .bits = bits,
@@ -556,177 +151,45 @@ auto ParseHeadersPayload(std::span<std::uint8_t const> payload,
   return core::Status::Success();
 }
 
-[[nodiscard]] auto ParseBlockPayload(std::span<std::uint8_t const> payload)
-  -> std::optional<BlockBody>
-{
-  if (payload.size() < 80U) {
-    return std::nullopt;
-  }
-  auto const header = std::span<std::uint8_t const>(payload.data(), 80U);
-  auto const hash = DoubleSha256(header);
-  auto reversed = std::array<std::uint8_t, 32> {};
-  std::reverse_copy(hash.begin(), hash.end(), reversed.begin());
-  return BlockBody {
-    .block_hash_hex = ToHex(reversed),
-    .payload = std::vector<std::uint8_t>(payload.begin(), payload.end()),
-  };
-}
-
-[[nodiscard]] auto ParseBlockMetadata(
-  std::span<std::uint8_t const> payload) -> std::optional<BlockMetadata>
+auto CheckHeader(Header const& header, std::optional<Header> const& previous)
+  -> core::Status
 {
-  if (payload.size() < 81U) {
-    return std::nullopt;
+  if (header.hash.IsNull()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument, "header hash is required");
   }
-
-  auto metadata = BlockMetadata {};
-  std::memcpy(&metadata.version, payload.data(), sizeof(metadata.version));
-  std::memcpy(&metadata.timestamp, payload.data() + 68U, sizeof(metadata.timestamp));
-  std::memcpy(&metadata.nonce, payload.data() + 76U, sizeof(metadata.nonce));
-  metadata.previous_hash_hex = WireHashToHex(
-    std::span<std::uint8_t const>(payload.data() + 4U, 32U));
-  metadata.merkle_root_hex = WireHashToHex(
-    std::span<std::uint8_t const>(payload.data() + 36U, 32U));
-
-  auto const hash = DoubleSha256(std::span<std::uint8_t const>(payload.data(), 80U));
-  auto reversed = std::array<std::uint8_t, 32> {};
-  std::reverse_copy(hash.begin(), hash.end(), reversed.begin());
-  metadata.block_hash_hex = ToHex(reversed);
-
-  auto offset = std::size_t { 80U };
-  auto const tx_count = ReadCompactSize(payload, offset);
-  if (!tx_count.has_value()) {
-    return std::nullopt;
+  if (header.height > 0 && header.previous_hash.IsNull()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument, "non-genesis headers require a previous hash");
   }
-  metadata.transaction_count = *tx_count;
-
-  auto read_bytes = [&](std::size_t count) -> bool {
-    if (offset + count > payload.size()) {
-      return false;
-    }
-    offset += count;
-    return true;
-  };
-  auto read_compact = [&]() -> std::optional<std::uint64_t> {
-    return ReadCompactSize(payload, offset);
-  };
-  auto append_range = [&](std::vector<std::uint8_t>& out,
-                        std::size_t begin,
-                        std::size_t end) -> void {
-    out.insert(out.end(), payload.begin() + begin, payload.begin() + end);
-  };
-
-  for (auto index = std::uint64_t { 0 }; index < metadata.transaction_count; ++index) {
-    auto const start = offset;
-    auto version = std::uint32_t { 0 };
-    if (offset + 4U > payload.size()) {
-      return std::nullopt;
-    }
-    std::memcpy(&version, payload.data() + offset, sizeof(version));
-    offset += 4U;
-    auto const version_end = offset;
-
-    auto has_witness = false;
-    if (offset + 2U <= payload.size() && payload[offset] == 0U && payload[offset + 1U] != 0U) {
-      has_witness = true;
-      offset += 2U;
-    }
-
-    auto const vin_count_offset = offset;
-    auto const input_count = read_compact();
-    if (!input_count.has_value()) {
-      return std::nullopt;
-    }
-    auto const vin_start = vin_count_offset;
-    for (auto vin = std::uint64_t { 0 }; vin < *input_count; ++vin) {
-      if (!read_bytes(36U)) {
-        return std::nullopt;
-      }
-      auto const script_size = read_compact();
-      if (!script_size.has_value() || !read_bytes(*script_size)) {
-        return std::nullopt;
-      }
-      if (!read_bytes(4U)) {
-        return std::nullopt;
-      }
+  if (previous.has_value()) {
+    if (header.height != previous->height + 1U) {
+      return core::Status::Failure(core::StatusCode::Rejected,
+        "headers must advance by exactly one height");
     }
-    auto const vin_end = offset;
-
-    auto const vout_count_offset = offset;
-    auto const output_count = read_compact();
-    if (!output_count.has_value()) {
-      return std::nullopt;
+    if (header.previous_hash != previous->hash) {
+      return core::Status::Failure(core::StatusCode::Rejected,
+        "header sequence is not continuous");
     }
-    auto const vout_start = vout_count_offset;
-    auto tx_output_total = std::uint64_t { 0 };
-    for (auto vout = std::uint64_t { 0 }; vout < *output_count; ++vout) {
-      if (offset + 8U > payload.size()) {
-        return std::nullopt;
-      }
-      auto value = std::uint64_t { 0 };
-      std::memcpy(&value, payload.data() + offset, sizeof(value));
-      tx_output_total += value;
-      offset += 8U;
-      auto const script_size = read_compact();
-      if (!script_size.has_value() || !read_bytes(*script_size)) {
-        return std::nullopt;
-      }
+  }
+  if (header.bits != 0U) {
+    auto const target = TargetFromCompact(header.bits, kSignetPowLimitHex);
+    if (!target.has_value()) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "header bits do not derive a valid target");
     }
-    auto const vout_end = offset;
-
-    if (has_witness) {
-      for (auto vin = std::uint64_t { 0 }; vin < *input_count; ++vin) {
-        auto const stack_items = read_compact();
-        if (!stack_items.has_value()) {
-          return std::nullopt;
-        }
-        for (auto item = std::uint64_t { 0 }; item < *stack_items; ++item) {
-          auto const witness_size = read_compact();
-          if (!witness_size.has_value() || !read_bytes(*witness_size)) {
-            return std::nullopt;
-          }
-        }
-      }
+    if (header.hash.CompareAsNumber(*target) > 0) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "header proof of work does not satisfy target");
     }
-
-    if (!read_bytes(4U)) {
-      return std::nullopt;
+    if (previous.has_value() && previous->bits != 0U && previous->height % 2016U != 0U
+      && header.bits != previous->bits) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected,
+        "unexpected signet difficulty transition between adjacent headers");
     }
-    auto const transaction_end = offset;
-    auto const transaction_size = transaction_end - start;
-    metadata.transaction_sizes.push_back(transaction_size);
-    metadata.transaction_versions.push_back(version);
-    metadata.transaction_input_counts.push_back(*input_count);
-    metadata.transaction_output_counts.push_back(*output_count);
-    metadata.transaction_output_values.push_back(tx_output_total);
-    metadata.total_output_value += tx_output_total;
-    metadata.transaction_has_witness.push_back(has_witness);
-
-    auto full_tx = std::vector<std::uint8_t> {};
-    append_range(full_tx, start, transaction_end);
-    auto const wtxid = DoubleSha256(full_tx);
-    auto wtxid_bytes = std::array<std::uint8_t, 32> {};
-    std::reverse_copy(wtxid.begin(), wtxid.end(), wtxid_bytes.begin());
-    metadata.transaction_witness_ids.push_back(ToHex(wtxid_bytes));
-
-    auto txid_payload = std::vector<std::uint8_t> {};
-    append_range(txid_payload, start, version_end);
-    append_range(txid_payload, vin_start, vin_end);
-    append_range(txid_payload, vout_start, vout_end);
-    append_range(txid_payload, transaction_end - 4U, transaction_end);
-    auto const txid = DoubleSha256(txid_payload);
-    auto txid_bytes = std::array<std::uint8_t, 32> {};
-    std::reverse_copy(txid.begin(), txid.end(), txid_bytes.begin());
-    metadata.transaction_ids.push_back(ToHex(txid_bytes));
-  }
-
-  auto const merkle = ComputeMerkleRootHex(metadata.transaction_ids);
-  if (!merkle.has_value()) {
-    return std::nullopt;
   }
-  metadata.merkle_root_matches = (*merkle == metadata.merkle_root_hex);
-
-  return metadata;
+  return core::Status::Success();
 }
 
 [[nodiscard]] auto ImportStatePath(std::filesystem::path const& root)
@@ -735,14 +198,14 @@ auto ParseHeadersPayload(std::span<std::uint8_t const> payload,
   return root / "bitcoin-signet-import.txt";
 }
 
-[[nodiscard]] auto BlockCacheDirectory(std::filesystem::path const& root)
+[[nodiscard]] auto BlockCachePath(std::filesystem::path const& root)
   -> std::filesystem::path
 {
-  return root / "bitcoin-signet-blocks";
+  return root / "bitcoin-signet-blocks" / "blocks.pack";
 }
 
 [[nodiscard]] auto LoadImportState(std::filesystem::path const& root)
-  -> std::optional<std::pair<std::uint32_t, std::string>>
+  -> std::optional<std::pair<std::uint32_t, BlockHash>>
 {
   auto const path = ImportStatePath(root);
   if (!std::filesystem::exists(path)) {
@@ -766,14 +229,93 @@ auto ParseHeadersPayload(std::span<std::uint8_t const> payload,
     return std::nullopt;
   }
 
-  return std::pair<std::uint32_t, std::string> {
+  auto const hash = BlockHash::FromHex(
+    std::string_view(hash_line).substr(hash_prefix.size()));
+  if (!hash.has_value()) {
+    return std::nullopt;
+  }
+  return std::pair<std::uint32_t, BlockHash> {
     static_cast<std::uint32_t>(std::stoul(height_line.substr(height_prefix.size()))),
-    hash_line.substr(hash_prefix.size()),
+    *hash,
   };
 }
 
 } // namespace
 
+auto SignetGenesisHash() -> BlockHash
+{
+  static auto const hash = *BlockHash::FromHex(
+    "00000008819873e925422c1ff0f99f7cc9bbb232af63a077a480a3633bee1ef6");
+  return hash;
+}
+
+auto BuildBlockLocator(std::span<BlockHash const> chain) -> std::vector<BlockHash>
+{
+  auto locator = std::vector<BlockHash> {};
+  if (chain.empty()) {
+    return locator;
+  }
+
+  auto step = std::size_t { 1 };
+  auto index = chain.size() - 1U;
+  while (true) {
+    locator.push_back(chain[index]);
+    if (index == 0U) {
+      break;
+    }
+    if (locator.size() > 10U) {
+      step *= 2U;
+    }
+    index = index > step ? index - step : 0U;
+  }
+  return locator;
+}
+
+auto ParseBlockMetadata(std::span<std::uint8_t const> payload,
+  BlockAnalysisOptions const& options) -> std::optional<BlockMetadata>
+{
+  auto analysis = BlockAnalysis {};
+  if (!AnalyzeBlock(payload, analysis, options)) {
+    return std::nullopt;
+  }
+
+  auto metadata = BlockMetadata {};
+  std::memcpy(&metadata.version, payload.data(), sizeof(metadata.version));
+  std::memcpy(&metadata.timestamp, payload.data() + 68U, sizeof(metadata.timestamp));
+  std::memcpy(&metadata.nonce, payload.data() + 76U, sizeof(metadata.nonce));
+  metadata.previous_hash = ReadWireHash<BlockHash>(payload, 4U);
+  metadata.merkle_root = ReadWireHash<MerkleRoot>(payload, 36U);
+  metadata.block_hash = BlockHash(HeaderHash(payload.first<kBlockHeaderSize>()));
+  metadata.merkle_root_matches
+    = MerkleRoot(analysis.merkle_root) == metadata.merkle_root;
+  metadata.total_output_value = analysis.total_output_value;
+
+  auto const count = analysis.transactions.size();
+  metadata.transaction_count = count;
+  metadata.transaction_sizes.reserve(count);
+  metadata.transaction_versions.reserve(count);
+  metadata.transaction_input_counts.reserve(count);
+  metadata.transaction_output_counts.reserve(count);
+  metadata.transaction_output_values.reserve(count);
+  metadata.transaction_has_witness.reserve(count);
+  metadata.transaction_ids.reserve(count);
+  metadata.transaction_witness_ids.reserve(count);
+  for (auto index = std::size_t { 0 }; index < count; ++index) {
+    auto const& transaction = analysis.transactions[index];
+    metadata.transaction_sizes.push_back(transaction.bytes.size);
+    metadata.transaction_versions.push_back(transaction.version);
+    metadata.transaction_input_counts.push_back(transaction.input_count);
+    metadata.transaction_output_counts.push_back(transaction.output_count);
+    metadata.transaction_output_values.push_back(transaction.output_value);
+    metadata.transaction_has_witness.push_back(transaction.has_witness);
+    metadata.transaction_ids.emplace_back(analysis.txids[index]);
+    metadata.transaction_witness_ids.emplace_back(analysis.wtxids[index]);
+  }
+  metadata.transactions = std::move(analysis.transactions);
+
+  return metadata;
+}
+
 HeaderSyncAdapter::HeaderSyncAdapter(Options options)
   : options_(std::move(options))
 {
@@ -781,170 +323,202 @@ HeaderSyncAdapter::HeaderSyncAdapter(Options options)
 
 SignetLiveClient::SignetLiveClient(SignetLiveOptions options)
   : options_(std::move(options))
+  , session_(std::make_shared<PeerSession>(PeerSessionOptions {
+      .host = options_.host,
+      .port = options_.port,
+    }))
 {
+  auto const resolved = ResolveBlockFetchOptions(options_);
+  if (!resolved.state_root.empty()) {
+    cache_ = std::make_shared<BlockCache>(BlockCachePath(resolved.state_root));
+  }
 }
 
 auto SignetLiveClient::FetchHeaders(SignetHeadersResult& result) -> core::Status
 {
-  auto io_context = asio::io_context {};
-  auto endpoints = ResolveEndpoints(io_context, options_.host, options_.port);
-  if (!endpoints.has_value()) {
-    return core::Status::Failure(
-      core::StatusCode::IOError, "failed to resolve signet host");
+  result = SignetHeadersResult {};
+  auto pending = session_->RequestHeaders(std::span(&options_.locator_hash, 1U));
+  auto reply = session_->Await(pending);
+  result.protocol_version = reply.protocol_version;
+  result.command_trace = std::move(reply.command_trace);
+  if (!reply.status.ok()) {
+    return reply.status;
   }
 
-  auto const getheaders = EncodeGetHeadersPayload(options_.locator_hash_hex);
-  if (!getheaders.has_value()) {
+  if (auto status = ParseHeadersPayload(reply.payloads.front(), options_.locator_height,
+        result.header_hashes, result.headers);
+    !status.ok()) {
+    return status;
+  }
+  if (result.headers.empty()) {
     return core::Status::Failure(
-      core::StatusCode::InvalidArgument, "invalid signet locator hash");
+      core::StatusCode::Rejected, "headers response is empty");
   }
+  result.peer_address = std::move(reply.peer_address);
+  return core::Status::Success();
+}
 
-  for (auto const& endpoint : *endpoints) {
-    auto socket = TcpSocket(io_context);
-    auto error = std::error_code {};
-    socket.connect(endpoint.endpoint(), error);
-    if (error) {
-      continue;
+auto SignetLiveClient::SyncHeaders(SignetHeaderSyncOptions const& sync_options,
+  HeaderBatchSink const& sink, SignetHeaderSyncResult& result) -> core::Status
+{
+  result = SignetHeaderSyncResult {};
+  // Hashes of the validated chain, from the starting locator to the tip.
+  auto chain = std::vector<BlockHash> { options_.locator_hash };
+  auto tip = std::optional<Header> {};
+  auto tip_height = options_.locator_height;
+  auto batch_hashes = std::vector<BlockHash> {};
+  auto batch = std::vector<Header> {};
+
+  // A request outstanding when the connection drops is sent again on the
+  // next one, and so resumes from the validated tip it was built from.
+  auto const reconnects_before = session_->Reconnects();
+  auto pending = session_->RequestHeaders(BuildBlockLocator(chain));
+  while (true) {
+    auto reply = session_->Await(pending);
+    result.peer_address = std::move(reply.peer_address);
+    result.protocol_version = reply.protocol_version;
+    result.command_trace.insert(result.command_trace.end(),
+      reply.command_trace.begin(), reply.command_trace.end());
+    result.reconnects = session_->Reconnects() - reconnects_before;
+    if (!reply.status.ok()) {
+      return reply.status;
+    }
+    if (result.reconnects > sync_options.max_reconnects) {
+      return core::Status::Failure(
+        core::StatusCode::IOError, "failed to complete live signet header sync");
     }
 
-    auto const remote_address = endpoint.endpoint().address().to_string();
-    result = SignetHeadersResult {};
-    if (!CompleteVersionHandshake(socket, remote_address, options_.port,
-          result.protocol_version, result.command_trace)) {
-      continue;
+    batch_hashes.clear();
+    batch.clear();
+    if (auto status
+      = ParseHeadersPayload(reply.payloads.front(), tip_height, batch_hashes, batch);
+      !status.ok()) {
+      return status;
+    }
+    auto const full = batch.size() == kMaxHeadersPerMessage;
+    if (sync_options.max_headers != 0U) {
+      auto const remaining = sync_options.max_headers - result.headers_received;
+      if (batch.size() >= remaining) {
+        batch.resize(remaining);
+        batch_hashes.resize(remaining);
+      }
     }
+    if (batch.empty()) {
+      return core::Status::Success();
+    }
+    auto const more = full
+      && (sync_options.max_headers == 0U
+        || result.headers_received + batch.size() < sync_options.max_headers);
 
-    if (!SendMessage(socket, "getheaders", *getheaders)) {
-      continue;
+    // The next getheaders goes out as soon as a full batch arrives, so the
+    // peer streams the following headers while this batch is validated and
+    // handed to the sink.
+    auto const anchor = chain.back();
+    chain.insert(chain.end(), batch_hashes.begin(), batch_hashes.end());
+    if (more) {
+      pending = session_->RequestHeaders(BuildBlockLocator(chain));
     }
 
-    while (true) {
-      auto message = ReadNextNonPingMessage(socket, result.command_trace);
-      if (!message.has_value()) {
-        break;
+    if (batch.front().previous_hash != anchor) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "headers do not connect to the local tip");
+    }
+    auto previous = tip;
+    for (auto const& header : batch) {
+      if (auto status = CheckHeader(header, previous); !status.ok()) {
+        return status;
       }
-      if (message->command == "headers") {
-        auto status = ParseHeadersPayload(message->payload, options_.locator_height,
-          result.header_hashes, result.headers);
-        if (!status.ok()) {
-          return status;
-        }
-        result.peer_address = remote_address;
-        return core::Status::Success();
+      previous = header;
+    }
+    if (sink) {
+      if (auto status = sink(batch); !status.ok()) {
+        return status;
       }
     }
-  }
 
-  return core::Status::Failure(
-    core::StatusCode::IOError, "failed to complete live signet headers fetch");
+    tip = batch.back();
+    tip_height = tip->height;
+    result.tip = tip;
+    result.headers_received += batch.size();
+    ++result.batches;
+    if (!more) {
+      return core::Status::Success();
+    }
+  }
 }
 
 auto SignetLiveClient::FetchBlocks(
-  std::span<std::string const> block_hashes, SignetBlocksResult& result) -> core::Status
+  std::span<BlockHash const> block_hashes, SignetBlocksResult& result) -> core::Status
 {
   if (block_hashes.empty()) {
     return core::Status::Failure(
       core::StatusCode::InvalidArgument, "at least one block hash is required");
   }
 
-  auto resolved_options = ResolveBlockFetchOptions(options_);
   result = SignetBlocksResult {};
   result.peer_address = "cache";
-  if (!resolved_options.state_root.empty()) {
-    auto const cache_dir = BlockCacheDirectory(resolved_options.state_root);
-    auto cached_all = true;
-    for (auto const& hash : block_hashes) {
-      auto const path = cache_dir / (hash + ".blk");
-      if (!std::filesystem::exists(path)) {
-        cached_all = false;
-        break;
-      }
-
-      auto input = std::ifstream(path, std::ios::binary);
-      if (!input) {
-        cached_all = false;
-        break;
-      }
-      auto payload = std::vector<std::uint8_t>(
-        std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
-      auto block = ParseBlockPayload(payload);
-      auto metadata = ParseBlockMetadata(payload);
-      if (!block.has_value() || !metadata.has_value()) {
-        cached_all = false;
-        break;
-      }
-      result.blocks.push_back(std::move(*block));
-      result.metadata.push_back(std::move(*metadata));
-    }
-    if (cached_all && result.blocks.size() == block_hashes.size()) {
-      result.command_trace.push_back("cache");
-      return core::Status::Success();
+  result.blocks.resize(block_hashes.size());
+  result.metadata.resize(block_hashes.size());
+  // A block is taken from the cache only when its cached copy parses back to
+  // the requested hash; any other block is requested from the peer.
+  auto missing = std::vector<BlockHash> {};
+  auto missing_slots = std::vector<std::size_t> {};
+  auto const cached = cache_ != nullptr ? cache_->Snapshot() : nullptr;
+  for (auto index = std::size_t { 0 }; index < block_hashes.size(); ++index) {
+    auto const& hash = block_hashes[index];
+    auto const payload = cached != nullptr ? cached->Find(hash) : std::nullopt;
+    auto metadata = payload.has_value() ? ParseBlockMetadata(*payload) : std::nullopt;
+    if (!metadata.has_value() || metadata->block_hash != hash) {
+      missing.push_back(hash);
+      missing_slots.push_back(index);
+      continue;
     }
-    result = SignetBlocksResult {};
-  }
-
-  auto const getdata = EncodeGetDataPayload(block_hashes);
-  if (!getdata.has_value()) {
-    return core::Status::Failure(
-      core::StatusCode::InvalidArgument, "invalid block hash for getdata");
+    result.blocks[index] = BlockBody {
+      .block_hash = hash,
+      .payload = { payload->begin(), payload->end() },
+    };
+    result.metadata[index] = std::move(*metadata);
+  }
+  if (missing.size() < block_hashes.size()) {
+    result.command_trace.push_back("cache");
+  }
+  if (missing.empty()) {
+    return core::Status::Success();
+  }
+
+  auto pending = session_->RequestBlocks(missing);
+  auto reply = session_->Await(pending);
+  result.protocol_version = reply.protocol_version;
+  result.command_trace.insert(result.command_trace.end(),
+    std::make_move_iterator(reply.command_trace.begin()),
+    std::make_move_iterator(reply.command_trace.end()));
+  auto fetched = std::vector<BlockBody> {};
+  fetched.reserve(missing.size());
+  for (auto& payload : reply.payloads) {
+    auto metadata = ParseBlockMetadata(payload);
+    if (!metadata.has_value()) {
+      reply.status = core::Status::Failure(
+        core::StatusCode::Rejected, "received malformed block payload");
+      break;
+    }
+    result.metadata[missing_slots[fetched.size()]] = std::move(*metadata);
+    fetched.push_back(BlockBody {
+      .block_hash = missing[fetched.size()],
+      .payload = std::move(payload),
+    });
   }
-
-  auto io_context = asio::io_context {};
-  auto endpoints = ResolveEndpoints(io_context, resolved_options.host, resolved_options.port);
-  if (!endpoints.has_value()) {
-    return core::Status::Failure(
-      core::StatusCode::IOError, "failed to resolve signet host");
+  if (!reply.status.ok()) {
+    result.blocks.clear();
+    result.metadata.clear();
+    return reply.status;
   }
 
-  for (auto const& endpoint : *endpoints) {
-    auto socket = TcpSocket(io_context);
-    auto error = std::error_code {};
-    socket.connect(endpoint.endpoint(), error);
-    if (error) {
-      continue;
-    }
-
-    auto const remote_address = endpoint.endpoint().address().to_string();
-    result = SignetBlocksResult {};
-    if (!CompleteVersionHandshake(socket, remote_address, resolved_options.port,
-          result.protocol_version, result.command_trace)) {
-      continue;
-    }
-
-    if (!SendMessage(socket, "getdata", *getdata)) {
-      continue;
-    }
-
-    while (result.blocks.size() < block_hashes.size()) {
-      auto message = ReadNextNonPingMessage(socket, result.command_trace);
-      if (!message.has_value()) {
-        break;
-      }
-      if (message->command == "block") {
-        auto block = ParseBlockPayload(message->payload);
-        if (!block.has_value()) {
-          return core::Status::Failure(
-            core::StatusCode::Rejected, "received malformed block payload");
-        }
-        auto metadata = ParseBlockMetadata(message->payload);
-        if (!metadata.has_value()) {
-          return core::Status::Failure(
-            core::StatusCode::Rejected, "received block with unreadable metadata");
-        }
-        result.blocks.push_back(std::move(*block));
-        result.metadata.push_back(std::move(*metadata));
-      }
-    }
-
-    if (result.blocks.size() == block_hashes.size()) {
-      result.peer_address = remote_address;
-      PersistFetchedBlocks(resolved_options, result);
-      return core::Status::Success();
-    }
+  PersistFetchedBlocks(fetched);
+  for (auto index = std::size_t { 0 }; index < fetched.size(); ++index) {
+    result.blocks[missing_slots[index]] = std::move(fetched[index]);
   }
-
-  return core::Status::Failure(
-    core::StatusCode::IOError, "failed to complete live signet block retrieval");
+  result.peer_address = std::move(reply.peer_address);
+  return core::Status::Success();
 }
 
 auto SignetLiveClient::ResolveBlockFetchOptions(SignetLiveOptions options) const
@@ -953,29 +527,14 @@ auto SignetLiveClient::ResolveBlockFetchOptions(SignetLiveOptions options) const
   return options;
 }
 
-auto SignetLiveClient::PersistFetchedBlocks(
-  SignetLiveOptions const& options, SignetBlocksResult const& result) const -> void
+auto SignetLiveClient::PersistFetchedBlocks(std::span<BlockBody const> blocks) const
+  -> void
 {
-  if (options.state_root.empty() || result.blocks.empty()) {
+  if (cache_ == nullptr || blocks.empty()) {
     return;
   }
-
-  auto error = std::error_code {};
-  auto const cache_dir = BlockCacheDirectory(options.state_root);
-  std::filesystem::create_directories(cache_dir, error);
-  if (error) {
-    return;
-  }
-
-  for (auto const& block : result.blocks) {
-    auto output = std::ofstream(cache_dir / (block.block_hash_hex + ".blk"),
-      std::ios::binary | std::ios::trunc);
-    if (!output) {
-      return;
-    }
-    output.write(reinterpret_cast<char const*>(block.payload.data()),
-      static_cast<std::streamsize>(block.payload.size()));
-  }
+  // A block that could not be cached is requested again next time.
+  (void)cache_->Append(blocks);
 }
 
 auto HeaderSyncAdapter::Bind(node::Node& node) -> core::Status
@@ -1019,8 +578,8 @@ auto HeaderSyncAdapter::SubmitHeaders(std::span<Header const> headers)
   imported.reserve(headers.size());
   for (auto const& header : headers) {
     auto payload = std::ostringstream {};
-    payload << "height=" << header.height << ";hash=" << header.hash_hex
-            << ";previous=" << header.previous_hash_hex
+    payload << "height=" << header.height << ";hash=" << header.hash.ToHex()
+            << ";previous=" << header.previous_hash.ToHex()
             << ";version=" << header.version;
 
     auto status = node_->SubmitTransaction(core::Transaction::FromText(
@@ -1064,7 +623,7 @@ auto HeaderSyncAdapter::ImportLiveSignetHeaders(
 
   auto status = SubmitHeaders(result.headers);
   if (status.ok()) {
-    PersistImportProgress(resolved_options, result);
+    PersistImportProgress(resolved_options, result.headers.back());
     if (live_result != nullptr) {
       *live_result = std::move(result);
     }
@@ -1072,6 +631,33 @@ auto HeaderSyncAdapter::ImportLiveSignetHeaders(
   return status;
 }
 
+auto HeaderSyncAdapter::SyncLiveSignetHeaders(SignetLiveOptions options,
+  SignetHeaderSyncOptions const& sync_options, SignetHeaderSyncResult* live_result)
+  -> core::Status
+{
+  if (node_ == nullptr) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "adapter must be bound to a node first");
+  }
+
+  auto resolved_options = ResolveImportOptions(std::move(options));
+  auto client = SignetLiveClient(resolved_options);
+  auto result = SignetHeaderSyncResult {};
+  auto const status = client.SyncHeaders(sync_options,
+    [&](std::span<Header const> batch) {
+      auto imported = SubmitHeaders(batch);
+      if (imported.ok()) {
+        PersistImportProgress(resolved_options, batch.back());
+      }
+      return imported;
+    },
+    result);
+  if (live_result != nullptr) {
+    *live_result = std::move(result);
+  }
+  return status;
+}
+
 auto HeaderSyncAdapter::ResolveImportOptions(SignetLiveOptions options) const
   -> SignetLiveOptions
 {
@@ -1091,15 +677,15 @@ auto HeaderSyncAdapter::ResolveImportOptions(SignetLiveOptions options) const
 
   if (auto persisted = LoadImportState(options.state_root)) {
     options.locator_height = persisted->first;
-    options.locator_hash_hex = persisted->second;
+    options.locator_hash = persisted->second;
   }
   return options;
 }
 
 auto HeaderSyncAdapter::PersistImportProgress(
-  SignetLiveOptions const& options, SignetHeadersResult const& result) const -> void
+  SignetLiveOptions const& options, Header const& last) const -> void
 {
-  if (options.state_root.empty() || result.headers.empty()) {
+  if (options.state_root.empty()) {
     return;
   }
 
@@ -1109,60 +695,29 @@ auto HeaderSyncAdapter::PersistImportProgress(
     return;
   }
 
-  auto output = std::ofstream(ImportStatePath(options.state_root), std::ios::trunc);
-  if (!output) {
-    return;
+  // Checkpoints are taken mid-sync, so the file is replaced in one step and
+  // an interrupted write never leaves a torn locator behind.
+  auto const path = ImportStatePath(options.state_root);
+  auto staging = path;
+  staging += ".tmp";
+  {
+    auto output = std::ofstream(staging, std::ios::trunc);
+    if (!output) {
+      return;
+    }
+    output << "height=" << last.height << '\n';
+    output << "hash=" << last.hash.ToHex() << '\n';
+    if (!output.flush()) {
+      return;
+    }
   }
-
-  auto const& last = result.headers.back();
-  output << "height=" << last.height << '\n';
-  output << "hash=" << last.hash_hex << '\n';
+  std::filesystem::rename(staging, path, error);
 }
 
 auto HeaderSyncAdapter::ValidateHeader(
   Header const& header, std::optional<Header> const& previous) const -> core::Status
 {
-  if (header.hash_hex.empty()) {
-    return core::Status::Failure(
-      core::StatusCode::InvalidArgument, "header hash is required");
-  }
-  if (header.height > 0 && header.previous_hash_hex.empty()) {
-    return core::Status::Failure(
-      core::StatusCode::InvalidArgument, "non-genesis headers require a previous hash");
-  }
-  if (previous.has_value()) {
-    if (header.height != previous->height + 1U) {
-      return core::Status::Failure(core::StatusCode::Rejected,
-        "headers must advance by exactly one height");
-    }
-    if (header.previous_hash_hex != previous->hash_hex) {
-      return core::Status::Failure(core::StatusCode::Rejected,
-        "header sequence is not continuous");
-    }
-  }
-  if (header.bits != 0U) {
-    auto const target = TargetFromCompact(header.bits, kSignetPowLimitHex);
-    if (!target.has_value()) {
-      return core::Status::Failure(
-        core::StatusCode::Rejected, "header bits do not derive a valid target");
-    }
-    auto const hash = HashBytesFromHex(header.hash_hex);
-    if (!hash.has_value()) {
-      return core::Status::Failure(
-        core::StatusCode::InvalidArgument, "header hash must be 32 bytes");
-    }
-    if (*hash > *target) {
-      return core::Status::Failure(
-        core::StatusCode::Rejected, "header proof of work does not satisfy target");
-    }
-    if (previous.has_value() && previous->bits != 0U && previous->height % 2016U != 0U
-      && header.bits != previous->bits) {
-      return core::Status::Failure(
-        core::StatusCode::Rejected,
-        "unexpected signet difficulty transition between adjacent headers");
-    }
-  }
-  return core::Status::Success();
+  return CheckHeader(header, previous);
 }
 
 auto HeaderSyncAdapter::HeaderMetadata() const -> std::string
@@ -10,12 +10,17 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <Blocxxi/Bitcoin/block_analysis.h>
+#include <Blocxxi/Bitcoin/block_parser.h>
+#include <Blocxxi/Bitcoin/hashes.h>
 #include <Blocxxi/Core/result.h>
 #include <Blocxxi/Node/node.h>
 
@@ -36,21 +41,22 @@ struct Options {
 
 struct Header {
   std::uint32_t height { 0 };
-  std::string hash_hex {};
-  std::string previous_hash_hex {};
-  std::string merkle_root_hex {};
+  BlockHash hash {};
+  BlockHash previous_hash {};
+  MerkleRoot merkle_root {};
   std::uint32_t version { 0 };
   std::uint32_t timestamp { 0 };
   std::uint32_t bits { 0 };
   std::uint32_t nonce { 0 };
 };
 
+// Hash of the signet genesis block, the default header locator.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto SignetGenesisHash() -> BlockHash;
+
 struct SignetLiveOptions {
   std::string host { "seed.signet.bitcoin.sprovoost.nl" };
   std::uint16_t port { 38333 };
-  std::string locator_hash_hex {
-    "00000008819873e925422c1ff0f99f7cc9bbb232af63a077a480a3633bee1ef6"
-  };
+  BlockHash locator_hash { SignetGenesisHash() };
   std::uint32_t locator_height { 0 };
   std::filesystem::path state_root {};
 };
@@ -59,19 +65,47 @@ struct SignetHeadersResult {
   std::string peer_address {};
   std::int32_t protocol_version { 0 };
   std::vector<std::string> command_trace {};
-  std::vector<std::string> header_hashes {};
+  std::vector<BlockHash> header_hashes {};
   std::vector<Header> headers {};
 };
 
+// Receives each validated batch of a header sync in chain order. A failed
+// status stops the sync.
+using HeaderBatchSink = std::function<core::Status(std::span<Header const>)>;
+
+struct SignetHeaderSyncOptions {
+  // Stop after this many headers; 0 syncs until the peer has no more.
+  std::uint32_t max_headers { 0 };
+  // Connections re-established after a drop, each resuming from the
+  // validated tip.
+  std::uint32_t max_reconnects { 3 };
+};
+
+struct SignetHeaderSyncResult {
+  std::string peer_address {};
+  std::int32_t protocol_version { 0 };
+  std::vector<std::string> command_trace {};
+  std::optional<Header> tip {};
+  std::uint64_t headers_received { 0 };
+  std::uint32_t batches { 0 };
+  std::uint32_t reconnects { 0 };
+};
+
+// Block locator for `chain`, consecutive header hashes ending at the tip: the
+// most recent hashes one by one, then exponentially sparser ones, always
+// ending with chain.front().
+[[nodiscard]] BLOCXXI_BITCOIN_API auto BuildBlockLocator(
+  std::span<BlockHash const> chain) -> std::vector<BlockHash>;
+
 struct BlockBody {
-  std::string block_hash_hex {};
+  BlockHash block_hash {};
   std::vector<std::uint8_t> payload {};
 };
 
 struct BlockMetadata {
-  std::string block_hash_hex {};
-  std::string previous_hash_hex {};
-  std::string merkle_root_hex {};
+  BlockHash block_hash {};
+  BlockHash previous_hash {};
+  MerkleRoot merkle_root {};
   std::uint32_t version { 0 };
   std::uint32_t timestamp { 0 };
   std::uint32_t nonce { 0 };
@@ -84,10 +118,19 @@ struct BlockMetadata {
   std::vector<std::uint64_t> transaction_output_counts {};
   std::vector<std::uint64_t> transaction_output_values {};
   std::vector<bool> transaction_has_witness {};
-  std::vector<std::string> transaction_ids {};
-  std::vector<std::string> transaction_witness_ids {};
+  std::vector<Txid> transaction_ids {};
+  std::vector<Wtxid> transaction_witness_ids {};
+  // Locations of the transactions in the matching BlockBody::payload.
+  std::vector<TransactionView> transactions {};
 };
 
+// Transactions are located in place in one pass, then their ids are hashed
+// and the merkle root computed across workers. The payload is never copied.
+// Returns nothing when the block is malformed.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ParseBlockMetadata(
+  std::span<std::uint8_t const> payload,
+  BlockAnalysisOptions const& options = {}) -> std::optional<BlockMetadata>;
+
 struct SignetBlocksResult {
   std::string peer_address {};
   std::int32_t protocol_version { 0 };
@@ -96,22 +139,37 @@ struct SignetBlocksResult {
   std::vector<BlockMetadata> metadata {};
 };
 
+class BlockCache;
+class PeerSession;
+
+// Requests go over one connection that the client keeps open between calls,
+// reconnecting when it drops. Copies share the connection, and the block
+// cache under state_root.
 class SignetLiveClient {
 public:
   explicit BLOCXXI_BITCOIN_API SignetLiveClient(SignetLiveOptions options = {});
 
   BLOCXXI_BITCOIN_API auto FetchHeaders(SignetHeadersResult& result)
     -> core::Status;
-  BLOCXXI_BITCOIN_API auto FetchBlocks(std::span<std::string const> block_hashes,
+  // Syncs headers from the locator to the peer's tip over one connection,
+  // keeping the next getheaders in flight while a batch is validated.
+  BLOCXXI_BITCOIN_API auto SyncHeaders(SignetHeaderSyncOptions const& sync_options,
+    HeaderBatchSink const& sink, SignetHeaderSyncResult& result) -> core::Status;
+  // Blocks in the cache are served from it; only the others are requested
+  // from the peer, and cached once received.
+  BLOCXXI_BITCOIN_API auto FetchBlocks(std::span<BlockHash const> block_hashes,
     SignetBlocksResult& result) -> core::Status;
 
 private:
   [[nodiscard]] BLOCXXI_BITCOIN_API auto ResolveBlockFetchOptions(
     SignetLiveOptions options) const -> SignetLiveOptions;
   BLOCXXI_BITCOIN_API auto PersistFetchedBlocks(
-    SignetLiveOptions const& options, SignetBlocksResult const& result) const -> void;
+    std::span<BlockBody const> blocks) const -> void;
 
   SignetLiveOptions options_ {};
+  std::shared_ptr<PeerSession> session_ {};
+  // Null without a state_root.
+  std::shared_ptr<BlockCache> cache_ {};
 };
 
 class HeaderSyncAdapter {
@@ -124,6 +182,11 @@ public:
     -> core::Status;
   BLOCXXI_BITCOIN_API auto ImportLiveSignetHeaders(SignetLiveOptions options = {},
     SignetHeadersResult* live_result = nullptr) -> core::Status;
+  // Imports headers until the peer has no more, checkpointing the import
+  // state after every batch so that an interrupted sync resumes from there.
+  BLOCXXI_BITCOIN_API auto SyncLiveSignetHeaders(SignetLiveOptions options = {},
+    SignetHeaderSyncOptions const& sync_options = {},
+    SignetHeaderSyncResult* live_result = nullptr) -> core::Status;
 
   [[nodiscard]] auto OptionsView() const -> Options const& { return options_; }
   [[nodiscard]] auto ImportedHeights() const -> std::vector<std::uint32_t>
@@ -135,7 +198,7 @@ private:
   [[nodiscard]] BLOCXXI_BITCOIN_API auto ResolveImportOptions(
     SignetLiveOptions options) const -> SignetLiveOptions;
   BLOCXXI_BITCOIN_API auto PersistImportProgress(
-    SignetLiveOptions const& options, SignetHeadersResult const& result) const -> void;
+    SignetLiveOptions const& options, Header const& last) const -> void;
 
   [[nodiscard]] BLOCXXI_BITCOIN_API auto ValidateHeader(Header const& header,
     std::optional<Header> const& previous) const -> core::Status;
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/async_wire.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// Completion token that reports failures through `error` instead of
+// throwing from co_await.
+[[nodiscard]] auto Redirect(std::error_code& error)
+{
+  return asio::redirect_error(asio::use_awaitable, error);
+}
+
+} // namespace
+
+AsyncPeerConnection::AsyncPeerConnection(asio::any_io_executor const& executor)
+  : socket_(executor)
+  , deadline_(executor)
+{
+}
+
+auto AsyncPeerConnection::Connect(std::string const& host, std::uint16_t port,
+  std::chrono::milliseconds timeout) -> asio::awaitable<bool>
+{
+  ArmDeadline(timeout);
+  auto error = std::error_code {};
+  auto resolver = asio::ip::tcp::resolver(socket_.get_executor());
+  resolver_ = &resolver;
+  auto const endpoints = co_await resolver.async_resolve(
+    host, std::to_string(static_cast<unsigned int>(port)), Redirect(error));
+  resolver_ = nullptr;
+  if (error) {
+    deadline_.cancel();
+    co_return false;
+  }
+
+  for (auto const& endpoint : endpoints) {
+    if (timed_out_ || cancelled_) {
+      break;
+    }
+    socket_.close(error);
+    buffer_.Clear();
+    co_await socket_.async_connect(endpoint.endpoint(), Redirect(error));
+    if (error) {
+      continue;
+    }
+    socket_.set_option(asio::ip::tcp::no_delay(true), error);
+
+    remote_address_ = endpoint.endpoint().address().to_string();
+    if (co_await CompleteHandshake(port)) {
+      deadline_.cancel();
+      co_return true;
+    }
+  }
+  deadline_.cancel();
+  co_return false;
+}
+
+auto AsyncPeerConnection::Send(std::string_view command,
+  std::span<std::uint8_t const> payload, std::chrono::milliseconds timeout)
+  -> asio::awaitable<bool>
+{
+  ArmDeadline(timeout);
+  auto const sent = co_await WriteMessage(command, payload);
+  deadline_.cancel();
+  co_return sent;
+}
+
+auto AsyncPeerConnection::Receive(std::chrono::milliseconds timeout)
+  -> asio::awaitable<std::optional<MessageView>>
+{
+  ArmDeadline(timeout);
+  while (true) {
+    auto message = co_await ReadMessage();
+    if (!message.has_value() || message->command != "ping") {
+      deadline_.cancel();
+      co_return message;
+    }
+    if (!co_await WriteMessage("pong", message->payload)) {
+      deadline_.cancel();
+      co_return std::nullopt;
+    }
+  }
+}
+
+auto AsyncPeerConnection::Cancel() -> void
+{
+  cancelled_ = true;
+  if (resolver_ != nullptr) {
+    resolver_->cancel();
+  }
+  auto error = std::error_code {};
+  socket_.cancel(error);
+  deadline_.cancel();
+}
+
+auto AsyncPeerConnection::ArmDeadline(std::chrono::milliseconds timeout) -> void
+{
+  timed_out_ = false;
+  deadline_.expires_after(timeout);
+  // The timer may fire as the operation completes; only an expiry that is
+  // still current cancels what is running now. `alive` guards against a
+  // completion that runs after the connection is gone.
+  deadline_.async_wait(
+    [this, alive = std::weak_ptr<bool>(alive_)](std::error_code const& error) {
+      if (error || alive.expired()
+        || deadline_.expiry() > asio::steady_timer::clock_type::now()) {
+        return;
+      }
+      timed_out_ = true;
+      if (resolver_ != nullptr) {
+        resolver_->cancel();
+      }
+      auto ignored = std::error_code {};
+      socket_.cancel(ignored);
+    });
+}
+
+auto AsyncPeerConnection::ReadMessage() -> asio::awaitable<std::optional<MessageView>>
+{
+  while (!cancelled_) {
+    if (auto message = buffer_.Next(); message.has_value() || buffer_.Corrupt()) {
+      co_return message;
+    }
+    auto const space = buffer_.PrepareRead();
+    auto error = std::error_code {};
+    auto const transferred = co_await socket_.async_read_some(
+      asio::buffer(space.data(), space.size()), Redirect(error));
+    if (error) {
+      break;
+    }
+    buffer_.CommitRead(transferred);
+  }
+  co_return std::nullopt;
+}
+
+auto AsyncPeerConnection::WriteMessage(
+  std::string_view command, std::span<std::uint8_t const> payload) -> asio::awaitable<bool>
+{
+  if (cancelled_) {
+    co_return false;
+  }
+  auto error = std::error_code {};
+  auto const message = EncodeMessage(command, payload);
+  co_await asio::async_write(socket_, asio::buffer(message), Redirect(error));
+  co_return !error && !cancelled_;
+}
+
+auto AsyncPeerConnection::CompleteHandshake(std::uint16_t port) -> asio::awaitable<bool>
+{
+  if (!co_await WriteMessage("version", EncodeVersionPayload(remote_address_, port))) {
+    co_return false;
+  }
+
+  auto saw_version = false;
+  auto saw_verack = false;
+  while (!(saw_version && saw_verack)) {
+    auto message = co_await ReadMessage();
+    if (!message.has_value()) {
+      co_return false;
+    }
+
+    if (message->command == "version") {
+      if (message->payload.size() >= sizeof(protocol_version_)) {
+        std::memcpy(
+          &protocol_version_, message->payload.data(), sizeof(protocol_version_));
+      }
+      saw_version = true;
+      if (!co_await WriteMessage("verack", {})) {
+        co_return false;
+      }
+    } else if (message->command == "ping") {
+      if (!co_await WriteMessage("pong", message->payload)) {
+        co_return false;
+      }
+    } else if (message->command == "verack") {
+      saw_verack = true;
+    }
+  }
+  co_return true;
+}
+
+} // namespace blocxxi::bitcoin
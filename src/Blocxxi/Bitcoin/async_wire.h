@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Bitcoin/wire.h>
+
+// The wire protocol as C++20 coroutines, so that many peers share one
+// io_context and thread. Not installed.
+
+namespace blocxxi::bitcoin {
+
+// One peer connection. Every operation takes a timeout, and an operation
+// still running when it passes fails as if the connection dropped. Cancel()
+// fails the running operation at once. A connection that failed an
+// operation is left in an unknown state and should be dropped. Like the
+// socket it wraps, a connection is used from one thread at a time.
+class AsyncPeerConnection {
+public:
+  explicit AsyncPeerConnection(asio::any_io_executor const& executor);
+
+  AsyncPeerConnection(AsyncPeerConnection const&) = delete;
+  auto operator=(AsyncPeerConnection const&) -> AsyncPeerConnection& = delete;
+
+  // Resolves `host` and completes the version handshake with the first
+  // endpoint that accepts, all within `timeout`.
+  auto Connect(std::string const& host, std::uint16_t port,
+    std::chrono::milliseconds timeout) -> asio::awaitable<bool>;
+  auto Send(std::string_view command, std::span<std::uint8_t const> payload,
+    std::chrono::milliseconds timeout) -> asio::awaitable<bool>;
+  // Reads the next message other than ping, answering pings on the way. The
+  // message is framed in the receive buffer and stays valid until the next
+  // Receive().
+  auto Receive(std::chrono::milliseconds timeout)
+    -> asio::awaitable<std::optional<MessageView>>;
+  auto Cancel() -> void;
+
+  [[nodiscard]] auto TimedOut() const -> bool { return timed_out_; }
+  [[nodiscard]] auto ProtocolVersion() const -> std::int32_t { return protocol_version_; }
+  [[nodiscard]] auto RemoteAddress() const -> std::string const& { return remote_address_; }
+
+private:
+  auto ArmDeadline(std::chrono::milliseconds timeout) -> void;
+  auto ReadMessage() -> asio::awaitable<std::optional<MessageView>>;
+  auto WriteMessage(std::string_view command, std::span<std::uint8_t const> payload)
+    -> asio::awaitable<bool>;
+  auto CompleteHandshake(std::uint16_t port) -> asio::awaitable<bool>;
+
+  TcpSocket socket_;
+  ReceiveBuffer buffer_ {};
+  asio::ip::tcp::resolver* resolver_ { nullptr };
+  asio::steady_timer deadline_;
+  std::shared_ptr<bool> alive_ { std::make_shared<bool>(true) };
+  bool timed_out_ { false };
+  bool cancelled_ { false };
+  std::int32_t protocol_version_ { 0 };
+  std::string remote_address_ {};
+};
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,212 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/block_analysis.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <utility>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+struct WorkerTotals {
+  std::uint64_t output_value { 0 };
+  std::uint64_t weight { 0 };
+  std::size_t witness_transactions { 0 };
+  bool output_value_overflowed { false };
+};
+
+// Adds `value` to `total` unless the sum would wrap.
+[[nodiscard]] auto AddOutputValue(std::uint64_t& total, std::uint64_t value) -> bool
+{
+  if (value > std::numeric_limits<std::uint64_t>::max() - total) {
+    return false;
+  }
+  total += value;
+  return true;
+}
+
+[[nodiscard]] auto WorkerCount(BlockAnalysisOptions const& options,
+  std::size_t items) -> std::size_t
+{
+  auto workers = options.worker_count;
+  if (workers == 0U) {
+    workers = std::max(1U, std::thread::hardware_concurrency());
+  }
+  auto const per_worker = std::max<std::size_t>(1U, options.min_transactions_per_worker);
+  return std::clamp<std::size_t>(items / per_worker, 1U, workers);
+}
+
+// Splits [0, count) into `workers` contiguous shares and runs
+// `body(worker, begin, end)` on each, the first share on the calling thread.
+template <typename Body>
+auto ParallelFor(std::size_t count, std::size_t workers, Body const& body) -> void
+{
+  auto const share = (count + workers - 1U) / workers;
+  // The threads join when `threads` goes out of scope.
+  auto threads = std::vector<std::jthread> {};
+  threads.reserve(workers - 1U);
+  for (auto worker = std::size_t { 1 }; worker < workers; ++worker) {
+    auto const begin = worker * share;
+    if (begin >= count) {
+      break;
+    }
+    threads.emplace_back([&body, worker, begin, end = std::min(count, begin + share)] {
+      body(worker, begin, end);
+    });
+  }
+  body(std::size_t { 0 }, std::size_t { 0 }, std::min(count, share));
+}
+
+// Reduces `leaves` to the root of a subtree of height `depth`. A lone node
+// below that height is the last one of an odd layer and so is paired with
+// itself, exactly as it would be inside the whole tree.
+[[nodiscard]] auto SubtreeRoot(std::span<nova::Sha256Digest const> leaves,
+  std::size_t depth) -> nova::Sha256Digest
+{
+  auto layer = std::vector<nova::Sha256Digest> {};
+  layer.reserve(leaves.size() + 1U);
+  layer.assign(leaves.begin(), leaves.end());
+  auto next = std::vector<nova::Sha256Digest> {};
+  auto height = std::size_t { 0 };
+  while (layer.size() > 1U) {
+    if ((layer.size() % 2U) != 0U) {
+      layer.push_back(layer.back());
+    }
+    // Every pair of siblings is one contiguous 64-byte block.
+    next.resize(layer.size() / 2U);
+    nova::ComputeSha256d64Many(std::as_bytes(std::span(layer)), next);
+    std::swap(layer, next);
+    ++height;
+  }
+
+  auto root = layer.front();
+  auto pair = std::array<std::byte, nova::Sha256::kBlockSize> {};
+  for (; height < depth; ++height) {
+    std::memcpy(pair.data(), root.data(), root.size());
+    std::memcpy(pair.data() + root.size(), root.data(), root.size());
+    root = nova::ComputeSha256d64(pair);
+  }
+  return root;
+}
+
+} // namespace
+
+auto TransactionWeight(TransactionView const& transaction) -> std::uint64_t
+{
+  auto const total_size = transaction.bytes.size;
+  // Without witness data the marker and flag bytes go too.
+  auto const base_size = transaction.has_witness
+    ? total_size - transaction.witness.size - 2U
+    : total_size;
+  return (base_size * 3U) + total_size;
+}
+
+auto AnalyzeBlock(std::span<std::uint8_t const> payload, BlockAnalysis& analysis,
+  BlockAnalysisOptions const& options) -> bool
+{
+  // Every block holds at least its coinbase.
+  if (!ParseBlockTransactions(payload, analysis.transactions)
+    || analysis.transactions.empty()) {
+    return false;
+  }
+
+  auto const& transactions = analysis.transactions;
+  auto const count = transactions.size();
+  analysis.txids.resize(count);
+  analysis.wtxids.resize(count);
+
+  auto const workers = WorkerCount(options, count);
+  auto messages = std::vector<std::span<std::byte const>>(count);
+  auto inner = std::vector<nova::Sha256Digest>(count);
+  auto totals = std::vector<WorkerTotals>(workers);
+
+  ParallelFor(count, workers,
+    [&](std::size_t worker, std::size_t begin, std::size_t end) {
+      auto& local = totals[worker];
+      for (auto index = begin; index < end; ++index) {
+        auto const& transaction = transactions[index];
+        messages[index] = std::as_bytes(
+          payload.subspan(transaction.bytes.offset, transaction.bytes.size));
+        local.output_value_overflowed
+          |= !AddOutputValue(local.output_value, transaction.output_value);
+        local.weight += TransactionWeight(transaction);
+        local.witness_transactions += transaction.has_witness ? 1U : 0U;
+      }
+
+      // Both passes of the wtxid run across the SIMD lanes.
+      auto const share = std::span(messages).subspan(begin, end - begin);
+      nova::ComputeSha256Many(share, std::span(inner).subspan(begin, end - begin));
+      for (auto index = begin; index < end; ++index) {
+        messages[index] = std::as_bytes(std::span(inner[index]));
+      }
+      nova::ComputeSha256Many(
+        share, std::span(analysis.wtxids).subspan(begin, end - begin));
+
+      // The txid of a witness transaction covers non-contiguous ranges and is
+      // streamed; otherwise it is the wtxid.
+      for (auto index = begin; index < end; ++index) {
+        analysis.txids[index] = transactions[index].has_witness
+          ? ComputeTxid(payload, transactions[index])
+          : analysis.wtxids[index];
+      }
+    });
+
+  analysis.total_output_value = 0;
+  analysis.total_weight = 0;
+  analysis.witness_transaction_count = 0;
+  for (auto const& local : totals) {
+    if (local.output_value_overflowed
+      || !AddOutputValue(analysis.total_output_value, local.output_value)) {
+      return false;
+    }
+    analysis.total_weight += local.weight;
+    analysis.witness_transaction_count += local.witness_transactions;
+  }
+
+  analysis.merkle_root = ComputeBlockMerkleRoot(analysis.txids, options);
+  return true;
+}
+
+auto ComputeBlockMerkleRoot(std::span<nova::Sha256Digest const> txids,
+  BlockAnalysisOptions const& options) -> nova::Sha256Digest
+{
+  if (txids.empty()) {
+    return nova::Sha256Digest {};
+  }
+
+  // Cut the leaves into aligned power-of-two subtrees, about one per worker;
+  // only the last one can be partial.
+  auto const workers = WorkerCount(options, txids.size());
+  if (workers <= 1U) {
+    return SubtreeRoot(txids, 0U);
+  }
+  auto const subtree_size = std::bit_floor((txids.size() + workers - 1U) / workers);
+  auto const depth = static_cast<std::size_t>(std::countr_zero(subtree_size));
+  auto const subtree_count = (txids.size() + subtree_size - 1U) / subtree_size;
+  if (subtree_count <= 1U) {
+    return SubtreeRoot(txids, 0U);
+  }
+
+  auto roots = std::vector<nova::Sha256Digest>(subtree_count);
+  ParallelFor(subtree_count, std::min(workers, subtree_count),
+    [&](std::size_t /*worker*/, std::size_t begin, std::size_t end) {
+      for (auto index = begin; index < end; ++index) {
+        auto const offset = index * subtree_size;
+        roots[index] = SubtreeRoot(
+          txids.subspan(offset, std::min(subtree_size, txids.size() - offset)),
+          depth);
+      }
+    });
+  return SubtreeRoot(roots, 0U);
+}
+
+} // namespace blocxxi::bitcoin
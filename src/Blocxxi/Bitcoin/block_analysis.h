@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+#include <Blocxxi/Bitcoin/block_parser.h>
+
+namespace blocxxi::bitcoin {
+
+struct BlockAnalysisOptions {
+  // 0 uses one worker per hardware thread.
+  std::size_t worker_count { 0 };
+  // Blocks are split so that no worker gets fewer transactions than this;
+  // smaller blocks are analyzed on the calling thread.
+  std::size_t min_transactions_per_worker { 256 };
+};
+
+struct BlockAnalysis {
+  std::vector<TransactionView> transactions {};
+  std::vector<nova::Sha256Digest> txids {};
+  std::vector<nova::Sha256Digest> wtxids {};
+  nova::Sha256Digest merkle_root {};
+  std::uint64_t total_output_value { 0 };
+  std::uint64_t total_weight { 0 };
+  std::size_t witness_transaction_count { 0 };
+};
+
+// BIP 141 weight: three times the size without witness data plus the full
+// size.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto TransactionWeight(
+  TransactionView const& transaction) -> std::uint64_t;
+
+// Locates the transactions in one serial pass, then hashes their ids,
+// gathers statistics and computes the merkle root across workers. Each worker
+// hashes its share of the transactions through the multi-buffer SHA-256
+// kernels. Buffers in `analysis` are reused. Returns false when the block is
+// malformed, has no transactions or its outputs sum past 2^64.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto AnalyzeBlock(
+  std::span<std::uint8_t const> payload, BlockAnalysis& analysis,
+  BlockAnalysisOptions const& options = {}) -> bool;
+
+// Bitcoin merkle root, in which the last node of an odd layer is paired with
+// itself. Aligned subtrees are reduced on separate workers when there are
+// enough leaves. The root of an empty list is all zero.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ComputeBlockMerkleRoot(
+  std::span<nova::Sha256Digest const> txids,
+  BlockAnalysisOptions const& options = {}) -> nova::Sha256Digest;
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/block_cache.h>
+
+#include <array>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include <Blocxxi/Bitcoin/mapped_file.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// Each record is the block hash in wire order, the payload size as 4
+// little-endian bytes, then the payload. A record under the all-zero hash,
+// which no block has, is padding over the remains of a torn record.
+constexpr auto kRecordHeaderSize = BlockHash::kSize + sizeof(std::uint32_t);
+
+} // namespace
+
+auto BlockCacheView::Find(BlockHash const& hash) const
+  -> std::optional<std::span<std::uint8_t const>>
+{
+  auto const found = index_.find(hash);
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+BlockCache::BlockCache(std::filesystem::path path)
+  : path_(std::move(path))
+{
+}
+
+auto BlockCache::Snapshot() -> std::shared_ptr<BlockCacheView const>
+{
+  auto lock = std::unique_lock(mutex_);
+  return SnapshotLocked();
+}
+
+auto BlockCache::Append(std::span<BlockBody const> blocks) -> bool
+{
+  auto lock = std::unique_lock(mutex_);
+  auto const known_end = SnapshotLocked()->end_;
+  // The next snapshot maps the file again, whatever this append leaves.
+  view_.reset();
+
+  auto error = std::error_code {};
+  std::filesystem::create_directories(path_.parent_path(), error);
+  auto file = LockedFile(path_);
+  auto const size = file.Size();
+  if (!file.IsOpen() || !size.has_value()) {
+    return false;
+  }
+
+  // Other caches on the file, in this process or another, may have
+  // appended since the view was taken. Their records are walked past up to
+  // any record cut short by a crash.
+  auto end = known_end <= *size ? std::uint64_t { known_end } : std::uint64_t { 0 };
+  auto header = std::array<std::uint8_t, kRecordHeaderSize> {};
+  while (*size - end >= kRecordHeaderSize) {
+    if (!file.ReadAt(end, header)) {
+      return false;
+    }
+    auto payload_size = std::uint32_t { 0 };
+    std::memcpy(&payload_size, header.data() + BlockHash::kSize, sizeof(payload_size));
+    if (*size - end - kRecordHeaderSize < payload_size) {
+      break;
+    }
+    end += kRecordHeaderSize + payload_size;
+  }
+  // The torn record is written over rather than cut off: the file cannot
+  // shrink on Windows while any view of it is mapped, and readers may hold
+  // views for as long as they like.
+  for (auto const& block : blocks) {
+    auto const payload_size = static_cast<std::uint32_t>(block.payload.size());
+    std::memcpy(header.data(), block.block_hash.Data().data(), BlockHash::kSize);
+    std::memcpy(header.data() + BlockHash::kSize, &payload_size, sizeof(payload_size));
+    if (!file.WriteAt(end, header) || !file.WriteAt(end + header.size(), block.payload)) {
+      return false;
+    }
+    end += header.size() + block.payload.size();
+  }
+  // What is left of it is covered by padding. Fewer bytes than a record
+  // header are walked past as a torn record and written over next time.
+  if (*size > end && *size - end >= kRecordHeaderSize) {
+    auto const padding_size = static_cast<std::uint32_t>(*size - end - kRecordHeaderSize);
+    header.fill(0U);
+    std::memcpy(header.data() + BlockHash::kSize, &padding_size, sizeof(padding_size));
+    if (!file.WriteAt(end, header)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto BlockCache::SnapshotLocked() -> std::shared_ptr<BlockCacheView const>
+{
+  if (view_ != nullptr) {
+    return view_;
+  }
+
+  auto view = std::make_shared<BlockCacheView>();
+  auto mapped = MapFile(path_);
+  view->mapping_ = std::move(mapped.mapping);
+  view->bytes_ = mapped.bytes;
+
+  // Only the record headers are read; payloads stay untouched until served.
+  auto const bytes = view->bytes_;
+  auto offset = std::size_t { 0 };
+  while (bytes.size() - offset >= kRecordHeaderSize) {
+    auto size = std::uint32_t { 0 };
+    std::memcpy(&size, bytes.data() + offset + BlockHash::kSize, sizeof(size));
+    if (bytes.size() - offset - kRecordHeaderSize < size) {
+      break;
+    }
+    auto const hash = *BlockHash::FromBytes(bytes.subspan(offset, BlockHash::kSize));
+    if (!hash.IsNull()) {
+      view->index_.insert_or_assign(hash, bytes.subspan(offset + kRecordHeaderSize, size));
+    }
+    offset += kRecordHeaderSize + size;
+  }
+  view->end_ = offset;
+  view_ = std::move(view);
+  return view_;
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+#include <Blocxxi/Bitcoin/adapter.h>
+#include <Blocxxi/Bitcoin/api_export.h>
+#include <Blocxxi/Bitcoin/hashes.h>
+
+// The blocks fetched by the live signet client, packed into one append-only
+// file. Not installed; exported for the tests only.
+
+namespace blocxxi::bitcoin {
+
+// The pack file as it was when the view was taken, mapped read-only, with
+// the location of every block in it. Blocks appended later are not in the
+// view; the mapping stays valid for as long as the view is held.
+class BLOCXXI_BITCOIN_API BlockCacheView {
+public:
+  // The payload is served from the mapping, not copied. When a block was
+  // appended more than once the last copy is found.
+  [[nodiscard]] auto Find(BlockHash const& hash) const
+    -> std::optional<std::span<std::uint8_t const>>;
+  [[nodiscard]] auto Size() const -> std::size_t { return index_.size(); }
+
+private:
+  friend class BlockCache;
+
+  std::shared_ptr<void const> mapping_ {};
+  std::span<std::uint8_t const> bytes_ {};
+  std::unordered_map<BlockHash, std::span<std::uint8_t const>> index_ {};
+  // Where the last complete record ends.
+  std::size_t end_ { 0 };
+};
+
+// Shared by the threads of one client; other caches, in this process or
+// another, may append to the same file. The file is mapped again only after
+// blocks were appended.
+class BLOCXXI_BITCOIN_API BlockCache {
+public:
+  explicit BlockCache(std::filesystem::path path);
+
+  [[nodiscard]] auto Snapshot() -> std::shared_ptr<BlockCacheView const>;
+  // Appends after the last complete record in the file, whoever wrote it,
+  // under a file lock. A record cut short by a crash is written over.
+  auto Append(std::span<BlockBody const> blocks) -> bool;
+
+private:
+  [[nodiscard]] auto SnapshotLocked() -> std::shared_ptr<BlockCacheView const>;
+
+  std::filesystem::path path_;
+  std::mutex mutex_ {};
+  std::shared_ptr<BlockCacheView const> view_ {};
+};
+
+} // namespace blocxxi::bitcoin
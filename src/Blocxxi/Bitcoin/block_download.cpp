@@ -0,0 +1,349 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/block_download.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Bitcoin/async_wire.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+enum class SlotState : std::uint8_t {
+  Pending,
+  InFlight,
+  Received,
+};
+
+struct Slot {
+  SlotState state { SlotState::Pending };
+  std::size_t peer { 0 };
+  std::uint32_t attempts { 0 };
+  std::optional<DownloadedBlock> block {};
+};
+
+struct PeerState {
+  explicit PeerState(asio::any_io_executor const& executor)
+    : connection(executor)
+  {
+  }
+
+  AsyncPeerConnection connection;
+  bool active { true };
+  std::size_t in_flight { 0 };
+  // When the peer counts as stalled if it still has requests outstanding.
+  // Only a block it delivers, or a request made while it had none
+  // outstanding, moves this on; other messages do not.
+  std::chrono::steady_clock::time_point deadline {};
+};
+
+// The state of one Download() call. Every peer is a coroutine on one
+// io_context, run by the thread that called Download(), so nothing here
+// needs a lock.
+class DownloadRun {
+public:
+  DownloadRun(BlockDownloadOptions const& options, std::uint32_t first_height,
+    std::span<BlockHash const> hashes, BlockSink const& sink, BlockDownloadStats& stats)
+    : options_(options)
+    , first_height_(first_height)
+    , hashes_(hashes)
+    , sink_(sink)
+    , slots_(hashes.size())
+    , stats_(stats)
+  {
+    index_.reserve(hashes.size());
+    for (auto index = std::size_t { 0 }; index < hashes.size(); ++index) {
+      index_.emplace(hashes[index], index);
+    }
+    peers_.reserve(options.peers.size());
+    for (auto peer = std::size_t { 0 }; peer < options.peers.size(); ++peer) {
+      peers_.push_back(std::make_unique<PeerState>(io_context_.get_executor()));
+    }
+  }
+
+  auto Run() -> core::Status
+  {
+    for (auto peer = std::size_t { 0 }; peer < peers_.size(); ++peer) {
+      asio::co_spawn(io_context_, ServePeer(peer), asio::detached);
+    }
+    io_context_.run();
+
+    if (failure_.has_value()) {
+      return *failure_;
+    }
+    return core::Status::Success();
+  }
+
+  // Safe to call from any thread while Run() is in progress.
+  auto Cancel() -> void
+  {
+    asio::post(io_context_, [this] {
+      Finish(core::Status::Failure(core::StatusCode::IOError, "block download cancelled"));
+    });
+  }
+
+private:
+  auto ServePeer(std::size_t peer) -> asio::awaitable<void>
+  {
+    auto& state = *peers_[peer];
+    auto const& endpoint = options_.peers[peer];
+    if (!co_await state.connection.Connect(
+          endpoint.host, endpoint.port, options_.connect_timeout)) {
+      DropPeer(peer);
+      co_return;
+    }
+
+    while (!finished_ && state.active) {
+      if (state.in_flight == 0U && !FirstPending().has_value()) {
+        // Woken when the window moves or another peer gives blocks back.
+        auto error = std::error_code {};
+        co_await wake_.async_wait(asio::redirect_error(asio::use_awaitable, error));
+        continue;
+      }
+
+      auto const request = NextRequest(peer);
+      if (!request.empty()
+        && !co_await state.connection.Send(
+          "getdata", EncodeGetDataPayload(request), options_.stall_timeout)) {
+        break;
+      }
+
+      auto const remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        state.deadline - std::chrono::steady_clock::now());
+      if (remaining <= std::chrono::milliseconds::zero()) {
+        if (state.in_flight == 0U) {
+          // Its blocks came from other peers meanwhile.
+          continue;
+        }
+        ++stats_.stalled_peers;
+        break;
+      }
+      auto message = co_await state.connection.Receive(remaining);
+      if (!message.has_value()) {
+        if (state.connection.TimedOut() && state.active) {
+          ++stats_.stalled_peers;
+        }
+        break;
+      }
+      if (message->command != "block") {
+        continue;
+      }
+      auto metadata = ParseBlockMetadata(message->payload);
+      if (!metadata.has_value()) {
+        break;
+      }
+      Receive(peer, message->payload, std::move(*metadata));
+      Deliver();
+    }
+    DropPeer(peer);
+  }
+
+  // Returns the blocks to request from the peer next, up to its in-flight
+  // limit.
+  auto NextRequest(std::size_t peer) -> std::vector<BlockHash>
+  {
+    auto& state = *peers_[peer];
+    if (state.in_flight == 0U) {
+      state.deadline = std::chrono::steady_clock::now() + options_.stall_timeout;
+    }
+    auto request = std::vector<BlockHash> {};
+    auto const end = std::min(slots_.size(), next_ + options_.window_size);
+    for (auto index = next_;
+         index < end && state.in_flight < options_.max_in_flight_per_peer; ++index) {
+      auto& slot = slots_[index];
+      if (slot.state != SlotState::Pending) {
+        continue;
+      }
+      slot.state = SlotState::InFlight;
+      slot.peer = peer;
+      if (++slot.attempts > 1U) {
+        ++stats_.re_requests;
+      }
+      ++state.in_flight;
+      request.push_back(hashes_[index]);
+    }
+    return request;
+  }
+
+  // `payload` is framed in the peer's receive buffer; only a block that is
+  // still wanted is copied out of it.
+  auto Receive(std::size_t peer, std::span<std::uint8_t const> payload,
+    BlockMetadata metadata) -> void
+  {
+    auto const found = index_.find(metadata.block_hash);
+    if (found == index_.end()) {
+      return;
+    }
+    auto& slot = slots_[found->second];
+    if (slot.state == SlotState::Received || found->second < next_) {
+      return;
+    }
+    if (slot.state == SlotState::InFlight) {
+      --peers_[slot.peer]->in_flight;
+    }
+
+    stats_.bytes_received += payload.size();
+    ++stats_.blocks_per_peer[peer];
+    peers_[peer]->deadline = std::chrono::steady_clock::now() + options_.stall_timeout;
+    slot.state = SlotState::Received;
+    slot.block = DownloadedBlock {
+      .height = first_height_ + static_cast<std::uint32_t>(found->second),
+      .body = BlockBody {
+        .block_hash = metadata.block_hash,
+        .payload = { payload.begin(), payload.end() },
+      },
+      .metadata = std::move(metadata),
+    };
+  }
+
+  // Hands the blocks that are next in height order to the sink.
+  auto Deliver() -> void
+  {
+    auto const before = next_;
+    while (!finished_ && next_ < slots_.size()
+      && slots_[next_].state == SlotState::Received) {
+      auto block = std::move(*slots_[next_].block);
+      slots_[next_].block.reset();
+      ++next_;
+      if (auto status = sink_(std::move(block)); !status.ok()) {
+        Finish(std::move(status));
+        return;
+      }
+      ++stats_.blocks_delivered;
+    }
+    if (next_ == slots_.size()) {
+      Finish(std::nullopt);
+    } else if (next_ != before) {
+      // The window moved, which may free requests for idle peers.
+      wake_.cancel();
+    }
+  }
+
+  // Returns the requests of the peer to the window and stops its coroutine.
+  auto DropPeer(std::size_t peer) -> void
+  {
+    auto& state = *peers_[peer];
+    if (!state.active) {
+      return;
+    }
+    state.active = false;
+    state.connection.Cancel();
+    for (auto index = next_; index < slots_.size() && state.in_flight > 0U; ++index) {
+      auto& slot = slots_[index];
+      if (slot.state != SlotState::InFlight || slot.peer != peer) {
+        continue;
+      }
+      slot.state = SlotState::Pending;
+      --state.in_flight;
+      if (slot.attempts >= options_.max_attempts_per_block) {
+        Finish(core::Status::Failure(core::StatusCode::IOError,
+          "block " + hashes_[index].ToHex() + " could not be downloaded"));
+        return;
+      }
+    }
+    if (std::ranges::none_of(peers_, [](auto const& other) { return other->active; })) {
+      Finish(core::Status::Failure(
+        core::StatusCode::IOError, "all block download peers disconnected"));
+      return;
+    }
+    wake_.cancel();
+  }
+
+  // Ends the download, with `failure` unless it is empty. The first call
+  // decides the outcome.
+  auto Finish(std::optional<core::Status> failure) -> void
+  {
+    if (finished_) {
+      return;
+    }
+    finished_ = true;
+    failure_ = std::move(failure);
+    for (auto& peer : peers_) {
+      peer->connection.Cancel();
+    }
+    wake_.cancel();
+  }
+
+  [[nodiscard]] auto FirstPending() const -> std::optional<std::size_t>
+  {
+    auto const end = std::min(slots_.size(), next_ + options_.window_size);
+    for (auto index = next_; index < end; ++index) {
+      if (slots_[index].state == SlotState::Pending) {
+        return index;
+      }
+    }
+    return std::nullopt;
+  }
+
+  BlockDownloadOptions const& options_;
+  std::uint32_t first_height_;
+  std::span<BlockHash const> hashes_;
+  BlockSink const& sink_;
+  std::unordered_map<BlockHash, std::size_t> index_ {};
+
+  asio::io_context io_context_ {};
+  // Never expires; cancelling it wakes the idle peers.
+  asio::steady_timer wake_ { io_context_, asio::steady_timer::time_point::max() };
+  std::vector<Slot> slots_;
+  std::vector<std::unique_ptr<PeerState>> peers_ {};
+  std::size_t next_ { 0 };
+  bool finished_ { false };
+  std::optional<core::Status> failure_ {};
+  BlockDownloadStats& stats_;
+};
+
+} // namespace
+
+BlockDownloadManager::BlockDownloadManager(BlockDownloadOptions options)
+  : options_(std::move(options))
+{
+  options_.max_in_flight_per_peer = std::max<std::size_t>(1U, options_.max_in_flight_per_peer);
+  options_.window_size = std::max<std::size_t>(1U, options_.window_size);
+  options_.max_attempts_per_block = std::max(1U, options_.max_attempts_per_block);
+}
+
+auto BlockDownloadManager::Download(std::uint32_t first_height,
+  std::span<BlockHash const> hashes, BlockSink const& sink) -> core::Status
+{
+  stats_ = BlockDownloadStats {};
+  stats_.blocks_per_peer.assign(options_.peers.size(), 0U);
+  if (options_.peers.empty()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument, "at least one peer is required");
+  }
+  if (hashes.empty()) {
+    return core::Status::Success();
+  }
+
+  auto run = DownloadRun(options_, first_height, hashes, sink, stats_);
+  auto lock = std::unique_lock(mutex_);
+  cancel_ = [&run] { run.Cancel(); };
+  lock.unlock();
+  auto status = run.Run();
+  lock.lock();
+  cancel_ = nullptr;
+  return status;
+}
+
+auto BlockDownloadManager::Cancel() -> void
+{
+  auto lock = std::unique_lock(mutex_);
+  if (cancel_) {
+    cancel_();
+  }
+}
+
+} // namespace blocxxi::bitcoin
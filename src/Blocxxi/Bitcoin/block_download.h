@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/adapter.h>
+#include <Blocxxi/Bitcoin/hashes.h>
+#include <Blocxxi/Core/result.h>
+
+namespace blocxxi::bitcoin {
+
+struct PeerEndpoint {
+  std::string host {};
+  std::uint16_t port { 38333 };
+};
+
+struct BlockDownloadOptions {
+  std::vector<PeerEndpoint> peers {};
+  // Time allowed to resolve a peer and complete the handshake.
+  std::chrono::milliseconds connect_timeout { 10000 };
+  // Blocks requested from one peer and not received yet.
+  std::size_t max_in_flight_per_peer { 16 };
+  // How far past the next block to deliver requests may run. This bounds the
+  // blocks held back for reordering.
+  std::size_t window_size { 1024 };
+  // A peer with requests outstanding that delivers no block for this long is
+  // disconnected, whatever else it sends, and its blocks are requested from
+  // the others.
+  std::chrono::milliseconds stall_timeout { 10000 };
+  // Requests of one block before the download gives up.
+  std::uint32_t max_attempts_per_block { 4 };
+};
+
+struct DownloadedBlock {
+  std::uint32_t height { 0 };
+  BlockBody body {};
+  BlockMetadata metadata {};
+};
+
+// Receives the blocks of a download in height order, on the thread that
+// called Download(). A failed status stops the download. The peers wait
+// while the sink runs.
+using BlockSink = std::function<core::Status(DownloadedBlock&&)>;
+
+struct BlockDownloadStats {
+  std::uint64_t blocks_delivered { 0 };
+  std::uint64_t bytes_received { 0 };
+  // Requests for blocks that had been requested before.
+  std::uint64_t re_requests { 0 };
+  std::uint32_t stalled_peers { 0 };
+  // Blocks received from each peer, in BlockDownloadOptions::peers order.
+  std::vector<std::uint64_t> blocks_per_peer {};
+};
+
+// Downloads a run of blocks from several peers at once. Every peer is a
+// coroutine on one io_context, run on the calling thread. Each peer is kept
+// busy with up to max_in_flight_per_peer requests drawn from a window that
+// starts at the next block to deliver. Blocks of a peer that stalls or
+// disconnects go back to the window for the others.
+class BlockDownloadManager {
+public:
+  explicit BLOCXXI_BITCOIN_API BlockDownloadManager(BlockDownloadOptions options);
+
+  // `hashes[i]` is the block at height `first_height + i`.
+  BLOCXXI_BITCOIN_API auto Download(std::uint32_t first_height,
+    std::span<BlockHash const> hashes, BlockSink const& sink) -> core::Status;
+  // Stops a Download() running on another thread, which then fails.
+  BLOCXXI_BITCOIN_API auto Cancel() -> void;
+
+  [[nodiscard]] auto Stats() const -> BlockDownloadStats const& { return stats_; }
+
+private:
+  BlockDownloadOptions options_ {};
+  BlockDownloadStats stats_ {};
+  std::mutex mutex_ {};
+  // Set while Download() runs.
+  std::function<void()> cancel_ {};
+};
+
+} // namespace blocxxi::bitcoin
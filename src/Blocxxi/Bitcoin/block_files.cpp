@@ -0,0 +1,251 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/block_files.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/mapped_file.h>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+using Magic = std::array<std::uint8_t, 4>;
+// Bytes at file offset `p` are stored XORed with key[p % 8].
+using ObfuscationKey = std::array<std::uint8_t, 8>;
+
+// Magic and payload length in front of every block.
+constexpr auto kFrameHeaderSize = std::size_t { 8 };
+
+[[nodiscard]] auto NetworkMagic(Network network) -> Magic
+{
+  switch (network) {
+  case Network::Mainnet:
+    return { 0xF9U, 0xBEU, 0xB4U, 0xD9U };
+  case Network::Testnet:
+    return { 0x0BU, 0x11U, 0x09U, 0x07U };
+  case Network::Signet:
+    return { 0x0AU, 0x03U, 0xCFU, 0x40U };
+  case Network::Regtest:
+    return { 0xFAU, 0xBFU, 0xB5U, 0xDAU };
+  }
+  return {};
+}
+
+[[nodiscard]] auto BlockFilePath(
+  std::filesystem::path const& blocks_directory, std::uint32_t number)
+  -> std::filesystem::path
+{
+  auto digits = std::to_string(number);
+  if (digits.size() < 5U) {
+    digits.insert(0U, 5U - digits.size(), '0');
+  }
+  return blocks_directory / ("blk" + digits + ".dat");
+}
+
+// Nodes that predate xor.dat, or run with obfuscation off, leave the files
+// as they are, which an all-zero key means too.
+[[nodiscard]] auto LoadObfuscationKey(std::filesystem::path const& blocks_directory,
+  ObfuscationKey& key) -> core::Status
+{
+  key = {};
+  auto const path = blocks_directory / "xor.dat";
+  auto error = std::error_code {};
+  if (!std::filesystem::exists(path, error)) {
+    return core::Status::Success();
+  }
+  auto input = std::ifstream(path, std::ios::binary);
+  if (!input || std::filesystem::file_size(path, error) != key.size()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument, "xor.dat must hold an 8-byte key");
+  }
+  input.read(
+    reinterpret_cast<char*>(key.data()), static_cast<std::streamsize>(key.size()));
+  return core::Status::Success();
+}
+
+// Copies `bytes`, found at `file_offset`, to `out` without the obfuscation.
+// The key is rotated to the offset once so that the bulk is XORed a word at
+// a time.
+auto Deobfuscate(std::span<std::uint8_t const> bytes, std::size_t file_offset,
+  ObfuscationKey const& key, std::vector<std::uint8_t>& out) -> void
+{
+  out.resize(bytes.size());
+  auto rotated = ObfuscationKey {};
+  for (auto index = std::size_t { 0 }; index < rotated.size(); ++index) {
+    rotated[index] = key[(file_offset + index) % key.size()];
+  }
+  auto word = std::uint64_t { 0 };
+  std::memcpy(&word, rotated.data(), sizeof(word));
+
+  auto index = std::size_t { 0 };
+  for (; index + sizeof(word) <= bytes.size(); index += sizeof(word)) {
+    auto chunk = std::uint64_t { 0 };
+    std::memcpy(&chunk, bytes.data() + index, sizeof(chunk));
+    chunk ^= word;
+    std::memcpy(out.data() + index, &chunk, sizeof(chunk));
+  }
+  for (; index < bytes.size(); ++index) {
+    out[index] = bytes[index] ^ rotated[index % rotated.size()];
+  }
+}
+
+struct Frame {
+  // Of the payload, past the frame header.
+  std::size_t offset { 0 };
+  std::size_t size { 0 };
+};
+
+// Walks the framing of one file. Bytes that do not start a complete block
+// are skipped one at a time until the magic is found again, the way the
+// node reindexes its own files.
+[[nodiscard]] auto FindFrames(std::span<std::uint8_t const> bytes, Magic const& magic,
+  ObfuscationKey const& key, std::uint64_t& skipped_bytes) -> std::vector<Frame>
+{
+  auto const at = [&](std::size_t offset) -> std::uint8_t {
+    return bytes[offset] ^ key[offset % key.size()];
+  };
+
+  auto frames = std::vector<Frame> {};
+  auto offset = std::size_t { 0 };
+  while (bytes.size() - offset >= kFrameHeaderSize) {
+    auto const matches = at(offset) == magic[0] && at(offset + 1U) == magic[1]
+      && at(offset + 2U) == magic[2] && at(offset + 3U) == magic[3];
+    auto size = std::size_t { 0 };
+    for (auto index = std::size_t { 0 }; matches && index < 4U; ++index) {
+      size |= static_cast<std::size_t>(at(offset + 4U + index)) << (index * 8U);
+    }
+    auto const payload = offset + kFrameHeaderSize;
+    if (!matches || size < kBlockHeaderSize || size > bytes.size() - payload) {
+      ++skipped_bytes;
+      ++offset;
+      continue;
+    }
+    frames.push_back(Frame { .offset = payload, .size = size });
+    offset = payload + size;
+  }
+  skipped_bytes += bytes.size() - offset;
+  return frames;
+}
+
+} // namespace
+
+BlockFileIngestion::BlockFileIngestion(BlockFileOptions options)
+  : options_(std::move(options))
+{
+}
+
+auto BlockFileIngestion::Run(FileBlockSink const& sink) -> core::Status
+{
+  stats_ = BlockFileStats {};
+  if (options_.data_directory.empty()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument, "a data directory is required");
+  }
+
+  auto const blocks_directory = options_.data_directory / "blocks";
+  auto key = ObfuscationKey {};
+  if (auto status = LoadObfuscationKey(blocks_directory, key); !status.ok()) {
+    return status;
+  }
+  auto const obfuscated
+    = std::ranges::any_of(key, [](std::uint8_t byte) { return byte != 0U; });
+  auto const magic = NetworkMagic(options_.network);
+
+  auto workers = options_.worker_count;
+  if (workers == 0U) {
+    workers = std::max(1U, std::thread::hardware_concurrency());
+  }
+  auto const batch_size = std::max<std::size_t>(1U, options_.blocks_in_flight);
+  // Blocks are parsed one per worker at a time, so each parse stays on its
+  // worker's thread.
+  auto const analysis_options = BlockAnalysisOptions { .worker_count = 1 };
+
+  auto parsed = std::vector<std::optional<BlockMetadata>>(batch_size);
+  auto buffers = std::vector<std::vector<std::uint8_t>>(obfuscated ? batch_size : 0U);
+
+  for (auto number = options_.first_file;
+       options_.max_files == 0U || number - options_.first_file < options_.max_files;
+       ++number) {
+    auto const path = BlockFilePath(blocks_directory, number);
+    auto error = std::error_code {};
+    if (!std::filesystem::exists(path, error)) {
+      break;
+    }
+    auto const file = MapFile(path, MapAccess::Sequential);
+    ++stats_.files_read;
+    stats_.bytes_read += file.bytes.size();
+    auto const frames = FindFrames(file.bytes, magic, key, stats_.skipped_bytes);
+
+    for (auto begin = std::size_t { 0 }; begin < frames.size(); begin += batch_size) {
+      auto const batch = std::span(frames).subspan(
+        begin, std::min(batch_size, frames.size() - begin));
+      auto const payload_of = [&](std::size_t index) -> std::span<std::uint8_t const> {
+        if (obfuscated) {
+          return buffers[index];
+        }
+        return file.bytes.subspan(batch[index].offset, batch[index].size);
+      };
+
+      // Workers take the next block as they finish one, which keeps them
+      // busy when block sizes vary.
+      auto next = std::atomic<std::size_t> { 0 };
+      auto const parse = [&] {
+        for (auto index = next++; index < batch.size(); index = next++) {
+          if (obfuscated) {
+            Deobfuscate(file.bytes.subspan(batch[index].offset, batch[index].size),
+              batch[index].offset, key, buffers[index]);
+          }
+          parsed[index] = ParseBlockMetadata(payload_of(index), analysis_options);
+        }
+      };
+      {
+        // The threads join when `threads` goes out of scope.
+        auto threads = std::vector<std::jthread> {};
+        auto const count = std::min(workers, batch.size());
+        threads.reserve(count - 1U);
+        for (auto worker = std::size_t { 1 }; worker < count; ++worker) {
+          threads.emplace_back(parse);
+        }
+        parse();
+      }
+
+      for (auto index = std::size_t { 0 }; index < batch.size(); ++index) {
+        if (!parsed[index].has_value()) {
+          ++stats_.malformed_blocks;
+          continue;
+        }
+        auto status = sink(FileBlock {
+          .file_number = number,
+          .file_offset = batch[index].offset,
+          .payload = payload_of(index),
+          .metadata = std::move(*parsed[index]),
+        });
+        if (!status.ok()) {
+          return status;
+        }
+        ++stats_.blocks_delivered;
+      }
+    }
+  }
+
+  if (stats_.files_read == 0U) {
+    return core::Status::Failure(core::StatusCode::NotFound,
+      "no block files in " + blocks_directory.string());
+  }
+  return core::Status::Success();
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+
+#include <Blocxxi/Bitcoin/adapter.h>
+#include <Blocxxi/Core/result.h>
+
+namespace blocxxi::bitcoin {
+
+struct BlockFileOptions {
+  // The Bitcoin Core data directory of the network, the one holding blocks/.
+  std::filesystem::path data_directory {};
+  Network network { Network::Mainnet };
+  // Reads blk<first_file>.dat onwards.
+  std::uint32_t first_file { 0 };
+  // Stop after this many files; 0 reads until the next file is missing.
+  std::uint32_t max_files { 0 };
+  // 0 uses one worker per hardware thread.
+  std::size_t worker_count { 0 };
+  // Blocks parsed ahead of the sink. More smooths out uneven block sizes at
+  // the cost of memory when the files are obfuscated.
+  std::size_t blocks_in_flight { 256 };
+};
+
+struct FileBlock {
+  // N in blkN.dat.
+  std::uint32_t file_number { 0 };
+  // Where the payload starts in the file.
+  std::uint64_t file_offset { 0 };
+  // Valid only while the sink runs. It points into the mapped file unless
+  // the files are obfuscated.
+  std::span<std::uint8_t const> payload {};
+  BlockMetadata metadata {};
+};
+
+// Receives the blocks in the order they are stored, which is the order the
+// node received them in and not height order, on the thread that called
+// Run(). A failed status stops the run.
+using FileBlockSink = std::function<core::Status(FileBlock&&)>;
+
+struct BlockFileStats {
+  std::uint32_t files_read { 0 };
+  std::uint64_t blocks_delivered { 0 };
+  std::uint64_t bytes_read { 0 };
+  // Blocks framed correctly that did not parse; they are skipped.
+  std::uint64_t malformed_blocks { 0 };
+  // Bytes between blocks that were not a block, such as the zeroed space
+  // preallocated at the end of the last file.
+  std::uint64_t skipped_bytes { 0 };
+};
+
+// Reads the blocks of a synced Bitcoin Core node straight from its
+// blocks/blk*.dat files, without the node running. Each file is mapped and
+// walked for its magic and length framing, deobfuscated with blocks/xor.dat
+// when the node wrote one, and its blocks parsed across workers.
+class BlockFileIngestion {
+public:
+  explicit BLOCXXI_BITCOIN_API BlockFileIngestion(BlockFileOptions options);
+
+  BLOCXXI_BITCOIN_API auto Run(FileBlockSink const& sink) -> core::Status;
+
+  [[nodiscard]] auto Stats() const -> BlockFileStats const& { return stats_; }
+
+private:
+  BlockFileOptions options_ {};
+  BlockFileStats stats_ {};
+};
+
+} // namespace blocxxi::bitcoin
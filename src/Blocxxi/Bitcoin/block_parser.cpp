@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/block_parser.h>
+
+#include <cstring>
+#include <limits>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// The smallest possible transaction: version, empty input and output counts
+// and lock time. Bounds how much a claimed transaction count may reserve.
+constexpr auto kMinTransactionSize = std::size_t { 10 };
+
+[[nodiscard]] auto Slice(std::span<std::uint8_t const> payload, ByteRange range)
+  -> std::span<std::byte const>
+{
+  return std::as_bytes(payload.subspan(range.offset, range.size));
+}
+
+} // namespace
+
+auto ReadCompactSize(std::span<std::uint8_t const> payload, std::size_t& offset)
+  -> std::optional<std::uint64_t>
+{
+  if (offset >= payload.size()) {
+    return std::nullopt;
+  }
+
+  auto const first = payload[offset++];
+  if (first < 253U) {
+    return first;
+  }
+
+  auto const width = first == 0xFD ? 2U : first == 0xFE ? 4U : 8U;
+  if (width > payload.size() - offset) {
+    return std::nullopt;
+  }
+
+  auto value = std::uint64_t { 0 };
+  for (auto index = std::size_t { 0 }; index < width; ++index) {
+    value |= static_cast<std::uint64_t>(payload[offset + index]) << (index * 8U);
+  }
+  offset += width;
+  return value;
+}
+
+auto BlockReader::Open(std::span<std::uint8_t const> payload)
+  -> std::optional<BlockReader>
+{
+  if (payload.size() <= kBlockHeaderSize) {
+    return std::nullopt;
+  }
+  auto offset = kBlockHeaderSize;
+  auto const count = ReadCompactSize(payload, offset);
+  if (!count.has_value()) {
+    return std::nullopt;
+  }
+  return BlockReader(payload, offset, *count);
+}
+
+auto BlockReader::Next() -> std::optional<TransactionView>
+{
+  if (failed_ || read_ == transaction_count_) {
+    return std::nullopt;
+  }
+
+  auto offset = offset_;
+  auto const skip = [&](std::uint64_t count) -> bool {
+    if (count > payload_.size() - offset) {
+      return false;
+    }
+    offset += count;
+    return true;
+  };
+  auto const fail = [this]() -> std::optional<TransactionView> {
+    failed_ = true;
+    return std::nullopt;
+  };
+
+  auto transaction = TransactionView {};
+  if (!skip(4U)) {
+    return fail();
+  }
+  std::memcpy(&transaction.version, payload_.data() + offset_, sizeof(transaction.version));
+
+  if (offset + 2U <= payload_.size() && payload_[offset] == 0U
+    && payload_[offset + 1U] != 0U) {
+    transaction.has_witness = true;
+    offset += 2U;
+  }
+
+  transaction.inputs.offset = offset;
+  auto const input_count = ReadCompactSize(payload_, offset);
+  if (!input_count.has_value()) {
+    return fail();
+  }
+  for (auto input = std::uint64_t { 0 }; input < *input_count; ++input) {
+    if (!skip(36U)) {
+      return fail();
+    }
+    auto const script_size = ReadCompactSize(payload_, offset);
+    if (!script_size.has_value() || !skip(*script_size) || !skip(4U)) {
+      return fail();
+    }
+  }
+  transaction.inputs.size = offset - transaction.inputs.offset;
+  transaction.input_count = *input_count;
+
+  transaction.outputs.offset = offset;
+  auto const output_count = ReadCompactSize(payload_, offset);
+  if (!output_count.has_value()) {
+    return fail();
+  }
+  for (auto output = std::uint64_t { 0 }; output < *output_count; ++output) {
+    auto value = std::uint64_t { 0 };
+    if (8U > payload_.size() - offset) {
+      return fail();
+    }
+    std::memcpy(&value, payload_.data() + offset, sizeof(value));
+    if (value > std::numeric_limits<std::uint64_t>::max() - transaction.output_value) {
+      return fail();
+    }
+    transaction.output_value += value;
+    offset += 8U;
+    auto const script_size = ReadCompactSize(payload_, offset);
+    if (!script_size.has_value() || !skip(*script_size)) {
+      return fail();
+    }
+  }
+  transaction.outputs.size = offset - transaction.outputs.offset;
+  transaction.output_count = *output_count;
+
+  transaction.witness.offset = offset;
+  if (transaction.has_witness) {
+    for (auto input = std::uint64_t { 0 }; input < *input_count; ++input) {
+      auto const stack_items = ReadCompactSize(payload_, offset);
+      if (!stack_items.has_value()) {
+        return fail();
+      }
+      for (auto item = std::uint64_t { 0 }; item < *stack_items; ++item) {
+        auto const item_size = ReadCompactSize(payload_, offset);
+        if (!item_size.has_value() || !skip(*item_size)) {
+          return fail();
+        }
+      }
+    }
+  }
+  transaction.witness.size = offset - transaction.witness.offset;
+
+  if (!skip(4U)) {
+    return fail();
+  }
+  transaction.bytes = ByteRange { .offset = offset_, .size = offset - offset_ };
+  offset_ = offset;
+  ++read_;
+  return transaction;
+}
+
+auto ParseBlockTransactions(std::span<std::uint8_t const> payload,
+  std::vector<TransactionView>& transactions) -> bool
+{
+  transactions.clear();
+  auto reader = BlockReader::Open(payload);
+  if (!reader.has_value()) {
+    return false;
+  }
+  if (reader->TransactionCount() > payload.size() / kMinTransactionSize) {
+    return false;
+  }
+  transactions.reserve(static_cast<std::size_t>(reader->TransactionCount()));
+  while (auto transaction = reader->Next()) {
+    transactions.push_back(*transaction);
+  }
+  return !reader->Failed() && reader->AtEnd();
+}
+
+auto ComputeTxid(std::span<std::uint8_t const> payload,
+  TransactionView const& transaction) -> nova::Sha256Digest
+{
+  if (!transaction.has_witness) {
+    return ComputeWtxid(payload, transaction);
+  }
+
+  // Inputs and outputs are adjacent; only the marker and the witness have to
+  // be stepped over.
+  auto hasher = nova::Sha256 {};
+  hasher.Update(Slice(payload, { .offset = transaction.bytes.offset, .size = 4U }));
+  hasher.Update(Slice(payload,
+    { .offset = transaction.inputs.offset,
+      .size = transaction.outputs.End() - transaction.inputs.offset }));
+  hasher.Update(
+    Slice(payload, { .offset = transaction.bytes.End() - 4U, .size = 4U }));
+  auto const first = hasher.Finalize();
+  return nova::ComputeSha256(std::as_bytes(std::span(first)));
+}
+
+auto ComputeWtxid(std::span<std::uint8_t const> payload,
+  TransactionView const& transaction) -> nova::Sha256Digest
+{
+  return nova::ComputeSha256d(Slice(payload, transaction.bytes));
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+namespace blocxxi::bitcoin {
+
+inline constexpr std::size_t kBlockHeaderSize = 80;
+
+// Bytes [offset, offset + size) of a serialized block.
+struct ByteRange {
+  std::size_t offset { 0 };
+  std::size_t size { 0 };
+
+  [[nodiscard]] auto End() const -> std::size_t { return offset + size; }
+
+  friend auto operator==(ByteRange const& lhs, ByteRange const& rhs)
+    -> bool = default;
+};
+
+// Where one transaction lives inside a serialized block. Ranges are offsets
+// rather than pointers, so a view stays valid when the block bytes move (for
+// example into a BlockBody).
+struct TransactionView {
+  // The whole transaction, with witness data when present.
+  ByteRange bytes {};
+  // The input count followed by the inputs.
+  ByteRange inputs {};
+  // The output count followed by the outputs.
+  ByteRange outputs {};
+  // One stack per input; empty when the transaction has no witness marker.
+  ByteRange witness {};
+  std::uint32_t version { 0 };
+  std::uint64_t input_count { 0 };
+  std::uint64_t output_count { 0 };
+  std::uint64_t output_value { 0 };
+  bool has_witness { false };
+
+  friend auto operator==(TransactionView const& lhs, TransactionView const& rhs)
+    -> bool = default;
+};
+
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ReadCompactSize(
+  std::span<std::uint8_t const> payload, std::size_t& offset)
+  -> std::optional<std::uint64_t>;
+
+// Walks the transactions of a serialized block in a single pass without
+// copying or allocating. Every length is bounds checked; a malformed block
+// makes Next() return nothing and Failed() report true.
+class BlockReader {
+public:
+  // Returns nothing when the payload is too short for a header and a
+  // transaction count.
+  [[nodiscard]] BLOCXXI_BITCOIN_API static auto Open(
+    std::span<std::uint8_t const> payload) -> std::optional<BlockReader>;
+
+  [[nodiscard]] auto Header() const
+    -> std::span<std::uint8_t const, kBlockHeaderSize>
+  {
+    return payload_.first<kBlockHeaderSize>();
+  }
+  [[nodiscard]] auto TransactionCount() const -> std::uint64_t
+  {
+    return transaction_count_;
+  }
+  [[nodiscard]] auto Failed() const -> bool { return failed_; }
+  // Whether the transactions read so far end exactly where the payload does.
+  [[nodiscard]] auto AtEnd() const -> bool { return offset_ == payload_.size(); }
+
+  [[nodiscard]] BLOCXXI_BITCOIN_API auto Next() -> std::optional<TransactionView>;
+
+private:
+  BlockReader(std::span<std::uint8_t const> payload, std::size_t offset,
+    std::uint64_t transaction_count)
+    : payload_(payload)
+    , offset_(offset)
+    , transaction_count_(transaction_count)
+  {
+  }
+
+  std::span<std::uint8_t const> payload_;
+  std::size_t offset_;
+  std::uint64_t transaction_count_;
+  std::uint64_t read_ { 0 };
+  bool failed_ { false };
+};
+
+// Reads every transaction of the block into `transactions`, reusing its
+// capacity. Returns false when the block is malformed, including when bytes
+// follow its last transaction.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ParseBlockTransactions(
+  std::span<std::uint8_t const> payload,
+  std::vector<TransactionView>& transactions) -> bool;
+
+// Double SHA-256 of the transaction without its witness, streamed over the
+// version, inputs, outputs and lock time where they lie in `payload`.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ComputeTxid(
+  std::span<std::uint8_t const> payload, TransactionView const& transaction)
+  -> nova::Sha256Digest;
+
+// Double SHA-256 of the full serialization. Equal to the txid when the
+// transaction has no witness.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto ComputeWtxid(
+  std::span<std::uint8_t const> payload, TransactionView const& transaction)
+  -> nova::Sha256Digest;
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <Blocxxi/Codec/base16.h>
+
+namespace blocxxi::bitcoin {
+
+// A 32-byte hash kept in wire byte order, which is the order it is computed,
+// serialized and compared for equality in. Bitcoin displays hashes
+// byte-reversed; FromHex() and ToHex() are the only places that reverse, and
+// belong at display and configuration boundaries. The tag keeps block hashes,
+// txids and merkle roots apart.
+template <typename Tag>
+class WireHash {
+public:
+  static constexpr std::size_t kSize = 32;
+  using Bytes = std::array<std::uint8_t, kSize>;
+
+  constexpr WireHash() noexcept = default;
+  constexpr explicit WireHash(Bytes const& bytes) noexcept
+    : bytes_(bytes)
+  {
+  }
+
+  // Returns nothing unless `bytes` holds exactly kSize bytes.
+  [[nodiscard]] static auto FromBytes(std::span<std::uint8_t const> bytes) noexcept
+    -> std::optional<WireHash>
+  {
+    if (bytes.size() != kSize) {
+      return std::nullopt;
+    }
+    auto hash = WireHash {};
+    std::memcpy(hash.bytes_.data(), bytes.data(), kSize);
+    return hash;
+  }
+
+  // Parses the 64-digit display form.
+  [[nodiscard]] static auto FromHex(std::string_view hex) -> std::optional<WireHash>
+  {
+    auto hash = WireHash {};
+    if (!codec::hex::TryDecodeReversed(hex, hash.bytes_)) {
+      return std::nullopt;
+    }
+    return hash;
+  }
+
+  [[nodiscard]] auto ToHex() const -> std::string
+  {
+    return codec::hex::EncodeReversed(bytes_, true);
+  }
+
+  [[nodiscard]] constexpr auto Data() const noexcept -> Bytes const& { return bytes_; }
+  [[nodiscard]] auto Span() const noexcept -> std::span<std::uint8_t const, kSize>
+  {
+    return bytes_;
+  }
+  [[nodiscard]] constexpr auto IsNull() const noexcept -> bool
+  {
+    return std::ranges::all_of(bytes_, [](std::uint8_t byte) { return byte == 0U; });
+  }
+
+  // Orders by the hash read as a 256-bit little-endian number, which is how
+  // proof of work compares it against a target.
+  [[nodiscard]] constexpr auto CompareAsNumber(WireHash const& other) const noexcept
+    -> std::strong_ordering
+  {
+    for (auto index = kSize; index > 0U; --index) {
+      if (auto const order = bytes_[index - 1U] <=> other.bytes_[index - 1U]; order != 0) {
+        return order;
+      }
+    }
+    return std::strong_ordering::equal;
+  }
+
+  friend constexpr auto operator==(WireHash const& lhs, WireHash const& rhs) noexcept
+    -> bool = default;
+
+private:
+  Bytes bytes_ {};
+};
+
+using BlockHash = WireHash<struct BlockHashTag>;
+using Txid = WireHash<struct TxidTag>;
+using Wtxid = WireHash<struct WtxidTag>;
+using MerkleRoot = WireHash<struct MerkleRootTag>;
+
+static_assert(std::is_trivially_copyable_v<BlockHash>);
+static_assert(sizeof(BlockHash) == BlockHash::kSize);
+
+} // namespace blocxxi::bitcoin
+
+template <typename Tag>
+struct std::hash<blocxxi::bitcoin::WireHash<Tag>> {
+  auto operator()(blocxxi::bitcoin::WireHash<Tag> const& hash) const noexcept
+    -> std::size_t
+  {
+    // Hash outputs are uniformly distributed already.
+    auto value = std::size_t { 0 };
+    std::memcpy(&value, hash.Data().data(), sizeof(value));
+    return value;
+  }
+};
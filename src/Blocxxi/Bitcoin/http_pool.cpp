@@ -0,0 +1,408 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/http_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <optional>
+#include <utility>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+constexpr auto kMaxHeaderSize = std::size_t { 64 * 1024 };
+
+[[nodiscard]] auto Trim(std::string_view value) -> std::string_view
+{
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1U);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1U);
+  }
+  return value;
+}
+
+[[nodiscard]] auto EqualsIgnoringCase(std::string_view lhs, std::string_view rhs) -> bool
+{
+  return std::ranges::equal(lhs, rhs, [](char left, char right) {
+    return std::tolower(static_cast<unsigned char>(left))
+      == std::tolower(static_cast<unsigned char>(right));
+  });
+}
+
+[[nodiscard]] auto ContainsIgnoringCase(std::string_view value, std::string_view token)
+  -> bool
+{
+  for (auto offset = std::size_t { 0 }; offset + token.size() <= value.size(); ++offset) {
+    if (EqualsIgnoringCase(value.substr(offset, token.size()), token)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Number>
+[[nodiscard]] auto ParseNumber(std::string_view text, int base) -> std::optional<Number>
+{
+  auto value = Number { 0 };
+  auto const* end = text.data() + text.size();
+  auto const [pointer, error] = std::from_chars(text.data(), end, value, base);
+  if (error != std::errc {} || pointer != end || text.empty()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Reads a response off a socket into `buffer`, from which the parts that
+// have been handed on are discarded.
+class ResponseReader {
+public:
+  explicit ResponseReader(asio::ip::tcp::socket& socket)
+    : socket_(socket)
+  {
+  }
+
+  // Reads until `buffer` holds at least `size` bytes.
+  [[nodiscard]] auto FillTo(std::size_t size) -> bool
+  {
+    while (buffer.size() < size) {
+      if (!ReadMore()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Where the next CRLF at or after `from` starts, reading as needed.
+  [[nodiscard]] auto FindLine(std::size_t from) -> std::optional<std::size_t>
+  {
+    while (true) {
+      if (auto const end = buffer.find("\r\n", from); end != std::string::npos) {
+        return end;
+      }
+      if (buffer.size() > from + kMaxHeaderSize || !ReadMore()) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  auto Discard(std::size_t count) -> void
+  {
+    buffer.erase(0U, count);
+  }
+
+  std::string buffer {};
+  std::error_code error {};
+  bool eof { false };
+
+private:
+  [[nodiscard]] auto ReadMore() -> bool
+  {
+    if (eof || error) {
+      return false;
+    }
+    auto chunk = std::array<char, 16 * 1024> {};
+    auto const read = socket_.read_some(asio::buffer(chunk), error);
+    if (error == asio::error::eof) {
+      error.clear();
+      eof = true;
+    }
+    buffer.append(chunk.data(), read);
+    return read > 0U || (!eof && !error);
+  }
+
+  asio::ip::tcp::socket& socket_;
+};
+
+struct Exchange {
+  core::Status status {};
+  bool keep_alive { false };
+  // Set once any of the response arrived.
+  bool responded { false };
+};
+
+[[nodiscard]] auto Malformed(std::string message) -> Exchange
+{
+  return Exchange {
+    .status = core::Status::Failure(core::StatusCode::Rejected, std::move(message)),
+    .responded = true,
+  };
+}
+
+[[nodiscard]] auto ReadFailed(ResponseReader const& reader) -> Exchange
+{
+  return Exchange {
+    .status = core::Status::Failure(core::StatusCode::IOError,
+      reader.error ? reader.error.message() : "connection closed mid-response"),
+    .responded = true,
+  };
+}
+
+// Hands the buffered bytes on, `limit` at most.
+[[nodiscard]] auto HandOn(ResponseReader& reader, std::size_t limit,
+  HttpBodySink const& sink, Exchange& failure) -> std::size_t
+{
+  auto const size = std::min(limit, reader.buffer.size());
+  if (auto status = sink(std::string_view(reader.buffer).substr(0U, size));
+      !status.ok()) {
+    failure = Exchange { .status = std::move(status), .responded = true };
+    return 0U;
+  }
+  reader.Discard(size);
+  return size;
+}
+
+// Hands the next `size` bytes of body to `sink` as they arrive.
+[[nodiscard]] auto StreamBody(ResponseReader& reader, std::size_t size,
+  HttpBodySink const& sink, Exchange& failure) -> bool
+{
+  while (size > 0U) {
+    if (reader.buffer.empty() && !reader.FillTo(1U)) {
+      failure = ReadFailed(reader);
+      return false;
+    }
+    auto const handed = HandOn(reader, size, sink, failure);
+    if (handed == 0U) {
+      return false;
+    }
+    size -= handed;
+  }
+  return true;
+}
+
+[[nodiscard]] auto StreamChunkedBody(
+  ResponseReader& reader, HttpBodySink const& sink, Exchange& failure) -> bool
+{
+  while (true) {
+    auto const line_end = reader.FindLine(0U);
+    if (!line_end.has_value()) {
+      failure = ReadFailed(reader);
+      return false;
+    }
+    auto size_text = std::string_view(reader.buffer).substr(0U, *line_end);
+    size_text = Trim(size_text.substr(0U, size_text.find(';')));
+    auto const size = ParseNumber<std::size_t>(size_text, 16);
+    if (!size.has_value()) {
+      failure = Malformed("rpc response has a malformed chunk size");
+      return false;
+    }
+    reader.Discard(*line_end + 2U);
+
+    if (*size == 0U) {
+      // Trailers, if any, end with an empty line.
+      while (true) {
+        auto const trailer_end = reader.FindLine(0U);
+        if (!trailer_end.has_value()) {
+          failure = ReadFailed(reader);
+          return false;
+        }
+        reader.Discard(*trailer_end + 2U);
+        if (*trailer_end == 0U) {
+          return true;
+        }
+      }
+    }
+
+    if (!StreamBody(reader, *size, sink, failure)) {
+      return false;
+    }
+    if (!reader.FillTo(2U)) {
+      failure = ReadFailed(reader);
+      return false;
+    }
+    if (reader.buffer.compare(0U, 2U, "\r\n") != 0) {
+      failure = Malformed("rpc response chunk is not terminated");
+      return false;
+    }
+    reader.Discard(2U);
+  }
+}
+
+[[nodiscard]] auto ReadResponse(asio::ip::tcp::socket& socket,
+  HttpBodySink const& sink, int& status_code) -> Exchange
+{
+  auto reader = ResponseReader(socket);
+  auto const status_end = reader.FindLine(0U);
+  if (!status_end.has_value()) {
+    auto failure = ReadFailed(reader);
+    failure.responded = !reader.buffer.empty();
+    return failure;
+  }
+  auto const status_line = std::string_view(reader.buffer).substr(0U, *status_end);
+  if (!status_line.starts_with("HTTP/1.") || status_line.size() < 12U) {
+    return Malformed("rpc response has a malformed status line");
+  }
+  auto const parsed_status = ParseNumber<int>(status_line.substr(9U, 3U), 10);
+  if (!parsed_status.has_value()) {
+    return Malformed("rpc response has a malformed status line");
+  }
+  auto keep_alive = status_line.starts_with("HTTP/1.1");
+
+  auto content_length = std::optional<std::size_t> {};
+  auto chunked = false;
+  auto offset = *status_end + 2U;
+  while (true) {
+    auto const line_end = reader.FindLine(offset);
+    if (!line_end.has_value()) {
+      return ReadFailed(reader);
+    }
+    if (*line_end > kMaxHeaderSize) {
+      return Malformed("rpc response headers are too large");
+    }
+    auto const line = std::string_view(reader.buffer).substr(offset, *line_end - offset);
+    offset = *line_end + 2U;
+    if (line.empty()) {
+      break;
+    }
+    auto const colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    auto const name = Trim(line.substr(0U, colon));
+    auto const value = Trim(line.substr(colon + 1U));
+    if (EqualsIgnoringCase(name, "Content-Length")) {
+      content_length = ParseNumber<std::size_t>(value, 10);
+      if (!content_length.has_value()) {
+        return Malformed("rpc response has a malformed content length");
+      }
+    } else if (EqualsIgnoringCase(name, "Transfer-Encoding")) {
+      chunked = ContainsIgnoringCase(value, "chunked");
+    } else if (EqualsIgnoringCase(name, "Connection")) {
+      if (ContainsIgnoringCase(value, "close")) {
+        keep_alive = false;
+      } else if (ContainsIgnoringCase(value, "keep-alive")) {
+        keep_alive = true;
+      }
+    }
+  }
+
+  status_code = *parsed_status;
+  reader.Discard(offset);
+  auto failure = Exchange {};
+  if (chunked) {
+    if (!StreamChunkedBody(reader, sink, failure)) {
+      return failure;
+    }
+  } else if (content_length.has_value()) {
+    if (!StreamBody(reader, *content_length, sink, failure)) {
+      return failure;
+    }
+  } else {
+    // Without framing the body runs to the end of the connection.
+    do {
+      if (!reader.buffer.empty()
+        && HandOn(reader, reader.buffer.size(), sink, failure) == 0U) {
+        return failure;
+      }
+    } while (reader.FillTo(1U));
+    if (!reader.eof) {
+      return ReadFailed(reader);
+    }
+    keep_alive = false;
+  }
+
+  // Nothing is pipelined, so bytes past the response mean the connection
+  // is out of step.
+  return Exchange {
+    .keep_alive = keep_alive && !reader.eof && reader.buffer.empty(),
+    .responded = true,
+  };
+}
+
+} // namespace
+
+HttpConnectionPool::HttpConnectionPool(HttpPoolOptions options)
+  : options_(std::move(options))
+{
+}
+
+auto HttpConnectionPool::Send(std::string_view request, HttpBodySink const& body_sink,
+  int& status_code) -> core::Status
+{
+  while (true) {
+    auto connection = Acquire();
+    auto const reused = connection != nullptr;
+    if (!reused) {
+      connection = std::make_unique<Connection>(io_context_);
+      if (auto status = Connect(*connection); !status.ok()) {
+        return status;
+      }
+    }
+
+    auto error = std::error_code {};
+    asio::write(connection->socket, asio::buffer(request.data(), request.size()), error);
+    auto exchange = error
+      ? Exchange {
+          .status = core::Status::Failure(core::StatusCode::IOError, error.message()),
+        }
+      : ReadResponse(connection->socket, body_sink, status_code);
+    if (exchange.status.ok()) {
+      if (exchange.keep_alive) {
+        Release(std::move(connection));
+      }
+      return core::Status::Success();
+    }
+    if (!reused || exchange.responded) {
+      return exchange.status;
+    }
+  }
+}
+
+auto HttpConnectionPool::Connects() const -> std::uint32_t
+{
+  auto lock = std::unique_lock(mutex_);
+  return connects_;
+}
+
+auto HttpConnectionPool::Acquire() -> std::unique_ptr<Connection>
+{
+  auto const now = std::chrono::steady_clock::now();
+  auto lock = std::unique_lock(mutex_);
+  while (!idle_.empty()) {
+    auto connection = std::move(idle_.back());
+    idle_.pop_back();
+    if (now - connection->idle_since < options_.idle_timeout) {
+      return connection;
+    }
+  }
+  return nullptr;
+}
+
+auto HttpConnectionPool::Connect(Connection& connection) -> core::Status
+{
+  auto resolver = asio::ip::tcp::resolver(io_context_);
+  auto error = std::error_code {};
+  auto const endpoints
+    = resolver.resolve(options_.host, std::to_string(options_.port), error);
+  if (error) {
+    return core::Status::Failure(core::StatusCode::IOError, error.message());
+  }
+  asio::connect(connection.socket, endpoints, error);
+  if (error) {
+    return core::Status::Failure(core::StatusCode::IOError, error.message());
+  }
+  connection.socket.set_option(asio::ip::tcp::no_delay(true), error);
+
+  auto lock = std::unique_lock(mutex_);
+  ++connects_;
+  return core::Status::Success();
+}
+
+auto HttpConnectionPool::Release(std::unique_ptr<Connection> connection) -> void
+{
+  connection->idle_since = std::chrono::steady_clock::now();
+  auto lock = std::unique_lock(mutex_);
+  if (idle_.size() >= options_.max_idle_connections) {
+    return;
+  }
+  idle_.push_back(std::move(connection));
+}
+
+} // namespace blocxxi::bitcoin
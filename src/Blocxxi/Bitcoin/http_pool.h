@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Core/result.h>
+
+// Persistent HTTP/1.1 connections for the Bitcoin Core RPC transport. Not
+// installed.
+
+namespace blocxxi::bitcoin {
+
+struct HttpPoolOptions {
+  std::string host {};
+  std::uint16_t port { 0 };
+  // Connections kept open between requests; more are opened while requests
+  // run concurrently, and closed after them.
+  std::size_t max_idle_connections { 2 };
+  // A connection idle for this long is closed rather than reused, ahead of
+  // the server timing it out.
+  std::chrono::milliseconds idle_timeout { 15000 };
+};
+
+// Receives a response body in the pieces it arrives in, which are only
+// valid during the call. A failure abandons the response.
+using HttpBodySink = std::function<core::Status(std::string_view)>;
+
+// Sends requests over kept-alive connections, safe to use from several
+// threads. Responses are framed by Content-Length or chunked transfer
+// coding, or else run to the end of the connection, which is then not
+// reused. Bodies are handed on as they are read, never held whole. A
+// request that fails on a reused connection before any of its response
+// arrived is sent again on a new one, since the server may have closed the
+// connection while it sat idle.
+class HttpConnectionPool {
+public:
+  explicit HttpConnectionPool(HttpPoolOptions options);
+
+  HttpConnectionPool(HttpConnectionPool const&) = delete;
+  auto operator=(HttpConnectionPool const&) -> HttpConnectionPool& = delete;
+
+  // `request` is a complete HTTP/1.1 request that does not ask for the
+  // connection to be closed. `status_code` is set before the body reaches
+  // `body_sink`.
+  auto Send(std::string_view request, HttpBodySink const& body_sink, int& status_code)
+    -> core::Status;
+
+  // Connections opened so far.
+  [[nodiscard]] auto Connects() const -> std::uint32_t;
+
+private:
+  struct Connection {
+    explicit Connection(asio::io_context& io_context)
+      : socket(io_context)
+    {
+    }
+
+    asio::ip::tcp::socket socket;
+    std::chrono::steady_clock::time_point idle_since {};
+  };
+
+  // An idle connection that has not timed out, or null.
+  auto Acquire() -> std::unique_ptr<Connection>;
+  auto Connect(Connection& connection) -> core::Status;
+  auto Release(std::unique_ptr<Connection> connection) -> void;
+
+  HttpPoolOptions options_;
+  // Only blocking operations are used, so it is never run.
+  asio::io_context io_context_ {};
+  mutable std::mutex mutex_ {};
+  // Most recently used last.
+  std::vector<std::unique_ptr<Connection>> idle_ {};
+  std::uint32_t connects_ { 0 };
+};
+
+} // namespace blocxxi::bitcoin
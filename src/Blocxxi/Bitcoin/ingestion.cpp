@@ -7,6 +7,7 @@
 #include <Blocxxi/Bitcoin/ingestion.h>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <cstdlib>
@@ -18,10 +19,12 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
 
-#include <asio.hpp>
-
+#include <Blocxxi/Bitcoin/http_pool.h>
+#include <Blocxxi/Bitcoin/json_stream.h>
+#include <Blocxxi/Bitcoin/json_tape.h>
 #include <Blocxxi/Core/primitives.h>
 
 namespace blocxxi::bitcoin {
@@ -55,98 +58,6 @@ auto Base64Encode(std::string_view value) -> std::string
   return output;
 }
 
-auto SkipWhitespace(std::string_view text, std::size_t position) -> std::size_t
-{
-  while (position < text.size()
-    && std::isspace(static_cast<unsigned char>(text[position])) != 0) {
-    position += 1U;
-  }
-  return position;
-}
-
-auto ConsumeString(std::string_view text, std::size_t position) -> std::optional<std::size_t>
-{
-  if (position >= text.size() || text[position] != '"') {
-    return std::nullopt;
-  }
-
-  auto escaped = false;
-  for (auto index = position + 1U; index < text.size(); ++index) {
-    auto const current = text[index];
-    if (escaped) {
-      escaped = false;
-      continue;
-    }
-    if (current == '\\') {
-      escaped = true;
-      continue;
-    }
-    if (current == '"') {
-      return index + 1U;
-    }
-  }
-  return std::nullopt;
-}
-
-auto ConsumeJsonValue(std::string_view text, std::size_t position)
-  -> std::optional<std::size_t>
-{
-  position = SkipWhitespace(text, position);
-  if (position >= text.size()) {
-    return std::nullopt;
-  }
-
-  auto const first = text[position];
-  if (first == '"') {
-    return ConsumeString(text, position);
-  }
-
-  auto depth = std::size_t { 0 };
-  auto in_string = false;
-  auto escaped = false;
-  for (auto index = position; index < text.size(); ++index) {
-    auto const current = text[index];
-    if (in_string) {
-      if (escaped) {
-        escaped = false;
-        continue;
-      }
-      if (current == '\\') {
-        escaped = true;
-        continue;
-      }
-      if (current == '"') {
-        in_string = false;
-      }
-      continue;
-    }
-
-    if (current == '"') {
-      in_string = true;
-      continue;
-    }
-    if (current == '{' || current == '[') {
-      depth += 1U;
-      continue;
-    }
-    if (current == '}' || current == ']') {
-      if (depth == 0U) {
-        return index;
-      }
-      depth -= 1U;
-      if (depth == 0U) {
-        return index + 1U;
-      }
-      continue;
-    }
-    if (depth == 0U && current == ',') {
-      return index;
-    }
-  }
-
-  return text.size();
-}
-
 auto Trim(std::string_view text) -> std::string_view
 {
   auto first = std::size_t { 0 };
@@ -225,120 +136,129 @@ auto ParseBool(std::string_view raw) -> std::optional<bool>
   return std::nullopt;
 }
 
-auto FindObjectValue(std::string_view object, std::string_view key)
-  -> std::optional<std::string_view>
-{
-  object = Trim(object);
-  if (object.size() < 2U || object.front() != '{' || object.back() != '}') {
-    return std::nullopt;
-  }
+// A response laid out on a tape, and the node of its "result".
+struct RpcResult {
+  JsonTape tape;
+  std::size_t node { 0 };
 
-  auto position = std::size_t { 1U };
-  while (position + 1U < object.size()) {
-    position = SkipWhitespace(object, position);
-    if (position >= object.size() || object[position] == '}') {
-      break;
-    }
-
-    auto const key_end = ConsumeString(object, position);
-    if (!key_end.has_value()) {
-      return std::nullopt;
-    }
+  [[nodiscard]] auto Text() const -> std::string_view { return tape.Text(node); }
 
-    auto const current_key
-      = ParseString(object.substr(position, *key_end - position));
-    position = SkipWhitespace(object, *key_end);
-    if (position >= object.size() || object[position] != ':') {
-      return std::nullopt;
-    }
-    position = SkipWhitespace(object, position + 1U);
-    auto const value_end = ConsumeJsonValue(object, position);
-    if (!value_end.has_value()) {
-      return std::nullopt;
-    }
-
-    if (current_key.has_value() && *current_key == key) {
-      return Trim(object.substr(position, *value_end - position));
-    }
-
-    position = SkipWhitespace(object, *value_end);
-    if (position < object.size() && object[position] == ',') {
-      position += 1U;
-    }
+  // The text of `key` in the result, or `fallback` if it has none.
+  [[nodiscard]] auto Field(std::string_view key, std::string_view fallback) const
+    -> std::string_view
+  {
+    return tape.FindText(node, key).value_or(fallback);
   }
+};
 
-  return std::nullopt;
-}
-
-auto ExtractResultValue(std::string_view response_json) -> std::optional<std::string_view>
+auto ParseRpcResult(std::string_view response_json) -> std::optional<RpcResult>
 {
-  return FindObjectValue(response_json, "result");
+  auto tape = JsonTape::Parse(response_json);
+  if (!tape.has_value()) {
+    return std::nullopt;
+  }
+  auto const result = tape->Find(tape->Root(), "result");
+  if (!result.has_value()) {
+    return std::nullopt;
+  }
+  return RpcResult { .tape = std::move(*tape), .node = *result };
 }
 
 template <typename T, typename Parser>
-auto ParseResult(std::string const& response_json, Parser parser) -> std::optional<T>
+auto ParseResult(std::string_view response_json, Parser parser) -> std::optional<T>
 {
-  auto const raw = ExtractResultValue(response_json);
-  if (!raw.has_value()) {
+  auto const result = ParseRpcResult(response_json);
+  if (!result.has_value()) {
     return std::nullopt;
   }
-  return parser(*raw);
+  return parser(result->Text());
 }
 
-auto ParseMempoolTransactions(std::string_view raw, std::size_t limit)
-  -> std::optional<std::vector<TransactionObservation>>
-{
-  raw = Trim(raw);
-  if (raw.size() < 2U || raw.front() != '{' || raw.back() != '}') {
-    return std::nullopt;
+// Collects the txids of a getrawmempool response as they stream in.
+class TxidListHandler final : public JsonHandler {
+public:
+  auto StartObject() -> bool override
+  {
+    ++depth_;
+    return true;
   }
 
-  auto observations = std::vector<TransactionObservation> {};
-  auto position = std::size_t { 1U };
-  while (position + 1U < raw.size() && observations.size() < limit) {
-    position = SkipWhitespace(raw, position);
-    if (position >= raw.size() || raw[position] == '}') {
-      break;
-    }
+  auto EndObject() -> bool override
+  {
+    --depth_;
+    return true;
+  }
 
-    auto const key_end = ConsumeString(raw, position);
-    if (!key_end.has_value()) {
-      return std::nullopt;
-    }
-    auto const txid = ParseString(raw.substr(position, *key_end - position));
-    position = SkipWhitespace(raw, *key_end);
-    if (position >= raw.size() || raw[position] != ':') {
-      return std::nullopt;
-    }
-    position = SkipWhitespace(raw, position + 1U);
-    auto const value_end = ConsumeJsonValue(raw, position);
-    if (!value_end.has_value()) {
-      return std::nullopt;
+  auto StartArray() -> bool override
+  {
+    ++depth_;
+    if (depth_ == kResultDepth && in_result_) {
+      in_result_array_ = true;
+      result_is_array_ = true;
     }
+    return true;
+  }
 
-    auto const entry = Trim(raw.substr(position, *value_end - position));
-    auto observation = TransactionObservation {};
-    observation.txid = txid.value_or(std::string {});
-    if (auto const vsize = FindObjectValue(entry, "vsize")) {
-      observation.vsize = ParseInteger<std::uint64_t>(*vsize).value_or(0U);
-    }
-    if (auto const weight = FindObjectValue(entry, "weight")) {
-      observation.weight = ParseInteger<std::uint64_t>(*weight).value_or(0U);
+  auto EndArray() -> bool override
+  {
+    if (depth_ == kResultDepth) {
+      in_result_array_ = false;
     }
-    if (auto const fees = FindObjectValue(entry, "fees")) {
-      if (auto const base = FindObjectValue(*fees, "base")) {
-        observation.base_fee_btc = ParseDouble(*base).value_or(0.0);
-      }
+    --depth_;
+    return true;
+  }
+
+  auto Key(std::string_view key) -> bool override
+  {
+    if (depth_ == kResponseDepth) {
+      in_result_ = key == "result";
+      saw_result_ = saw_result_ || in_result_;
     }
-    observations.push_back(std::move(observation));
+    return true;
+  }
 
-    position = SkipWhitespace(raw, *value_end);
-    if (position < raw.size() && raw[position] == ',') {
-      position += 1U;
+  auto String(std::string_view value) -> bool override
+  {
+    if (in_result_array_ && depth_ == kResultDepth) {
+      txids_.emplace_back(value);
     }
+    return true;
   }
 
-  return observations;
+  [[nodiscard]] auto SawResult() const -> bool { return saw_result_; }
+  [[nodiscard]] auto ResultIsArray() const -> bool { return result_is_array_; }
+  [[nodiscard]] auto Txids() const -> std::vector<std::string> const& { return txids_; }
+
+private:
+  // Of the response object and the result array.
+  static constexpr auto kResponseDepth = std::size_t { 1 };
+  static constexpr auto kResultDepth = std::size_t { 2 };
+
+  std::size_t depth_ { 0 };
+  bool in_result_ { false };
+  bool in_result_array_ { false };
+  bool saw_result_ { false };
+  bool result_is_array_ { false };
+  std::vector<std::string> txids_ {};
+};
+
+// The transaction in a getmempoolentry response, or nothing if the call
+// failed.
+auto ParseMempoolEntry(std::string txid, std::string_view response_json)
+  -> std::optional<TransactionObservation>
+{
+  auto const entry = ParseRpcResult(response_json);
+  if (!entry.has_value() || entry->tape.Node(entry->node).kind != JsonKind::Object) {
+    return std::nullopt;
+  }
+  auto observation = TransactionObservation { .txid = std::move(txid) };
+  observation.vsize = ParseInteger<std::uint64_t>(entry->Field("vsize", "0")).value_or(0U);
+  observation.weight = ParseInteger<std::uint64_t>(entry->Field("weight", "0")).value_or(0U);
+  if (auto const fees = entry->tape.Find(entry->node, "fees")) {
+    observation.base_fee_btc
+      = ParseDouble(entry->tape.FindText(*fees, "base").value_or("0")).value_or(0.0);
+  }
+  return observation;
 }
 
 auto ToSatoshis(double btc_value) -> std::uint64_t
@@ -346,11 +266,13 @@ auto ToSatoshis(double btc_value) -> std::uint64_t
   return static_cast<std::uint64_t>(btc_value * 100000000.0);
 }
 
-auto BuildRequest(std::string_view method, std::string_view params_json)
-  -> std::string
+auto BuildRequest(std::string_view method, std::string_view params_json,
+  std::string_view id_json = R"("blocxxi")") -> std::string
 {
   auto request = std::string {};
-  request += R"({"jsonrpc":"1.0","id":"blocxxi","method":")";
+  request += R"({"jsonrpc":"1.0","id":)";
+  request += id_json;
+  request += R"(,"method":")";
   request += method;
   request += R"(","params":)";
   request += params_json;
@@ -358,6 +280,42 @@ auto BuildRequest(std::string_view method, std::string_view params_json)
   return request;
 }
 
+// Splits the reply to a batch of `calls`, sent with the ids 0 to
+// calls.size() - 1, into the response to each call. The node may answer in
+// any order, and answers with 200 even when some of the calls failed.
+auto SplitBatchResponse(std::string_view raw, std::span<RpcCall const> calls,
+  std::vector<std::string>& responses_json) -> core::Status
+{
+  auto const malformed = core::Status::Failure(
+    core::StatusCode::Rejected, "failed to parse rpc batch response");
+  auto const tape = JsonTape::Parse(raw);
+  if (!tape.has_value() || tape->Node(tape->Root()).kind != JsonKind::Array) {
+    return malformed;
+  }
+
+  auto responses = std::vector<std::string>(calls.size());
+  auto seen = std::vector<bool>(calls.size(), false);
+  for (auto const reply : tape->Children(tape->Root())) {
+    auto const id = ParseInteger<std::size_t>(tape->FindText(reply, "id").value_or(""));
+    if (!id.has_value() || *id >= calls.size() || seen[*id]) {
+      return malformed;
+    }
+    auto const error = tape->FindText(reply, "error");
+    if (error.has_value() && *error != "null" && !calls[*id].may_fail) {
+      return core::Status::Failure(core::StatusCode::Rejected,
+        std::string(calls[*id].method) + " failed: " + std::string(*error));
+    }
+    responses[*id] = std::string(tape->Text(reply));
+    seen[*id] = true;
+  }
+  if (!std::ranges::all_of(seen, [](bool value) { return value; })) {
+    return malformed;
+  }
+
+  responses_json = std::move(responses);
+  return core::Status::Success();
+}
+
 auto ReadEnv(std::string_view name) -> std::optional<std::string>
 {
   auto const* value = std::getenv(std::string(name).c_str());
@@ -414,13 +372,98 @@ auto LoadCookie(std::filesystem::path const& path) -> std::optional<std::pair<st
   };
 }
 
+// The calls Poll batches, in the order of `kSnapshotCalls`.
+enum SnapshotCall : std::size_t {
+  kBlockCount,
+  kBestBlockHash,
+  kMempoolInfo,
+  kNetworkInfo,
+  kBlockchainInfo,
+};
+
+constexpr auto kSnapshotCalls = std::array {
+  RpcCall { .method = "getblockcount", .params_json = "[]" },
+  RpcCall { .method = "getbestblockhash", .params_json = "[]" },
+  RpcCall { .method = "getmempoolinfo", .params_json = "[]" },
+  RpcCall { .method = "getnetworkinfo", .params_json = "[]" },
+  RpcCall { .method = "getblockchaininfo", .params_json = "[]" },
+};
+
 } // namespace
 
+auto MempoolMirror::Find(std::string const& txid) const -> TransactionObservation const*
+{
+  auto const found = transactions_.find(txid);
+  return found == transactions_.end() ? nullptr : &found->second;
+}
+
+auto MempoolMirror::Diff(std::span<std::string const> txids,
+  std::vector<std::string>& added, std::vector<std::string>& removed) const -> void
+{
+  added.clear();
+  removed.clear();
+  auto current = std::unordered_set<std::string_view> {};
+  current.reserve(txids.size());
+  for (auto const& txid : txids) {
+    if (current.insert(txid).second && !transactions_.contains(txid)) {
+      added.push_back(txid);
+    }
+  }
+  for (auto const& [txid, transaction] : transactions_) {
+    if (!current.contains(txid)) {
+      removed.push_back(txid);
+    }
+  }
+  std::ranges::sort(removed);
+}
+
+auto MempoolMirror::Apply(std::span<TransactionObservation const> added,
+  std::span<std::string const> removed) -> void
+{
+  for (auto const& txid : removed) {
+    transactions_.erase(txid);
+  }
+  for (auto const& transaction : added) {
+    transactions_.insert_or_assign(transaction.txid, transaction);
+  }
+}
+
 RpcTransport::~RpcTransport() = default;
 DataSourceAdapter::~DataSourceAdapter() = default;
 
+auto RpcTransport::CallBatch(std::span<RpcCall const> calls,
+  std::vector<std::string>& responses_json) -> core::Status
+{
+  responses_json.assign(calls.size(), std::string {});
+  for (auto index = std::size_t { 0 }; index < calls.size(); ++index) {
+    auto status = Call(calls[index].method, calls[index].params_json, responses_json[index]);
+    if (!status.ok() && calls[index].may_fail) {
+      responses_json[index].clear();
+    } else if (!status.ok()) {
+      return status;
+    }
+  }
+  return core::Status::Success();
+}
+
+auto RpcTransport::CallStreaming(std::string_view method, std::string_view params_json,
+  RpcResponseSink const& sink) -> core::Status
+{
+  auto response = std::string {};
+  if (auto status = Call(method, params_json, response); !status.ok()) {
+    return status;
+  }
+  return sink(response);
+}
+
 HttpRpcTransport::HttpRpcTransport(RpcConnectionConfig config)
   : config_(std::move(config))
+  , pool_(std::make_shared<HttpConnectionPool>(HttpPoolOptions {
+      .host = config_.host,
+      .port = config_.port,
+      .max_idle_connections = config_.max_idle_connections,
+      .idle_timeout = config_.idle_timeout,
+    }))
 {
 }
 
@@ -429,68 +472,78 @@ HttpRpcTransport::~HttpRpcTransport() = default;
 auto HttpRpcTransport::Call(std::string_view method, std::string_view params_json,
   std::string& response_json) -> core::Status
 {
-  if (config_.host.empty() || config_.username.empty() || config_.password.empty()) {
-    return core::Status::Failure(
-      core::StatusCode::InvalidArgument,
-      "rpc transport requires host, username, and password");
+  response_json.clear();
+  return Post(BuildRequest(method, params_json), [&response_json](std::string_view piece) {
+    response_json.append(piece);
+    return core::Status::Success();
+  });
+}
+
+auto HttpRpcTransport::CallBatch(std::span<RpcCall const> calls,
+  std::vector<std::string>& responses_json) -> core::Status
+{
+  if (calls.empty()) {
+    responses_json.clear();
+    return core::Status::Success();
   }
 
-  auto io_context = asio::io_context {};
-  auto resolver = asio::ip::tcp::resolver(io_context);
-  auto socket = asio::ip::tcp::socket(io_context);
-  auto error = std::error_code {};
-  auto const endpoints = resolver.resolve(
-    config_.host, std::to_string(config_.port), error);
-  if (error) {
-    return core::Status::Failure(core::StatusCode::IOError, error.message());
+  auto body = std::string { "[" };
+  for (auto index = std::size_t { 0 }; index < calls.size(); ++index) {
+    if (index > 0U) {
+      body += ",";
+    }
+    body += BuildRequest(
+      calls[index].method, calls[index].params_json, std::to_string(index));
   }
+  body += "]";
 
-  asio::connect(socket, endpoints, error);
-  if (error) {
-    return core::Status::Failure(core::StatusCode::IOError, error.message());
+  auto response = std::string {};
+  auto const collect = [&response](std::string_view piece) {
+    response.append(piece);
+    return core::Status::Success();
+  };
+  if (auto status = Post(body, collect); !status.ok()) {
+    return status;
+  }
+  return SplitBatchResponse(response, calls, responses_json);
+}
+
+auto HttpRpcTransport::CallStreaming(std::string_view method,
+  std::string_view params_json, RpcResponseSink const& sink) -> core::Status
+{
+  return Post(BuildRequest(method, params_json), sink);
+}
+
+auto HttpRpcTransport::Post(std::string_view body, RpcResponseSink const& sink)
+  -> core::Status
+{
+  if (config_.host.empty() || config_.username.empty() || config_.password.empty()) {
+    return core::Status::Failure(
+      core::StatusCode::InvalidArgument,
+      "rpc transport requires host, username, and password");
   }
 
-  auto const body = BuildRequest(method, params_json);
   auto request = std::string {};
   request += "POST " + config_.path + " HTTP/1.1\r\n";
   request += "Host: " + config_.host + ":" + std::to_string(config_.port) + "\r\n";
   request += "Authorization: Basic "
     + Base64Encode(config_.username + ":" + config_.password) + "\r\n";
   request += "Content-Type: application/json\r\n";
-  request += "Connection: close\r\n";
   request += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
   request += body;
 
-  asio::write(socket, asio::buffer(request), error);
-  if (error) {
-    return core::Status::Failure(core::StatusCode::IOError, error.message());
-  }
-
-  auto response = std::string {};
-  auto buffer = std::array<char, 4096> {};
-  while (true) {
-    auto const read = socket.read_some(asio::buffer(buffer), error);
-    if (error == asio::error::eof) {
-      break;
-    }
-    if (error) {
-      return core::Status::Failure(core::StatusCode::IOError, error.message());
-    }
-    response.append(buffer.data(), read);
-  }
-
-  auto const separator = response.find("\r\n\r\n");
-  if (separator == std::string::npos) {
-    return core::Status::Failure(
-      core::StatusCode::Rejected, "rpc response missing http body");
+  // The body of a failed call is dropped rather than handed on.
+  auto status_code = 0;
+  auto const forward = [&sink, &status_code](std::string_view piece) {
+    return status_code == 200 ? sink(piece) : core::Status::Success();
+  };
+  if (auto status = pool_->Send(request, forward, status_code); !status.ok()) {
+    return status;
   }
-  if (response.rfind("HTTP/1.1 200", 0U) != 0U
-    && response.rfind("HTTP/1.0 200", 0U) != 0U) {
+  if (status_code != 200) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "rpc transport returned non-200 response");
   }
-
-  response_json = response.substr(separator + 4U);
   return core::Status::Success();
 }
 
@@ -523,33 +576,32 @@ auto BitcoinCoreRpcAdapter::Poll(ObservationBatch& batch) -> core::Status
   batch.network = config_.network;
   batch.observed_at_utc = core::NowUnixSeconds();
 
-  auto response = std::string {};
-  auto status = transport_->Call("getblockcount", "[]", response);
+  // Everything but the mempool and the block stats goes out in one request.
+  auto responses = std::vector<std::string> {};
+  auto status = transport_->CallBatch(kSnapshotCalls, responses);
   if (!status.ok()) {
     return status;
   }
-  auto const block_count
-    = ParseResult<std::uint64_t>(response, ParseInteger<std::uint64_t>);
+  if (responses.size() != kSnapshotCalls.size()) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "rpc batch returned the wrong number of responses");
+  }
+
+  auto const block_count = ParseResult<std::uint64_t>(
+    responses[kBlockCount], ParseInteger<std::uint64_t>);
   if (!block_count.has_value()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getblockcount result");
   }
 
-  status = transport_->Call("getbestblockhash", "[]", response);
-  if (!status.ok()) {
-    return status;
-  }
-  auto const best_hash = ParseResult<std::string>(response, ParseString);
+  auto const best_hash
+    = ParseResult<std::string>(responses[kBestBlockHash], ParseString);
   if (!best_hash.has_value()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getbestblockhash result");
   }
 
-  status = transport_->Call("getmempoolinfo", "[]", response);
-  if (!status.ok()) {
-    return status;
-  }
-  auto const mempool_info = ExtractResultValue(response);
+  auto const mempool_info = ParseRpcResult(responses[kMempoolInfo]);
   if (!mempool_info.has_value()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getmempoolinfo result");
@@ -557,80 +609,123 @@ auto BitcoinCoreRpcAdapter::Poll(ObservationBatch& batch) -> core::Status
 
   auto network = NetworkHealthObservation {};
   network.mempool_transaction_count
-    = ParseInteger<std::uint64_t>(FindObjectValue(*mempool_info, "size").value_or("0"))
-        .value_or(0U);
+    = ParseInteger<std::uint64_t>(mempool_info->Field("size", "0")).value_or(0U);
   network.mempool_bytes
-    = ParseInteger<std::uint64_t>(FindObjectValue(*mempool_info, "bytes").value_or("0"))
-        .value_or(0U);
+    = ParseInteger<std::uint64_t>(mempool_info->Field("bytes", "0")).value_or(0U);
 
-  status = transport_->Call("getnetworkinfo", "[]", response);
-  if (!status.ok()) {
-    return status;
-  }
-  auto const network_info = ExtractResultValue(response);
+  auto const network_info = ParseRpcResult(responses[kNetworkInfo]);
   if (!network_info.has_value()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getnetworkinfo result");
   }
-  network.connection_count = ParseInteger<std::uint64_t>(
-    FindObjectValue(*network_info, "connections").value_or("0")).value_or(0U);
-  network.relay_fee_btc = ParseDouble(
-    FindObjectValue(*network_info, "relayfee").value_or("0")).value_or(0.0);
-  network.warning = ParseString(
-    FindObjectValue(*network_info, "warnings").value_or("\"\"")).value_or("");
+  network.connection_count
+    = ParseInteger<std::uint64_t>(network_info->Field("connections", "0")).value_or(0U);
+  network.relay_fee_btc = ParseDouble(network_info->Field("relayfee", "0")).value_or(0.0);
+  network.warning = ParseString(network_info->Field("warnings", "\"\"")).value_or("");
 
-  status = transport_->Call("getblockchaininfo", "[]", response);
-  if (!status.ok()) {
-    return status;
-  }
-  auto const blockchain_info = ExtractResultValue(response);
+  auto const blockchain_info = ParseRpcResult(responses[kBlockchainInfo]);
   if (!blockchain_info.has_value()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getblockchaininfo result");
   }
-  network.initial_block_download = ParseBool(
-    FindObjectValue(*blockchain_info, "initialblockdownload").value_or("false"))
-                                     .value_or(false);
-
-  status = transport_->Call("getrawmempool", "[true]", response);
+  network.initial_block_download
+    = ParseBool(blockchain_info->Field("initialblockdownload", "false")).value_or(false);
+
+  // Only the txids are read each poll, and streamed since even they run to
+  // tens of megabytes for a full mempool.
+  auto txid_list = TxidListHandler {};
+  auto parser = JsonStreamParser(txid_list);
+  status = transport_->CallStreaming(
+    "getrawmempool", "[false]", [&parser](std::string_view piece) {
+      if (!parser.Feed(piece)) {
+        return core::Status::Failure(
+          core::StatusCode::Rejected, "failed to parse getrawmempool result");
+      }
+      return core::Status::Success();
+    });
   if (!status.ok()) {
     return status;
   }
-  auto const mempool_entries = ExtractResultValue(response);
-  if (!mempool_entries.has_value()) {
+  if (!parser.Finish() || !txid_list.SawResult()) {
     return core::Status::Failure(
       core::StatusCode::Rejected, "failed to parse getrawmempool result");
   }
-  auto const parsed_entries
-    = ParseMempoolTransactions(*mempool_entries, config_.max_mempool_transactions);
-  if (!parsed_entries.has_value()) {
-    return core::Status::Failure(
-      core::StatusCode::Rejected, "failed to parse verbose mempool entries");
-  }
-
-  status = transport_->Call(
-    "getblockstats", "[" + std::to_string(*block_count) + ", [\"txs\", \"totalfee\"]]",
-    response);
-  if (!status.ok()) {
-    return status;
-  }
-  auto const block_stats = ExtractResultValue(response);
-  if (!block_stats.has_value()) {
+  if (!txid_list.ResultIsArray()) {
     return core::Status::Failure(
-      core::StatusCode::Rejected, "failed to parse getblockstats result");
+      core::StatusCode::Rejected, "failed to parse mempool txids");
+  }
+
+  // Entries are looked up for every new txid, and for those only, a bounded
+  // batch at a time.
+  auto added = std::vector<std::string> {};
+  mempool_.Diff(txid_list.Txids(), added, batch.removed_txids);
+  auto const batch_size = std::max<std::size_t>(1U, config_.max_mempool_transactions);
+  auto params = std::vector<std::string> {};
+  // The calls point into `params`, which therefore never reallocates.
+  params.reserve(std::min(batch_size, added.size()));
+  auto calls = std::vector<RpcCall> {};
+  auto entries = std::vector<std::string> {};
+  for (auto first = std::size_t { 0 }; first < added.size(); first += batch_size) {
+    auto const chunk
+      = std::span(added).subspan(first, std::min(batch_size, added.size() - first));
+    params.clear();
+    calls.clear();
+    for (auto const& txid : chunk) {
+      params.push_back("[\"" + txid + "\"]");
+      calls.push_back(RpcCall {
+        .method = "getmempoolentry", .params_json = params.back(), .may_fail = true });
+    }
+    status = transport_->CallBatch(calls, entries);
+    if (!status.ok()) {
+      return status;
+    }
+    if (entries.size() != calls.size()) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "rpc batch returned the wrong number of responses");
+    }
+    for (auto index = std::size_t { 0 }; index < chunk.size(); ++index) {
+      // A transaction that left the mempool after the txids were read has
+      // no entry, and is left out as if it had never been seen.
+      if (auto observation = ParseMempoolEntry(chunk[index], entries[index])) {
+        batch.added_transactions.push_back(std::move(*observation));
+      }
+    }
   }
 
   auto block = BlockObservation {};
   block.height = *block_count;
   block.block_hash_hex = *best_hash;
-  block.transaction_count = ParseInteger<std::uint64_t>(
-    FindObjectValue(*block_stats, "txs").value_or("0")).value_or(0U);
-  block.total_fee_satoshis = ToSatoshis(ParseDouble(
-    FindObjectValue(*block_stats, "totalfee").value_or("0")).value_or(0.0));
+  if (last_block_.has_value() && last_block_->block_hash_hex == *best_hash) {
+    // A block's stats never change, so they are only asked for when the tip
+    // moves.
+    block.transaction_count = last_block_->transaction_count;
+    block.total_fee_satoshis = last_block_->total_fee_satoshis;
+  } else {
+    // Asked for by hash, so the stats are those of the tip reported above
+    // even if another block arrived since.
+    auto response = std::string {};
+    status = transport_->Call("getblockstats",
+      "[\"" + *best_hash + "\", [\"txs\", \"totalfee\"]]", response);
+    if (!status.ok()) {
+      return status;
+    }
+    auto const block_stats = ParseRpcResult(response);
+    if (!block_stats.has_value()) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "failed to parse getblockstats result");
+    }
+    block.transaction_count
+      = ParseInteger<std::uint64_t>(block_stats->Field("txs", "0")).value_or(0U);
+    block.total_fee_satoshis
+      = ToSatoshis(ParseDouble(block_stats->Field("totalfee", "0")).value_or(0.0));
+  }
+  last_block_ = block;
 
   batch.latest_block = std::move(block);
   batch.network_health = std::move(network);
-  batch.mempool_transactions = *parsed_entries;
+  // Applied last, so that a failed poll leaves the mirror as the previous
+  // one did and the next poll reports what this one would have.
+  mempool_.Apply(batch.added_transactions, batch.removed_txids);
   return core::Status::Success();
 }
 
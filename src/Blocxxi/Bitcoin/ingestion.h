@@ -8,12 +8,16 @@
 
 #include <Blocxxi/Bitcoin/api_export.h>
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <Blocxxi/Bitcoin/adapter.h>
@@ -27,11 +31,18 @@ struct RpcConnectionConfig {
   std::string username {};
   std::string password {};
   std::string path { "/" };
+  // Connections kept open between calls.
+  std::size_t max_idle_connections { 2 };
+  // Bitcoin Core drops connections idle for -rpcservertimeout, 30 seconds by
+  // default; ones idle for this long are not reused.
+  std::chrono::milliseconds idle_timeout { 15000 };
 };
 
 struct BitcoinCoreRpcConfig {
   Network network { Network::Mainnet };
   RpcConnectionConfig connection {};
+  // Mempool entries asked for in one RPC batch. Every new transaction is
+  // looked up each poll, in as many batches as it takes.
   std::size_t max_mempool_transactions { 64 };
 };
 
@@ -73,11 +84,27 @@ struct ObservationBatch {
   std::string source_name {};
   Network network { Network::Mainnet };
   std::int64_t observed_at_utc { 0 };
-  std::vector<TransactionObservation> mempool_transactions {};
+  // How the mempool changed since the previous poll, which for the first
+  // poll is every transaction in it.
+  std::vector<TransactionObservation> added_transactions {};
+  std::vector<std::string> removed_txids {};
   std::optional<BlockObservation> latest_block {};
   std::optional<NetworkHealthObservation> network_health {};
 };
 
+// Receives a response in the pieces it arrives in, which are only valid
+// during the call. A failure abandons the response.
+using RpcResponseSink = std::function<core::Status(std::string_view)>;
+
+struct RpcCall {
+  std::string_view method {};
+  std::string_view params_json {};
+  // Whether the call can fail in the normal course, such as asking about a
+  // transaction that has just left the mempool. Its failure then leaves an
+  // empty or error response rather than failing the batch.
+  bool may_fail { false };
+};
+
 class BLOCXXI_BITCOIN_API RpcTransport {
 public:
   virtual ~RpcTransport();
@@ -85,6 +112,18 @@ public:
   virtual auto Call(std::string_view method, std::string_view params_json,
     std::string& response_json) -> core::Status
     = 0;
+
+  // Makes `calls`, which must not depend on each other, and leaves the
+  // response to each at the same index of `responses_json`. Fails if any of
+  // them not marked `may_fail` does. Makes the calls one at a time unless
+  // overridden.
+  virtual auto CallBatch(std::span<RpcCall const> calls,
+    std::vector<std::string>& responses_json) -> core::Status;
+
+  // Hands the response to `sink` as it arrives instead of holding all of it,
+  // for responses too large to hold. Hands it over whole unless overridden.
+  virtual auto CallStreaming(std::string_view method, std::string_view params_json,
+    RpcResponseSink const& sink) -> core::Status;
 };
 
 class BLOCXXI_BITCOIN_API DataSourceAdapter {
@@ -95,6 +134,30 @@ public:
   virtual auto Poll(ObservationBatch& batch) -> core::Status = 0;
 };
 
+// The transactions of a node's mempool as of the last poll, kept in step
+// with the node by applying what changed instead of reading it all again.
+class BLOCXXI_BITCOIN_API MempoolMirror {
+public:
+  [[nodiscard]] auto Size() const -> std::size_t { return transactions_.size(); }
+  [[nodiscard]] auto Find(std::string const& txid) const -> TransactionObservation const*;
+
+  // Compares the mirror with `txids`, the whole mempool now. Leaves in
+  // `added` the txids not mirrored, in the order given, and in `removed`
+  // the mirrored ones no longer there, sorted.
+  auto Diff(std::span<std::string const> txids, std::vector<std::string>& added,
+    std::vector<std::string>& removed) const -> void;
+  auto Apply(std::span<TransactionObservation const> added,
+    std::span<std::string const> removed) -> void;
+
+private:
+  std::unordered_map<std::string, TransactionObservation> transactions_ {};
+};
+
+class HttpConnectionPool;
+
+// Calls go over HTTP/1.1 connections kept alive between calls, reconnecting
+// when the node closed one. A batch goes out as one JSON-RPC batch request,
+// and a streamed response is handed on as it is read off the socket.
 class BLOCXXI_BITCOIN_API HttpRpcTransport final : public RpcTransport {
 public:
   explicit BLOCXXI_BITCOIN_API HttpRpcTransport(RpcConnectionConfig config);
@@ -102,9 +165,16 @@ public:
 
   BLOCXXI_BITCOIN_API auto Call(std::string_view method,
     std::string_view params_json, std::string& response_json) -> core::Status override;
+  BLOCXXI_BITCOIN_API auto CallBatch(std::span<RpcCall const> calls,
+    std::vector<std::string>& responses_json) -> core::Status override;
+  BLOCXXI_BITCOIN_API auto CallStreaming(std::string_view method,
+    std::string_view params_json, RpcResponseSink const& sink) -> core::Status override;
 
 private:
+  auto Post(std::string_view body, RpcResponseSink const& sink) -> core::Status;
+
   RpcConnectionConfig config_ {};
+  std::shared_ptr<HttpConnectionPool> pool_ {};
 };
 
 class BLOCXXI_BITCOIN_API BitcoinCoreRpcAdapter final : public DataSourceAdapter {
@@ -117,9 +187,15 @@ public:
   [[nodiscard]] BLOCXXI_BITCOIN_API auto Name() const -> std::string override;
   BLOCXXI_BITCOIN_API auto Poll(ObservationBatch& batch) -> core::Status override;
 
+  [[nodiscard]] auto Mempool() const -> MempoolMirror const& { return mempool_; }
+
 private:
   BitcoinCoreRpcConfig config_ {};
   std::shared_ptr<RpcTransport> transport_ {};
+  MempoolMirror mempool_ {};
+  // The tip seen by the last poll, whose stats are reused while it stays
+  // the tip.
+  std::optional<BlockObservation> last_block_ {};
 };
 
 [[nodiscard]] BLOCXXI_BITCOIN_API auto DefaultBitcoinCoreConfigPath(
@@ -0,0 +1,315 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/json_stream.h>
+
+#include <algorithm>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+// Bounds on what a hostile or broken server can make the parser hold.
+constexpr auto kMaxDepth = std::size_t { 256 };
+constexpr auto kMaxTokenSize = std::size_t { 1024 * 1024 };
+
+[[nodiscard]] auto IsWhitespace(char current) -> bool
+{
+  return current == ' ' || current == '\t' || current == '\n' || current == '\r';
+}
+
+[[nodiscard]] auto IsNumber(std::string_view text) -> bool
+{
+  if (text.empty() || (text.front() != '-' && (text.front() < '0' || text.front() > '9'))) {
+    return false;
+  }
+  return text.find_first_not_of("0123456789+-.eE") == std::string_view::npos;
+}
+
+[[nodiscard]] auto HexValue(char current) -> int
+{
+  if (current >= '0' && current <= '9') {
+    return current - '0';
+  }
+  if (current >= 'a' && current <= 'f') {
+    return current - 'a' + 10;
+  }
+  if (current >= 'A' && current <= 'F') {
+    return current - 'A' + 10;
+  }
+  return -1;
+}
+
+} // namespace
+
+JsonHandler::~JsonHandler() = default;
+
+JsonStreamParser::JsonStreamParser(JsonHandler& handler)
+  : handler_(handler)
+{
+}
+
+auto JsonStreamParser::Feed(std::string_view input) -> bool
+{
+  auto position = std::size_t { 0 };
+  while (position < input.size() && state_ != State::Failed) {
+    auto ok = true;
+    if (state_ == State::String || state_ == State::Literal) {
+      // Runs of plain characters are copied in one go.
+      auto const end = state_ == State::String ? input.find_first_of("\"\\", position)
+                                               : input.find_first_of(" \t\r\n,]}", position);
+      auto const run_end = end == std::string_view::npos ? input.size() : end;
+      auto const run = input.substr(position, run_end - position);
+      // JSON allows no control character unescaped in a string.
+      ok = (state_ != State::String || std::ranges::none_of(run, [](char current) {
+        return static_cast<unsigned char>(current) < 0x20U;
+      })) && Append(run);
+      position = run_end;
+      if (ok && position < input.size()) {
+        if (state_ == State::Literal) {
+          // The delimiter is left for the next state.
+          ok = EmitLiteral();
+        } else if (input[position++] == '\\') {
+          state_ = State::Escape;
+        } else {
+          ok = EmitString();
+        }
+      }
+    } else {
+      ok = Step(input[position++]);
+    }
+    if (!ok) {
+      state_ = State::Failed;
+    }
+  }
+  return state_ != State::Failed;
+}
+
+auto JsonStreamParser::Finish() -> bool
+{
+  if (state_ == State::Literal && open_.empty() && !EmitLiteral()) {
+    state_ = State::Failed;
+  }
+  return state_ == State::Done;
+}
+
+auto JsonStreamParser::Step(char current) -> bool
+{
+  switch (state_) {
+  case State::Escape:
+    return Unescape(current);
+  case State::Unicode: {
+    auto const value = HexValue(current);
+    if (value < 0) {
+      return false;
+    }
+    code_point_ = code_point_ * 16U + static_cast<std::uint32_t>(value);
+    if (++code_point_digits_ < 4U) {
+      return true;
+    }
+    state_ = State::String;
+    return AppendCodePoint();
+  }
+  default:
+    break;
+  }
+
+  if (IsWhitespace(current)) {
+    return true;
+  }
+  switch (state_) {
+  case State::ValueOrEnd:
+    if (current == ']') {
+      return Close('[');
+    }
+    return BeginValue(current);
+  case State::Value:
+    return BeginValue(current);
+  case State::KeyOrEnd:
+    if (current == '}') {
+      return Close('{');
+    }
+    [[fallthrough]];
+  case State::Key:
+    if (current != '"') {
+      return false;
+    }
+    token_.clear();
+    token_is_key_ = true;
+    state_ = State::String;
+    return true;
+  case State::Colon:
+    if (current != ':') {
+      return false;
+    }
+    state_ = State::Value;
+    return true;
+  case State::AfterValue:
+    if (current == ',') {
+      state_ = open_.back() == '{' ? State::Key : State::Value;
+      return true;
+    }
+    if (current == '}' || current == ']') {
+      return Close(current == '}' ? '{' : '[');
+    }
+    return false;
+  default:
+    return false;
+  }
+}
+
+auto JsonStreamParser::BeginValue(char current) -> bool
+{
+  if (current == '{' || current == '[') {
+    if (open_.size() >= kMaxDepth) {
+      return false;
+    }
+    open_.push_back(current);
+    state_ = current == '{' ? State::KeyOrEnd : State::ValueOrEnd;
+    return current == '{' ? handler_.StartObject() : handler_.StartArray();
+  }
+  token_.clear();
+  if (current == '"') {
+    token_is_key_ = false;
+    state_ = State::String;
+    return true;
+  }
+  if (current != '-' && current != 't' && current != 'f' && current != 'n'
+    && (current < '0' || current > '9')) {
+    return false;
+  }
+  token_.push_back(current);
+  state_ = State::Literal;
+  return true;
+}
+
+auto JsonStreamParser::Close(char open) -> bool
+{
+  if (open_.empty() || open_.back() != open) {
+    return false;
+  }
+  open_.pop_back();
+  if (!(open == '{' ? handler_.EndObject() : handler_.EndArray())) {
+    return false;
+  }
+  return EndValue();
+}
+
+auto JsonStreamParser::EndValue() -> bool
+{
+  state_ = open_.empty() ? State::Done : State::AfterValue;
+  return true;
+}
+
+auto JsonStreamParser::Append(std::string_view text) -> bool
+{
+  if (text.empty()) {
+    return true;
+  }
+  if (high_surrogate_ != 0U || token_.size() + text.size() > kMaxTokenSize) {
+    return false;
+  }
+  token_.append(text);
+  return true;
+}
+
+auto JsonStreamParser::Unescape(char current) -> bool
+{
+  state_ = State::String;
+  if (current == 'u') {
+    code_point_ = 0U;
+    code_point_digits_ = 0U;
+    state_ = State::Unicode;
+    return true;
+  }
+  auto replacement = char { 0 };
+  switch (current) {
+  case '"':
+  case '\\':
+  case '/':
+    replacement = current;
+    break;
+  case 'b':
+    replacement = '\b';
+    break;
+  case 'f':
+    replacement = '\f';
+    break;
+  case 'n':
+    replacement = '\n';
+    break;
+  case 'r':
+    replacement = '\r';
+    break;
+  case 't':
+    replacement = '\t';
+    break;
+  default:
+    return false;
+  }
+  return Append(std::string_view(&replacement, 1U));
+}
+
+auto JsonStreamParser::AppendCodePoint() -> bool
+{
+  auto code_point = code_point_;
+  if (high_surrogate_ != 0U) {
+    if (code_point < 0xDC00U || code_point > 0xDFFFU) {
+      return false;
+    }
+    code_point = 0x10000U + ((high_surrogate_ - 0xD800U) << 10U) + (code_point - 0xDC00U);
+    high_surrogate_ = 0U;
+  } else if (code_point >= 0xD800U && code_point <= 0xDBFFU) {
+    high_surrogate_ = code_point;
+    return true;
+  } else if (code_point >= 0xDC00U && code_point <= 0xDFFFU) {
+    return false;
+  }
+
+  auto encoded = std::string {};
+  if (code_point < 0x80U) {
+    encoded.push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800U) {
+    encoded.push_back(static_cast<char>(0xC0U | (code_point >> 6U)));
+    encoded.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+  } else if (code_point < 0x10000U) {
+    encoded.push_back(static_cast<char>(0xE0U | (code_point >> 12U)));
+    encoded.push_back(static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU)));
+    encoded.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+  } else {
+    encoded.push_back(static_cast<char>(0xF0U | (code_point >> 18U)));
+    encoded.push_back(static_cast<char>(0x80U | ((code_point >> 12U) & 0x3FU)));
+    encoded.push_back(static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU)));
+    encoded.push_back(static_cast<char>(0x80U | (code_point & 0x3FU)));
+  }
+  return Append(encoded);
+}
+
+auto JsonStreamParser::EmitString() -> bool
+{
+  if (high_surrogate_ != 0U) {
+    return false;
+  }
+  if (token_is_key_) {
+    state_ = State::Colon;
+    return handler_.Key(token_);
+  }
+  return handler_.String(token_) && EndValue();
+}
+
+auto JsonStreamParser::EmitLiteral() -> bool
+{
+  auto handled = false;
+  if (token_ == "true" || token_ == "false") {
+    handled = handler_.Bool(token_ == "true");
+  } else if (token_ == "null") {
+    handled = handler_.Null();
+  } else if (IsNumber(token_)) {
+    handled = handler_.Number(token_);
+  }
+  return handled && EndValue();
+}
+
+} // namespace blocxxi::bitcoin
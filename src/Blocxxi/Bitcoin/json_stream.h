@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Event-driven JSON parsing for RPC responses too large to hold whole. Not
+// installed; exported for the tests and the benchmark only.
+
+namespace blocxxi::bitcoin {
+
+// Receives the parts of a document in order; returning false stops the
+// parse. Keys and strings arrive unescaped, numbers as written, and both
+// are only valid during the call.
+class BLOCXXI_BITCOIN_API JsonHandler {
+public:
+  virtual ~JsonHandler();
+
+  virtual auto StartObject() -> bool { return true; }
+  virtual auto EndObject() -> bool { return true; }
+  virtual auto StartArray() -> bool { return true; }
+  virtual auto EndArray() -> bool { return true; }
+  virtual auto Key(std::string_view /*key*/) -> bool { return true; }
+  virtual auto String(std::string_view /*value*/) -> bool { return true; }
+  virtual auto Number(std::string_view /*value*/) -> bool { return true; }
+  virtual auto Bool(bool /*value*/) -> bool { return true; }
+  virtual auto Null() -> bool { return true; }
+};
+
+// Parses one JSON value fed in pieces split anywhere. Memory use depends on
+// the nesting depth and the longest string or number, not on the size of
+// the document.
+class BLOCXXI_BITCOIN_API JsonStreamParser {
+public:
+  explicit JsonStreamParser(JsonHandler& handler);
+
+  // False once the input is not JSON or the handler stopped the parse.
+  auto Feed(std::string_view input) -> bool;
+  // Whether the input fed was exactly one complete value.
+  [[nodiscard]] auto Finish() -> bool;
+
+private:
+  enum class State : std::uint8_t {
+    Value,
+    ValueOrEnd,
+    Key,
+    KeyOrEnd,
+    Colon,
+    AfterValue,
+    String,
+    Escape,
+    Unicode,
+    Literal,
+    Done,
+    Failed,
+  };
+
+  auto Step(char current) -> bool;
+  auto BeginValue(char current) -> bool;
+  auto Close(char open) -> bool;
+  auto EndValue() -> bool;
+  auto Append(std::string_view text) -> bool;
+  auto Unescape(char current) -> bool;
+  auto AppendCodePoint() -> bool;
+  auto EmitString() -> bool;
+  auto EmitLiteral() -> bool;
+
+  JsonHandler& handler_;
+  State state_ { State::Value };
+  // '{' or '[' for each open container.
+  std::vector<char> open_ {};
+  std::string token_ {};
+  bool token_is_key_ { false };
+  std::uint32_t code_point_ { 0 };
+  std::uint32_t code_point_digits_ { 0 };
+  // The first half of a surrogate pair, waiting for the second.
+  std::uint32_t high_surrogate_ { 0 };
+};
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,429 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/json_tape.h>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+// SSE2 is part of every x86-64 target, so unlike the hex kernels this needs
+// neither a target attribute nor a runtime check.
+// NOLINTBEGIN(portability-simd-intrinsics,*-reinterpret-cast)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCXXI_JSON_HAS_SSE2 1
+#else
+#define BLOCXXI_JSON_HAS_SSE2 0
+#endif
+
+namespace blocxxi::bitcoin {
+namespace {
+
+constexpr auto kBlockSize = std::size_t { 64 };
+
+// One bit per byte of a 64-byte block.
+struct BlockMasks {
+  std::uint64_t backslash { 0 };
+  std::uint64_t quote { 0 };
+  // {, }, [, ], : and ,
+  std::uint64_t structural { 0 };
+  std::uint64_t whitespace { 0 };
+  // Bytes below 0x20, which JSON allows in no string.
+  std::uint64_t control { 0 };
+};
+
+#if BLOCXXI_JSON_HAS_SSE2
+
+auto Classify(char const* block) -> BlockMasks
+{
+  auto masks = BlockMasks {};
+  for (auto lane = std::size_t { 0 }; lane < kBlockSize / 16U; ++lane) {
+    auto const bytes
+      = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + (lane * 16U)));
+    auto const equal
+      = [&bytes](char value) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)); };
+    auto const bits = [lane](__m128i matches) {
+      return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(matches)))
+        << (lane * 16U);
+    };
+    masks.backslash |= bits(equal('\\'));
+    masks.quote |= bits(equal('"'));
+    masks.structural |= bits(_mm_or_si128(
+      _mm_or_si128(_mm_or_si128(equal('{'), equal('}')), _mm_or_si128(equal('['), equal(']'))),
+      _mm_or_si128(equal(':'), equal(','))));
+    masks.whitespace |= bits(_mm_or_si128(
+      _mm_or_si128(equal(' '), equal('\n')), _mm_or_si128(equal('\r'), equal('\t'))));
+    // Unsigned bytes up to 0x1F are those the unsigned maximum leaves alone.
+    auto const limit = _mm_set1_epi8(0x1F);
+    masks.control |= bits(_mm_cmpeq_epi8(_mm_max_epu8(bytes, limit), limit));
+  }
+  return masks;
+}
+
+#else
+
+auto Classify(char const* block) -> BlockMasks
+{
+  auto masks = BlockMasks {};
+  for (auto index = std::size_t { 0 }; index < kBlockSize; ++index) {
+    auto const bit = std::uint64_t { 1 } << index;
+    if (static_cast<unsigned char>(block[index]) < 0x20U) {
+      masks.control |= bit;
+    }
+    switch (block[index]) {
+    case '\\':
+      masks.backslash |= bit;
+      break;
+    case '"':
+      masks.quote |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      masks.structural |= bit;
+      break;
+    case ' ':
+    case '\n':
+    case '\r':
+    case '\t':
+      masks.whitespace |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+  return masks;
+}
+
+#endif // BLOCXXI_JSON_HAS_SSE2
+
+// The bytes escaped by a backslash. A run of backslashes escapes the byte
+// after it when the run is odd, which is found without a loop by adding the
+// runs that start on odd bits to the backslash mask, carrying out into the
+// next block.
+auto FindEscaped(std::uint64_t backslash, std::uint64_t& next_is_escaped) -> std::uint64_t
+{
+  constexpr auto kEvenBits = std::uint64_t { 0x5555555555555555 };
+  backslash &= ~next_is_escaped;
+  auto const follows_escape = (backslash << 1U) | next_is_escaped;
+  auto const odd_sequence_starts = backslash & ~kEvenBits & ~follows_escape;
+  auto const sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+  next_is_escaped = sequences_starting_on_even_bits < backslash ? 1U : 0U;
+  auto const invert_mask = sequences_starting_on_even_bits << 1U;
+  return (kEvenBits ^ invert_mask) & follows_escape;
+}
+
+// Bit `i` is the XOR of bits 0 to `i`, which turns quote positions into the
+// spans between them.
+auto PrefixXor(std::uint64_t bits) -> std::uint64_t
+{
+  for (auto shift = 1U; shift < 64U; shift *= 2U) {
+    bits ^= bits << shift;
+  }
+  return bits;
+}
+
+[[nodiscard]] auto IsWhitespace(char current) -> bool
+{
+  return current == ' ' || current == '\t' || current == '\n' || current == '\r';
+}
+
+[[nodiscard]] auto IsLiteral(std::string_view text) -> bool
+{
+  if (text == "true" || text == "false" || text == "null") {
+    return true;
+  }
+  if (text.empty() || (text.front() != '-' && (text.front() < '0' || text.front() > '9'))) {
+    return false;
+  }
+  return text.find_first_not_of("0123456789+-.eE") == std::string_view::npos;
+}
+
+// Whether the escapes between a string's quotes are ones JSON defines, with
+// every \u surrogate in a pair, as the stream parser requires.
+[[nodiscard]] auto HasValidEscapes(std::string_view raw) -> bool
+{
+  auto pending_high = false;
+  for (auto index = std::size_t { 0 }; index < raw.size(); ++index) {
+    if (raw[index] != '\\') {
+      if (pending_high) {
+        return false;
+      }
+      continue;
+    }
+    // The closing quote is never escaped, so something follows.
+    auto const escape = raw[++index];
+    if (escape != 'u') {
+      if (pending_high || std::string_view(R"("\/bfnrt)").find(escape) == std::string_view::npos) {
+        return false;
+      }
+      continue;
+    }
+    if (raw.size() - index <= 4U) {
+      return false;
+    }
+    auto code = 0U;
+    for (auto const digit : raw.substr(index + 1U, 4U)) {
+      auto const value = digit >= '0' && digit <= '9' ? digit - '0'
+        : digit >= 'a' && digit <= 'f'                ? digit - 'a' + 10
+        : digit >= 'A' && digit <= 'F'                ? digit - 'A' + 10
+                                                      : -1;
+      if (value < 0) {
+        return false;
+      }
+      code = (code << 4U) | static_cast<unsigned>(value);
+    }
+    index += 4U;
+    auto const is_low = code >= 0xDC00U && code <= 0xDFFFU;
+    if (pending_high != is_low) {
+      return false;
+    }
+    pending_high = code >= 0xD800U && code <= 0xDBFFU;
+  }
+  return !pending_high;
+}
+
+// Compares a quoted key with `key`, dropping escapes the way the response
+// parsing does.
+[[nodiscard]] auto KeyEquals(std::string_view quoted, std::string_view key) -> bool
+{
+  auto const raw = quoted.substr(1U, quoted.size() - 2U);
+  if (raw.find('\\') == std::string_view::npos) {
+    return raw == key;
+  }
+  auto matched = std::size_t { 0 };
+  for (auto index = std::size_t { 0 }; index < raw.size(); ++index) {
+    if (raw[index] == '\\') {
+      ++index;
+    }
+    if (matched == key.size() || key[matched] != raw[index]) {
+      return false;
+    }
+    ++matched;
+  }
+  return matched == key.size();
+}
+
+} // namespace
+
+auto BuildStructuralIndex(std::string_view text) -> std::vector<std::uint32_t>
+{
+  auto index = std::vector<std::uint32_t> {};
+  index.reserve(text.size() / 8U);
+  // What carries from one block into the next: whether its first byte is
+  // escaped, whether it starts inside a string (all ones if so), and
+  // whether it starts in the middle of a number or literal.
+  auto next_is_escaped = std::uint64_t { 0 };
+  auto in_string_carry = std::uint64_t { 0 };
+  auto literal_carry = std::uint64_t { 0 };
+  auto padded = std::array<char, kBlockSize> {};
+
+  for (auto offset = std::size_t { 0 }; offset < text.size(); offset += kBlockSize) {
+    auto const* block = text.data() + offset;
+    if (text.size() - offset < kBlockSize) {
+      padded.fill(' ');
+      std::memcpy(padded.data(), block, text.size() - offset);
+      block = padded.data();
+    }
+
+    auto const masks = Classify(block);
+    auto const escaped = FindEscaped(masks.backslash, next_is_escaped);
+    auto const quotes = masks.quote & ~escaped;
+    // Includes the opening quote of each string but not the closing one.
+    auto const in_string = PrefixXor(quotes) ^ in_string_carry;
+    in_string_carry = static_cast<std::uint64_t>(static_cast<std::int64_t>(in_string) >> 63);
+    auto const literal = ~(masks.structural | masks.whitespace | masks.quote) & ~in_string;
+    auto const literal_starts = literal & ~((literal << 1U) | literal_carry);
+    literal_carry = literal >> 63U;
+
+    for (auto bits = (masks.structural & ~in_string) | quotes | literal_starts
+           | (masks.control & in_string);
+         bits != 0U;
+         bits &= bits - 1U) {
+      index.push_back(static_cast<std::uint32_t>(offset + std::countr_zero(bits)));
+    }
+  }
+  return index;
+}
+
+auto JsonTape::Parse(std::string_view text) -> std::optional<JsonTape>
+{
+  if (text.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    return std::nullopt;
+  }
+  auto const index = BuildStructuralIndex(text);
+  // Responses rarely escape anything, so most never look at a string twice.
+  auto const has_escapes = text.find('\\') != std::string_view::npos;
+
+  enum class Expect : std::uint8_t {
+    Value,
+    ValueOrEnd,
+    Key,
+    KeyOrEnd,
+    Colon,
+    CommaOrEnd,
+    Nothing,
+  };
+
+  auto tape = JsonTape {};
+  tape.text_ = text;
+  tape.nodes_.reserve(index.size());
+  auto open = std::vector<std::uint32_t> {};
+  auto expect = Expect::Value;
+  auto const end_value = [&] { expect = open.empty() ? Expect::Nothing : Expect::CommaOrEnd; };
+  auto const next_node = [&tape] { return static_cast<std::uint32_t>(tape.nodes_.size()); };
+
+  for (auto at = std::size_t { 0 }; at < index.size(); ++at) {
+    auto const position = index[at];
+    auto const current = text[position];
+    switch (current) {
+    case '{':
+    case '[':
+      if (expect != Expect::Value && expect != Expect::ValueOrEnd) {
+        return std::nullopt;
+      }
+      open.push_back(next_node());
+      tape.nodes_.push_back(JsonNode {
+        .kind = current == '{' ? JsonKind::Object : JsonKind::Array,
+        .begin = position,
+      });
+      expect = current == '{' ? Expect::KeyOrEnd : Expect::ValueOrEnd;
+      break;
+    case '}':
+    case ']': {
+      auto const kind = current == '}' ? JsonKind::Object : JsonKind::Array;
+      auto const may_end = expect == Expect::CommaOrEnd
+        || expect == (current == '}' ? Expect::KeyOrEnd : Expect::ValueOrEnd);
+      if (!may_end || open.empty() || tape.nodes_[open.back()].kind != kind) {
+        return std::nullopt;
+      }
+      auto& container = tape.nodes_[open.back()];
+      container.end = position + 1U;
+      container.next = next_node();
+      open.pop_back();
+      end_value();
+      break;
+    }
+    case ':':
+      if (expect != Expect::Colon) {
+        return std::nullopt;
+      }
+      expect = Expect::Value;
+      break;
+    case ',':
+      if (expect != Expect::CommaOrEnd) {
+        return std::nullopt;
+      }
+      expect = tape.nodes_[open.back()].kind == JsonKind::Object ? Expect::Key
+                                                                  : Expect::Value;
+      break;
+    case '"': {
+      // Only control characters are indexed inside a string, so its closing
+      // quote is next unless the string holds one.
+      auto const is_key = expect == Expect::Key || expect == Expect::KeyOrEnd;
+      if ((!is_key && expect != Expect::Value && expect != Expect::ValueOrEnd)
+        || at + 1U == index.size()) {
+        return std::nullopt;
+      }
+      auto const close = index[++at];
+      if (text[close] != '"'
+        || (has_escapes && !HasValidEscapes(text.substr(position + 1U, close - position - 1U)))) {
+        return std::nullopt;
+      }
+      tape.nodes_.push_back(JsonNode {
+        .kind = JsonKind::String,
+        .begin = position,
+        .end = close + 1U,
+        .next = next_node() + 1U,
+      });
+      if (is_key) {
+        expect = Expect::Colon;
+      } else {
+        end_value();
+      }
+      break;
+    }
+    default: {
+      if (expect != Expect::Value && expect != Expect::ValueOrEnd) {
+        return std::nullopt;
+      }
+      auto end = at + 1U < index.size() ? std::size_t { index[at + 1U] } : text.size();
+      while (end > position && IsWhitespace(text[end - 1U])) {
+        --end;
+      }
+      if (!IsLiteral(text.substr(position, end - position))) {
+        return std::nullopt;
+      }
+      tape.nodes_.push_back(JsonNode {
+        .kind = JsonKind::Literal,
+        .begin = position,
+        .end = static_cast<std::uint32_t>(end),
+        .next = next_node() + 1U,
+      });
+      end_value();
+      break;
+    }
+    }
+  }
+
+  if (expect != Expect::Nothing) {
+    return std::nullopt;
+  }
+  return tape;
+}
+
+auto JsonTape::Text(std::size_t index) const -> std::string_view
+{
+  auto const& node = nodes_[index];
+  return text_.substr(node.begin, node.end - node.begin);
+}
+
+auto JsonTape::Find(std::size_t object, std::string_view key) const
+  -> std::optional<std::size_t>
+{
+  if (nodes_[object].kind != JsonKind::Object) {
+    return std::nullopt;
+  }
+  for (auto member = object + 1U; member < nodes_[object].next;
+       member = nodes_[member + 1U].next) {
+    if (KeyEquals(Text(member), key)) {
+      return member + 1U;
+    }
+  }
+  return std::nullopt;
+}
+
+auto JsonTape::FindText(std::size_t object, std::string_view key) const
+  -> std::optional<std::string_view>
+{
+  auto const value = Find(object, key);
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  return Text(*value);
+}
+
+auto JsonTape::Children(std::size_t container) const -> std::vector<std::size_t>
+{
+  auto children = std::vector<std::size_t> {};
+  auto const kind = nodes_[container].kind;
+  if (kind != JsonKind::Object && kind != JsonKind::Array) {
+    return children;
+  }
+  for (auto child = container + 1U; child < nodes_[container].next;) {
+    children.push_back(child);
+    child = kind == JsonKind::Object ? nodes_[child + 1U].next : nodes_[child].next;
+  }
+  return children;
+}
+
+} // namespace blocxxi::bitcoin
+// NOLINTEND(portability-simd-intrinsics,*-reinterpret-cast)
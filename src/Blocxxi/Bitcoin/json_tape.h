@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Bitcoin/api_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Two-stage parsing of RPC responses held whole. Not installed; exported for
+// the tests and the benchmark only.
+
+namespace blocxxi::bitcoin {
+
+// Offsets of the structural characters of `text` outside strings, of the
+// quotes around each string, of the control characters inside strings, and
+// of the first character of each number or literal, in order. The text is
+// classified 64 bytes at a time, with SSE2 where available.
+[[nodiscard]] BLOCXXI_BITCOIN_API auto BuildStructuralIndex(std::string_view text)
+  -> std::vector<std::uint32_t>;
+
+enum class JsonKind : std::uint8_t {
+  Object,
+  Array,
+  String,
+  // A number, true, false or null.
+  Literal,
+};
+
+struct JsonNode {
+  JsonKind kind { JsonKind::Literal };
+  // The text of the value, quotes included for a string.
+  std::uint32_t begin { 0 };
+  std::uint32_t end { 0 };
+  // The node after this value and everything in it. The members of an
+  // object are its key and value nodes in turn.
+  std::uint32_t next { 0 };
+};
+
+// A document laid out as one node per value in document order, so that a
+// value is found by following `next` links from its container instead of
+// scanning text.
+class BLOCXXI_BITCOIN_API JsonTape {
+public:
+  // Nothing unless `text` is exactly one JSON value, which must outlive the
+  // tape.
+  [[nodiscard]] static auto Parse(std::string_view text) -> std::optional<JsonTape>;
+
+  [[nodiscard]] auto Root() const -> std::size_t { return 0U; }
+  [[nodiscard]] auto Node(std::size_t index) const -> JsonNode const&
+  {
+    return nodes_[index];
+  }
+  [[nodiscard]] auto Text(std::size_t index) const -> std::string_view;
+
+  // The value of `key` in the object at `object`. Steps over one member at
+  // a time whatever its size.
+  [[nodiscard]] auto Find(std::size_t object, std::string_view key) const
+    -> std::optional<std::size_t>;
+  // The text of the value of `key`, for reading scalars.
+  [[nodiscard]] auto FindText(std::size_t object, std::string_view key) const
+    -> std::optional<std::string_view>;
+
+  // The values of the array or object at `container`; for an object, its
+  // keys.
+  [[nodiscard]] auto Children(std::size_t container) const -> std::vector<std::size_t>;
+
+private:
+  JsonTape() = default;
+
+  std::string_view text_ {};
+  std::vector<JsonNode> nodes_ {};
+};
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,246 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/mapped_file.h>
+
+#include <Nova/Base/Platforms.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+
+#ifdef NOVA_WINDOWS
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/file.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace blocxxi::bitcoin {
+
+auto MapFile(std::filesystem::path const& path, MapAccess access) -> MappedFile
+{
+#ifdef NOVA_WINDOWS
+  auto* file = ::CreateFileW(path.c_str(), GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return {};
+  }
+  auto size = LARGE_INTEGER {};
+  if (::GetFileSizeEx(file, &size) == 0 || size.QuadPart == 0) {
+    ::CloseHandle(file);
+    return {};
+  }
+  auto* mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  ::CloseHandle(file);
+  if (mapping == nullptr) {
+    return {};
+  }
+  auto const* address = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  ::CloseHandle(mapping);
+  if (address == nullptr) {
+    return {};
+  }
+  // Views take no access hint; Windows reads ahead on its own.
+  (void)access;
+  return MappedFile {
+    .mapping = std::shared_ptr<void const>(
+      address, [](void const* view) { ::UnmapViewOfFile(view); }),
+    .bytes = { static_cast<std::uint8_t const*>(address),
+      static_cast<std::size_t>(size.QuadPart) },
+  };
+#else
+  auto const file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0) {
+    return {};
+  }
+  struct stat status {};
+  if (::fstat(file, &status) != 0 || status.st_size <= 0) {
+    ::close(file);
+    return {};
+  }
+  auto const size = static_cast<std::size_t>(status.st_size);
+  auto* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+  ::close(file);
+  if (address == MAP_FAILED) {
+    return {};
+  }
+  if (access == MapAccess::Sequential) {
+    ::madvise(address, size, MADV_SEQUENTIAL);
+  }
+  return MappedFile {
+    .mapping = std::shared_ptr<void const>(
+      address, [size](void const* view) { ::munmap(const_cast<void*>(view), size); }),
+    .bytes = { static_cast<std::uint8_t const*>(address), size },
+  };
+#endif
+}
+
+#ifdef NOVA_WINDOWS
+
+namespace {
+
+[[nodiscard]] auto Overlapped(std::uint64_t offset) -> OVERLAPPED
+{
+  auto overlapped = OVERLAPPED {};
+  overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+  overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+  return overlapped;
+}
+
+} // namespace
+
+LockedFile::LockedFile(std::filesystem::path const& path)
+{
+  auto* file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  auto overlapped = Overlapped(0U);
+  if (::LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) == 0) {
+    ::CloseHandle(file);
+    return;
+  }
+  file_ = reinterpret_cast<std::intptr_t>(file);
+}
+
+LockedFile::~LockedFile()
+{
+  if (IsOpen()) {
+    // Closing the handle releases the lock.
+    ::CloseHandle(reinterpret_cast<HANDLE>(file_));
+  }
+}
+
+auto LockedFile::Size() const -> std::optional<std::uint64_t>
+{
+  auto size = LARGE_INTEGER {};
+  if (!IsOpen() || ::GetFileSizeEx(reinterpret_cast<HANDLE>(file_), &size) == 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::uint64_t>(size.QuadPart);
+}
+
+auto LockedFile::ReadAt(std::uint64_t offset, std::span<std::uint8_t> bytes) const -> bool
+{
+  while (!bytes.empty()) {
+    auto overlapped = Overlapped(offset);
+    auto read = DWORD { 0 };
+    auto const chunk = static_cast<DWORD>(std::min<std::size_t>(bytes.size(), MAXDWORD));
+    if (::ReadFile(reinterpret_cast<HANDLE>(file_), bytes.data(), chunk, &read, &overlapped)
+        == 0
+      || read == 0) {
+      return false;
+    }
+    offset += read;
+    bytes = bytes.subspan(read);
+  }
+  return true;
+}
+
+auto LockedFile::WriteAt(std::uint64_t offset, std::span<std::uint8_t const> bytes) -> bool
+{
+  while (!bytes.empty()) {
+    auto overlapped = Overlapped(offset);
+    auto written = DWORD { 0 };
+    auto const chunk = static_cast<DWORD>(std::min<std::size_t>(bytes.size(), MAXDWORD));
+    if (::WriteFile(
+          reinterpret_cast<HANDLE>(file_), bytes.data(), chunk, &written, &overlapped)
+      == 0) {
+      return false;
+    }
+    offset += written;
+    bytes = bytes.subspan(written);
+  }
+  return true;
+}
+
+#else
+
+LockedFile::LockedFile(std::filesystem::path const& path)
+{
+  auto const file = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (file < 0) {
+    return;
+  }
+  // flock, unlike fcntl locks, belongs to the open file and so also keeps
+  // out other opens of the file in this process.
+  auto locked = ::flock(file, LOCK_EX);
+  while (locked != 0 && errno == EINTR) {
+    locked = ::flock(file, LOCK_EX);
+  }
+  if (locked != 0) {
+    ::close(file);
+    return;
+  }
+  file_ = file;
+}
+
+LockedFile::~LockedFile()
+{
+  if (IsOpen()) {
+    // Closing the descriptor releases the lock.
+    ::close(static_cast<int>(file_));
+  }
+}
+
+auto LockedFile::Size() const -> std::optional<std::uint64_t>
+{
+  struct stat status {};
+  if (!IsOpen() || ::fstat(static_cast<int>(file_), &status) != 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::uint64_t>(status.st_size);
+}
+
+auto LockedFile::ReadAt(std::uint64_t offset, std::span<std::uint8_t> bytes) const -> bool
+{
+  while (!bytes.empty()) {
+    auto const read = ::pread(static_cast<int>(file_), bytes.data(), bytes.size(),
+      static_cast<off_t>(offset));
+    if (read < 0 && errno == EINTR) {
+      continue;
+    }
+    if (read <= 0) {
+      return false;
+    }
+    offset += static_cast<std::uint64_t>(read);
+    bytes = bytes.subspan(static_cast<std::size_t>(read));
+  }
+  return true;
+}
+
+auto LockedFile::WriteAt(std::uint64_t offset, std::span<std::uint8_t const> bytes) -> bool
+{
+  while (!bytes.empty()) {
+    auto const written = ::pwrite(static_cast<int>(file_), bytes.data(), bytes.size(),
+      static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written < 0) {
+      return false;
+    }
+    offset += static_cast<std::uint64_t>(written);
+    bytes = bytes.subspan(static_cast<std::size_t>(written));
+  }
+  return true;
+}
+
+#endif // NOVA_WINDOWS
+
+auto LockedFile::IsOpen() const -> bool
+{
+  return file_ != -1;
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+// Read-only file mappings for the block cache and block file ingestion,
+// and the locked appends of the block cache. Not installed.
+
+namespace blocxxi::bitcoin {
+
+enum class MapAccess : std::uint8_t {
+  Random,
+  // Tells the kernel to read ahead and drop pages behind the reader.
+  Sequential,
+};
+
+// The bytes stay mapped for as long as a copy of `mapping` is held.
+struct MappedFile {
+  std::shared_ptr<void const> mapping {};
+  std::span<std::uint8_t const> bytes {};
+};
+
+// Maps the whole file read-only. A missing or empty file maps to no bytes.
+[[nodiscard]] auto MapFile(
+  std::filesystem::path const& path, MapAccess access = MapAccess::Random)
+  -> MappedFile;
+
+// A file opened for writing, created if missing, and held under an
+// exclusive lock until destroyed. The lock is taken per open, so it keeps
+// out other processes and other LockedFile objects in this one alike.
+class LockedFile {
+public:
+  explicit LockedFile(std::filesystem::path const& path);
+  ~LockedFile();
+
+  LockedFile(LockedFile const&) = delete;
+  auto operator=(LockedFile const&) -> LockedFile& = delete;
+
+  [[nodiscard]] auto IsOpen() const -> bool;
+  [[nodiscard]] auto Size() const -> std::optional<std::uint64_t>;
+  [[nodiscard]] auto ReadAt(std::uint64_t offset, std::span<std::uint8_t> bytes) const
+    -> bool;
+  auto WriteAt(std::uint64_t offset, std::span<std::uint8_t const> bytes) -> bool;
+
+private:
+  // A file descriptor, or a HANDLE on Windows; -1 is invalid for both.
+  std::intptr_t file_ { -1 };
+};
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,484 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/peer_session.h>
+
+#include <Nova/Base/Sha256.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+constexpr auto kInventoryEntrySize = std::size_t { 36 };
+
+// Hashes listed in an inv or notfound payload.
+[[nodiscard]] auto ReadInventoryHashes(std::span<std::uint8_t const> payload)
+  -> std::vector<BlockHash>
+{
+  if (payload.empty()) {
+    return {};
+  }
+  auto count = std::size_t { payload[0] };
+  auto offset = std::size_t { 1 };
+  if (payload[0] == 0xFDU && payload.size() >= 3U) {
+    count = static_cast<std::size_t>(payload[1] | (payload[2] << 8U));
+    offset = 3U;
+  }
+
+  auto hashes = std::vector<BlockHash> {};
+  for (auto index = std::size_t { 0 };
+       index < count && offset + kInventoryEntrySize <= payload.size(); ++index) {
+    hashes.push_back(
+      *BlockHash::FromBytes(payload.subspan(offset + 4U, BlockHash::kSize)));
+    offset += kInventoryEntrySize;
+  }
+  return hashes;
+}
+
+// Completion token that reports failures through `error` instead of
+// throwing from co_await.
+[[nodiscard]] auto Redirect(std::error_code& error)
+{
+  return asio::redirect_error(asio::use_awaitable, error);
+}
+
+// Reads until `buffer` holds a complete message, like ReadMessage.
+auto ReadMessageAsync(TcpSocket& socket, ReceiveBuffer& buffer)
+  -> asio::awaitable<std::optional<MessageView>>
+{
+  while (true) {
+    if (auto message = buffer.Next(); message.has_value() || buffer.Corrupt()) {
+      co_return message;
+    }
+    auto const space = buffer.PrepareRead();
+    auto error = std::error_code {};
+    auto const transferred = co_await socket.async_read_some(
+      asio::buffer(space.data(), space.size()), Redirect(error));
+    if (error) {
+      co_return std::nullopt;
+    }
+    buffer.CommitRead(transferred);
+  }
+}
+
+} // namespace
+
+PeerSession::PeerSession(PeerSessionOptions options)
+  : options_(std::move(options))
+{
+}
+
+PeerSession::~PeerSession()
+{
+  auto lock = std::unique_lock(mutex_);
+  closing_ = true;
+  FailAllLocked(
+    core::Status::Failure(core::StatusCode::IOError, "peer session closed"));
+  DisconnectLocked();
+  lock.unlock();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+auto PeerSession::RequestHeaders(std::span<BlockHash const> locator)
+  -> std::future<PeerReply>
+{
+  return Submit(Request {
+    .kind = RequestKind::Headers,
+    .payload = EncodeGetHeadersPayload(locator),
+  });
+}
+
+auto PeerSession::RequestBlocks(std::span<BlockHash const> block_hashes)
+  -> std::future<PeerReply>
+{
+  return Submit(Request {
+    .kind = RequestKind::Blocks,
+    .payload = EncodeGetDataPayload(block_hashes),
+    .block_hashes = { block_hashes.begin(), block_hashes.end() },
+    .payloads = decltype(Request::payloads)(block_hashes.size()),
+  });
+}
+
+auto PeerSession::Await(std::future<PeerReply>& reply) -> PeerReply
+{
+  while (reply.wait_for(options_.request_timeout) == std::future_status::timeout) {
+    auto lock = std::unique_lock(mutex_);
+    DisconnectLocked();
+  }
+  return reply.get();
+}
+
+auto PeerSession::Reconnects() const -> std::uint32_t
+{
+  auto lock = std::unique_lock(mutex_);
+  return connects_ == 0U ? 0U : connects_ - 1U;
+}
+
+auto PeerSession::Submit(Request request) -> std::future<PeerReply>
+{
+  auto reply = request.promise.get_future();
+  auto lock = std::unique_lock(mutex_);
+  if (closing_) {
+    request.promise.set_value(PeerReply {
+      .status
+      = core::Status::Failure(core::StatusCode::IOError, "peer session closed"),
+    });
+    return reply;
+  }
+
+  pending_.push_back(std::move(request));
+  if (connected_) {
+    SendLocked(pending_.back());
+  }
+  // The session thread stops when a connection drops with nothing left to
+  // send; the next request starts it again.
+  if (!running_) {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    running_ = true;
+    thread_ = std::thread([this] { Run(); });
+  }
+  return reply;
+}
+
+auto PeerSession::Run() -> void
+{
+  auto io_context = asio::io_context {};
+  auto endpoints = std::optional<TcpEndpoints> {};
+  auto failed_attempts = std::uint32_t { 0 };
+  auto buffer = ReceiveBuffer {};
+
+  auto lock = std::unique_lock(mutex_);
+  io_context_ = &io_context;
+  while (!closing_ && !pending_.empty()) {
+    lock.unlock();
+    // Endpoints are resolved again only when none of them would connect.
+    if (!endpoints.has_value()) {
+      endpoints = ResolveEndpoints(io_context, options_.host, options_.port);
+    }
+    auto connected = false;
+    auto socket = TcpSocket(io_context);
+    if (endpoints.has_value()) {
+      asio::co_spawn(io_context,
+        [&]() -> asio::awaitable<void> {
+          connected = co_await Connect(*endpoints, socket, buffer);
+          if (connected) {
+            co_await Serve(socket, buffer);
+          }
+        },
+        asio::detached);
+      io_context.restart();
+      io_context.run();
+    }
+    lock.lock();
+    socket_ = nullptr;
+    connected_ = false;
+    writing_ = false;
+    outbox_.clear();
+    lock.unlock();
+    // Disconnects posted while the connection went down find no socket.
+    io_context.restart();
+    io_context.poll();
+    lock.lock();
+
+    if (!connected) {
+      endpoints.reset();
+      if (++failed_attempts > options_.max_resends) {
+        FailAllLocked(core::Status::Failure(
+          core::StatusCode::IOError, "failed to connect to " + options_.host));
+      }
+      continue;
+    }
+    failed_attempts = 0;
+    // What was outstanding on the dropped connection is sent again on the
+    // next one.
+    for (auto request = pending_.begin(); request != pending_.end();) {
+      auto const current = request++;
+      if (++current->resends > options_.max_resends) {
+        CompleteLocked(current,
+          core::Status::Failure(core::StatusCode::IOError,
+            "connection to " + options_.host + " kept dropping"));
+      }
+    }
+  }
+  io_context_ = nullptr;
+  running_ = false;
+}
+
+// Connects to the first of `endpoints` that completes the version
+// handshake, leaving in `buffer` what was read past it. A connect is given
+// request_timeout; the handshake waits in reads, which Await and the
+// destructor cut short like those of a connected session.
+auto PeerSession::Connect(TcpEndpoints const& endpoints, TcpSocket& socket,
+  ReceiveBuffer& buffer) -> asio::awaitable<bool>
+{
+  for (auto const& endpoint : endpoints) {
+    {
+      auto lock = std::unique_lock(mutex_);
+      if (closing_) {
+        co_return false;
+      }
+      socket_ = &socket;
+      ++sockets_opened_;
+      outbox_.clear();
+      writing_ = false;
+    }
+    auto error = std::error_code {};
+    socket.close(error);
+    // The deadline may expire as the connect completes; `waiting` keeps it
+    // from closing a socket that connected.
+    auto waiting = std::make_shared<bool>(true);
+    auto deadline = asio::steady_timer(socket.get_executor(), options_.request_timeout);
+    deadline.async_wait([&socket, waiting](std::error_code const& expired) {
+      if (!expired && *waiting) {
+        auto ignored = std::error_code {};
+        socket.close(ignored);
+      }
+    });
+    co_await socket.async_connect(endpoint.endpoint(), Redirect(error));
+    *waiting = false;
+    deadline.cancel();
+    if (error) {
+      continue;
+    }
+
+    // Requests are small messages that wait for a reply, which Nagle's
+    // algorithm would hold back.
+    socket.set_option(asio::ip::tcp::no_delay(true), error);
+
+    buffer.Clear();
+    if (co_await Handshake(socket, buffer, endpoint.endpoint().address().to_string())) {
+      co_return true;
+    }
+  }
+  co_return false;
+}
+
+auto PeerSession::Handshake(TcpSocket& socket, ReceiveBuffer& buffer,
+  std::string remote_address) -> asio::awaitable<bool>
+{
+  {
+    auto lock = std::unique_lock(mutex_);
+    QueueLocked("version", EncodeVersionPayload(remote_address, options_.port));
+  }
+
+  auto protocol_version = std::int32_t { 0 };
+  auto handshake_trace = std::vector<std::string> {};
+  auto saw_version = false;
+  auto saw_verack = false;
+  while (!(saw_version && saw_verack)) {
+    auto message = co_await ReadMessageAsync(socket, buffer);
+    if (!message.has_value()) {
+      co_return false;
+    }
+    handshake_trace.emplace_back(message->command);
+
+    auto lock = std::unique_lock(mutex_);
+    if (message->command == "version") {
+      if (message->payload.size() >= sizeof(protocol_version)) {
+        std::memcpy(&protocol_version, message->payload.data(), sizeof(protocol_version));
+      }
+      saw_version = true;
+      QueueLocked("verack", {});
+    } else if (message->command == "ping") {
+      QueueLocked("pong", message->payload);
+    } else if (message->command == "verack") {
+      saw_verack = true;
+    }
+  }
+
+  auto lock = std::unique_lock(mutex_);
+  ++connects_;
+  connected_ = true;
+  peer_address_ = std::move(remote_address);
+  protocol_version_ = protocol_version;
+  for (auto& request : pending_) {
+    request.command_trace.insert(
+      request.command_trace.end(), handshake_trace.begin(), handshake_trace.end());
+    SendLocked(request);
+  }
+  co_return true;
+}
+
+// Reads until the connection drops, then closes it, which also ends a
+// write in progress.
+auto PeerSession::Serve(TcpSocket& socket, ReceiveBuffer& buffer) -> asio::awaitable<void>
+{
+  while (true) {
+    auto message = co_await ReadMessageAsync(socket, buffer);
+    auto lock = std::unique_lock(mutex_);
+    if (!message.has_value() || closing_) {
+      CloseLocked();
+      co_return;
+    }
+    for (auto& request : pending_) {
+      request.command_trace.emplace_back(message->command);
+    }
+    if (message->command == "ping") {
+      QueueLocked("pong", message->payload);
+      continue;
+    }
+    DispatchLocked(*message);
+  }
+}
+
+auto PeerSession::DispatchLocked(MessageView const& message) -> void
+{
+  if (message.command == "headers") {
+    auto const request = std::ranges::find(pending_, RequestKind::Headers, &Request::kind);
+    if (request != pending_.end()) {
+      request->payloads.emplace_back(
+        std::in_place, message.payload.begin(), message.payload.end());
+      CompleteLocked(request, core::Status::Success());
+    }
+    return;
+  }
+
+  if (message.command == "block") {
+    if (message.payload.size() < nova::kSha256dHeaderSize) {
+      return;
+    }
+    auto const hash = BlockHash(nova::ComputeSha256d80(
+      std::as_bytes(message.payload).first<nova::kSha256dHeaderSize>()));
+    for (auto request = pending_.begin(); request != pending_.end(); ++request) {
+      for (auto index = std::size_t { 0 }; index < request->block_hashes.size(); ++index) {
+        if (request->block_hashes[index] != hash || request->payloads[index].has_value()) {
+          continue;
+        }
+        // Only a block that was asked for is copied out of the buffer.
+        request->payloads[index].emplace(message.payload.begin(), message.payload.end());
+        if (++request->payloads_received == request->payloads.size()) {
+          CompleteLocked(request, core::Status::Success());
+        }
+        return;
+      }
+    }
+    return;
+  }
+
+  if (message.command == "notfound") {
+    for (auto const& hash : ReadInventoryHashes(message.payload)) {
+      auto const request = std::ranges::find_if(pending_, [&](Request const& candidate) {
+        return std::ranges::find(candidate.block_hashes, hash) != candidate.block_hashes.end();
+      });
+      if (request != pending_.end()) {
+        CompleteLocked(request,
+          core::Status::Failure(
+            core::StatusCode::NotFound, "peer does not have block " + hash.ToHex()));
+      }
+    }
+  }
+}
+
+auto PeerSession::CompleteLocked(RequestList::iterator request, core::Status status)
+  -> void
+{
+  auto reply = PeerReply {
+    .status = std::move(status),
+    .peer_address = peer_address_,
+    .protocol_version = protocol_version_,
+    .command_trace = std::move(request->command_trace),
+  };
+  if (reply.status.ok()) {
+    reply.payloads.reserve(request->payloads.size());
+    for (auto& payload : request->payloads) {
+      reply.payloads.push_back(std::move(*payload));
+    }
+  }
+  request->promise.set_value(std::move(reply));
+  pending_.erase(request);
+}
+
+auto PeerSession::FailAllLocked(core::Status const& status) -> void
+{
+  while (!pending_.empty()) {
+    CompleteLocked(pending_.begin(), status);
+  }
+}
+
+auto PeerSession::SendLocked(Request const& request) -> void
+{
+  auto const* command = request.kind == RequestKind::Headers ? "getheaders" : "getdata";
+  auto payload = std::span<std::uint8_t const>(request.payload);
+  // Blocks that arrived before a connection dropped are not asked for again.
+  auto missing = std::vector<std::uint8_t> {};
+  if (request.payloads_received > 0U) {
+    auto hashes = std::vector<BlockHash> {};
+    for (auto index = std::size_t { 0 }; index < request.block_hashes.size(); ++index) {
+      if (!request.payloads[index].has_value()) {
+        hashes.push_back(request.block_hashes[index]);
+      }
+    }
+    missing = EncodeGetDataPayload(hashes);
+    payload = missing;
+  }
+  QueueLocked(command, payload);
+}
+
+auto PeerSession::QueueLocked(
+  std::string_view command, std::span<std::uint8_t const> payload) -> void
+{
+  outbox_.push_back(EncodeMessage(command, payload));
+  asio::post(*io_context_, [this] {
+    auto lock = std::unique_lock(mutex_);
+    WriteLocked();
+  });
+}
+
+// Session thread only. Writes the outbox one message at a time; a failed
+// write closes the socket, which fails the read and so reconnects.
+auto PeerSession::WriteLocked() -> void
+{
+  if (writing_ || outbox_.empty() || socket_ == nullptr) {
+    return;
+  }
+  writing_ = true;
+  asio::async_write(*socket_, asio::buffer(outbox_.front()),
+    [this, opened = sockets_opened_](std::error_code const& error, std::size_t /*written*/) {
+      auto lock = std::unique_lock(mutex_);
+      if (opened != sockets_opened_) {
+        // Written to a socket given up since; the outbox is the next one's.
+        return;
+      }
+      writing_ = false;
+      outbox_.pop_front();
+      if (error) {
+        CloseLocked();
+        return;
+      }
+      WriteLocked();
+    });
+}
+
+// Session thread only.
+auto PeerSession::CloseLocked() -> void
+{
+  if (socket_ != nullptr) {
+    auto error = std::error_code {};
+    socket_->close(error);
+  }
+}
+
+// Closing the socket on the session thread ends the connect, handshake or
+// read running there.
+auto PeerSession::DisconnectLocked() -> void
+{
+  if (socket_ != nullptr) {
+    asio::post(*io_context_, [this] {
+      auto lock = std::unique_lock(mutex_);
+      CloseLocked();
+    });
+  }
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,145 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <Blocxxi/Bitcoin/api_export.h>
+#include <Blocxxi/Bitcoin/hashes.h>
+#include <Blocxxi/Bitcoin/wire.h>
+#include <Blocxxi/Core/result.h>
+
+// A connection to one peer kept open across requests. Used by the live
+// signet client. Not installed; exported for the tests only.
+
+namespace blocxxi::bitcoin {
+
+struct PeerSessionOptions {
+  std::string host {};
+  std::uint16_t port { 38333 };
+  // A request unanswered for this long drops the connection, and is sent
+  // again on the next one. Connecting and the handshake are bounded by it
+  // too.
+  std::chrono::milliseconds request_timeout { 30000 };
+  // Times one request is sent again after its connection dropped, and
+  // connection attempts in a row, before requests fail.
+  std::uint32_t max_resends { 3 };
+};
+
+struct PeerReply {
+  core::Status status {};
+  std::string peer_address {};
+  std::int32_t protocol_version { 0 };
+  // Commands read while the request was outstanding, including the
+  // handshake of a connection made for it.
+  std::vector<std::string> command_trace {};
+  // The headers payload, or the block payloads in request order.
+  std::vector<std::vector<std::uint8_t>> payloads {};
+};
+
+// Connects on the first request and then stays connected: a background
+// thread answers pings and hands each reply to the request it answers, so
+// requests from several threads share the connection. Only that thread
+// touches the socket; requests are queued for it to write. When the connection
+// drops, the next one is made with the same resolved endpoints and the
+// outstanding requests are sent again.
+class BLOCXXI_BITCOIN_API PeerSession {
+public:
+  explicit PeerSession(PeerSessionOptions options);
+  ~PeerSession();
+
+  PeerSession(PeerSession const&) = delete;
+  auto operator=(PeerSession const&) -> PeerSession& = delete;
+
+  // Peers answer getheaders in the order it was sent, which is how replies
+  // are matched to these requests.
+  auto RequestHeaders(std::span<BlockHash const> locator) -> std::future<PeerReply>;
+  // Fails with NotFound when the peer does not have one of the blocks.
+  auto RequestBlocks(std::span<BlockHash const> block_hashes) -> std::future<PeerReply>;
+  // Waits for `reply`, dropping the connection each time request_timeout
+  // passes without it.
+  auto Await(std::future<PeerReply>& reply) -> PeerReply;
+
+  // Connections made after the first one.
+  [[nodiscard]] auto Reconnects() const -> std::uint32_t;
+
+private:
+  enum class RequestKind : std::uint8_t {
+    Headers,
+    Blocks,
+  };
+
+  struct Request {
+    RequestKind kind { RequestKind::Headers };
+    std::vector<std::uint8_t> payload {};
+    std::vector<BlockHash> block_hashes {};
+    // The headers payload once received, or one slot per requested block.
+    std::vector<std::optional<std::vector<std::uint8_t>>> payloads {};
+    std::size_t payloads_received { 0 };
+    std::uint32_t resends { 0 };
+    std::vector<std::string> command_trace {};
+    std::promise<PeerReply> promise {};
+  };
+  using RequestList = std::list<Request>;
+
+  auto Submit(Request request) -> std::future<PeerReply>;
+  auto Run() -> void;
+  auto Connect(TcpEndpoints const& endpoints, TcpSocket& socket, ReceiveBuffer& buffer)
+    -> asio::awaitable<bool>;
+  auto Handshake(TcpSocket& socket, ReceiveBuffer& buffer, std::string remote_address)
+    -> asio::awaitable<bool>;
+  auto Serve(TcpSocket& socket, ReceiveBuffer& buffer) -> asio::awaitable<void>;
+  auto DispatchLocked(MessageView const& message) -> void;
+  auto CompleteLocked(RequestList::iterator request, core::Status status) -> void;
+  auto FailAllLocked(core::Status const& status) -> void;
+  auto SendLocked(Request const& request) -> void;
+  auto QueueLocked(std::string_view command, std::span<std::uint8_t const> payload) -> void;
+  auto WriteLocked() -> void;
+  auto CloseLocked() -> void;
+  auto DisconnectLocked() -> void;
+
+  PeerSessionOptions options_;
+
+  mutable std::mutex mutex_ {};
+  // Outstanding requests, in the order they were sent.
+  RequestList pending_ {};
+  // Set while the session thread runs. Other threads reach the socket only
+  // by posting to it.
+  asio::io_context* io_context_ { nullptr };
+  // Set from the first connect of an attempt until its connection drops.
+  // Only the session thread uses the socket.
+  TcpSocket* socket_ { nullptr };
+  // Set once the handshake completed, from when requests are sent.
+  bool connected_ { false };
+  // Encoded messages for the session thread to write, front first; the
+  // front one is being written while `writing_` is set.
+  std::deque<std::vector<std::uint8_t>> outbox_ {};
+  bool writing_ { false };
+  // Counts sockets opened, so that a write completing after its socket was
+  // given up leaves the outbox alone.
+  std::uint64_t sockets_opened_ { 0 };
+  std::string peer_address_ {};
+  std::int32_t protocol_version_ { 0 };
+  std::uint32_t connects_ { 0 };
+  bool running_ { false };
+  bool closing_ { false };
+  std::thread thread_ {};
+};
+
+} // namespace blocxxi::bitcoin
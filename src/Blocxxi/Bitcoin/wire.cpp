@@ -0,0 +1,333 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Bitcoin/wire.h>
+
+#include <Nova/Base/Sha256.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace blocxxi::bitcoin {
+namespace {
+
+[[nodiscard]] auto ToBytes(std::string_view text) -> std::vector<std::uint8_t>
+{
+  return std::vector<std::uint8_t>(text.begin(), text.end());
+}
+
+[[nodiscard]] auto DoubleSha256(std::span<std::uint8_t const> payload)
+  -> std::array<std::uint8_t, 32>
+{
+  return nova::ComputeSha256d(std::as_bytes(payload));
+}
+
+auto AppendLittleEndian(
+  std::vector<std::uint8_t>& out, std::uint64_t value, std::size_t width) -> void
+{
+  for (auto index = std::size_t { 0 }; index < width; ++index) {
+    out.push_back(static_cast<std::uint8_t>((value >> (index * 8U)) & 0xFFU));
+  }
+}
+
+auto AppendCompactSize(std::vector<std::uint8_t>& out, std::uint64_t value)
+  -> void
+{
+  if (value < 253U) {
+    out.push_back(static_cast<std::uint8_t>(value));
+    return;
+  }
+  if (value <= 0xFFFFU) {
+    out.push_back(0xFD);
+    AppendLittleEndian(out, value, 2U);
+    return;
+  }
+  if (value <= 0xFFFFFFFFU) {
+    out.push_back(0xFE);
+    AppendLittleEndian(out, value, 4U);
+    return;
+  }
+  out.push_back(0xFF);
+  AppendLittleEndian(out, value, 8U);
+}
+
+// Below this much room behind the unread bytes, they move to the front
+// before the next read.
+constexpr auto kMinReadSize = kReceiveBufferSize / 4U;
+
+} // namespace
+
+auto EncodeMessage(
+  std::string_view command, std::span<std::uint8_t const> payload) -> std::vector<std::uint8_t>
+{
+  auto message = std::vector<std::uint8_t> {};
+  message.insert(message.end(), kSignetMagic.begin(), kSignetMagic.end());
+
+  auto padded_command = std::array<std::uint8_t, 12> {};
+  auto const command_bytes = ToBytes(command);
+  std::copy(command_bytes.begin(), command_bytes.end(), padded_command.begin());
+  message.insert(message.end(), padded_command.begin(), padded_command.end());
+
+  AppendLittleEndian(message, payload.size(), 4U);
+  auto const checksum = DoubleSha256(payload);
+  message.insert(message.end(), checksum.begin(), checksum.begin() + 4U);
+  message.insert(message.end(), payload.begin(), payload.end());
+  return message;
+}
+
+auto EncodeVersionPayload(std::string const& remote_address,
+  std::uint16_t remote_port) -> std::vector<std::uint8_t>
+{
+  auto payload = std::vector<std::uint8_t> {};
+  auto const now = static_cast<std::uint64_t>(std::time(nullptr));
+  auto const user_agent = std::string_view { "/blocxxi:0.1.0/" };
+
+  AppendLittleEndian(payload, static_cast<std::uint32_t>(kProtocolVersion), 4U);
+  AppendLittleEndian(payload, 0U, 8U);
+  AppendLittleEndian(payload, now, 8U);
+
+  auto append_network_address =
+    [&](std::string const& host, std::uint16_t port) {
+      AppendLittleEndian(payload, 0U, 8U);
+      auto const address = asio::ip::make_address(host);
+      if (address.is_v4()) {
+        payload.insert(payload.end(), 10U, 0U);
+        payload.push_back(0xFF);
+        payload.push_back(0xFF);
+        auto const bytes = address.to_v4().to_bytes();
+        payload.insert(payload.end(), bytes.begin(), bytes.end());
+      } else {
+        auto const bytes = address.to_v6().to_bytes();
+        payload.insert(payload.end(), bytes.begin(), bytes.end());
+      }
+      payload.push_back(static_cast<std::uint8_t>((port >> 8U) & 0xFFU));
+      payload.push_back(static_cast<std::uint8_t>(port & 0xFFU));
+    };
+
+  append_network_address(remote_address, remote_port);
+  append_network_address("0.0.0.0", 0U);
+  AppendLittleEndian(payload, 0x12345678ABCDEF00ULL, 8U);
+  AppendCompactSize(payload, user_agent.size());
+  payload.insert(payload.end(), user_agent.begin(), user_agent.end());
+  AppendLittleEndian(payload, 0U, 4U);
+  payload.push_back(0U);
+  return payload;
+}
+
+auto EncodeGetHeadersPayload(std::span<BlockHash const> locator)
+  -> std::vector<std::uint8_t>
+{
+  auto payload = std::vector<std::uint8_t> {};
+  payload.reserve(4U + 9U + ((locator.size() + 1U) * BlockHash::kSize));
+  AppendLittleEndian(payload, static_cast<std::uint32_t>(kProtocolVersion), 4U);
+  AppendCompactSize(payload, locator.size());
+  for (auto const& hash : locator) {
+    payload.insert(payload.end(), hash.Data().begin(), hash.Data().end());
+  }
+  payload.insert(payload.end(), 32U, 0U);
+  return payload;
+}
+
+auto EncodeGetDataPayload(std::span<BlockHash const> block_hashes)
+  -> std::vector<std::uint8_t>
+{
+  auto payload = std::vector<std::uint8_t> {};
+  payload.reserve(9U + (block_hashes.size() * (4U + BlockHash::kSize)));
+  AppendCompactSize(payload, block_hashes.size());
+  for (auto const& hash : block_hashes) {
+    AppendLittleEndian(payload, 2U, 4U); // MSG_BLOCK
+    payload.insert(payload.end(), hash.Data().begin(), hash.Data().end());
+  }
+  return payload;
+}
+
+auto DecodeMessageHeader(std::span<std::uint8_t const, kMessageHeaderSize> bytes)
+  -> std::optional<MessageHeader>
+{
+  if (!std::equal(kSignetMagic.begin(), kSignetMagic.end(), bytes.begin())) {
+    return std::nullopt;
+  }
+
+  auto header = MessageHeader {};
+  for (auto index = std::size_t { 4U }; index < 16U && bytes[index] != 0U; ++index) {
+    header.command.push_back(static_cast<char>(bytes[index]));
+  }
+  std::memcpy(&header.payload_size, bytes.data() + 16U, sizeof(header.payload_size));
+  if (header.payload_size > kMaxMessageSize) {
+    return std::nullopt;
+  }
+  std::copy(bytes.begin() + 20U, bytes.end(), header.checksum.begin());
+  return header;
+}
+
+auto ChecksumMatches(MessageHeader const& header, std::span<std::uint8_t const> payload)
+  -> bool
+{
+  auto const checksum = DoubleSha256(payload);
+  return std::equal(header.checksum.begin(), header.checksum.end(), checksum.begin());
+}
+
+ReceiveBuffer::ReceiveBuffer(std::size_t capacity)
+  : bytes_(std::max(capacity, kMessageHeaderSize))
+{
+}
+
+auto ReceiveBuffer::Next() -> std::optional<MessageView>
+{
+  if (corrupt_ || end_ - begin_ < kMessageHeaderSize) {
+    return std::nullopt;
+  }
+  auto const available = std::span<std::uint8_t const>(bytes_).subspan(begin_, end_ - begin_);
+  auto const header = DecodeMessageHeader(available.first<kMessageHeaderSize>());
+  if (!header.has_value()) {
+    corrupt_ = true;
+    return std::nullopt;
+  }
+  auto const size = kMessageHeaderSize + header->payload_size;
+  if (available.size() < size) {
+    return std::nullopt;
+  }
+  auto const payload = available.subspan(kMessageHeaderSize, header->payload_size);
+  if (!ChecksumMatches(*header, payload)) {
+    corrupt_ = true;
+    return std::nullopt;
+  }
+
+  begin_ += size;
+  auto const* command = reinterpret_cast<char const*>(available.data() + 4U);
+  return MessageView {
+    .command = std::string_view(command, header->command.size()),
+    .payload = payload,
+  };
+}
+
+auto ReceiveBuffer::PrepareRead() -> std::span<std::uint8_t>
+{
+  if (begin_ == end_) {
+    begin_ = 0;
+    end_ = 0;
+  }
+  auto const needed = FrontMessageSize();
+  if (begin_ > 0U
+    && (bytes_.size() - begin_ < needed || bytes_.size() - end_ < kMinReadSize)) {
+    std::memmove(bytes_.data(), bytes_.data() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  if (bytes_.size() - begin_ < needed) {
+    bytes_.resize(begin_ + needed);
+  }
+  if (end_ == bytes_.size()) {
+    bytes_.resize(bytes_.size() + kMinReadSize);
+  }
+  return std::span(bytes_).subspan(end_);
+}
+
+auto ReceiveBuffer::CommitRead(std::size_t size) -> void
+{
+  end_ = std::min(end_ + size, bytes_.size());
+}
+
+auto ReceiveBuffer::Clear() -> void
+{
+  begin_ = 0;
+  end_ = 0;
+  corrupt_ = false;
+}
+
+auto ReceiveBuffer::FrontMessageSize() const -> std::size_t
+{
+  if (end_ - begin_ < kMessageHeaderSize) {
+    return kMessageHeaderSize;
+  }
+  auto const header = DecodeMessageHeader(
+    std::span<std::uint8_t const>(bytes_).subspan(begin_).first<kMessageHeaderSize>());
+  return header.has_value() ? kMessageHeaderSize + header->payload_size : kMessageHeaderSize;
+}
+
+auto ReadMessage(TcpSocket& socket, ReceiveBuffer& buffer) -> std::optional<MessageView>
+{
+  while (true) {
+    if (auto message = buffer.Next(); message.has_value() || buffer.Corrupt()) {
+      return message;
+    }
+    auto const space = buffer.PrepareRead();
+    auto error = std::error_code {};
+    auto const transferred
+      = socket.read_some(asio::buffer(space.data(), space.size()), error);
+    if (error) {
+      return std::nullopt;
+    }
+    buffer.CommitRead(transferred);
+  }
+}
+
+auto SendMessage(
+  TcpSocket& socket, std::string_view command, std::span<std::uint8_t const> payload)
+  -> bool
+{
+  auto const message = EncodeMessage(command, payload);
+  auto error = std::error_code {};
+  asio::write(socket, asio::buffer(message), error);
+  return !error;
+}
+
+auto ResolveEndpoints(asio::io_context& io_context, std::string const& host,
+  std::uint16_t port) -> std::optional<TcpEndpoints>
+{
+  auto resolver = asio::ip::tcp::resolver(io_context);
+  auto error = std::error_code {};
+  auto endpoints
+    = resolver.resolve(host, std::to_string(static_cast<unsigned int>(port)), error);
+  if (error) {
+    return std::nullopt;
+  }
+  return endpoints;
+}
+
+auto CompleteVersionHandshake(TcpSocket& socket, ReceiveBuffer& buffer,
+  std::string const& remote_address, std::uint16_t port, std::int32_t& protocol_version,
+  std::vector<std::string>& command_trace) -> bool
+{
+  auto const version = EncodeVersionPayload(remote_address, port);
+  if (!SendMessage(socket, "version", version)) {
+    return false;
+  }
+
+  auto saw_version = false;
+  auto saw_verack = false;
+  while (!(saw_version && saw_verack)) {
+    auto message = ReadMessage(socket, buffer);
+    if (!message.has_value()) {
+      return false;
+    }
+    command_trace.emplace_back(message->command);
+
+    if (message->command == "version") {
+      if (message->payload.size() >= sizeof(protocol_version)) {
+        std::memcpy(&protocol_version, message->payload.data(), sizeof(protocol_version));
+      }
+      saw_version = true;
+      if (!SendMessage(socket, "verack", std::span<std::uint8_t const> {})) {
+        return false;
+      }
+      continue;
+    }
+    if (message->command == "ping") {
+      if (!SendMessage(socket, "pong", message->payload)) {
+        return false;
+      }
+      continue;
+    }
+    if (message->command == "verack") {
+      saw_verack = true;
+    }
+  }
+  return true;
+}
+
+} // namespace blocxxi::bitcoin
@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio.hpp>
+
+#include <Blocxxi/Bitcoin/hashes.h>
+
+// Message framing and the version handshake of the Bitcoin P2P protocol,
+// over blocking sockets. Shared by the live signet clients; not installed.
+
+namespace blocxxi::bitcoin {
+
+inline constexpr auto kProtocolVersion = std::int32_t { 70016 };
+// A peer answers getheaders with at most this many headers; a full batch
+// means it has more.
+inline constexpr auto kMaxHeadersPerMessage = std::size_t { 2000 };
+inline constexpr auto kSignetMagic
+  = std::array<std::uint8_t, 4> { 0x0a, 0x03, 0xcf, 0x40 };
+
+inline constexpr auto kMessageHeaderSize = std::size_t { 24 };
+// Larger payloads are refused before they are read; no valid message,
+// blocks included, comes near it.
+inline constexpr auto kMaxMessageSize = std::uint32_t { 4 * 1000 * 1000 };
+
+using TcpSocket = asio::ip::tcp::socket;
+using TcpEndpoints = asio::ip::tcp::resolver::results_type;
+
+struct DecodedMessage {
+  std::string command {};
+  std::vector<std::uint8_t> payload {};
+};
+
+struct MessageHeader {
+  std::string command {};
+  std::uint32_t payload_size { 0 };
+  std::array<std::uint8_t, 4> checksum {};
+};
+
+// Returns nothing for a message of another network or one that is too large.
+[[nodiscard]] auto DecodeMessageHeader(
+  std::span<std::uint8_t const, kMessageHeaderSize> bytes) -> std::optional<MessageHeader>;
+[[nodiscard]] auto ChecksumMatches(
+  MessageHeader const& header, std::span<std::uint8_t const> payload) -> bool;
+
+// A message framed in place in a ReceiveBuffer.
+struct MessageView {
+  std::string_view command {};
+  std::span<std::uint8_t const> payload {};
+
+  // Copies the message out, for a caller that keeps it.
+  [[nodiscard]] auto ToOwned() const -> DecodedMessage
+  {
+    return { std::string(command), { payload.begin(), payload.end() } };
+  }
+};
+
+inline constexpr auto kReceiveBufferSize = std::size_t { 256 * 1024 };
+
+// The receive side of one connection. Reads go into one buffer in large
+// chunks, and messages are framed and checked where they lie. The unread
+// tail moves to the front when too little room is left behind it, so a
+// message is always contiguous; a message larger than the buffer grows it.
+class ReceiveBuffer {
+public:
+  explicit ReceiveBuffer(std::size_t capacity = kReceiveBufferSize);
+
+  // Frames and consumes the next complete message. Returns nothing until
+  // more bytes arrive, and for good once the stream is corrupt. Views stay
+  // valid until the next PrepareRead() or Clear().
+  [[nodiscard]] auto Next() -> std::optional<MessageView>;
+  // A message had a bad magic, size or checksum.
+  [[nodiscard]] auto Corrupt() const -> bool { return corrupt_; }
+
+  // Room for the next read, at least enough for the rest of the message
+  // being received.
+  [[nodiscard]] auto PrepareRead() -> std::span<std::uint8_t>;
+  auto CommitRead(std::size_t size) -> void;
+  auto Clear() -> void;
+
+private:
+  // Size of the message at the front, header included, once its header is
+  // in; kMessageHeaderSize before.
+  [[nodiscard]] auto FrontMessageSize() const -> std::size_t;
+
+  std::vector<std::uint8_t> bytes_;
+  std::size_t begin_ { 0 };
+  std::size_t end_ { 0 };
+  bool corrupt_ { false };
+};
+
+[[nodiscard]] auto EncodeMessage(
+  std::string_view command, std::span<std::uint8_t const> payload)
+  -> std::vector<std::uint8_t>;
+[[nodiscard]] auto EncodeVersionPayload(std::string const& remote_address,
+  std::uint16_t remote_port) -> std::vector<std::uint8_t>;
+[[nodiscard]] auto EncodeGetHeadersPayload(std::span<BlockHash const> locator)
+  -> std::vector<std::uint8_t>;
+[[nodiscard]] auto EncodeGetDataPayload(std::span<BlockHash const> block_hashes)
+  -> std::vector<std::uint8_t>;
+
+// Reads until `buffer` holds a complete message, checking its magic and
+// checksum. Returns nothing when the connection fails or the stream is
+// corrupt.
+auto ReadMessage(TcpSocket& socket, ReceiveBuffer& buffer) -> std::optional<MessageView>;
+auto SendMessage(
+  TcpSocket& socket, std::string_view command, std::span<std::uint8_t const> payload)
+  -> bool;
+
+auto ResolveEndpoints(asio::io_context& io_context, std::string const& host,
+  std::uint16_t port) -> std::optional<TcpEndpoints>;
+
+// Messages the peer sends after its verack are left in `buffer`.
+auto CompleteVersionHandshake(TcpSocket& socket, ReceiveBuffer& buffer,
+  std::string const& remote_address, std::uint16_t port, std::int32_t& protocol_version,
+  std::vector<std::string>& command_trace) -> bool;
+
+} // namespace blocxxi::bitcoin
@@ -6,6 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <Blocxxi/Chain/kernel.h>
 
 namespace blocxxi::chain {
@@ -85,4 +88,68 @@ TEST(ChainKernelTest, CommitPendingAdvancesTheLocalChain)
   EXPECT_TRUE(kernel.PendingTransactions().empty());
 }
 
+TEST(ChainKernelTest, CommitPendingCommitsToTheRootOfWhatIsLeftPending)
+{
+  auto blocks = std::make_shared<MemoryBlockStore>();
+  auto snapshots = std::make_shared<MemorySnapshotStore>();
+  auto kernel = Kernel(core::ChainConfig {}, blocks, snapshots);
+  ASSERT_TRUE(kernel.Bootstrap().ok());
+
+  auto transactions = std::vector<core::Transaction> {};
+  for (auto index = 0; index < 5; ++index) {
+    transactions.push_back(
+      core::Transaction::FromText("demo.tx", "payload-" + std::to_string(index)));
+    ASSERT_TRUE(kernel.SubmitTransaction(transactions.back()).ok());
+  }
+  // A block from elsewhere takes the second pending transaction.
+  ASSERT_TRUE(kernel.CommitBlock(core::Block::MakeNext(kernel.Snapshot().head_id, 1,
+    { transactions[1] }, "unit-test")).ok());
+  ASSERT_EQ(kernel.PendingTransactions().size(), 4U);
+
+  ASSERT_TRUE(kernel.CommitPending("unit-test").ok());
+  auto const head = kernel.Head();
+  ASSERT_TRUE(head.has_value());
+  EXPECT_EQ(head->transactions.size(), 4U);
+  EXPECT_EQ(head->header.merkle_root, head->ComputeMerkleRoot());
+}
+
+TEST(ChainKernelTest, SubmitTransactionRejectsMismatchedId)
+{
+  auto blocks = std::make_shared<MemoryBlockStore>();
+  auto snapshots = std::make_shared<MemorySnapshotStore>();
+  auto kernel = Kernel(core::ChainConfig {}, blocks, snapshots);
+  ASSERT_TRUE(kernel.Bootstrap().ok());
+
+  auto forged = core::Transaction::FromText("demo.tx", "payload");
+  forged.payload = core::ToBytes("other");
+
+  EXPECT_EQ(kernel.SubmitTransaction(forged).code, core::StatusCode::Rejected);
+  EXPECT_TRUE(kernel.PendingTransactions().empty());
+  ASSERT_TRUE(kernel.SubmitTransaction(
+    core::Transaction::FromText("demo.tx", "payload")).ok());
+  EXPECT_TRUE(kernel.CommitPending("unit-test").ok());
+}
+
+TEST(ChainKernelTest, CommitBlockRejectsBrokenHeaderCommitments)
+{
+  auto blocks = std::make_shared<MemoryBlockStore>();
+  auto snapshots = std::make_shared<MemorySnapshotStore>();
+  auto kernel = Kernel(core::ChainConfig {}, blocks, snapshots);
+  ASSERT_TRUE(kernel.Bootstrap().ok());
+
+  auto block = core::Block::MakeNext(kernel.Snapshot().head_id, 1,
+    { core::Transaction::FromText("demo.tx", "payload") }, "unit-test");
+  auto swapped = block;
+  swapped.transactions.front() = core::Transaction::FromText("demo.tx", "other");
+  auto forged = block;
+  forged.transactions.front().payload = core::ToBytes("other");
+  auto renamed = block;
+  renamed.header.source = "someone-else";
+
+  EXPECT_EQ(kernel.CommitBlock(swapped).code, core::StatusCode::Rejected);
+  EXPECT_EQ(kernel.CommitBlock(forged).code, core::StatusCode::Rejected);
+  EXPECT_EQ(kernel.CommitBlock(renamed).code, core::StatusCode::Rejected);
+  EXPECT_TRUE(kernel.CommitBlock(block).ok());
+}
+
 } // namespace blocxxi::chain
@@ -9,6 +9,44 @@
 #include <algorithm>
 
 namespace blocxxi::chain {
+namespace {
+
+// Checks that the header commits to exactly the transactions it carries.
+[[nodiscard]] auto ValidateCommitments(core::Block const& block) -> core::Status
+{
+  for (auto const& transaction : block.transactions) {
+    if (!(transaction.id == transaction.ComputeId())) {
+      return core::Status::Failure(
+        core::StatusCode::Rejected, "transaction id does not match its contents");
+    }
+  }
+  if (block.header.transaction_count != block.transactions.size()) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "block transaction count does not match its body");
+  }
+  if (!(block.header.merkle_root == block.ComputeMerkleRoot())) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "block merkle root does not match its transactions");
+  }
+  if (!(block.header.id == block.header.ComputeId())) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "block id does not match its header");
+  }
+  return core::Status::Success();
+}
+
+} // namespace
+
+auto BlockStore::ProveInclusion(core::BlockId const& block_id,
+  core::TransactionId const& transaction_id) const
+  -> std::optional<core::MerkleProof>
+{
+  auto const block = GetBlock(block_id);
+  if (!block) {
+    return std::nullopt;
+  }
+  return block->ProveInclusion(transaction_id);
+}
 
 auto BasicBlockValidator::Validate(core::Block const& block,
   core::ChainSnapshot const& snapshot) const -> core::Status
@@ -23,6 +61,10 @@ auto BasicBlockValidator::Validate(core::Block const& block,
       core::StatusCode::InvalidArgument, "non-genesis blocks require transactions");
   }
 
+  if (auto status = ValidateCommitments(block); !status.ok()) {
+    return status;
+  }
+
   if (!snapshot.bootstrapped) {
     if (block.header.height != 0) {
       return core::Status::Failure(
@@ -90,6 +132,12 @@ auto Kernel::SubmitTransaction(core::Transaction transaction) -> core::Status
     return core::Status::Failure(
       core::StatusCode::InvalidArgument, "transaction payload is required");
   }
+  // Caught here rather than at commit, where it would fail every block
+  // built from the pending set.
+  if (!(transaction.id == transaction.ComputeId())) {
+    return core::Status::Failure(
+      core::StatusCode::Rejected, "transaction id does not match its contents");
+  }
 
   auto const duplicate = std::ranges::find_if(pending_transactions_,
     [&](auto const& pending) { return pending.id == transaction.id; });
@@ -98,6 +146,7 @@ auto Kernel::SubmitTransaction(core::Transaction transaction) -> core::Status
       core::StatusCode::Duplicate, "transaction already pending");
   }
 
+  pending_root_.Append(transaction.id);
   pending_transactions_.push_back(std::move(transaction));
   return core::Status::Success();
 }
@@ -124,6 +173,12 @@ auto Kernel::CommitBlock(core::Block block) -> core::Status
           [&](auto const& committed) { return committed.id == pending.id; });
       }),
     pending_transactions_.end());
+  if (pending_root_.Size() != pending_transactions_.size()) {
+    pending_root_.Clear();
+    for (auto const& pending : pending_transactions_) {
+      pending_root_.Append(pending.id);
+    }
+  }
 
   if (auto status = snapshot_store_->Save(snapshot_); !status.ok()) {
     return status;
@@ -140,7 +195,7 @@ auto Kernel::CommitPending(std::string source) -> core::Status
 
   auto block = core::Block::MakeNext(
     snapshot_.head_id, snapshot_.bootstrapped ? snapshot_.height + 1 : 0,
-    pending_transactions_, std::move(source));
+    pending_transactions_, pending_root_.Root(), std::move(source));
   return CommitBlock(std::move(block));
 }
 
@@ -157,4 +212,11 @@ auto Kernel::Chain() const -> std::vector<core::Block>
   return block_store_->GetChain();
 }
 
+auto Kernel::ProveInclusion(core::BlockId const& block_id,
+  core::TransactionId const& transaction_id) const
+  -> std::optional<core::MerkleProof>
+{
+  return block_store_->ProveInclusion(block_id, transaction_id);
+}
+
 } // namespace blocxxi::chain
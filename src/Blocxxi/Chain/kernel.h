@@ -25,6 +25,13 @@ public:
   [[nodiscard]] virtual auto GetBlock(core::BlockId const& id) const
     -> std::optional<core::Block> = 0;
   [[nodiscard]] virtual auto GetChain() const -> std::vector<core::Block> = 0;
+
+  // Loads the block and rehashes its whole tree. Stores override this to serve
+  // proofs from cached tree levels.
+  [[nodiscard]] BLOCXXI_CHAIN_API virtual auto ProveInclusion(
+    core::BlockId const& block_id,
+    core::TransactionId const& transaction_id) const
+    -> std::optional<core::MerkleProof>;
 };
 
 class SnapshotStore {
@@ -82,6 +89,10 @@ public:
     -> std::optional<core::Block>;
   [[nodiscard]] BLOCXXI_CHAIN_API auto Chain() const
     -> std::vector<core::Block>;
+  [[nodiscard]] BLOCXXI_CHAIN_API auto ProveInclusion(
+    core::BlockId const& block_id,
+    core::TransactionId const& transaction_id) const
+    -> std::optional<core::MerkleProof>;
 
 private:
   core::ChainConfig config_;
@@ -90,6 +101,9 @@ private:
   std::shared_ptr<BlockValidator> validator_;
   core::ChainSnapshot snapshot_ {};
   std::vector<core::Transaction> pending_transactions_ {};
+  // Root over the ids of pending_transactions_, grown as they are submitted
+  // so that CommitPending() does not rehash them.
+  core::MerkleAccumulator pending_root_ {};
 };
 
 } // namespace blocxxi::chain
@@ -4,6 +4,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -167,5 +169,100 @@ TEST(Base16DecodeInvalidInputTest, ThrowsDomainError) {
       std::domain_error);
 }
 
+namespace {
+// Byte sequence whose length and contents exercise the SIMD chunks as well as
+// the scalar tail of the kernels.
+auto MakeBinary(size_t size) -> std::vector<uint8_t> {
+  std::vector<uint8_t> binary(size);
+  for (size_t index = 0; index < size; ++index) {
+    binary[index] = static_cast<uint8_t>((index * 37U) + (size * 11U));
+  }
+  return binary;
+}
+
+auto ReferenceHex(std::span<const uint8_t> binary, bool lower_case)
+    -> std::string {
+  const std::string digits =
+      lower_case ? "0123456789abcdef" : "0123456789ABCDEF";
+  std::string hex;
+  for (const auto bin : binary) {
+    hex.push_back(digits[bin >> 4U]);
+    hex.push_back(digits[bin & 0x0FU]);
+  }
+  return hex;
+}
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(Base16BulkTest, EncodeMatchesReferenceForAllSizes) {
+  for (size_t size = 0; size <= 130; ++size) {
+    const auto binary = MakeBinary(size);
+    auto reversed = binary;
+    std::reverse(reversed.begin(), reversed.end());
+    for (const bool lower_case : {false, true}) {
+      const auto expected = ReferenceHex(binary, lower_case);
+      ASSERT_EQ(expected, Encode(binary, false, lower_case)) << size;
+
+      std::string buffer(2 * size, '?');
+      EncodeTo(binary, std::span(buffer), lower_case);
+      ASSERT_EQ(expected, buffer) << size;
+
+      ASSERT_EQ(ReferenceHex(reversed, lower_case),
+          EncodeReversed(binary, lower_case))
+          << size;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(Base16BulkTest, DecodeRoundTripsForAllSizes) {
+  for (size_t size = 0; size <= 130; ++size) {
+    const auto binary = MakeBinary(size);
+    std::vector<uint8_t> decoded(size);
+
+    ASSERT_TRUE(TryDecode(Encode(binary, false, true), std::span(decoded)));
+    ASSERT_EQ(binary, decoded) << size;
+    ASSERT_TRUE(TryDecode(Encode(binary), std::span(decoded)));
+    ASSERT_EQ(binary, decoded) << size;
+
+    ASSERT_TRUE(TryDecodeReversed(EncodeReversed(binary), std::span(decoded)));
+    ASSERT_EQ(binary, decoded) << size;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(Base16BulkTest, EncodeReversedKeepsDigitOrder) {
+  const std::vector<uint8_t> binary{0x01, 0x02, 0xAB};
+  ASSERT_EQ("ab0201", EncodeReversed(binary, true));
+
+  std::array<uint8_t, 3> decoded{};
+  ASSERT_TRUE(TryDecodeReversed("Ab0201", std::span(decoded)));
+  ASSERT_TRUE(std::equal(binary.begin(), binary.end(), decoded.begin()));
+}
+
+// NOLINTNEXTLINE
+TEST(Base16BulkTest, TryDecodeRejectsInvalidDigitAtAnyPosition) {
+  const auto valid = Encode(MakeBinary(50));
+  std::vector<uint8_t> decoded(50);
+  ASSERT_TRUE(TryDecode(valid, std::span(decoded)));
+  for (size_t pos = 0; pos < valid.size(); ++pos) {
+    for (const char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xC6'}) {
+      auto text = valid;
+      text[pos] = bad;
+      ASSERT_FALSE(TryDecode(text, std::span(decoded))) << pos;
+      ASSERT_FALSE(TryDecodeReversed(text, std::span(decoded))) << pos;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(Base16BulkTest, TryDecodeRejectsSizeMismatch) {
+  std::array<uint8_t, 2> decoded{};
+  ASSERT_FALSE(TryDecode("ABC", std::span(decoded)));
+  ASSERT_FALSE(TryDecode("AB", std::span(decoded)));
+  ASSERT_FALSE(TryDecode("ABCDEF", std::span(decoded)));
+  ASSERT_TRUE(TryDecode("ABCD", std::span(decoded)));
+}
+
 } // namespace blocxxi::codec::hex
 NOVA_DIAGNOSTIC_POP
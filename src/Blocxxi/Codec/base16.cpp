@@ -12,6 +12,7 @@
 
 #include <Blocxxi/Codec/base16.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <stdexcept>
@@ -19,6 +20,26 @@
 #include <Nova/Base/Compilers.h>
 #include <Nova/Base/Logging.h>
 
+// The SIMD kernels are compiled for their instruction set with a function
+// attribute (MSVC needs none), so the rest of the library stays portable and
+// the kernel is picked from the CPU features at runtime.
+// NOLINTBEGIN(portability-simd-intrinsics,*-reinterpret-cast)
+#if (defined(__GNUC__) || defined(__clang__))                                  \
+    && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BLOCXXI_HEX_HAS_SIMD 1
+#define BLOCXXI_HEX_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define BLOCXXI_HEX_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define BLOCXXI_HEX_HAS_SIMD 1
+#define BLOCXXI_HEX_TARGET_SSSE3
+#define BLOCXXI_HEX_TARGET_AVX2
+#else
+#define BLOCXXI_HEX_HAS_SIMD 0
+#endif
+
 namespace {
 /* Range generation,from
  * http://stackoverflow.com/questions/13313980/populate-an-array-using-constexpr-at-compile-time
@@ -125,25 +146,315 @@ constexpr size_t c_lookup_table_size = 256;
 const DecLookupTable<c_lookup_table_size> DEC_LOOKUP_TABLE =
     DecTableGenerator<c_lookup_table_size>(DecForIndex);
 
+// -----------------------------------------------------------------------------
+// Bulk kernels
+//
+// Every kernel works on `count` bytes (`2 * count` hex digits). When `Reversed`
+// is true, byte `i` of the binary side pairs with digits `2 * (count - 1 - i)`
+// and `2 * (count - 1 - i) + 1`. SIMD kernels only handle whole chunks and
+// return how many bytes they processed, starting from the front of the text;
+// the caller finishes the remainder with a narrower kernel.
+// -----------------------------------------------------------------------------
+
+template <bool Reversed>
+void EncodeScalar(
+    const uint8_t *src, size_t count, char *out, const char *alphabet) {
+  for (size_t index = 0; index < count; ++index) {
+    const uint8_t bin = Reversed ? src[count - 1 - index] : src[index];
+    out[2 * index] = alphabet[bin >> 4U];
+    out[(2 * index) + 1] = alphabet[bin & c_lower_four_bits_mask];
+  }
+}
+
+template <bool Reversed>
+auto DecodeScalar(const char *src, size_t count, uint8_t *out) -> bool {
+  for (size_t index = 0; index < count; ++index) {
+    const uint8_t hi =
+        DEC_LOOKUP_TABLE.dec_[static_cast<uint8_t>(src[2 * index])];
+    const uint8_t lo =
+        DEC_LOOKUP_TABLE.dec_[static_cast<uint8_t>(src[(2 * index) + 1])];
+    if ((hi | lo) > c_lower_four_bits_mask) {
+      return false;
+    }
+    out[Reversed ? count - 1 - index : index] =
+        static_cast<uint8_t>((hi << 4U) | lo);
+  }
+  return true;
+}
+
+#if BLOCXXI_HEX_HAS_SIMD
+
+constexpr size_t c_sse_chunk = 16;
+constexpr size_t c_avx_chunk = 32;
+
+// Converts 16 hex digits to their values. `valid` gets 0xFF in every lane that
+// holds a hex digit. Characters >= 0x80 compare negative and are rejected.
+BLOCXXI_HEX_TARGET_SSSE3
+inline auto NibblesSsse3(__m128i chars, __m128i &valid) -> __m128i {
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i is_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+          _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+  const __m128i is_alpha =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+          _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+  valid = _mm_or_si128(is_digit, is_alpha);
+  const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  const __m128i alpha = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+  return _mm_or_si128(
+      _mm_and_si128(is_digit, digit), _mm_and_si128(is_alpha, alpha));
+}
+
+template <bool Reversed>
+BLOCXXI_HEX_TARGET_SSSE3 auto EncodeSsse3(
+    const uint8_t *src, size_t count, char *out, const char *alphabet)
+    -> size_t {
+  const __m128i lut =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(alphabet));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  const __m128i reverse =
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  size_t done = 0;
+  for (; done + c_sse_chunk <= count; done += c_sse_chunk) {
+    const auto *in = Reversed ? src + count - done - c_sse_chunk : src + done;
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    if constexpr (Reversed) {
+      bytes = _mm_shuffle_epi8(bytes, reverse);
+    }
+    const __m128i hi =
+        _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(bytes, mask));
+    auto *dst = reinterpret_cast<__m128i *>(out + (2 * done));
+    _mm_storeu_si128(dst, _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi8(hi, lo));
+  }
+  return done;
+}
+
+template <bool Reversed>
+BLOCXXI_HEX_TARGET_SSSE3 auto DecodeSsse3(
+    const char *src, size_t count, uint8_t *out) -> size_t {
+  // Multiply-add of adjacent digits: high * 16 + low.
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  const __m128i reverse =
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  size_t done = 0;
+  for (; done + c_sse_chunk <= count; done += c_sse_chunk) {
+    const auto *in = reinterpret_cast<const __m128i *>(src + (2 * done));
+    __m128i valid_0;
+    __m128i valid_1;
+    const __m128i nibbles_0 = NibblesSsse3(_mm_loadu_si128(in), valid_0);
+    const __m128i nibbles_1 = NibblesSsse3(_mm_loadu_si128(in + 1), valid_1);
+    if (_mm_movemask_epi8(_mm_and_si128(valid_0, valid_1)) != 0xFFFF) {
+      break;
+    }
+    __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(nibbles_0, weights),
+        _mm_maddubs_epi16(nibbles_1, weights));
+    auto *dst = out + done;
+    if constexpr (Reversed) {
+      bytes = _mm_shuffle_epi8(bytes, reverse);
+      dst = out + count - done - c_sse_chunk;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), bytes);
+  }
+  return done;
+}
+
+BLOCXXI_HEX_TARGET_AVX2
+inline auto NibblesAvx2(__m256i chars, __m256i &valid) -> __m256i {
+  const __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+  const __m256i is_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+          _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+  const __m256i is_alpha =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+          _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+  valid = _mm256_or_si256(is_digit, is_alpha);
+  const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  const __m256i alpha = _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10));
+  return _mm256_or_si256(
+      _mm256_and_si256(is_digit, digit), _mm256_and_si256(is_alpha, alpha));
+}
+
+// Reverses the 32 bytes of a register: within each 128-bit lane, then the
+// lanes themselves.
+BLOCXXI_HEX_TARGET_AVX2
+inline auto ReverseBytesAvx2(__m256i bytes) -> __m256i {
+  const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6,
+      5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(bytes, reverse), 0x4E);
+}
+
+template <bool Reversed>
+BLOCXXI_HEX_TARGET_AVX2 auto EncodeAvx2(
+    const uint8_t *src, size_t count, char *out, const char *alphabet)
+    -> size_t {
+  const __m256i lut = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(alphabet)));
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  size_t done = 0;
+  for (; done + c_avx_chunk <= count; done += c_avx_chunk) {
+    const auto *in = Reversed ? src + count - done - c_avx_chunk : src + done;
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+    if constexpr (Reversed) {
+      bytes = ReverseBytesAvx2(bytes);
+    }
+    const __m256i hi = _mm256_shuffle_epi8(
+        lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+    const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, mask));
+    // Unpacking works within 128-bit lanes: `first` holds the digits of bytes
+    // 0-7 and 16-23, `second` those of bytes 8-15 and 24-31.
+    const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+    auto *dst = reinterpret_cast<__m256i *>(out + (2 * done));
+    _mm256_storeu_si256(dst, _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(
+        dst + 1, _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return done;
+}
+
+template <bool Reversed>
+BLOCXXI_HEX_TARGET_AVX2 auto DecodeAvx2(
+    const char *src, size_t count, uint8_t *out) -> size_t {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t done = 0;
+  for (; done + c_avx_chunk <= count; done += c_avx_chunk) {
+    const auto *in = reinterpret_cast<const __m256i *>(src + (2 * done));
+    __m256i valid_0;
+    __m256i valid_1;
+    const __m256i nibbles_0 = NibblesAvx2(_mm256_loadu_si256(in), valid_0);
+    const __m256i nibbles_1 = NibblesAvx2(_mm256_loadu_si256(in + 1), valid_1);
+    if (_mm256_movemask_epi8(_mm256_and_si256(valid_0, valid_1)) != -1) {
+      break;
+    }
+    // Packing also works within lanes; restore the 64-bit group order.
+    __m256i bytes = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(_mm256_maddubs_epi16(nibbles_0, weights),
+            _mm256_maddubs_epi16(nibbles_1, weights)),
+        0xD8);
+    auto *dst = out + done;
+    if constexpr (Reversed) {
+      bytes = ReverseBytesAvx2(bytes);
+      dst = out + count - done - c_avx_chunk;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), bytes);
+  }
+  return done;
+}
+
+#endif // BLOCXXI_HEX_HAS_SIMD
+
+enum class Kernel : uint8_t { kScalar, kSsse3, kAvx2 };
+
+auto DetectKernel() -> Kernel {
+#if BLOCXXI_HEX_HAS_SIMD && defined(_MSC_VER)
+  int cpu_info[4] = {};
+  __cpuid(cpu_info, 0);
+  const int max_leaf = cpu_info[0];
+  if (max_leaf < 1) {
+    return Kernel::kScalar;
+  }
+  __cpuid(cpu_info, 1);
+  // SSSE3 is bit 9 of ECX
+  const bool has_ssse3 = (cpu_info[2] & (1 << 9)) != 0;
+  const bool os_saves_ymm = (cpu_info[2] & (1 << 27)) != 0 &&
+                            (cpu_info[2] & (1 << 28)) != 0 &&
+                            (_xgetbv(0) & 0x6U) == 0x6U;
+  if (os_saves_ymm && max_leaf >= 7) {
+    __cpuidex(cpu_info, 7, 0);
+    // AVX2 is bit 5 of EBX
+    if ((cpu_info[1] & (1 << 5)) != 0) {
+      return Kernel::kAvx2;
+    }
+  }
+  return has_ssse3 ? Kernel::kSsse3 : Kernel::kScalar;
+#elif BLOCXXI_HEX_HAS_SIMD
+  // These builtins also verify that the OS saves the extended registers.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernel::kAvx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return Kernel::kSsse3;
+  }
+  return Kernel::kScalar;
+#else
+  return Kernel::kScalar;
+#endif
+}
+
+auto ActiveKernel() -> Kernel {
+  static const Kernel kernel = DetectKernel();
+  return kernel;
+}
+
+template <bool Reversed>
+void EncodeBulk(const uint8_t *src, size_t count, char *out, bool lower_case) {
+  const char *alphabet =
+      lower_case ? ALPHABET_LC.data() : ALPHABET_UC.data();
+  size_t done = 0;
+#if BLOCXXI_HEX_HAS_SIMD
+  // With `Reversed`, the processed bytes are the last `done` ones.
+  const auto rest = [&](size_t processed) {
+    return Reversed ? src : src + processed;
+  };
+  const auto kernel = ActiveKernel();
+  if (kernel == Kernel::kAvx2) {
+    done = EncodeAvx2<Reversed>(src, count, out, alphabet);
+  }
+  if (kernel != Kernel::kScalar) {
+    done += EncodeSsse3<Reversed>(
+        rest(done), count - done, out + (2 * done), alphabet);
+  }
+  EncodeScalar<Reversed>(rest(done), count - done, out + (2 * done), alphabet);
+#else
+  EncodeScalar<Reversed>(src, count, out, alphabet);
+#endif
+}
+
+template <bool Reversed>
+auto DecodeBulk(const char *src, size_t count, uint8_t *out) -> bool {
+#if BLOCXXI_HEX_HAS_SIMD
+  // With `Reversed`, the processed bytes are the last `done` ones.
+  size_t done = 0;
+  const auto rest = [&](size_t processed) {
+    return Reversed ? out : out + processed;
+  };
+  const auto kernel = ActiveKernel();
+  if (kernel == Kernel::kAvx2) {
+    done = DecodeAvx2<Reversed>(src, count, out);
+  }
+  if (kernel != Kernel::kScalar) {
+    done += DecodeSsse3<Reversed>(src + (2 * done), count - done, rest(done));
+  }
+  // A chunk with an invalid digit stops the SIMD kernels; the scalar kernel
+  // then reaches it and reports the failure.
+  return DecodeScalar<Reversed>(src + (2 * done), count - done, rest(done));
+#else
+  return DecodeScalar<Reversed>(src, count, out);
+#endif
+}
+
 } // namespace
+// NOLINTEND(portability-simd-intrinsics,*-reinterpret-cast)
 
 auto blocxxi::codec::hex::Encode(std::span<const uint8_t> src, bool reverse,
     bool lower_case) -> std::string {
+  std::string out;
+  if (!reverse) {
+    out.resize(2 * src.size());
+    EncodeBulk<false>(src.data(), src.size(), out.data(), lower_case);
+    return out;
+  }
+
+  // Reverse the whole text, including the digit order within each byte.
   const HexLookupTable<c_lookup_table_size> &table =
       (lower_case) ? HEX_LOOKUP_TABLE_LC : HEX_LOOKUP_TABLE_UC;
-
-  std::string out;
   out.reserve(2 * src.size());
-  if (reverse) {
-    for (auto bin_iter = src.rbegin(); bin_iter != src.rend(); ++bin_iter) {
-      out.push_back(table.lo_.at(*bin_iter));
-      out.push_back(table.hi_.at(*bin_iter));
-    }
-  } else {
-    for (const auto bin : src) {
-      out.push_back(table.hi_.at(bin));
-      out.push_back(table.lo_.at(bin));
-    }
+  for (auto bin_iter = src.rbegin(); bin_iter != src.rend(); ++bin_iter) {
+    out.push_back(table.lo_.at(*bin_iter));
+    out.push_back(table.hi_.at(*bin_iter));
   }
   return out;
 }
@@ -163,6 +474,14 @@ void blocxxi::codec::hex::Decode(
     return;
   }
 
+  // Fast path for valid input; the loops below locate and report the first
+  // invalid character otherwise.
+  if (!reverse && DecodeBulk<false>(src.data(), src.size() / 2, dest.data())) {
+    std::fill(dest.begin() + static_cast<std::ptrdiff_t>(src.size() / 2),
+        dest.end(), uint8_t{0});
+    return;
+  }
+
   auto out = dest.begin();
   if (reverse) {
     auto src_begin = src.rbegin();
@@ -212,3 +531,42 @@ void blocxxi::codec::hex::Decode(
     *out++ = 0;
   }
 }
+
+void blocxxi::codec::hex::EncodeTo(
+    std::span<const uint8_t> src, std::span<char> dest, bool lower_case) {
+  CHECK_F((dest.size() >= 2 * src.size()),
+      "buffer to receive the encoded data must be at least twice the size of "
+      "the data");
+  EncodeBulk<false>(src.data(), src.size(), dest.data(), lower_case);
+}
+
+void blocxxi::codec::hex::EncodeReversedTo(
+    std::span<const uint8_t> src, std::span<char> dest, bool lower_case) {
+  CHECK_F((dest.size() >= 2 * src.size()),
+      "buffer to receive the encoded data must be at least twice the size of "
+      "the data");
+  EncodeBulk<true>(src.data(), src.size(), dest.data(), lower_case);
+}
+
+auto blocxxi::codec::hex::EncodeReversed(
+    std::span<const uint8_t> src, bool lower_case) -> std::string {
+  std::string out(2 * src.size(), '\0');
+  EncodeBulk<true>(src.data(), src.size(), out.data(), lower_case);
+  return out;
+}
+
+auto blocxxi::codec::hex::TryDecode(
+    std::string_view src, std::span<uint8_t> dest) noexcept -> bool {
+  if (src.size() != 2 * dest.size()) {
+    return false;
+  }
+  return DecodeBulk<false>(src.data(), dest.size(), dest.data());
+}
+
+auto blocxxi::codec::hex::TryDecodeReversed(
+    std::string_view src, std::span<uint8_t> dest) noexcept -> bool {
+  if (src.size() != 2 * dest.size()) {
+    return false;
+  }
+  return DecodeBulk<true>(src.data(), dest.size(), dest.data());
+}
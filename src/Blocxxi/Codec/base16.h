@@ -59,4 +59,56 @@ BLOCXXI_CODEC_API auto Encode(std::span<const uint8_t> src,
 BLOCXXI_CODEC_API void Decode(
     std::string_view src, std::span<uint8_t> dest, bool reverse = false);
 
+/*!
+ * \brief Encode `src` into the caller provided buffer `dest`, without
+ * allocating.
+ *
+ * Exactly `2 * src.size()` characters are written at the start of `dest`.
+ * On x86 CPUs with SSSE3 or AVX2 the bulk of the data is encoded 16 or 32
+ * bytes at a time; the instruction set is selected at runtime.
+ *
+ * \note Providing a `dest` buffer that is smaller than `2 * src.size()` will
+ * abort the program.
+ */
+BLOCXXI_CODEC_API void EncodeTo(std::span<const uint8_t> src,
+    std::span<char> dest, bool lower_case = false);
+
+/*!
+ * \brief Like EncodeTo(), but encodes the bytes of `src` from last to first.
+ *
+ * This is the textual order of hashes that are stored little-endian but
+ * displayed big-endian, such as Bitcoin block hashes and transaction ids.
+ * Unlike `Encode(src, true)`, the two digits of each byte keep their order.
+ */
+BLOCXXI_CODEC_API void EncodeReversedTo(std::span<const uint8_t> src,
+    std::span<char> dest, bool lower_case = false);
+
+/*!
+ * \brief Encode the bytes of `src` from last to first into a new string.
+ * \see EncodeReversedTo()
+ */
+BLOCXXI_CODEC_API auto EncodeReversed(std::span<const uint8_t> src,
+    bool lower_case = false) -> std::string;
+
+/*!
+ * \brief Decode `src` into `dest`, reporting invalid input instead of
+ * throwing.
+ *
+ * Both upper and lower case digits are accepted. Uses the same runtime
+ * selected SIMD kernels as EncodeTo().
+ *
+ * \return `true` on success; `false` when `src` is not exactly
+ * `2 * dest.size()` characters long or contains a character that is not a hex
+ * digit. The contents of `dest` are unspecified after a failure.
+ */
+[[nodiscard]] BLOCXXI_CODEC_API auto TryDecode(
+    std::string_view src, std::span<uint8_t> dest) noexcept -> bool;
+
+/*!
+ * \brief Like TryDecode(), but the first two digits of `src` fill the last
+ * byte of `dest`. This is the inverse of EncodeReversedTo().
+ */
+[[nodiscard]] BLOCXXI_CODEC_API auto TryDecodeReversed(
+    std::string_view src, std::span<uint8_t> dest) noexcept -> bool;
+
 } // namespace blocxxi::codec::hex
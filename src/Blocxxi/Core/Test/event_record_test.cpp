@@ -80,4 +80,49 @@ TEST(EventRecordTest, VerifyRejectsSignatureMismatch)
   EXPECT_FALSE(VerifyEventRecord(record));
 }
 
+TEST(EventRecordTest, BatchVerifyFlagsEachRecord)
+{
+  auto const first_key = blocxxi::crypto::KeyPair(
+    "40C756697E6F60AC839FE53DD403F0B254D49A26243A196300CD4D515EE28062");
+  auto const second_key = blocxxi::crypto::KeyPair();
+
+  auto records = std::vector<SignedEventRecord> {};
+  for (auto index = 0; index < 40; ++index) {
+    auto envelope = EventEnvelope {
+      .event_type = "bitcoin.fee.spike",
+      .taxonomy = "fee-market",
+      .source = "bitcoin.rpc",
+      .producer = "blocxxi.test",
+      .window = { .start_utc = index, .end_utc = index + 1 },
+      .observed_at_utc = 100 + index,
+      .published_at_utc = 100 + index,
+      .summary = "batch-" + std::to_string(index),
+    };
+    records.push_back(SignEventRecord(
+      std::move(envelope), (index % 2) == 0 ? first_key : second_key, "batch"));
+  }
+  records[3].signature_hex = "abcd";
+  records[10].envelope.summary = "tampered";
+  records[17].signer_public_key_hex = "not-a-key";
+
+  auto const verified = VerifyEventRecords(records, 4U);
+  auto const sequential = VerifyEventRecords(records, 1U);
+
+  ASSERT_EQ(verified.size(), records.size());
+  EXPECT_EQ(verified, sequential);
+  for (auto index = std::size_t { 0 }; index < records.size(); ++index) {
+    EXPECT_EQ(verified[index], VerifyEventRecord(records[index])) << index;
+  }
+  EXPECT_FALSE(verified[3]);
+  EXPECT_FALSE(verified[10]);
+  EXPECT_FALSE(verified[17]);
+  EXPECT_TRUE(verified[0]);
+  EXPECT_TRUE(verified[1]);
+}
+
+TEST(EventRecordTest, BatchVerifyHandlesEmptyInput)
+{
+  EXPECT_TRUE(VerifyEventRecords({}).empty());
+}
+
 } // namespace blocxxi::core
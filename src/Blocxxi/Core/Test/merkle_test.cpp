@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <Blocxxi/Core/merkle.h>
+#include <Blocxxi/Core/primitives.h>
+
+namespace blocxxi::core {
+namespace {
+
+auto MakeLeaves(std::size_t count) -> std::vector<MerkleHash>
+{
+  auto leaves = std::vector<MerkleHash> {};
+  for (auto index = std::size_t { 0 }; index < count; ++index) {
+    leaves.push_back(Transaction::FromText("leaf", std::to_string(index)).id);
+  }
+  return leaves;
+}
+
+// Straightforward level-by-level reference: pair siblings, carry the odd one.
+auto ReferenceRoot(std::vector<MerkleHash> layer) -> MerkleHash
+{
+  if (layer.empty()) {
+    return MerkleHash {};
+  }
+  while (layer.size() > 1U) {
+    auto next = std::vector<MerkleHash> {};
+    for (auto index = std::size_t { 0 }; index + 1U < layer.size(); index += 2U) {
+      next.push_back(HashMerkleNode(layer[index], layer[index + 1U]));
+    }
+    if ((layer.size() % 2U) != 0U) {
+      next.push_back(layer.back());
+    }
+    layer = std::move(next);
+  }
+  return layer.front();
+}
+
+} // namespace
+
+TEST(MerkleTest, NodeHashIsDoubleSha256OfConcatenation)
+{
+  // SHA-256d of 64 zero bytes.
+  auto const expected = MerkleHash::FromHex(
+    "e2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf9");
+  EXPECT_EQ(HashMerkleNode(MerkleHash {}, MerkleHash {}), expected);
+}
+
+TEST(MerkleTest, SmallTreesHaveTheExpectedShape)
+{
+  auto const leaves = MakeLeaves(3);
+  EXPECT_EQ(ComputeMerkleRoot({}), MerkleHash {});
+  EXPECT_EQ(ComputeMerkleRoot(std::span(leaves).first(1)), leaves[0]);
+  EXPECT_EQ(ComputeMerkleRoot(leaves),
+    HashMerkleNode(HashMerkleNode(leaves[0], leaves[1]), leaves[2]));
+}
+
+TEST(MerkleTest, RepeatingTheLastLeafChangesTheRoot)
+{
+  auto leaves = MakeLeaves(3);
+  auto const root = ComputeMerkleRoot(leaves);
+  leaves.push_back(leaves.back());
+  EXPECT_NE(ComputeMerkleRoot(leaves), root);
+}
+
+TEST(MerkleTest, BatchAndAccumulatorMatchReferenceAtEverySize)
+{
+  auto const leaves = MakeLeaves(70);
+  auto accumulator = MerkleAccumulator {};
+  EXPECT_EQ(accumulator.Root(), MerkleHash {});
+  for (auto count = std::size_t { 1 }; count <= leaves.size(); ++count) {
+    accumulator.Append(leaves[count - 1U]);
+    auto const prefix = std::vector<MerkleHash>(leaves.begin(),
+      leaves.begin() + static_cast<std::ptrdiff_t>(count));
+    auto const expected = ReferenceRoot(prefix);
+    ASSERT_EQ(ComputeMerkleRoot(prefix), expected) << count;
+    ASSERT_EQ(accumulator.Root(), expected) << count;
+    ASSERT_EQ(accumulator.Size(), count);
+  }
+
+  accumulator.Clear();
+  EXPECT_EQ(accumulator.Size(), 0U);
+  EXPECT_EQ(accumulator.Root(), MerkleHash {});
+}
+
+TEST(MerkleTest, ProofsVerifyForEveryLeafAtEverySize)
+{
+  auto const leaves = MakeLeaves(33);
+  for (auto count = std::size_t { 1 }; count <= leaves.size(); ++count) {
+    auto const prefix = std::span(leaves).first(count);
+    auto const tree = MerkleTree(prefix);
+    ASSERT_EQ(tree.Root(), ComputeMerkleRoot(prefix)) << count;
+    for (auto index = std::uint64_t { 0 }; index < count; ++index) {
+      auto const proof = tree.Prove(index);
+      ASSERT_TRUE(proof.has_value());
+      EXPECT_EQ(proof->leaf, prefix[index]);
+      ASSERT_TRUE(VerifyInclusion(*proof, tree.Root())) << count << "/" << index;
+    }
+    EXPECT_FALSE(tree.Prove(count).has_value());
+  }
+}
+
+TEST(MerkleTest, TamperedProofsAreRejected)
+{
+  auto const leaves = MakeLeaves(11);
+  auto const tree = MerkleTree(leaves);
+  auto const proof = *tree.Prove(9);
+
+  auto wrong_leaf = proof;
+  wrong_leaf.leaf = leaves[8];
+  EXPECT_FALSE(VerifyInclusion(wrong_leaf, tree.Root()));
+
+  auto wrong_sibling = proof;
+  wrong_sibling.siblings.front() = leaves[0];
+  EXPECT_FALSE(VerifyInclusion(wrong_sibling, tree.Root()));
+
+  auto extra_sibling = proof;
+  extra_sibling.siblings.push_back(leaves[0]);
+  EXPECT_FALSE(VerifyInclusion(extra_sibling, tree.Root()));
+
+  // With 10 leaves the proven leaf's parent has no sibling, so the path no
+  // longer fits the tree shape.
+  auto wrong_count = proof;
+  wrong_count.leaf_count = 10;
+  EXPECT_FALSE(VerifyInclusion(wrong_count, tree.Root()));
+
+  auto out_of_range = proof;
+  out_of_range.leaf_index = out_of_range.leaf_count;
+  EXPECT_FALSE(VerifyInclusion(out_of_range, tree.Root()));
+}
+
+TEST(MerkleTest, BlockHeaderCommitsToTransactions)
+{
+  auto block = Block::MakeNext(BlockId {}, 3,
+    { Transaction::FromText("demo.tx", "a"), Transaction::FromText("demo.tx", "b") },
+    "demo");
+
+  EXPECT_EQ(block.header.transaction_count, 2U);
+  EXPECT_EQ(block.header.merkle_root, block.ComputeMerkleRoot());
+  EXPECT_EQ(block.header.id, block.header.ComputeId());
+
+  auto tampered = block;
+  tampered.transactions[1] = Transaction::FromText("demo.tx", "c");
+  EXPECT_NE(tampered.ComputeMerkleRoot(), block.header.merkle_root);
+
+  tampered.header = block.header;
+  tampered.header.timestamp_utc += 1;
+  EXPECT_NE(tampered.header.ComputeId(), block.header.id);
+}
+
+TEST(MerkleTest, BlockProvesItsTransactionsAgainstTheHeader)
+{
+  auto block = Block::MakeNext(BlockId {}, 1,
+    { Transaction::FromText("demo.tx", "a"), Transaction::FromText("demo.tx", "b"),
+      Transaction::FromText("demo.tx", "c") },
+    "demo");
+
+  for (auto const& transaction : block.transactions) {
+    auto const proof = block.ProveInclusion(transaction.id);
+    ASSERT_TRUE(proof.has_value());
+    EXPECT_TRUE(VerifyInclusion(*proof, block.header));
+  }
+  EXPECT_FALSE(
+    block.ProveInclusion(Transaction::FromText("demo.tx", "d").id).has_value());
+
+  // The same path checked against a header claiming a different count fails.
+  auto const proof = *block.ProveInclusion(block.transactions[2].id);
+  auto header = block.header;
+  header.transaction_count = 4;
+  EXPECT_FALSE(VerifyInclusion(proof, header));
+}
+
+} // namespace blocxxi::core
@@ -29,6 +29,16 @@ TEST(CorePrimitivesTest, TransactionFromTextCapturesPayloadAndMetadata)
   EXPECT_EQ(transaction.metadata, "kind=demo");
 }
 
+TEST(CorePrimitivesTest, TransactionIdBindsFieldBoundaries)
+{
+  auto const transaction = Transaction::FromText("demo.tx", "payload", "kind=demo");
+  auto const shifted = Transaction::FromText("demo.t", "xpayload", "kind=demo");
+
+  EXPECT_EQ(transaction.id, transaction.ComputeId());
+  EXPECT_EQ(transaction.id, Transaction::FromText("demo.tx", "payload", "kind=demo").id);
+  EXPECT_NE(transaction.id, shifted.id);
+}
+
 TEST(CorePrimitivesTest, BlockCompositionBuildsStableHeaderShape)
 {
   auto const transaction = Transaction::FromText("demo.tx", "payload");
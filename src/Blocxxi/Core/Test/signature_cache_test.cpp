@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <Blocxxi/Core/event_record.h>
+#include <Blocxxi/Core/signature_cache.h>
+
+namespace blocxxi::core {
+namespace {
+
+auto MakeKey(std::uint8_t seed) -> SignatureCacheKey
+{
+  auto key = SignatureCacheKey {};
+  key.content_digest.fill(seed);
+  key.signer_public_key_hex = "signer";
+  key.signature_hex = "signature-" + std::to_string(seed);
+  return key;
+}
+
+auto MakeRecord() -> SignedEventRecord
+{
+  auto const key_pair = blocxxi::crypto::KeyPair(
+    "40C756697E6F60AC839FE53DD403F0B254D49A26243A196300CD4D515EE28062");
+  return SignEventRecord(EventEnvelope {
+      .event_type = "bitcoin.block.new",
+      .taxonomy = "block",
+      .source = "bitcoin.rpc",
+      .producer = "blocxxi.test",
+      .window = { .start_utc = 7, .end_utc = 8 },
+      .observed_at_utc = 9,
+      .published_at_utc = 10,
+      .summary = "cached",
+    },
+    key_pair, "cache-test");
+}
+
+} // namespace
+
+TEST(SignatureCacheTest, InsertedKeysHitAndCountMetrics)
+{
+  auto cache = VerifiedSignatureCache(64U);
+  auto const key = MakeKey(1U);
+
+  EXPECT_FALSE(cache.Contains(key));
+  cache.Insert(key);
+  EXPECT_TRUE(cache.Contains(key));
+  EXPECT_FALSE(cache.Contains(MakeKey(2U)));
+
+  auto const metrics = cache.Metrics();
+  EXPECT_EQ(metrics.hits, 1U);
+  EXPECT_EQ(metrics.misses, 2U);
+  EXPECT_EQ(metrics.insertions, 1U);
+  EXPECT_EQ(metrics.size, 1U);
+  EXPECT_DOUBLE_EQ(metrics.HitRate(), 1.0 / 3.0);
+}
+
+TEST(SignatureCacheTest, DistinctSignatureOnSameContentMisses)
+{
+  auto cache = VerifiedSignatureCache(64U);
+  auto key = MakeKey(3U);
+  cache.Insert(key);
+
+  key.signature_hex = "other";
+
+  EXPECT_FALSE(cache.Contains(key));
+}
+
+TEST(SignatureCacheTest, SizeStaysWithinCapacity)
+{
+  auto cache = VerifiedSignatureCache(16U);
+  for (auto seed = 0U; seed < 200U; ++seed) {
+    cache.Insert(MakeKey(static_cast<std::uint8_t>(seed)));
+  }
+
+  auto const metrics = cache.Metrics();
+  EXPECT_LE(metrics.size, cache.Capacity());
+  EXPECT_EQ(metrics.insertions - metrics.evictions, metrics.size);
+}
+
+TEST(SignatureCacheTest, RepeatedVerificationHitsSharedCache)
+{
+  auto& cache = SharedSignatureCache();
+  cache.Clear();
+  auto const record = MakeRecord();
+
+  EXPECT_TRUE(VerifyEventRecord(record));
+  EXPECT_TRUE(VerifyEventRecord(record));
+  auto const batch = VerifyEventRecords(std::vector<SignedEventRecord> { record, record });
+
+  EXPECT_EQ(batch, (std::vector<bool> { true, true }));
+  auto const metrics = cache.Metrics();
+  EXPECT_EQ(metrics.insertions, 1U);
+  EXPECT_EQ(metrics.hits, 3U);
+}
+
+TEST(SignatureCacheTest, TamperedRecordDoesNotHitCache)
+{
+  auto& cache = SharedSignatureCache();
+  cache.Clear();
+  auto record = MakeRecord();
+  ASSERT_TRUE(VerifyEventRecord(record));
+
+  record.envelope.summary = "tampered";
+
+  EXPECT_FALSE(VerifyEventRecord(record));
+  EXPECT_EQ(cache.Metrics().hits, 0U);
+}
+
+} // namespace blocxxi::core
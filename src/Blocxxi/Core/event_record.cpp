@@ -7,26 +7,19 @@
 #include <Blocxxi/Core/event_record.h>
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 
+#include <Blocxxi/Codec/base16.h>
+#include <Blocxxi/Core/signature_cache.h>
 #include <Blocxxi/Crypto/signature.h>
 
 namespace blocxxi::core {
 namespace {
 
-constexpr auto kHexDigits = std::string_view { "0123456789abcdef" };
-
-auto EncodeHex(ByteVector const& payload) -> std::string
-{
-  auto text = std::string {};
-  text.reserve(payload.size() * 2U);
-  for (auto const byte : payload) {
-    text.push_back(kHexDigits[(byte >> 4U) & 0x0FU]);
-    text.push_back(kHexDigits[byte & 0x0FU]);
-  }
-  return text;
-}
-
 auto SortedIdentifiers(std::vector<std::string> values) -> std::vector<std::string>
 {
   std::sort(values.begin(), values.end());
@@ -80,10 +73,52 @@ auto CanonicalSeed(EventEnvelope const& envelope) -> std::string
   output.push_back('\n');
 
   output += "summary=" + envelope.summary + '\n';
-  output += "payload_hex=" + EncodeHex(envelope.payload) + '\n';
+  output += "payload_hex=" + codec::hex::Encode(envelope.payload, false, true) + '\n';
   return output;
 }
 
+// Below this many records per thread, spawning workers costs more than the
+// verifications it parallelizes.
+constexpr auto kMinRecordsPerWorker = std::size_t { 8 };
+constexpr auto kRecordsPerChunk = std::size_t { 16 };
+
+auto ResolveWorkerCount(std::size_t items, std::size_t max_workers) -> std::size_t
+{
+  if (max_workers == 0U) {
+    max_workers = std::max(std::size_t { 1 },
+      static_cast<std::size_t>(std::thread::hardware_concurrency()));
+  }
+  auto const useful = (items + kMinRecordsPerWorker - 1U) / kMinRecordsPerWorker;
+  return std::clamp(useful, std::size_t { 1 }, max_workers);
+}
+
+// Runs `work(worker_index, begin, end)` over [0, count) in chunks pulled from
+// a shared cursor. The calling thread takes part as worker 0.
+template <typename Work>
+auto RunChunked(std::size_t count, std::size_t workers, Work const& work) -> void
+{
+  auto cursor = std::atomic<std::size_t> { 0 };
+  auto const drain = [&](std::size_t worker_index) {
+    for (;;) {
+      auto const begin = cursor.fetch_add(kRecordsPerChunk);
+      if (begin >= count) {
+        return;
+      }
+      work(worker_index, begin, std::min(count, begin + kRecordsPerChunk));
+    }
+  };
+
+  auto threads = std::vector<std::thread> {};
+  threads.reserve(workers - 1U);
+  for (auto index = std::size_t { 1 }; index < workers; ++index) {
+    threads.emplace_back(drain, index);
+  }
+  drain(0U);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 } // namespace
 
 auto EventEnvelope::CanonicalText() const -> std::string
@@ -158,8 +193,93 @@ auto VerifyEventRecord(SignedEventRecord const& record) -> bool
   }
 
   auto const canonical = record.envelope.CanonicalBytes();
-  return blocxxi::crypto::VerifyMessageHex(
-    *public_key, canonical, record.signature_hex);
+  auto cache_key = MakeSignatureCacheKey(record, canonical);
+  auto& cache = SharedSignatureCache();
+  if (cache.Contains(cache_key)) {
+    return true;
+  }
+
+  if (!blocxxi::crypto::VerifyMessageHex(*public_key, canonical, record.signature_hex)) {
+    return false;
+  }
+  cache.Insert(std::move(cache_key));
+  return true;
+}
+
+auto VerifyEventRecords(std::span<SignedEventRecord const> records,
+  std::size_t max_workers) -> std::vector<bool>
+{
+  using blocxxi::crypto::SignatureVerifier;
+
+  auto signer_index = std::unordered_map<std::string_view, std::size_t> {};
+  auto signer_keys = std::vector<std::string_view> {};
+  auto record_signer = std::vector<std::size_t>(records.size());
+  for (auto index = std::size_t { 0 }; index < records.size(); ++index) {
+    auto const& key_hex = records[index].signer_public_key_hex;
+    auto const [found, inserted] = signer_index.try_emplace(key_hex, signer_keys.size());
+    if (inserted) {
+      signer_keys.push_back(key_hex);
+    }
+    record_signer[index] = found->second;
+  }
+
+  // Records already in the verified-signature cache need no curve math at all;
+  // the canonical bytes of the others are kept for the verification pass.
+  auto& cache = SharedSignatureCache();
+  auto verified = std::vector<std::uint8_t>(records.size(), 0U);
+  auto canonical = std::vector<ByteVector>(records.size());
+  auto cache_keys = std::vector<SignatureCacheKey>(records.size());
+  RunChunked(records.size(), ResolveWorkerCount(records.size(), max_workers),
+    [&](std::size_t, std::size_t begin, std::size_t end) {
+      for (auto index = begin; index < end; ++index) {
+        canonical[index] = records[index].envelope.CanonicalBytes();
+        cache_keys[index] = MakeSignatureCacheKey(records[index], canonical[index]);
+        verified[index] = cache.Contains(cache_keys[index]) ? 1U : 0U;
+      }
+    });
+
+  auto pending = std::vector<std::size_t> {};
+  auto signer_needed = std::vector<std::uint8_t>(signer_keys.size(), 0U);
+  for (auto index = std::size_t { 0 }; index < records.size(); ++index) {
+    if (verified[index] == 0U) {
+      pending.push_back(index);
+      signer_needed[record_signer[index]] = 1U;
+    }
+  }
+
+  // Decoding and validating the public point dominates single verifications,
+  // so it happens once per distinct signer.
+  auto verifiers = std::vector<std::optional<SignatureVerifier>>(signer_keys.size());
+  RunChunked(signer_keys.size(), ResolveWorkerCount(signer_keys.size(), max_workers),
+    [&](std::size_t, std::size_t begin, std::size_t end) {
+      for (auto index = begin; index < end; ++index) {
+        if (signer_needed[index] != 0U) {
+          verifiers[index] = SignatureVerifier::FromHex(std::string(signer_keys[index]));
+        }
+      }
+    });
+
+  // Group records by signer so each chunk mostly touches a single verifier.
+  std::stable_sort(pending.begin(), pending.end(), [&](std::size_t lhs, std::size_t rhs) {
+    return record_signer[lhs] < record_signer[rhs];
+  });
+
+  RunChunked(pending.size(), ResolveWorkerCount(pending.size(), max_workers),
+    [&](std::size_t, std::size_t begin, std::size_t end) {
+      for (auto position = begin; position < end; ++position) {
+        auto const index = pending[position];
+        auto const& verifier = verifiers[record_signer[index]];
+        if (!verifier.has_value()) {
+          continue;
+        }
+        if (verifier->VerifyHex(canonical[index], records[index].signature_hex)) {
+          cache.Insert(std::move(cache_keys[index]));
+          verified[index] = 1U;
+        }
+      }
+    });
+
+  return std::vector<bool>(verified.begin(), verified.end());
 }
 
 } // namespace blocxxi::core
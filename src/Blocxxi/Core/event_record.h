@@ -8,7 +8,9 @@
 
 #include <Blocxxi/Core/api_export.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -77,4 +79,11 @@ struct SignedEventRecord {
 [[nodiscard]] BLOCXXI_CORE_API auto VerifyEventRecord(
   SignedEventRecord const& record) -> bool;
 
+// Verifies a batch of records and returns one flag per input record, in input
+// order. Public keys are decoded once per distinct signer and the work is
+// spread over up to `max_workers` threads (0 picks the hardware concurrency).
+[[nodiscard]] BLOCXXI_CORE_API auto VerifyEventRecords(
+  std::span<SignedEventRecord const> records, std::size_t max_workers = 0)
+  -> std::vector<bool>;
+
 } // namespace blocxxi::core
@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Core/merkle.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+#include <Nova/Base/Sha256.h>
+
+namespace blocxxi::core {
+namespace {
+
+[[nodiscard]] auto ToMerkleHash(nova::Sha256Digest const& digest) -> MerkleHash
+{
+  return MerkleHash(std::span<std::uint8_t const>(digest.data(), digest.size()));
+}
+
+// Hashes every pair of siblings of `layer` in one multi-lane batch and carries
+// the odd node, if any, into `next`. MerkleHash is a dense, trivially copyable
+// 32-byte value, so each pair already is a contiguous 64-byte block.
+auto HashLevel(std::span<MerkleHash const> layer,
+  std::vector<nova::Sha256Digest>& scratch, std::vector<MerkleHash>& next)
+  -> void
+{
+  auto const pairs = layer.size() / 2U;
+  scratch.resize(pairs);
+  nova::ComputeSha256d64Many(std::as_bytes(layer.first(pairs * 2U)), scratch);
+  next.clear();
+  std::ranges::transform(scratch, std::back_inserter(next), ToMerkleHash);
+  if ((layer.size() % 2U) != 0U) {
+    next.push_back(layer.back());
+  }
+}
+
+} // namespace
+
+auto HashMerkleNode(MerkleHash const& left, MerkleHash const& right) -> MerkleHash
+{
+  auto block = std::array<std::byte, 64> {};
+  std::memcpy(block.data(), left.Data(), MerkleHash::Size());
+  std::memcpy(block.data() + MerkleHash::Size(), right.Data(), MerkleHash::Size());
+  return ToMerkleHash(nova::ComputeSha256d64(block));
+}
+
+auto ComputeMerkleRoot(std::span<MerkleHash const> leaves) -> MerkleHash
+{
+  if (leaves.empty()) {
+    return MerkleHash {};
+  }
+
+  auto scratch = std::vector<nova::Sha256Digest> {};
+  auto layer = std::vector<MerkleHash>(leaves.begin(), leaves.end());
+  auto next = std::vector<MerkleHash> {};
+  while (layer.size() > 1U) {
+    HashLevel(layer, scratch, next);
+    std::swap(layer, next);
+  }
+  return layer.front();
+}
+
+auto MerkleAccumulator::Append(MerkleHash const& leaf) -> void
+{
+  // Adding a leaf works like incrementing a binary counter: every complete
+  // subtree of the same height merges with the carry.
+  auto carry = leaf;
+  auto level = std::size_t { 0 };
+  while (((size_ >> level) & 1U) != 0U) {
+    carry = HashMerkleNode(subtrees_[level], carry);
+    ++level;
+  }
+  if (subtrees_.size() <= level) {
+    subtrees_.resize(level + 1U);
+  }
+  subtrees_[level] = carry;
+  ++size_;
+}
+
+auto MerkleAccumulator::Clear() -> void
+{
+  subtrees_.clear();
+  size_ = 0;
+}
+
+auto MerkleAccumulator::Root() const -> MerkleHash
+{
+  if (size_ == 0U) {
+    return MerkleHash {};
+  }
+
+  // The smallest subtree is the one carried up; fold it into the larger ones
+  // to its left.
+  auto root = std::optional<MerkleHash> {};
+  for (auto level = std::size_t { 0 }; level < subtrees_.size(); ++level) {
+    if (((size_ >> level) & 1U) == 0U) {
+      continue;
+    }
+    root = root.has_value() ? HashMerkleNode(subtrees_[level], *root)
+                            : subtrees_[level];
+  }
+  return *root;
+}
+
+MerkleTree::MerkleTree(std::span<MerkleHash const> leaves)
+{
+  if (leaves.empty()) {
+    return;
+  }
+  levels_.emplace_back(leaves.begin(), leaves.end());
+  auto scratch = std::vector<nova::Sha256Digest> {};
+  while (levels_.back().size() > 1U) {
+    auto next = std::vector<MerkleHash> {};
+    next.reserve((levels_.back().size() + 1U) / 2U);
+    HashLevel(levels_.back(), scratch, next);
+    levels_.push_back(std::move(next));
+  }
+}
+
+auto MerkleTree::Root() const -> MerkleHash
+{
+  return levels_.empty() ? MerkleHash {} : levels_.back().front();
+}
+
+auto MerkleTree::Prove(std::uint64_t leaf_index) const
+  -> std::optional<MerkleProof>
+{
+  if (leaf_index >= LeafCount()) {
+    return std::nullopt;
+  }
+
+  auto proof = MerkleProof {
+    .leaf = levels_.front()[leaf_index],
+    .leaf_index = leaf_index,
+    .leaf_count = LeafCount(),
+  };
+  auto index = leaf_index;
+  for (auto level = std::size_t { 0 }; level + 1U < levels_.size(); ++level) {
+    auto const sibling = index ^ 1U;
+    if (sibling < levels_[level].size()) {
+      proof.siblings.push_back(levels_[level][sibling]);
+    }
+    index /= 2U;
+  }
+  return proof;
+}
+
+auto VerifyInclusion(MerkleProof const& proof, MerkleHash const& root) -> bool
+{
+  if (proof.leaf_index >= proof.leaf_count) {
+    return false;
+  }
+
+  auto node = proof.leaf;
+  auto index = proof.leaf_index;
+  auto width = proof.leaf_count;
+  auto sibling = proof.siblings.begin();
+  while (width > 1U) {
+    if ((index & 1U) != 0U || index + 1U < width) {
+      if (sibling == proof.siblings.end()) {
+        return false;
+      }
+      node = (index & 1U) != 0U ? HashMerkleNode(*sibling, node)
+                                : HashMerkleNode(node, *sibling);
+      ++sibling;
+    }
+    index /= 2U;
+    width = (width + 1U) / 2U;
+  }
+  return sibling == proof.siblings.end() && node == root;
+}
+
+} // namespace blocxxi::core
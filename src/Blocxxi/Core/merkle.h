@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Core/api_export.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <Blocxxi/Crypto/hash.h>
+
+// Binary merkle trees over 32-byte ids, as committed to by block headers.
+//
+// An interior node is SHA-256d(left || right). A node without a sibling is
+// carried up to the next level unchanged rather than paired with itself, so
+// two different leaf lists cannot produce the same root by repeating the last
+// leaf (the flaw behind Bitcoin's CVE-2012-2459). The root of an empty list is
+// all zero. Block headers also commit to the leaf count, which rules out
+// passing an interior node off as a leaf of a shorter list.
+namespace blocxxi::core {
+
+using MerkleHash = blocxxi::crypto::Hash256;
+
+[[nodiscard]] BLOCXXI_CORE_API auto HashMerkleNode(
+  MerkleHash const& left, MerkleHash const& right) -> MerkleHash;
+
+// Hashes the tree one level at a time, each level in a single multi-lane batch.
+[[nodiscard]] BLOCXXI_CORE_API auto ComputeMerkleRoot(
+  std::span<MerkleHash const> leaves) -> MerkleHash;
+
+// Root of a leaf list that grows one leaf at a time, e.g. while a block is
+// being assembled. Only the roots of the complete subtrees on the right edge
+// are kept (one per set bit of the leaf count), so both Append() and Root()
+// cost O(log n) hashes and agree with ComputeMerkleRoot() at every size.
+class MerkleAccumulator {
+public:
+  BLOCXXI_CORE_API auto Append(MerkleHash const& leaf) -> void;
+  BLOCXXI_CORE_API auto Clear() -> void;
+
+  [[nodiscard]] BLOCXXI_CORE_API auto Root() const -> MerkleHash;
+  [[nodiscard]] auto Size() const -> std::uint64_t { return size_; }
+
+private:
+  // subtrees_[level] is meaningful only when bit `level` of size_ is set.
+  std::vector<MerkleHash> subtrees_ {};
+  std::uint64_t size_ { 0 };
+};
+
+// Path from one leaf to the root. Levels where the node was carried up have no
+// sibling, so the verifier replays the tree shape from leaf_index and
+// leaf_count to know which side, if any, each sibling goes on.
+struct MerkleProof {
+  MerkleHash leaf {};
+  std::uint64_t leaf_index { 0 };
+  std::uint64_t leaf_count { 0 };
+  std::vector<MerkleHash> siblings {};
+
+  friend auto operator==(MerkleProof const& lhs, MerkleProof const& rhs)
+    -> bool = default;
+};
+
+// A merkle tree with every level kept, so that proofs are read off the stored
+// nodes in O(log n) instead of rehashing the leaves.
+class MerkleTree {
+public:
+  MerkleTree() = default;
+  BLOCXXI_CORE_API explicit MerkleTree(std::span<MerkleHash const> leaves);
+
+  [[nodiscard]] BLOCXXI_CORE_API auto Root() const -> MerkleHash;
+  [[nodiscard]] auto LeafCount() const -> std::uint64_t
+  {
+    return levels_.empty() ? 0U : levels_.front().size();
+  }
+
+  // Returns nothing when `leaf_index` is out of range.
+  [[nodiscard]] BLOCXXI_CORE_API auto Prove(std::uint64_t leaf_index) const
+    -> std::optional<MerkleProof>;
+
+private:
+  // levels_[0] holds the leaves and levels_.back() the single root.
+  std::vector<std::vector<MerkleHash>> levels_ {};
+};
+
+// Checks that `proof` leads from its leaf to `root`. The caller must also trust
+// proof.leaf_count, e.g. by comparing it with the count the header commits to.
+[[nodiscard]] BLOCXXI_CORE_API auto VerifyInclusion(
+  MerkleProof const& proof, MerkleHash const& root) -> bool;
+
+} // namespace blocxxi::core
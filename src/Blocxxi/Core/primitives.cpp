@@ -6,8 +6,14 @@
 
 #include <Blocxxi/Core/primitives.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <span>
+
+#include <Nova/Base/Sha256.h>
+
+#include <Blocxxi/Core/merkle.h>
 
 namespace blocxxi::core {
 namespace {
@@ -28,19 +34,55 @@ constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
   return value;
 }
 
+auto AppendLittleEndian(ByteVector& out, std::uint64_t value) -> void
+{
+  for (auto index = 0U; index < 8U; ++index) {
+    out.push_back(static_cast<std::uint8_t>((value >> (index * 8U)) & 0xFFU));
+  }
+}
+
+auto AppendField(ByteVector& out, std::span<std::uint8_t const> field) -> void
+{
+  AppendLittleEndian(out, field.size());
+  out.insert(out.end(), field.begin(), field.end());
+}
+
+auto AppendField(ByteVector& out, std::string_view field) -> void
+{
+  AppendLittleEndian(out, field.size());
+  out.insert(out.end(), field.begin(), field.end());
+}
+
+[[nodiscard]] auto DoubleSha256(ByteVector const& bytes) -> blocxxi::crypto::Hash256
+{
+  auto const digest = nova::ComputeSha256d(std::as_bytes(std::span(bytes)));
+  return blocxxi::crypto::Hash256(
+    std::span<std::uint8_t const>(digest.data(), digest.size()));
+}
+
+[[nodiscard]] auto TransactionIds(std::vector<Transaction> const& transactions)
+  -> std::vector<MerkleHash>
+{
+  auto ids = std::vector<MerkleHash> {};
+  ids.reserve(transactions.size());
+  for (auto const& transaction : transactions) {
+    ids.push_back(transaction.id);
+  }
+  return ids;
+}
+
 } // namespace
 
 auto Transaction::FromText(
   std::string type, std::string payload, std::string metadata) -> Transaction
 {
-  auto payload_bytes = ToBytes(payload);
-  auto const seed = type + "|" + payload + "|" + metadata;
-  return Transaction {
-    .id = MakeId(seed),
+  auto transaction = Transaction {
     .type = std::move(type),
-    .payload = std::move(payload_bytes),
+    .payload = ToBytes(payload),
     .metadata = std::move(metadata),
   };
+  transaction.id = transaction.ComputeId();
+  return transaction;
 }
 
 auto Transaction::PayloadText() const -> std::string
@@ -48,29 +90,86 @@ auto Transaction::PayloadText() const -> std::string
   return ToString(payload);
 }
 
+auto Transaction::ComputeId() const -> TransactionId
+{
+  auto encoded = ByteVector {};
+  encoded.reserve(24U + type.size() + payload.size() + metadata.size());
+  AppendField(encoded, type);
+  AppendField(encoded, payload);
+  AppendField(encoded, metadata);
+  return DoubleSha256(encoded);
+}
+
+auto BlockHeader::ComputeId() const -> BlockId
+{
+  auto encoded = ByteVector {};
+  encoded.reserve(2U * BlockId::Size() + 32U + source.size());
+  encoded.insert(encoded.end(), previous_id.begin(), previous_id.end());
+  encoded.insert(encoded.end(), merkle_root.begin(), merkle_root.end());
+  AppendLittleEndian(encoded, transaction_count);
+  AppendLittleEndian(encoded, height);
+  AppendLittleEndian(encoded, static_cast<std::uint64_t>(timestamp_utc));
+  AppendField(encoded, source);
+  return DoubleSha256(encoded);
+}
+
 auto Block::MakeNext(BlockId previous_id,
   Height height,
   std::vector<Transaction> transactions,
   std::string source) -> Block
 {
-  auto seed = std::string {};
-  seed.reserve(256);
-  seed += previous_id.ToHex();
-  seed += "|" + std::to_string(height) + "|" + source;
-  for (auto const& transaction : transactions) {
-    seed += "|" + transaction.id.ToHex();
-  }
+  auto const merkle_root = core::ComputeMerkleRoot(TransactionIds(transactions));
+  return MakeNext(
+    previous_id, height, std::move(transactions), merkle_root, std::move(source));
+}
 
-  return Block {
+auto Block::MakeNext(BlockId previous_id,
+  Height height,
+  std::vector<Transaction> transactions,
+  BlockId merkle_root,
+  std::string source) -> Block
+{
+  auto block = Block {
     .header = BlockHeader {
-      .id = MakeId(seed),
       .previous_id = previous_id,
+      .merkle_root = merkle_root,
+      .transaction_count = transactions.size(),
       .height = height,
       .timestamp_utc = NowUnixSeconds(),
       .source = std::move(source),
     },
     .transactions = std::move(transactions),
   };
+  block.header.id = block.header.ComputeId();
+  return block;
+}
+
+auto Block::ComputeMerkleRoot() const -> BlockId
+{
+  return core::ComputeMerkleRoot(TransactionIds(transactions));
+}
+
+auto Block::BuildMerkleTree() const -> MerkleTree
+{
+  return MerkleTree(TransactionIds(transactions));
+}
+
+auto Block::ProveInclusion(TransactionId const& transaction_id) const
+  -> std::optional<MerkleProof>
+{
+  auto const found = std::ranges::find(
+    transactions, transaction_id, &Transaction::id);
+  if (found == transactions.end()) {
+    return std::nullopt;
+  }
+  return BuildMerkleTree().Prove(
+    static_cast<std::uint64_t>(found - transactions.begin()));
+}
+
+auto VerifyInclusion(MerkleProof const& proof, BlockHeader const& header) -> bool
+{
+  return proof.leaf_count == header.transaction_count
+    && VerifyInclusion(proof, header.merkle_root);
 }
 
 auto MakeId(std::string_view seed) -> blocxxi::crypto::Hash256
@@ -16,6 +16,7 @@
 #include <string_view>
 #include <vector>
 
+#include <Blocxxi/Core/merkle.h>
 #include <Blocxxi/Crypto/hash.h>
 
 namespace blocxxi::core {
@@ -45,6 +46,10 @@ struct Transaction {
 
   [[nodiscard]] BLOCXXI_CORE_API auto PayloadText() const -> std::string;
 
+  // SHA-256d of the length-prefixed type, payload and metadata. This is the
+  // id FromText() assigns.
+  [[nodiscard]] BLOCXXI_CORE_API auto ComputeId() const -> TransactionId;
+
   friend auto operator==(Transaction const& lhs, Transaction const& rhs)
     -> bool = default;
 };
@@ -52,10 +57,16 @@ struct Transaction {
 struct BlockHeader {
   BlockId id {};
   BlockId previous_id {};
+  // Root of the merkle tree over the block's transaction ids (see merkle.h).
+  BlockId merkle_root {};
+  std::uint64_t transaction_count { 0 };
   Height height { 0 };
   std::int64_t timestamp_utc { 0 };
   std::string source { "local" };
 
+  // SHA-256d of every field above except `id`, in a fixed binary layout.
+  [[nodiscard]] BLOCXXI_CORE_API auto ComputeId() const -> BlockId;
+
   friend auto operator==(BlockHeader const& lhs, BlockHeader const& rhs)
     -> bool = default;
 };
@@ -69,6 +80,23 @@ struct Block {
     Height height,
     std::vector<Transaction> transactions,
     std::string source = "local") -> Block;
+  // As above, with the root over `transactions` already known, e.g. from a
+  // MerkleAccumulator fed as they arrived.
+  static BLOCXXI_CORE_API auto MakeNext(
+    BlockId previous_id,
+    Height height,
+    std::vector<Transaction> transactions,
+    BlockId merkle_root,
+    std::string source) -> Block;
+
+  [[nodiscard]] BLOCXXI_CORE_API auto ComputeMerkleRoot() const -> BlockId;
+  [[nodiscard]] BLOCXXI_CORE_API auto BuildMerkleTree() const -> MerkleTree;
+
+  // Proves that the transaction is committed to by header.merkle_root. This
+  // hashes the whole tree; stores that serve many proofs should keep the
+  // result of BuildMerkleTree() instead.
+  [[nodiscard]] BLOCXXI_CORE_API auto ProveInclusion(
+    TransactionId const& transaction_id) const -> std::optional<MerkleProof>;
 
   friend auto operator==(Block const& lhs, Block const& rhs) -> bool = default;
 };
@@ -114,6 +142,11 @@ public:
 
 using EventHandler = std::function<void(ChainEvent const& event)>;
 
+// Checks a proof from Block::ProveInclusion() against the root and transaction
+// count the header commits to.
+BLOCXXI_CORE_NDAPI auto VerifyInclusion(
+  MerkleProof const& proof, BlockHeader const& header) -> bool;
+
 BLOCXXI_CORE_NDAPI auto MakeId(std::string_view seed) -> blocxxi::crypto::Hash256;
 BLOCXXI_CORE_NDAPI auto ToBytes(std::string_view text) -> ByteVector;
 BLOCXXI_CORE_NDAPI auto ToString(ByteVector const& bytes) -> std::string;
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Core/signature_cache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <Blocxxi/Core/event_record.h>
+
+namespace blocxxi::core {
+namespace {
+
+struct SignatureCacheKeyHash {
+  auto operator()(SignatureCacheKey const& key) const -> std::size_t
+  {
+    // The digest is already uniformly distributed; fold in the signature so
+    // re-signed copies of the same content land in different buckets.
+    auto seed = std::size_t { 0 };
+    std::memcpy(&seed, key.content_digest.data(), sizeof(seed));
+    return seed ^ (std::hash<std::string_view> {}(key.signature_hex) << 1U);
+  }
+};
+
+} // namespace
+
+struct VerifiedSignatureCache::Shard {
+  using Order = std::list<SignatureCacheKey>;
+
+  std::mutex mutex {};
+  std::size_t capacity { 0 };
+  Order order {};
+  std::unordered_map<SignatureCacheKey, Order::iterator, SignatureCacheKeyHash>
+    entries {};
+};
+
+auto MakeSignatureCacheKey(SignedEventRecord const& record,
+  std::span<std::uint8_t const> canonical_bytes) -> SignatureCacheKey
+{
+  return SignatureCacheKey {
+    .content_digest = nova::ComputeSha256(std::as_bytes(canonical_bytes)),
+    .signer_public_key_hex = record.signer_public_key_hex,
+    .signature_hex = record.signature_hex,
+  };
+}
+
+VerifiedSignatureCache::VerifiedSignatureCache(std::size_t capacity)
+{
+  auto const per_shard = std::max(std::size_t { 1 }, (capacity + kShardCount - 1U) / kShardCount);
+  capacity_ = per_shard * kShardCount;
+  for (auto& shard : shards_) {
+    shard = std::make_unique<Shard>();
+    shard->capacity = per_shard;
+  }
+}
+
+VerifiedSignatureCache::~VerifiedSignatureCache() = default;
+
+auto VerifiedSignatureCache::ShardFor(SignatureCacheKey const& key) -> Shard&
+{
+  return *shards_[SignatureCacheKeyHash {}(key) % kShardCount];
+}
+
+auto VerifiedSignatureCache::Contains(SignatureCacheKey const& key) -> bool
+{
+  auto& shard = ShardFor(key);
+  {
+    auto const lock = std::lock_guard(shard.mutex);
+    auto const found = shard.entries.find(key);
+    if (found != shard.entries.end()) {
+      shard.order.splice(shard.order.begin(), shard.order, found->second);
+      hits_.fetch_add(1U, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  misses_.fetch_add(1U, std::memory_order_relaxed);
+  return false;
+}
+
+auto VerifiedSignatureCache::Insert(SignatureCacheKey key) -> void
+{
+  auto& shard = ShardFor(key);
+  auto const lock = std::lock_guard(shard.mutex);
+  auto const found = shard.entries.find(key);
+  if (found != shard.entries.end()) {
+    shard.order.splice(shard.order.begin(), shard.order, found->second);
+    return;
+  }
+
+  if (shard.entries.size() >= shard.capacity) {
+    shard.entries.erase(shard.order.back());
+    shard.order.pop_back();
+    evictions_.fetch_add(1U, std::memory_order_relaxed);
+  }
+  shard.order.push_front(std::move(key));
+  shard.entries.emplace(shard.order.front(), shard.order.begin());
+  insertions_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+auto VerifiedSignatureCache::Clear() -> void
+{
+  for (auto& shard : shards_) {
+    auto const lock = std::lock_guard(shard->mutex);
+    shard->entries.clear();
+    shard->order.clear();
+  }
+  hits_.store(0U, std::memory_order_relaxed);
+  misses_.store(0U, std::memory_order_relaxed);
+  insertions_.store(0U, std::memory_order_relaxed);
+  evictions_.store(0U, std::memory_order_relaxed);
+}
+
+auto VerifiedSignatureCache::Capacity() const -> std::size_t
+{
+  return capacity_;
+}
+
+auto VerifiedSignatureCache::Metrics() const -> SignatureCacheMetrics
+{
+  auto metrics = SignatureCacheMetrics {
+    .hits = hits_.load(std::memory_order_relaxed),
+    .misses = misses_.load(std::memory_order_relaxed),
+    .insertions = insertions_.load(std::memory_order_relaxed),
+    .evictions = evictions_.load(std::memory_order_relaxed),
+    .capacity = capacity_,
+  };
+  for (auto const& shard : shards_) {
+    auto const lock = std::lock_guard(shard->mutex);
+    metrics.size += shard->entries.size();
+  }
+  return metrics;
+}
+
+auto SharedSignatureCache() -> VerifiedSignatureCache&
+{
+  static auto cache = VerifiedSignatureCache {};
+  return cache;
+}
+
+} // namespace blocxxi::core
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Core/api_export.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include <Nova/Base/Sha256.h>
+
+namespace blocxxi::core {
+
+struct SignedEventRecord;
+
+struct SignatureCacheMetrics {
+  std::uint64_t hits { 0 };
+  std::uint64_t misses { 0 };
+  std::uint64_t insertions { 0 };
+  std::uint64_t evictions { 0 };
+  std::size_t size { 0 };
+  std::size_t capacity { 0 };
+
+  [[nodiscard]] auto Lookups() const -> std::uint64_t { return hits + misses; }
+  [[nodiscard]] auto HitRate() const -> double
+  {
+    auto const lookups = Lookups();
+    return lookups == 0U ? 0.0
+                         : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+};
+
+// Identifies a signature that already verified. The content is keyed by the
+// SHA-256 of the canonical bytes rather than EventEnvelope::ContentId(), which
+// is not collision resistant and so cannot stand in for the signed message.
+struct SignatureCacheKey {
+  nova::Sha256Digest content_digest {};
+  std::string signer_public_key_hex {};
+  std::string signature_hex {};
+
+  friend auto operator==(SignatureCacheKey const& lhs, SignatureCacheKey const& rhs)
+    -> bool = default;
+};
+
+[[nodiscard]] BLOCXXI_CORE_API auto MakeSignatureCacheKey(
+  SignedEventRecord const& record, std::span<std::uint8_t const> canonical_bytes)
+  -> SignatureCacheKey;
+
+// Bounded, thread-safe set of signatures known to be valid. Only successful
+// verifications are recorded, so a hit can safely skip the curve math. The set
+// is split in independently locked shards, each evicting its least recently
+// used entry when full.
+class VerifiedSignatureCache {
+public:
+  static constexpr auto kDefaultCapacity = std::size_t { 4096 };
+
+  BLOCXXI_CORE_API explicit VerifiedSignatureCache(
+    std::size_t capacity = kDefaultCapacity);
+  BLOCXXI_CORE_API ~VerifiedSignatureCache();
+
+  VerifiedSignatureCache(VerifiedSignatureCache const&) = delete;
+  auto operator=(VerifiedSignatureCache const&) -> VerifiedSignatureCache& = delete;
+  VerifiedSignatureCache(VerifiedSignatureCache&&) = delete;
+  auto operator=(VerifiedSignatureCache&&) -> VerifiedSignatureCache& = delete;
+
+  // Returns true and refreshes the entry when `key` already verified.
+  [[nodiscard]] BLOCXXI_CORE_API auto Contains(SignatureCacheKey const& key) -> bool;
+  BLOCXXI_CORE_API auto Insert(SignatureCacheKey key) -> void;
+  BLOCXXI_CORE_API auto Clear() -> void;
+
+  [[nodiscard]] BLOCXXI_CORE_API auto Capacity() const -> std::size_t;
+  [[nodiscard]] BLOCXXI_CORE_API auto Metrics() const -> SignatureCacheMetrics;
+
+private:
+  static constexpr auto kShardCount = std::size_t { 16 };
+
+  struct Shard;
+
+  auto ShardFor(SignatureCacheKey const& key) -> Shard&;
+
+  std::size_t capacity_ { 0 };
+  std::array<std::unique_ptr<Shard>, kShardCount> shards_ {};
+  std::atomic<std::uint64_t> hits_ { 0 };
+  std::atomic<std::uint64_t> misses_ { 0 };
+  std::atomic<std::uint64_t> insertions_ { 0 };
+  std::atomic<std::uint64_t> evictions_ { 0 };
+};
+
+// Process-wide cache consulted by VerifyEventRecord() and VerifyEventRecords().
+[[nodiscard]] BLOCXXI_CORE_API auto SharedSignatureCache() -> VerifiedSignatureCache&;
+
+} // namespace blocxxi::core
@@ -8,6 +8,13 @@
 
 #include <Blocxxi/Crypto/hash.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
 #if NOVA_MSVC_VERSION && !NOVA_CLANG_VERSION
 #include <iso646.h>
 #endif
@@ -254,6 +261,87 @@ TEST(HashTest, ToBitSet) {
       hash.ToBitSet().to_string());
 }
 
+// NOLINTNEXTLINE
+TEST(HashTest, IsTriviallyCopyableAndDense) {
+  static_assert(std::is_trivially_copyable_v<Hash160>);
+  static_assert(std::is_trivially_copyable_v<Hash512>);
+  static_assert(sizeof(Hash160) == 20);
+  static_assert(sizeof(std::array<Hash160, 3>) == 60);
+
+  const auto original = Hash160::RandomHash();
+  std::array<std::uint8_t, sizeof(Hash160)> raw{};
+  std::memcpy(raw.data(), &original, sizeof(original));
+  Hash160 copy;
+  std::memcpy(&copy, raw.data(), sizeof(copy));
+  ASSERT_EQ(original, copy);
+  ASSERT_TRUE(std::equal(raw.begin(), raw.end(), original.begin()));
+}
+
+// NOLINTNEXTLINE
+TEST(HashTest, LeadingZeroBitsAtEveryPosition) {
+  ASSERT_EQ(160U, Hash160().LeadingZeroBits());
+  ASSERT_EQ(256U, Hash256().LeadingZeroBits());
+  ASSERT_EQ(0U, Hash256::Max().LeadingZeroBits());
+  for (std::size_t bit = 0; bit < 160; ++bit) {
+    Hash160 h;
+    h[bit / 8] = static_cast<std::uint8_t>(0x80U >> (bit % 8));
+    // Bits below the first set one must not matter.
+    h.Back() |= 1U;
+    ASSERT_EQ(bit, h.LeadingZeroBits());
+  }
+  for (std::size_t bit = 0; bit < 512; bit += 7) {
+    Hash512 h;
+    h[bit / 8] = static_cast<std::uint8_t>(0x80U >> (bit % 8));
+    ASSERT_EQ(bit, h.LeadingZeroBits());
+    ASSERT_FALSE(h.IsAllZero());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashTest, EqualityAndOrderingAtEveryByte) {
+  const auto base = Hash160::RandomHash();
+  for (std::size_t pos = 0; pos < Hash160::Size(); ++pos) {
+    auto other = base;
+    other[pos] = static_cast<std::uint8_t>(other[pos] + 1);
+    ASSERT_NE(base, other);
+    const auto expected = std::lexicographical_compare(
+        base.begin(), base.end(), other.begin(), other.end());
+    ASSERT_EQ(expected, base < other);
+    ASSERT_EQ(!expected, other < base);
+    ASSERT_FALSE(base < base);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashTest, XorMatchesBytewiseXor) {
+  const auto lhs = Hash512::RandomHash();
+  const auto rhs = Hash512::RandomHash();
+  const auto res = lhs ^ rhs;
+  for (std::size_t pos = 0; pos < Hash512::Size(); ++pos) {
+    ASSERT_EQ(static_cast<std::uint8_t>(lhs[pos] ^ rhs[pos]), res[pos]);
+  }
+  ASSERT_TRUE((lhs ^ lhs).IsAllZero());
+}
+
+// NOLINTNEXTLINE
+TEST(HashTest, StdHashSpreadsPaddedValues) {
+  // Small counters padded with leading zeros differ only in their last bytes;
+  // a good hash must still give each one a distinct value.
+  std::unordered_set<std::size_t> values;
+  std::unordered_set<Hash256> hashes;
+  for (std::uint32_t counter = 0; counter < 1000; ++counter) {
+    const std::array<std::uint8_t, 2> bytes{
+        static_cast<std::uint8_t>(counter >> 8U),
+        static_cast<std::uint8_t>(counter & 0xFFU)};
+    const Hash256 h{std::span{bytes}};
+    values.insert(std::hash<Hash256>{}(h));
+    hashes.insert(h);
+    ASSERT_EQ(std::hash<Hash256>{}(h), std::hash<Hash256>{}(Hash256{h}));
+  }
+  ASSERT_EQ(1000U, values.size());
+  ASSERT_EQ(1000U, hashes.size());
+}
+
 } // namespace blocxxi::crypto
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
 NOVA_DIAGNOSTIC_POP
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause).
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <set>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <Blocxxi/Crypto/random.h>
+
+namespace blocxxi::crypto::random {
+namespace {
+
+using Block = std::array<std::uint8_t, 32>;
+
+auto Draw() -> Block
+{
+  auto block = Block {};
+  GenerateBlock(block.data(), block.size());
+  return block;
+}
+
+auto IsAllZero(std::span<std::uint8_t const> bytes) -> bool
+{
+  return std::all_of(bytes.begin(), bytes.end(), [](auto value) { return value == 0U; });
+}
+
+} // namespace
+
+TEST(RandomTest, ConsecutiveDrawsDiffer)
+{
+  auto seen = std::set<Block> {};
+  for (auto round = 0; round < 256; ++round) {
+    EXPECT_TRUE(seen.insert(Draw()).second);
+  }
+}
+
+TEST(RandomTest, FillsRequestsOfAnySize)
+{
+  for (auto const size : { std::size_t { 1 }, std::size_t { 63 }, std::size_t { 481 },
+         std::size_t { 4096 }, std::size_t { 70000 } }) {
+    auto bytes = std::vector<std::uint8_t>(size + 2, 0xA5U);
+    GenerateBlock(bytes.data() + 1, size);
+
+    // Guard bytes around the request are left untouched.
+    EXPECT_EQ(bytes.front(), 0xA5U);
+    EXPECT_EQ(bytes.back(), 0xA5U);
+    if (size >= 32) {
+      EXPECT_FALSE(IsAllZero(std::span<std::uint8_t const>(bytes).subspan(1, size)));
+    }
+  }
+}
+
+TEST(RandomTest, ThreadsDrawIndependentStreams)
+{
+  constexpr auto kThreads = 4;
+  auto draws = std::vector<Block>(kThreads);
+  auto threads = std::vector<std::thread> {};
+  for (auto index = 0; index < kThreads; ++index) {
+    threads.emplace_back([&draws, index] { draws[static_cast<std::size_t>(index)] = Draw(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto const distinct = std::set<Block>(draws.begin(), draws.end());
+  EXPECT_EQ(distinct.size(), draws.size());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(RandomTest, ForkedChildDoesNotReplayParentStream)
+{
+  // Make sure the parent generator is seeded and has buffered keystream.
+  (void)Draw();
+
+  auto pipe_ends = std::array<int, 2> {};
+  ASSERT_EQ(::pipe(pipe_ends.data()), 0);
+  auto const child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    auto const block = Draw();
+    auto const written = ::write(pipe_ends[1], block.data(), block.size());
+    ::_exit(written == static_cast<ssize_t>(block.size()) ? 0 : 1);
+  }
+
+  auto const parent_block = Draw();
+  auto child_block = Block {};
+  auto const received = ::read(pipe_ends[0], child_block.data(), child_block.size());
+  auto status = 0;
+  ::waitpid(child, &status, 0);
+  ::close(pipe_ends[0]);
+  ::close(pipe_ends[1]);
+
+  ASSERT_EQ(received, static_cast<ssize_t>(child_block.size()));
+  EXPECT_NE(parent_block, child_block);
+}
+#endif
+
+} // namespace blocxxi::crypto::random
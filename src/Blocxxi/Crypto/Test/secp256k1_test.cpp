@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause).
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include <Blocxxi/Codec/base16.h>
+#include <Blocxxi/Crypto/keypair.h>
+#include <Blocxxi/Crypto/secp256k1.h>
+
+namespace blocxxi::crypto::secp256k1 {
+namespace {
+
+auto ScalarFromHex(std::string const& hex) -> Scalar
+{
+  auto scalar = Scalar {};
+  auto const padded = std::string(kScalarSize * 2 - hex.size(), '0') + hex;
+  codec::hex::Decode(padded, scalar);
+  return scalar;
+}
+
+auto ToHex(std::span<std::uint8_t const> bytes) -> std::string
+{
+  return codec::hex::Encode(bytes, false, true);
+}
+
+constexpr auto kGeneratorHex = "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+                               "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+constexpr auto kOrderHex = "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141";
+
+} // namespace
+
+TEST(Secp256k1Test, SecretOneDerivesGenerator)
+{
+  auto const public_key = DerivePublicKey(ScalarFromHex("01"));
+
+  ASSERT_TRUE(public_key.has_value());
+  EXPECT_EQ(ToHex(*public_key), kGeneratorHex);
+}
+
+TEST(Secp256k1Test, DerivePublicKeyMatchesKeyPair)
+{
+  for (auto round = 0; round < 8; ++round) {
+    auto const key_pair = KeyPair();
+    auto secret = Scalar {};
+    std::copy_n(key_pair.Secret().Data(), secret.size(), secret.begin());
+
+    auto const public_key = DerivePublicKey(secret);
+
+    ASSERT_TRUE(public_key.has_value());
+    EXPECT_EQ(ToHex(*public_key), key_pair.Public().ToHex());
+  }
+}
+
+TEST(Secp256k1Test, DerivePublicKeyRejectsOutOfRangeSecrets)
+{
+  EXPECT_FALSE(DerivePublicKey(Scalar {}).has_value());
+  EXPECT_FALSE(DerivePublicKey(ScalarFromHex(kOrderHex)).has_value());
+  EXPECT_FALSE(SignDigest(Scalar {}, Scalar {}).has_value());
+}
+
+TEST(Secp256k1Test, ParseRejectsPointsOffTheCurve)
+{
+  auto encoded = PublicKeyBytes {};
+  codec::hex::Decode(kGeneratorHex, encoded);
+  ASSERT_TRUE(PublicKeyContext::Parse(encoded).has_value());
+
+  encoded.back() ^= 0x01U;
+
+  EXPECT_FALSE(PublicKeyContext::Parse(encoded).has_value());
+}
+
+TEST(Secp256k1Test, VerifyRejectsMalformedSignatures)
+{
+  auto const secret = ScalarFromHex("c0ffee");
+  auto const digest = ScalarFromHex("0123456789abcdef");
+  auto const public_key = DerivePublicKey(secret);
+  ASSERT_TRUE(public_key.has_value());
+  auto const context = PublicKeyContext::Parse(*public_key);
+  ASSERT_TRUE(context.has_value());
+  auto const signature = SignDigest(secret, digest);
+  ASSERT_TRUE(signature.has_value());
+  ASSERT_TRUE(context->VerifyDigest(digest, *signature));
+
+  auto truncated = std::span<std::uint8_t const>(*signature).first(kSignatureSize - 1);
+  EXPECT_FALSE(context->VerifyDigest(digest, truncated));
+
+  auto zero_r = *signature;
+  std::fill_n(zero_r.begin(), kScalarSize, std::uint8_t { 0 });
+  EXPECT_FALSE(context->VerifyDigest(digest, zero_r));
+
+  auto order_s = *signature;
+  auto const order = ScalarFromHex(kOrderHex);
+  std::copy(order.begin(), order.end(), order_s.begin() + kScalarSize);
+  EXPECT_FALSE(context->VerifyDigest(digest, order_s));
+}
+
+TEST(Secp256k1Test, HighSSignatureStillVerifies)
+{
+  auto const secret = ScalarFromHex("5eed");
+  auto const digest = ScalarFromHex("feedface");
+  auto const public_key = DerivePublicKey(secret);
+  ASSERT_TRUE(public_key.has_value());
+  auto const context = PublicKeyContext::Parse(*public_key);
+  ASSERT_TRUE(context.has_value());
+  auto signature = SignDigest(secret, digest);
+  ASSERT_TRUE(signature.has_value());
+
+  // Negate s modulo the group order: (r, n - s) is the high-s twin.
+  auto const order = ScalarFromHex(kOrderHex);
+  auto borrow = 0;
+  for (auto index = kScalarSize; index-- > 0;) {
+    auto const diff = static_cast<int>(order[index]) - (*signature)[kScalarSize + index] - borrow;
+    borrow = diff < 0 ? 1 : 0;
+    (*signature)[kScalarSize + index] = static_cast<std::uint8_t>(diff + (borrow * 256));
+  }
+
+  EXPECT_TRUE(context->VerifyDigest(digest, *signature));
+}
+
+} // namespace blocxxi::crypto::secp256k1
@@ -15,6 +15,10 @@
 
 #include <Blocxxi/Crypto/signature.h>
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace blocxxi::crypto {
 namespace {
 
@@ -31,6 +35,18 @@ auto MakePrivateKey(KeyPair const& key_pair) -> PrivateKeyType
   return private_key;
 }
 
+auto MakePublicKey(KeyPair const& key_pair) -> PublicKeyType
+{
+  auto public_key = PublicKeyType {};
+  MakePrivateKey(key_pair).MakePublicKey(public_key);
+  return public_key;
+}
+
+auto PayloadOf(std::string_view text) -> std::vector<std::uint8_t>
+{
+  return { text.begin(), text.end() };
+}
+
 } // namespace
 
 TEST(SignatureTest, SignAndVerifyRoundTrip)
@@ -72,4 +88,58 @@ TEST(SignatureTest, VerifyRejectsTamperedPayload)
   EXPECT_FALSE(VerifyMessageHex(key_pair.Public(), tampered, signature_hex));
 }
 
+// CryptoPP stays the reference implementation: signatures must interoperate in
+// both directions.
+TEST(SignatureTest, ReferenceImplementationVerifiesSignatures)
+{
+  for (auto round = 0; round < 8; ++round) {
+    auto key_pair = KeyPair();
+    auto const payload = PayloadOf("signed by the native backend " + std::to_string(round));
+    auto verifier = cr::ECDSA<cr::ECP, cr::SHA256>::Verifier(MakePublicKey(key_pair));
+
+    auto const signature = SignMessage(key_pair, payload);
+
+    ASSERT_EQ(signature.size(), verifier.SignatureLength());
+    EXPECT_TRUE(verifier.VerifyMessage(
+      payload.data(), payload.size(), signature.data(), signature.size()));
+  }
+}
+
+TEST(SignatureTest, VerifiesReferenceImplementationSignatures)
+{
+  auto prng = cr::AutoSeededRandomPool {};
+  for (auto round = 0; round < 8; ++round) {
+    auto key_pair = KeyPair();
+    auto const payload = PayloadOf("signed by the reference " + std::to_string(round));
+    auto signer = cr::ECDSA<cr::ECP, cr::SHA256>::Signer(MakePrivateKey(key_pair));
+    auto signature = SignatureBytes(signer.MaxSignatureLength());
+    signature.resize(
+      signer.SignMessage(prng, payload.data(), payload.size(), signature.data()));
+    auto const verifier = SignatureVerifier(key_pair.Public());
+
+    // Random nonces give high-s signatures half of the time; both are valid.
+    EXPECT_TRUE(VerifyMessage(key_pair.Public(), payload, signature));
+    EXPECT_TRUE(verifier.Verify(payload, signature));
+  }
+}
+
+TEST(SignatureTest, SigningIsDeterministic)
+{
+  auto key_pair = KeyPair();
+  auto const payload = PayloadOf("same message, same nonce");
+
+  EXPECT_EQ(SignMessageHex(key_pair, payload), SignMessageHex(key_pair, payload));
+}
+
+TEST(SignatureTest, MatchesRfc6979Vector)
+{
+  auto const key_pair = KeyPair(std::string(63, '0') + "1");
+
+  auto const signature_hex = SignMessageHex(key_pair, PayloadOf("Satoshi Nakamoto"));
+
+  EXPECT_EQ(signature_hex,
+    "934b1ea10a4b3c1757e2b0c017d0b6143ce3c9a7e6a4a49860d7a6ab210ee3d8"
+    "2442ce9d2b916064108014783e923ec36b49743e2ffa1c4496f01a512aafd9e5");
+}
+
 } // namespace blocxxi::crypto
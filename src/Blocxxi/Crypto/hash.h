@@ -14,17 +14,44 @@
 #include <cstddef>
 #include <cstdint> // for standard int types
 #include <cstring> // for std::memcpy
+#include <functional> // for std::hash
 #include <iosfwd> // for implementation of operator<<
 #include <iterator> // for std::reverse_iterator
 #include <string> // for std::string
 
 #include <span>
+#include <type_traits>
 
+#include <Nova/Base/Compilers.h>
 #include <Nova/Base/Logging.h>
 
 #include <Blocxxi/Codec/base16.h> // for hex enc/decoding
 #include <Blocxxi/Crypto/random.h> // for random block generation
 
+NOVA_DIAGNOSTIC_PUSH
+#if NOVA_CLANG_VERSION && NOVA_HAS_WARNING("-Wreserved-macro-identifier")
+#  pragma clang diagnostic ignored "-Wreserved-macro-identifier"
+#endif
+#if NOVA_CLANG_VERSION && NOVA_HAS_WARNING("-Wreserved-identifier")
+#  pragma clang diagnostic ignored "-Wreserved-identifier"
+#endif
+#include <bit> // for std::countl_zero, std::countr_zero
+NOVA_DIAGNOSTIC_POP
+
+#if defined(__SSE2__) || defined(_M_X64)                                       \
+  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BLOCXXI_HASH_USE_SSE2 1
+#  include <emmintrin.h>
+#else
+#  define BLOCXXI_HASH_USE_SSE2 0
+#endif
+#if defined(__AVX2__)
+#  define BLOCXXI_HASH_USE_AVX2 1
+#  include <immintrin.h>
+#else
+#  define BLOCXXI_HASH_USE_AVX2 0
+#endif
+
 namespace blocxxi::crypto {
 
 namespace detail {
@@ -39,6 +66,201 @@ namespace detail {
   BLOCXXI_CRYPTO_API auto CountLeadingZeroBits(
     std::span<std::uint32_t const> buf) -> size_t;
 
+  /// @name Fixed-size byte primitives
+  /// Operate on the raw storage of a Hash, `N` bytes long (a multiple of 4).
+  /// Whole 32-byte (AVX2) and 16-byte (SSE2) chunks go through vector
+  /// registers with unaligned loads; what remains, such as the last 4 bytes of
+  /// a 160-bit hash, is handled one 32-bit word at a time. The sizes are
+  /// compile-time constants, so the loops fully unroll.
+  //@{
+  inline auto LoadWord(std::uint8_t const* ptr, std::size_t pos) noexcept
+    -> std::uint32_t
+  {
+    std::uint32_t word;
+    std::memcpy(&word, ptr + pos, sizeof(word));
+    return word;
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+#if BLOCXXI_HASH_USE_SSE2
+  inline auto Load128(std::uint8_t const* ptr) noexcept -> __m128i
+  {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr));
+  }
+  inline void Store128(std::uint8_t* ptr, __m128i value) noexcept
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value);
+  }
+#endif
+#if BLOCXXI_HASH_USE_AVX2
+  inline auto Load256(std::uint8_t const* ptr) noexcept -> __m256i
+  {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr));
+  }
+  inline void Store256(std::uint8_t* ptr, __m256i value) noexcept
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value);
+  }
+#endif
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  /// Returns true if the two buffers hold the same bytes.
+  template <std::size_t N>
+  inline auto BytesEqual(
+    std::uint8_t const* lhs, std::uint8_t const* rhs) noexcept -> bool
+  {
+    std::size_t pos = 0;
+#if BLOCXXI_HASH_USE_AVX2
+    for (; pos + 32 <= N; pos += 32) {
+      const auto a = Load256(lhs + pos);
+      const auto b = Load256(rhs + pos);
+      if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != -1) {
+        return false;
+      }
+    }
+#endif
+#if BLOCXXI_HASH_USE_SSE2
+    for (; pos + 16 <= N; pos += 16) {
+      const auto a = Load128(lhs + pos);
+      const auto b = Load128(rhs + pos);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) {
+        return false;
+      }
+    }
+#endif
+    for (; pos < N; pos += 4) {
+      if (LoadWord(lhs, pos) != LoadWord(rhs, pos)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Returns the index of the first byte that differs between the two buffers,
+  /// or `N` if they are equal.
+  template <std::size_t N>
+  inline auto FirstMismatch(
+    std::uint8_t const* lhs, std::uint8_t const* rhs) noexcept -> std::size_t
+  {
+    std::size_t pos = 0;
+#if BLOCXXI_HASH_USE_AVX2
+    for (; pos + 32 <= N; pos += 32) {
+      const auto a = Load256(lhs + pos);
+      const auto b = Load256(rhs + pos);
+      const auto diff = ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+      if (diff != 0) {
+        return pos + static_cast<std::size_t>(std::countr_zero(diff));
+      }
+    }
+#endif
+#if BLOCXXI_HASH_USE_SSE2
+    for (; pos + 16 <= N; pos += 16) {
+      const auto a = Load128(lhs + pos);
+      const auto b = Load128(rhs + pos);
+      const auto diff
+        = ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)))
+        & 0xFFFFU;
+      if (diff != 0) {
+        return pos + static_cast<std::size_t>(std::countr_zero(diff));
+      }
+    }
+#endif
+    for (; pos < N; ++pos) {
+      if (lhs[pos] != rhs[pos]) {
+        return pos;
+      }
+    }
+    return N;
+  }
+
+  /// Returns the index of the first non-zero byte, or `N` if all are zero.
+  template <std::size_t N>
+  inline auto FirstNonZero(std::uint8_t const* buf) noexcept -> std::size_t
+  {
+    std::size_t pos = 0;
+#if BLOCXXI_HASH_USE_AVX2
+    for (; pos + 32 <= N; pos += 32) {
+      const auto a = Load256(buf + pos);
+      const auto set = ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256())));
+      if (set != 0) {
+        return pos + static_cast<std::size_t>(std::countr_zero(set));
+      }
+    }
+#endif
+#if BLOCXXI_HASH_USE_SSE2
+    for (; pos + 16 <= N; pos += 16) {
+      const auto a = Load128(buf + pos);
+      const auto zero = _mm_cmpeq_epi8(a, _mm_setzero_si128());
+      const auto set
+        = ~static_cast<std::uint32_t>(_mm_movemask_epi8(zero)) & 0xFFFFU;
+      if (set != 0) {
+        return pos + static_cast<std::size_t>(std::countr_zero(set));
+      }
+    }
+#endif
+    for (; pos < N; ++pos) {
+      if (buf[pos] != 0) {
+        return pos;
+      }
+    }
+    return N;
+  }
+
+  /// In-place `dst ^= src`.
+  template <std::size_t N>
+  inline void XorBytes(std::uint8_t* dst, std::uint8_t const* src) noexcept
+  {
+    std::size_t pos = 0;
+#if BLOCXXI_HASH_USE_AVX2
+    for (; pos + 32 <= N; pos += 32) {
+      const auto a = Load256(dst + pos);
+      const auto b = Load256(src + pos);
+      Store256(dst + pos, _mm256_xor_si256(a, b));
+    }
+#endif
+#if BLOCXXI_HASH_USE_SSE2
+    for (; pos + 16 <= N; pos += 16) {
+      const auto a = Load128(dst + pos);
+      const auto b = Load128(src + pos);
+      Store128(dst + pos, _mm_xor_si128(a, b));
+    }
+#endif
+    for (; pos < N; pos += 4) {
+      const auto word = LoadWord(dst, pos) ^ LoadWord(src, pos);
+      std::memcpy(dst + pos, &word, sizeof(word));
+    }
+  }
+
+  /// Folds the buffer into a 64-bit value in which every input bit affects
+  /// every output bit, so that hashes with long runs of zero bytes (e.g.
+  /// padded identifiers) still spread over hash table buckets.
+  template <std::size_t N>
+  inline auto MixBytes(std::uint8_t const* buf) noexcept -> std::uint64_t
+  {
+    constexpr std::uint64_t c_multiplier = 0x9e3779b97f4a7c15ULL;
+    std::uint64_t acc = N;
+    std::size_t pos = 0;
+    for (; pos + 8 <= N; pos += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, buf + pos, sizeof(word));
+      acc = (acc ^ word) * c_multiplier;
+      acc ^= acc >> 32U;
+    }
+    if constexpr (N % 8 != 0) {
+      acc = (acc ^ LoadWord(buf, pos)) * c_multiplier;
+    }
+    // Final avalanche from MurmurHash3 (fmix64).
+    acc ^= acc >> 33U;
+    acc *= 0xff51afd7ed558ccdULL;
+    acc ^= acc >> 33U;
+    acc *= 0xc4ceb9fe1a85ec53ULL;
+    acc ^= acc >> 33U;
+    return acc;
+  }
+  //@}
+
 } // namespace detail
 
 constexpr std::size_t c_hash_align_at = 32;
@@ -49,6 +271,11 @@ constexpr std::size_t c_hash_align_at = 32;
    has almost the same semantics of std::array<> except that it will never be
    zero-length (size() is always > 0). It offers a number of additional
    convenience methods, such as bitwise arithemtics, comparisons etc.
+
+   Hash is a plain value type: it is trivially copyable, has no padding
+   (`sizeof(Hash<N>) == N / 8`), and can therefore be memcpy'd and packed
+   densely in arrays, stores and flat hash maps. Equality, ordering, XOR and
+   leading zero counts run on SIMD registers where available.
  */
 template <std::size_t BITS> class Hash {
   static_assert(
@@ -71,10 +298,7 @@ public:
   ///@name Constructors and Factory methods
   //@{
   /// Initializes the hash with all '0' bits
-  Hash()
-    : storage_({})
-  {
-  }
+  constexpr Hash() noexcept = default;
 
   Hash(const Hash& other) = default;
 
@@ -84,7 +308,7 @@ public:
 
   auto operator=(Hash&& rhs) noexcept -> Hash& = default;
 
-  virtual ~Hash() = default;
+  ~Hash() = default;
 
   /*!
   \brief Construct a Hash by assigning content from the provided sequence of
@@ -193,7 +417,7 @@ public:
   {
     CHECK_F(pos < Size(), "hash index out of range");
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    return reinterpret_cast<pointer>(storage_.data())[pos];
+    return reinterpret_cast<const_pointer>(storage_.data())[pos];
   }
 
   /// Returns a reference to the first element in the container.
@@ -311,12 +535,7 @@ public:
   /// Return true if all bits are set to 0.
   [[nodiscard]] auto IsAllZero() const -> bool
   {
-    for (auto chunk : storage_) {
-      if (chunk != 0) {
-        return false;
-      }
-    }
-    return true;
+    return detail::FirstNonZero<Size()>(Data()) == Size();
   }
 
   /// Exchanges the contents of the container with those of other. Does not
@@ -326,7 +545,18 @@ public:
   /// Count leading zero bits.
   [[nodiscard]] auto LeadingZeroBits() const -> size_t
   {
-    return detail::CountLeadingZeroBits(std::span(storage_));
+    const auto pos = detail::FirstNonZero<Size()>(Data());
+    if (pos == Size()) {
+      return BITS;
+    }
+    return (pos * 8) + static_cast<size_t>(std::countl_zero(Data()[pos]));
+  }
+
+  /// A well-mixed 64-bit digest of the contents, suitable for hash tables.
+  /// Not stable across platforms of different endianness.
+  [[nodiscard]] auto HashValue() const noexcept -> std::uint64_t
+  {
+    return detail::MixBytes<Size()>(Data());
   }
 
   /// @name Comparison operators
@@ -340,33 +570,22 @@ public:
   /// the same position.
   friend auto operator==(const Hash<BITS>& lhs, const Hash<BITS>& rhs) -> bool
   {
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    return detail::BytesEqual<Size()>(lhs.Data(), rhs.Data());
   }
   /// \brief Compares the contents of `lhs` and `rhs` lexicographically. The
   /// comparison is performed by a function equivalent to
   /// `std::lexicographical_compare`.
   friend auto operator<(const Hash<BITS>& lhs, const Hash<BITS>& rhs) -> bool
   {
-    for (std::size_t i = 0; i < SIZE_DWORD; ++i) {
-      std::uint32_t const native_lhs = detail::NetworkToHost(lhs.storage_[i]);
-      std::uint32_t const native_rhs = detail::NetworkToHost(rhs.storage_[i]);
-      if (native_lhs < native_rhs) {
-        return true;
-      }
-      if (native_lhs > native_rhs) {
-        return false;
-      }
-    }
-    return false;
+    const auto pos = detail::FirstMismatch<Size()>(lhs.Data(), rhs.Data());
+    return pos != Size() && lhs.Data()[pos] < rhs.Data()[pos];
   }
   //@}
 
   /// In-place bitwise XOR with the given other hash.
   auto operator^=(Hash const& other) noexcept -> Hash&
   {
-    for (std::size_t i = 0; i < SIZE_DWORD; ++i) {
-      storage_[i] ^= other.storage_[i];
-    }
+    detail::XorBytes<Size()>(Data(), other.Data());
     return *this;
   }
 
@@ -444,7 +663,7 @@ private:
   /// if it were a byte array laid out in network order (big endian).
   ///
   /// > First DWORD is the most significant 4 bytes.
-  std::array<std::uint32_t, SIZE_DWORD> storage_;
+  std::array<std::uint32_t, SIZE_DWORD> storage_ {};
 };
 
 /// @name Comparison operators
@@ -504,4 +723,17 @@ using Hash512 = Hash<512>; // 64 bytes
 using Hash256 = Hash<256>; // 32 bytes
 using Hash160 = Hash<160>; // 20 bytes
 
+static_assert(std::is_trivially_copyable_v<Hash256>);
+static_assert(sizeof(Hash256) == Hash256::Size());
+static_assert(sizeof(Hash160) == Hash160::Size());
+
 } // namespace blocxxi::crypto
+
+/// Hashes a blocxxi::crypto::Hash for use as an unordered container key.
+template <std::size_t BITS> struct std::hash<blocxxi::crypto::Hash<BITS>> {
+  [[nodiscard]] auto operator()(
+    blocxxi::crypto::Hash<BITS> const& hash) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(hash.HashValue());
+  }
+};
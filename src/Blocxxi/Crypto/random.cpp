@@ -6,13 +6,220 @@
 
 #include <Blocxxi/Crypto/random.h>
 
-#include <cryptopp/osrng.h> // for random number generation
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/random.h> // for getrandom
+#elif defined(__APPLE__)
+#include <unistd.h> // for getentropy
+#else
+#include <cryptopp/osrng.h> // for OS_GenerateBlock
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h> // for pthread_atfork
+#endif
 
 namespace blocxxi::crypto::random {
 
+namespace {
+
+constexpr std::size_t kKeySize = 32;
+constexpr std::size_t kBlockSize = 64;
+constexpr std::size_t kBlocksPerRefill = 8;
+constexpr std::size_t kBufferSize = kBlockSize * kBlocksPerRefill;
+// Bytes served between two reseeds from the operating system.
+constexpr std::size_t kReseedInterval = std::size_t { 1 } << 20;
+
+void OsGenerateBlock(std::uint8_t *output, std::size_t size) {
+#if defined(__linux__)
+  while (size > 0) {
+    auto const count = ::getrandom(output, size, 0);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("getrandom failed");
+    }
+    output += count;
+    size -= static_cast<std::size_t>(count);
+  }
+#elif defined(__APPLE__)
+  // getentropy serves at most 256 bytes per call.
+  constexpr std::size_t kMaxChunk = 256;
+  while (size > 0) {
+    auto const chunk = std::min(size, kMaxChunk);
+    if (::getentropy(output, chunk) != 0) {
+      throw std::runtime_error("getentropy failed");
+    }
+    output += chunk;
+    size -= chunk;
+  }
+#else
+  CryptoPP::OS_GenerateBlock(false, output, size);
+#endif
+}
+
+// Bumped in every child process after a fork. Generators seeded under an older
+// generation reseed before serving another byte.
+std::atomic<std::uint64_t> fork_generation { 0 };
+
+void RegisterForkHandler() {
+#if defined(__unix__) || defined(__APPLE__)
+  static auto const registered = [] {
+    ::pthread_atfork(nullptr, nullptr,
+        [] { fork_generation.fetch_add(1, std::memory_order_relaxed); });
+    return true;
+  }();
+  (void)registered;
+#endif
+}
+
+inline auto RotateLeft(std::uint32_t value, int bits) -> std::uint32_t {
+  return (value << bits) | (value >> (32 - bits));
+}
+
+inline void QuarterRound(std::array<std::uint32_t, 16> &x, std::size_t a,
+    std::size_t b, std::size_t c, std::size_t d) {
+  x[a] += x[b];
+  x[d] = RotateLeft(x[d] ^ x[a], 16);
+  x[c] += x[d];
+  x[b] = RotateLeft(x[b] ^ x[c], 12);
+  x[a] += x[b];
+  x[d] = RotateLeft(x[d] ^ x[a], 8);
+  x[c] += x[d];
+  x[b] = RotateLeft(x[b] ^ x[c], 7);
+}
+
+inline auto LoadLittleEndian(std::uint8_t const *input) -> std::uint32_t {
+  return static_cast<std::uint32_t>(input[0])
+         | (static_cast<std::uint32_t>(input[1]) << 8)
+         | (static_cast<std::uint32_t>(input[2]) << 16)
+         | (static_cast<std::uint32_t>(input[3]) << 24);
+}
+
+inline void StoreLittleEndian(std::uint8_t *output, std::uint32_t value) {
+  output[0] = static_cast<std::uint8_t>(value);
+  output[1] = static_cast<std::uint8_t>(value >> 8);
+  output[2] = static_cast<std::uint8_t>(value >> 16);
+  output[3] = static_cast<std::uint8_t>(value >> 24);
+}
+
+// One ChaCha20 block (RFC 8439) with a 64-bit block counter and a zero nonce.
+// Every refill switches to a fresh key, so nonces are never needed.
+void ChaCha20Block(std::array<std::uint8_t, kKeySize> const &key,
+    std::uint64_t counter, std::uint8_t *output) {
+  auto state = std::array<std::uint32_t, 16> {
+      0x61707865U, 0x3320646eU, 0x79622d32U, 0x6b206574U};
+  for (std::size_t word = 0; word < 8; ++word) {
+    state[4 + word] = LoadLittleEndian(key.data() + (word * 4));
+  }
+  state[12] = static_cast<std::uint32_t>(counter);
+  state[13] = static_cast<std::uint32_t>(counter >> 32);
+
+  auto working = state;
+  for (auto round = 0; round < 10; ++round) {
+    QuarterRound(working, 0, 4, 8, 12);
+    QuarterRound(working, 1, 5, 9, 13);
+    QuarterRound(working, 2, 6, 10, 14);
+    QuarterRound(working, 3, 7, 11, 15);
+    QuarterRound(working, 0, 5, 10, 15);
+    QuarterRound(working, 1, 6, 11, 12);
+    QuarterRound(working, 2, 7, 8, 13);
+    QuarterRound(working, 3, 4, 9, 14);
+  }
+  for (std::size_t word = 0; word < 16; ++word) {
+    StoreLittleEndian(output + (word * 4), working[word] + state[word]);
+  }
+}
+
+// Fast-key-erasure generator: each refill expands the current key into a
+// buffer of keystream, immediately overwrites the key with the first bytes of
+// that keystream and serves the rest. Served bytes are wiped from the buffer,
+// so a later compromise of the state does not reveal earlier output.
+class ThreadGenerator {
+public:
+  ThreadGenerator() { RegisterForkHandler(); }
+
+  ~ThreadGenerator() {
+    Wipe(key_.data(), key_.size());
+    Wipe(buffer_.data(), buffer_.size());
+  }
+
+  ThreadGenerator(ThreadGenerator const &) = delete;
+  auto operator=(ThreadGenerator const &) -> ThreadGenerator & = delete;
+  ThreadGenerator(ThreadGenerator &&) = delete;
+  auto operator=(ThreadGenerator &&) -> ThreadGenerator & = delete;
+
+  void Generate(std::uint8_t *output, std::size_t size) {
+    if (!seeded_
+        || generation_ != fork_generation.load(std::memory_order_relaxed)
+        || served_since_reseed_ >= kReseedInterval) {
+      Reseed();
+    }
+    served_since_reseed_ += size;
+
+    while (size > 0) {
+      if (position_ == buffer_.size()) {
+        Refill();
+      }
+      auto const count = std::min(size, buffer_.size() - position_);
+      std::memcpy(output, buffer_.data() + position_, count);
+      Wipe(buffer_.data() + position_, count);
+      position_ += count;
+      output += count;
+      size -= count;
+    }
+  }
+
+private:
+  static void Wipe(std::uint8_t *data, std::size_t size) {
+    std::fill_n(static_cast<std::uint8_t volatile *>(data), size, 0U);
+  }
+
+  void Reseed() {
+    auto fresh = std::array<std::uint8_t, kKeySize> {};
+    OsGenerateBlock(fresh.data(), fresh.size());
+    // Mix rather than replace, so a weak OS source cannot make things worse.
+    for (std::size_t index = 0; index < kKeySize; ++index) {
+      key_[index] ^= fresh[index];
+    }
+    Wipe(fresh.data(), fresh.size());
+    Wipe(buffer_.data(), buffer_.size());
+    position_ = buffer_.size();
+    served_since_reseed_ = 0;
+    generation_ = fork_generation.load(std::memory_order_relaxed);
+    seeded_ = true;
+  }
+
+  void Refill() {
+    for (std::size_t block = 0; block < kBlocksPerRefill; ++block) {
+      ChaCha20Block(key_, counter_++, buffer_.data() + (block * kBlockSize));
+    }
+    std::memcpy(key_.data(), buffer_.data(), kKeySize);
+    Wipe(buffer_.data(), kKeySize);
+    position_ = kKeySize;
+  }
+
+  std::array<std::uint8_t, kKeySize> key_ {};
+  std::array<std::uint8_t, kBufferSize> buffer_ {};
+  std::size_t position_ {kBufferSize};
+  std::uint64_t counter_ {0};
+  std::size_t served_since_reseed_ {0};
+  std::uint64_t generation_ {0};
+  bool seeded_ {false};
+};
+
+} // namespace
+
 void GenerateBlock(std::uint8_t *output, std::size_t size) {
-  CryptoPP::AutoSeededRandomPool rng;
-  rng.GenerateBlock(output, size);
+  thread_local ThreadGenerator generator;
+  generator.Generate(output, size);
 }
 
 } // namespace blocxxi::crypto::random
@@ -13,6 +13,12 @@
 
 namespace blocxxi::crypto::random {
 
+// Fills `output` with cryptographically secure random bytes.
+//
+// Each thread owns a ChaCha20 generator seeded from the operating system and
+// serves bytes from a small keystream buffer, so most calls do not enter the
+// kernel. The key is replaced after every refill, the generator reseeds from
+// the OS periodically, and a forked child never replays its parent's stream.
 BLOCXXI_CRYPTO_API void GenerateBlock(std::uint8_t *output, std::size_t size);
 
 } // namespace blocxxi::crypto::random
@@ -0,0 +1,1212 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause).
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Crypto/secp256k1.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace blocxxi::crypto::secp256k1 {
+namespace {
+
+using Limbs = std::array<std::uint64_t, 4>;
+
+// -- Wide word helpers --------------------------------------------------------
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 Uint128; // NOLINT(modernize-use-using)
+
+inline auto MulWide(std::uint64_t a, std::uint64_t b, std::uint64_t& high)
+  -> std::uint64_t
+{
+  auto const product = static_cast<Uint128>(a) * b;
+  high = static_cast<std::uint64_t>(product >> 64U);
+  return static_cast<std::uint64_t>(product);
+}
+
+inline auto AddCarry(std::uint64_t a, std::uint64_t b, std::uint64_t& carry)
+  -> std::uint64_t
+{
+  auto const sum = static_cast<Uint128>(a) + b + carry;
+  carry = static_cast<std::uint64_t>(sum >> 64U);
+  return static_cast<std::uint64_t>(sum);
+}
+
+inline auto SubBorrow(std::uint64_t a, std::uint64_t b, std::uint64_t& borrow)
+  -> std::uint64_t
+{
+  auto const difference = static_cast<Uint128>(a) - b - borrow;
+  borrow = static_cast<std::uint64_t>(difference >> 64U) & 1U;
+  return static_cast<std::uint64_t>(difference);
+}
+
+// Returns the low word of a * b + c + d and stores the high word in `high`.
+// The sum cannot overflow 128 bits.
+inline auto MulAdd(std::uint64_t a, std::uint64_t b, std::uint64_t c,
+  std::uint64_t d, std::uint64_t& high) -> std::uint64_t
+{
+  auto const sum = static_cast<Uint128>(a) * b + c + d;
+  high = static_cast<std::uint64_t>(sum >> 64U);
+  return static_cast<std::uint64_t>(sum);
+}
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+inline auto MulWide(std::uint64_t a, std::uint64_t b, std::uint64_t& high)
+  -> std::uint64_t
+{
+  return _umul128(a, b, &high);
+}
+#else
+inline auto MulWide(std::uint64_t a, std::uint64_t b, std::uint64_t& high)
+  -> std::uint64_t
+{
+  auto const a_lo = a & 0xFFFFFFFFU;
+  auto const a_hi = a >> 32U;
+  auto const b_lo = b & 0xFFFFFFFFU;
+  auto const b_hi = b >> 32U;
+  auto const lo_lo = a_lo * b_lo;
+  auto const hi_lo = a_hi * b_lo;
+  auto const lo_hi = a_lo * b_hi;
+  auto const hi_hi = a_hi * b_hi;
+  auto const cross = (lo_lo >> 32U) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+  high = hi_hi + (hi_lo >> 32U) + (cross >> 32U);
+  return (cross << 32U) | (lo_lo & 0xFFFFFFFFU);
+}
+#endif
+
+inline auto AddCarry(std::uint64_t a, std::uint64_t b, std::uint64_t& carry)
+  -> std::uint64_t
+{
+  auto const sum = a + b;
+  auto const first = static_cast<std::uint64_t>(sum < a);
+  auto const result = sum + carry;
+  carry = first | static_cast<std::uint64_t>(result < sum);
+  return result;
+}
+
+inline auto SubBorrow(std::uint64_t a, std::uint64_t b, std::uint64_t& borrow)
+  -> std::uint64_t
+{
+  auto const difference = a - b;
+  auto const first = static_cast<std::uint64_t>(a < b);
+  auto const result = difference - borrow;
+  borrow = first | static_cast<std::uint64_t>(difference < borrow);
+  return result;
+}
+
+// Returns the low word of a * b + c + d and stores the high word in `high`.
+// The sum cannot overflow 128 bits.
+inline auto MulAdd(std::uint64_t a, std::uint64_t b, std::uint64_t c,
+  std::uint64_t d, std::uint64_t& high) -> std::uint64_t
+{
+  auto product_high = std::uint64_t { 0 };
+  auto low = MulWide(a, b, product_high);
+  auto carry = std::uint64_t { 0 };
+  low = AddCarry(low, c, carry);
+  product_high += carry;
+  carry = 0U;
+  low = AddCarry(low, d, carry);
+  high = product_high + carry;
+  return low;
+}
+#endif
+
+// Returns all ones when `flag` is non-zero, zero otherwise.
+inline auto MaskFrom(std::uint64_t flag) -> std::uint64_t
+{
+  return std::uint64_t { 0 } - static_cast<std::uint64_t>(flag != 0U);
+}
+
+// The limb helpers below are spelled out rather than looped: compilers do not
+// reliably unroll four-iteration carry chains at -O2, and the loop overhead
+// doubles the cost of a field multiplication.
+inline auto Select(std::uint64_t mask, Limbs const& when_set, Limbs const& otherwise)
+  -> Limbs
+{
+  return Limbs {
+    (when_set[0] & mask) | (otherwise[0] & ~mask),
+    (when_set[1] & mask) | (otherwise[1] & ~mask),
+    (when_set[2] & mask) | (otherwise[2] & ~mask),
+    (when_set[3] & mask) | (otherwise[3] & ~mask),
+  };
+}
+
+inline auto Add4(Limbs const& a, Limbs const& b, std::uint64_t& carry) -> Limbs
+{
+  auto result = Limbs {};
+  carry = 0U;
+  result[0] = AddCarry(a[0], b[0], carry);
+  result[1] = AddCarry(a[1], b[1], carry);
+  result[2] = AddCarry(a[2], b[2], carry);
+  result[3] = AddCarry(a[3], b[3], carry);
+  return result;
+}
+
+inline auto Sub4(Limbs const& a, Limbs const& b, std::uint64_t& borrow) -> Limbs
+{
+  auto result = Limbs {};
+  borrow = 0U;
+  result[0] = SubBorrow(a[0], b[0], borrow);
+  result[1] = SubBorrow(a[1], b[1], borrow);
+  result[2] = SubBorrow(a[2], b[2], borrow);
+  result[3] = SubBorrow(a[3], b[3], borrow);
+  return result;
+}
+
+inline auto IsZero(Limbs const& value) -> bool
+{
+  return (value[0] | value[1] | value[2] | value[3]) == 0U;
+}
+
+inline auto LoadBigEndian(std::uint8_t const* bytes) -> Limbs
+{
+  auto value = Limbs {};
+  for (auto limb = std::size_t { 0 }; limb < value.size(); ++limb) {
+    auto word = std::uint64_t { 0 };
+    for (auto index = std::size_t { 0 }; index < 8U; ++index) {
+      word = (word << 8U) | bytes[((3U - limb) * 8U) + index];
+    }
+    value[limb] = word;
+  }
+  return value;
+}
+
+inline auto StoreBigEndian(Limbs const& value, std::uint8_t* bytes) -> void
+{
+  for (auto limb = std::size_t { 0 }; limb < value.size(); ++limb) {
+    auto word = value[limb];
+    for (auto index = std::size_t { 0 }; index < 8U; ++index) {
+      bytes[((3U - limb) * 8U) + (7U - index)] = static_cast<std::uint8_t>(word);
+      word >>= 8U;
+    }
+  }
+}
+
+// Accumulates a * b into product[0 .. 4].
+inline auto MulRow(std::uint64_t a, Limbs const& b, std::uint64_t* product) -> void
+{
+  auto carry = std::uint64_t { 0 };
+  product[0] = MulAdd(a, b[0], product[0], carry, carry);
+  product[1] = MulAdd(a, b[1], product[1], carry, carry);
+  product[2] = MulAdd(a, b[2], product[2], carry, carry);
+  product[3] = MulAdd(a, b[3], product[3], carry, carry);
+  product[4] = carry;
+}
+
+// Full 256x256 -> 512 bit product, little-endian limbs.
+inline auto MulFull(Limbs const& a, Limbs const& b) -> std::array<std::uint64_t, 8>
+{
+  auto product = std::array<std::uint64_t, 8> {};
+  MulRow(a[0], b, product.data());
+  MulRow(a[1], b, product.data() + 1);
+  MulRow(a[2], b, product.data() + 2);
+  MulRow(a[3], b, product.data() + 3);
+  return product;
+}
+
+// a^2 as a 512-bit product: the six cross products are computed once and
+// doubled, which saves a quarter of the multiplications of MulFull().
+inline auto SqrFull(Limbs const& a) -> std::array<std::uint64_t, 8>
+{
+  auto product = std::array<std::uint64_t, 8> {};
+  auto carry = std::uint64_t { 0 };
+  product[1] = MulAdd(a[0], a[1], 0U, 0U, carry);
+  product[2] = MulAdd(a[0], a[2], 0U, carry, carry);
+  product[3] = MulAdd(a[0], a[3], 0U, carry, carry);
+  product[4] = carry;
+  product[3] = MulAdd(a[1], a[2], product[3], 0U, carry);
+  product[4] = MulAdd(a[1], a[3], product[4], carry, carry);
+  product[5] = carry;
+  product[5] = MulAdd(a[2], a[3], product[5], 0U, carry);
+  product[6] = carry;
+
+  product[7] = product[6] >> 63U;
+  product[6] = (product[6] << 1U) | (product[5] >> 63U);
+  product[5] = (product[5] << 1U) | (product[4] >> 63U);
+  product[4] = (product[4] << 1U) | (product[3] >> 63U);
+  product[3] = (product[3] << 1U) | (product[2] >> 63U);
+  product[2] = (product[2] << 1U) | (product[1] >> 63U);
+  product[1] = product[1] << 1U;
+
+  auto high = std::uint64_t { 0 };
+  carry = 0U;
+  auto low = MulWide(a[0], a[0], high);
+  product[0] = AddCarry(product[0], low, carry);
+  product[1] = AddCarry(product[1], high, carry);
+  low = MulWide(a[1], a[1], high);
+  product[2] = AddCarry(product[2], low, carry);
+  product[3] = AddCarry(product[3], high, carry);
+  low = MulWide(a[2], a[2], high);
+  product[4] = AddCarry(product[4], low, carry);
+  product[5] = AddCarry(product[5], high, carry);
+  low = MulWide(a[3], a[3], high);
+  product[6] = AddCarry(product[6], low, carry);
+  product[7] = AddCarry(product[7], high, carry);
+  return product;
+}
+
+// -- Field arithmetic modulo p = 2^256 - 2^32 - 977 ---------------------------
+
+// 2^256 mod p.
+constexpr auto kPComplement = std::uint64_t { 0x1000003D1ULL };
+
+// Field elements are always kept fully reduced.
+struct Fe {
+  Limbs v {};
+};
+
+// Adds 2^256 - p to `value`, which subtracts p when value >= p.
+inline auto AddPComplement(Limbs const& value, std::uint64_t& carry) -> Limbs
+{
+  return Add4(value, Limbs { kPComplement, 0U, 0U, 0U }, carry);
+}
+
+inline auto FeAdd(Fe const& a, Fe const& b) -> Fe
+{
+  auto carry = std::uint64_t { 0 };
+  auto const sum = Add4(a.v, b.v, carry);
+  auto reduced_carry = std::uint64_t { 0 };
+  auto const reduced = AddPComplement(sum, reduced_carry);
+  return Fe { Select(MaskFrom(carry | reduced_carry), reduced, sum) };
+}
+
+inline auto FeSub(Fe const& a, Fe const& b) -> Fe
+{
+  auto borrow = std::uint64_t { 0 };
+  auto const difference = Sub4(a.v, b.v, borrow);
+  // Adding p back is the same as subtracting 2^256 - p modulo 2^256.
+  auto wrap_borrow = std::uint64_t { 0 };
+  auto const wrapped = Sub4(difference, Limbs { kPComplement, 0U, 0U, 0U }, wrap_borrow);
+  return Fe { Select(MaskFrom(borrow), wrapped, difference) };
+}
+
+inline auto FeNegate(Fe const& a) -> Fe
+{
+  return FeSub(Fe {}, a);
+}
+
+inline auto FeReduce(std::array<std::uint64_t, 8> const& product) -> Fe
+{
+  // Fold the high half back in: x * 2^256 == x * (2^256 - p) (mod p).
+  auto folded = std::array<std::uint64_t, 5> {};
+  auto carry = std::uint64_t { 0 };
+  folded[0] = MulAdd(product[4], kPComplement, product[0], 0U, carry);
+  folded[1] = MulAdd(product[5], kPComplement, product[1], carry, carry);
+  folded[2] = MulAdd(product[6], kPComplement, product[2], carry, carry);
+  folded[3] = MulAdd(product[7], kPComplement, product[3], carry, carry);
+  folded[4] = carry;
+
+  auto top_high = std::uint64_t { 0 };
+  auto const top_low = MulWide(folded[4], kPComplement, top_high);
+  auto result = Limbs {};
+  carry = 0U;
+  result[0] = AddCarry(folded[0], top_low, carry);
+  result[1] = AddCarry(folded[1], top_high, carry);
+  result[2] = AddCarry(folded[2], 0U, carry);
+  result[3] = AddCarry(folded[3], 0U, carry);
+
+  // A final wrap leaves a value far below p, so one more fold is enough.
+  result = Add4(result, Limbs { kPComplement & MaskFrom(carry), 0U, 0U, 0U }, carry);
+
+  auto reduced_carry = std::uint64_t { 0 };
+  auto const reduced = AddPComplement(result, reduced_carry);
+  return Fe { Select(MaskFrom(reduced_carry), reduced, result) };
+}
+
+inline auto FeMul(Fe const& a, Fe const& b) -> Fe
+{
+  return FeReduce(MulFull(a.v, b.v));
+}
+
+inline auto FeSqr(Fe const& a) -> Fe
+{
+  return FeReduce(SqrFull(a.v));
+}
+
+inline auto FeSqrTimes(Fe value, int count) -> Fe
+{
+  for (auto index = 0; index < count; ++index) {
+    value = FeSqr(value);
+  }
+  return value;
+}
+
+inline auto FeDouble(Fe const& a) -> Fe
+{
+  return FeAdd(a, a);
+}
+
+inline auto FeIsZero(Fe const& a) -> bool
+{
+  return IsZero(a.v);
+}
+
+inline auto FeEqual(Fe const& a, Fe const& b) -> bool
+{
+  return ((a.v[0] ^ b.v[0]) | (a.v[1] ^ b.v[1]) | (a.v[2] ^ b.v[2]) | (a.v[3] ^ b.v[3]))
+    == 0U;
+}
+
+auto FeFromBytes(std::uint8_t const* bytes, Fe& out) -> bool
+{
+  out.v = LoadBigEndian(bytes);
+  auto carry = std::uint64_t { 0 };
+  (void)AddPComplement(out.v, carry);
+  return carry == 0U;
+}
+
+auto FeToBytes(Fe const& value, std::uint8_t* bytes) -> void
+{
+  StoreBigEndian(value.v, bytes);
+}
+
+// a^(p - 2) through the usual secp256k1 addition chain: 255 squarings and 15
+// multiplications.
+auto FeInvert(Fe const& a) -> Fe
+{
+  auto const x2 = FeMul(FeSqr(a), a);
+  auto const x3 = FeMul(FeSqr(x2), a);
+  auto const x6 = FeMul(FeSqrTimes(x3, 3), x3);
+  auto const x9 = FeMul(FeSqrTimes(x6, 3), x3);
+  auto const x11 = FeMul(FeSqrTimes(x9, 2), x2);
+  auto const x22 = FeMul(FeSqrTimes(x11, 11), x11);
+  auto const x44 = FeMul(FeSqrTimes(x22, 22), x22);
+  auto const x88 = FeMul(FeSqrTimes(x44, 44), x44);
+  auto const x176 = FeMul(FeSqrTimes(x88, 88), x88);
+  auto const x220 = FeMul(FeSqrTimes(x176, 44), x44);
+  auto const x223 = FeMul(FeSqrTimes(x220, 3), x3);
+
+  auto result = FeMul(FeSqrTimes(x223, 23), x22);
+  result = FeMul(FeSqrTimes(result, 5), a);
+  result = FeMul(FeSqrTimes(result, 3), x2);
+  return FeMul(FeSqrTimes(result, 2), a);
+}
+
+// -- Scalar arithmetic modulo the group order n -------------------------------
+
+constexpr auto kN = Limbs {
+  0xBFD25E8CD0364141ULL,
+  0xBAAEDCE6AF48A03BULL,
+  0xFFFFFFFFFFFFFFFEULL,
+  0xFFFFFFFFFFFFFFFFULL,
+};
+// 2^256 - n.
+constexpr auto kNComplement = Limbs {
+  0x402DA1732FC9BEBFULL,
+  0x4551231950B75FC4ULL,
+  0x0000000000000001ULL,
+  0x0000000000000000ULL,
+};
+constexpr auto kNHalf = Limbs {
+  0xDFE92F46681B20A0ULL,
+  0x5D576E7357A4501DULL,
+  0xFFFFFFFFFFFFFFFFULL,
+  0x7FFFFFFFFFFFFFFFULL,
+};
+// p - n; an x coordinate below this value may also stand for x - n.
+constexpr auto kPMinusN = Limbs {
+  0x402DA1722FC9BAEEULL,
+  0x4551231950B75FC4ULL,
+  0x0000000000000001ULL,
+  0x0000000000000000ULL,
+};
+
+struct Sc {
+  Limbs v {};
+};
+
+inline auto AddNComplement(Limbs const& value, std::uint64_t& carry) -> Limbs
+{
+  return Add4(value, kNComplement, carry);
+}
+
+inline auto LessThan(Limbs const& a, Limbs const& b) -> bool
+{
+  auto borrow = std::uint64_t { 0 };
+  (void)Sub4(a, b, borrow);
+  return borrow != 0U;
+}
+
+// Loads a big-endian scalar, reducing it modulo n. `overflow` reports whether
+// the encoded value was n or larger.
+auto ScFromBytes(std::uint8_t const* bytes, bool& overflow) -> Sc
+{
+  auto const value = LoadBigEndian(bytes);
+  auto carry = std::uint64_t { 0 };
+  auto const reduced = AddNComplement(value, carry);
+  overflow = carry != 0U;
+  return Sc { Select(MaskFrom(carry), reduced, value) };
+}
+
+auto ScToBytes(Sc const& value, std::uint8_t* bytes) -> void
+{
+  StoreBigEndian(value.v, bytes);
+}
+
+inline auto ScIsZero(Sc const& value) -> bool
+{
+  return IsZero(value.v);
+}
+
+inline auto ScIsHigh(Sc const& value) -> bool
+{
+  return LessThan(kNHalf, value.v);
+}
+
+inline auto ScAdd(Sc const& a, Sc const& b) -> Sc
+{
+  auto carry = std::uint64_t { 0 };
+  auto const sum = Add4(a.v, b.v, carry);
+  auto reduced_carry = std::uint64_t { 0 };
+  auto const reduced = AddNComplement(sum, reduced_carry);
+  return Sc { Select(MaskFrom(carry | reduced_carry), reduced, sum) };
+}
+
+inline auto ScNegate(Sc const& a) -> Sc
+{
+  auto borrow = std::uint64_t { 0 };
+  auto const result = Sub4(kN, a.v, borrow);
+  return Sc { Select(MaskFrom(ScIsZero(a) ? 1U : 0U), Limbs {}, result) };
+}
+
+// Reduces a 512-bit value modulo n by repeatedly folding the high half with
+// 2^256 == 2^256 - n (mod n). Each fold shrinks the value by ~127 bits.
+auto ScReduce512(std::array<std::uint64_t, 8> value) -> Sc
+{
+  while ((value[4] | value[5] | value[6] | value[7]) != 0U) {
+    auto folded = std::array<std::uint64_t, 8> {};
+    for (auto i = std::size_t { 0 }; i < 4U; ++i) {
+      auto carry = std::uint64_t { 0 };
+      for (auto j = std::size_t { 0 }; j < 3U; ++j) {
+        folded[i + j] = MulAdd(value[i + 4U], kNComplement[j], folded[i + j], carry, carry);
+      }
+      folded[i + 3U] = carry;
+    }
+    auto carry = std::uint64_t { 0 };
+    for (auto index = std::size_t { 0 }; index < 8U; ++index) {
+      value[index] = AddCarry(index < 4U ? value[index] : 0U, folded[index], carry);
+    }
+  }
+
+  auto const low = Limbs { value[0], value[1], value[2], value[3] };
+  auto carry = std::uint64_t { 0 };
+  auto const reduced = AddNComplement(low, carry);
+  return Sc { Select(MaskFrom(carry), reduced, low) };
+}
+
+inline auto ScMul(Sc const& a, Sc const& b) -> Sc
+{
+  return ScReduce512(MulFull(a.v, b.v));
+}
+
+inline auto ScSubtract(Sc const& a, Sc const& b) -> Sc
+{
+  return ScAdd(a, ScNegate(b));
+}
+
+// x / 2 (mod n).
+inline auto ScHalve(Sc const& value) -> Sc
+{
+  auto carry = std::uint64_t { 0 };
+  auto const sum = Add4(value.v, Select(MaskFrom(value.v[0] & 1U), kN, Limbs {}), carry);
+  auto result = Sc {};
+  for (auto index = std::size_t { 0 }; index < 3U; ++index) {
+    result.v[index] = (sum[index] >> 1U) | (sum[index + 1U] << 63U);
+  }
+  result.v[3] = (sum[3] >> 1U) | (carry << 63U);
+  return result;
+}
+
+// Binary extended Euclid. It is several times faster than a Fermat inversion
+// but its running time depends on the input, so it only ever sees public
+// values or blinded secrets.
+auto ScInvertVariable(Sc const& a) -> Sc
+{
+  auto const is_one = [](Limbs const& value) {
+    return value[0] == 1U && (value[1] | value[2] | value[3]) == 0U;
+  };
+  auto const shift_right = [](Limbs& value) {
+    for (auto index = std::size_t { 0 }; index < 3U; ++index) {
+      value[index] = (value[index] >> 1U) | (value[index + 1U] << 63U);
+    }
+    value[3] >>= 1U;
+  };
+  auto const subtract = [](Limbs& lhs, Limbs const& rhs) {
+    auto borrow = std::uint64_t { 0 };
+    lhs = Sub4(lhs, rhs, borrow);
+  };
+
+  if (ScIsZero(a)) {
+    return Sc {};
+  }
+  auto u = a.v;
+  auto v = kN;
+  auto x1 = Sc { Limbs { 1U, 0U, 0U, 0U } };
+  auto x2 = Sc {};
+  while (!is_one(u) && !is_one(v)) {
+    while ((u[0] & 1U) == 0U) {
+      shift_right(u);
+      x1 = ScHalve(x1);
+    }
+    while ((v[0] & 1U) == 0U) {
+      shift_right(v);
+      x2 = ScHalve(x2);
+    }
+    if (!LessThan(u, v)) {
+      subtract(u, v);
+      x1 = ScSubtract(x1, x2);
+    } else {
+      subtract(v, u);
+      x2 = ScSubtract(x2, x1);
+    }
+  }
+  return is_one(u) ? x1 : x2;
+}
+
+// -- GLV endomorphism ---------------------------------------------------------
+
+// lambda * (x, y) == (beta * x, y) for every curve point.
+constexpr auto kBeta = Fe { Limbs {
+  0xC1396C28719501EEULL,
+  0x9CF0497512F58995ULL,
+  0x6E64479EAC3434E9ULL,
+  0x7AE96A2B657C0710ULL,
+} };
+constexpr auto kMinusLambda = Sc { Limbs {
+  0xE0CFC810B51283CFULL,
+  0xA880B9FC8EC739C2ULL,
+  0x5AD9E3FD77ED9BA4ULL,
+  0xAC9C52B33FA3CF1FULL,
+} };
+constexpr auto kMinusB1 = Sc { Limbs {
+  0x6F547FA90ABFE4C3ULL,
+  0xE4437ED6010E8828ULL,
+  0x0000000000000000ULL,
+  0x0000000000000000ULL,
+} };
+constexpr auto kMinusB2 = Sc { Limbs {
+  0xD765CDA83DB1562CULL,
+  0x8A280AC50774346DULL,
+  0xFFFFFFFFFFFFFFFEULL,
+  0xFFFFFFFFFFFFFFFFULL,
+} };
+constexpr auto kG1 = Limbs {
+  0xE893209A45DBB031ULL,
+  0x3DAA8A1471E8CA7FULL,
+  0xE86C90E49284EB15ULL,
+  0x3086D221A7D46BCDULL,
+};
+constexpr auto kG2 = Limbs {
+  0x1571B4AE8AC47F71ULL,
+  0x221208AC9DF506C6ULL,
+  0x6F547FA90ABFE4C4ULL,
+  0xE4437ED6010E8828ULL,
+};
+
+// round(a * b / 2^384)
+auto MulShift384(Limbs const& a, Limbs const& b) -> Sc
+{
+  auto const product = MulFull(a, b);
+  auto result = Limbs { product[6], product[7], 0U, 0U };
+  auto carry = product[5] >> 63U;
+  result[0] = AddCarry(result[0], 0U, carry);
+  result[1] = AddCarry(result[1], 0U, carry);
+  return Sc { result };
+}
+
+// A scalar with magnitude below 2^128 and the sign it had modulo n.
+struct HalfScalar {
+  Sc magnitude {};
+  bool negative { false };
+};
+
+auto MakeHalf(Sc const& value) -> HalfScalar
+{
+  if (ScIsHigh(value)) {
+    return HalfScalar { ScNegate(value), true };
+  }
+  return HalfScalar { value, false };
+}
+
+// Splits k into k1 + k2 * lambda (mod n) with |k1|, |k2| < 2^128.
+auto SplitLambda(Sc const& k, HalfScalar& k1, HalfScalar& k2) -> void
+{
+  auto const c1 = ScMul(MulShift384(k.v, kG1), kMinusB1);
+  auto const c2 = ScMul(MulShift384(k.v, kG2), kMinusB2);
+  auto const r2 = ScAdd(c1, c2);
+  auto const r1 = ScAdd(ScMul(r2, kMinusLambda), k);
+  k1 = MakeHalf(r1);
+  k2 = MakeHalf(r2);
+}
+
+// -- Group arithmetic ---------------------------------------------------------
+
+struct Ge {
+  Fe x {};
+  Fe y {};
+};
+
+struct Gej {
+  Fe x {};
+  Fe y {};
+  Fe z {};
+  bool infinity { true };
+};
+
+constexpr auto kGenerator = Ge {
+  Fe { Limbs {
+    0x59F2815B16F81798ULL,
+    0x029BFCDB2DCE28D9ULL,
+    0x55A06295CE870B07ULL,
+    0x79BE667EF9DCBBACULL,
+  } },
+  Fe { Limbs {
+    0x9C47D08FFB10D4B8ULL,
+    0xFD17B448A6855419ULL,
+    0x5DA4FBFC0E1108A8ULL,
+    0x483ADA7726A3C465ULL,
+  } },
+};
+
+constexpr auto kCurveB = Fe { Limbs { 7U, 0U, 0U, 0U } };
+
+inline auto ToJacobian(Ge const& point) -> Gej
+{
+  return Gej { point.x, point.y, Fe { Limbs { 1U, 0U, 0U, 0U } }, false };
+}
+
+inline auto NegateAffine(Ge const& point) -> Ge
+{
+  return Ge { point.x, FeNegate(point.y) };
+}
+
+inline auto IsOnCurve(Ge const& point) -> bool
+{
+  auto const lhs = FeSqr(point.y);
+  auto const rhs = FeAdd(FeMul(FeSqr(point.x), point.x), kCurveB);
+  return FeEqual(lhs, rhs);
+}
+
+// dbl-2009-l for a = 0. secp256k1 has no point of order two, so a finite
+// point never doubles to infinity.
+auto Double(Gej const& point) -> Gej
+{
+  if (point.infinity) {
+    return point;
+  }
+  auto const a = FeSqr(point.x);
+  auto const b = FeSqr(point.y);
+  auto const c = FeSqr(b);
+  auto const d = FeDouble(FeSub(FeSub(FeSqr(FeAdd(point.x, b)), a), c));
+  auto const e = FeAdd(FeDouble(a), a);
+  auto const f = FeSqr(e);
+
+  auto result = Gej {};
+  result.infinity = false;
+  result.x = FeSub(f, FeDouble(d));
+  auto const c8 = FeDouble(FeDouble(FeDouble(c)));
+  result.y = FeSub(FeMul(e, FeSub(d, result.x)), c8);
+  result.z = FeDouble(FeMul(point.y, point.z));
+  return result;
+}
+
+// Mixed Jacobian + affine addition.
+auto AddAffine(Gej const& lhs, Ge const& rhs) -> Gej
+{
+  if (lhs.infinity) {
+    return ToJacobian(rhs);
+  }
+  auto const z1z1 = FeSqr(lhs.z);
+  auto const u2 = FeMul(rhs.x, z1z1);
+  auto const s2 = FeMul(rhs.y, FeMul(lhs.z, z1z1));
+  auto const h = FeSub(u2, lhs.x);
+  auto const r = FeSub(s2, lhs.y);
+  if (FeIsZero(h)) {
+    if (FeIsZero(r)) {
+      return Double(lhs);
+    }
+    return Gej {};
+  }
+
+  auto const hh = FeSqr(h);
+  auto const hhh = FeMul(h, hh);
+  auto const v = FeMul(lhs.x, hh);
+
+  auto result = Gej {};
+  result.infinity = false;
+  result.x = FeSub(FeSub(FeSqr(r), hhh), FeDouble(v));
+  result.y = FeSub(FeMul(r, FeSub(v, result.x)), FeMul(lhs.y, hhh));
+  result.z = FeMul(lhs.z, h);
+  return result;
+}
+
+// Converts finite Jacobian points to affine with a single field inversion.
+auto BatchToAffine(std::span<Gej const> points, std::span<Ge> out) -> void
+{
+  if (points.empty()) {
+    return;
+  }
+  auto prefix = std::vector<Fe>(points.size());
+  prefix[0] = points[0].z;
+  for (auto index = std::size_t { 1 }; index < points.size(); ++index) {
+    prefix[index] = FeMul(prefix[index - 1U], points[index].z);
+  }
+
+  auto inverse = FeInvert(prefix.back());
+  for (auto index = points.size(); index-- > 0U;) {
+    auto const z_inverse = index == 0U ? inverse : FeMul(inverse, prefix[index - 1U]);
+    inverse = FeMul(inverse, points[index].z);
+    auto const z2 = FeSqr(z_inverse);
+    out[index].x = FeMul(points[index].x, z2);
+    out[index].y = FeMul(points[index].y, FeMul(z2, z_inverse));
+  }
+}
+
+auto ToAffine(Gej const& point) -> Ge
+{
+  auto result = Ge {};
+  BatchToAffine(std::span<Gej const>(&point, 1U), std::span<Ge>(&result, 1U));
+  return result;
+}
+
+// Variable-time double-and-add, only used while building tables.
+auto MulVariable(Ge const& point, Sc const& scalar) -> Gej
+{
+  auto result = Gej {};
+  for (auto bit = 255; bit >= 0; --bit) {
+    result = Double(result);
+    if (((scalar.v[static_cast<std::size_t>(bit) / 64U] >> (bit % 64)) & 1U) != 0U) {
+      result = AddAffine(result, point);
+    }
+  }
+  return result;
+}
+
+// Writes point, 3*point, 5*point, ... into `out` and the lambda images of the
+// same multiples into `out_lambda`.
+auto BuildOddMultiples(Ge const& point, std::span<Ge> out, std::span<Ge> out_lambda) -> void
+{
+  auto const twice = ToAffine(Double(ToJacobian(point)));
+  auto multiples = std::vector<Gej>(out.size());
+  multiples[0] = ToJacobian(point);
+  for (auto index = std::size_t { 1 }; index < multiples.size(); ++index) {
+    multiples[index] = AddAffine(multiples[index - 1U], twice);
+  }
+  BatchToAffine(multiples, out);
+  for (auto index = std::size_t { 0 }; index < out.size(); ++index) {
+    out_lambda[index] = Ge { FeMul(out[index].x, kBeta), out[index].y };
+  }
+}
+
+// -- Precomputed tables -------------------------------------------------------
+
+// Signing comb: 64 windows of 4 bits, each holding (d * 16^i + offset_i) * G
+// for every digit d. The offsets (1 for the first 63 windows and -63 for the
+// last) sum to zero and keep every entry finite, so a lookup never has to
+// special-case the point at infinity.
+constexpr auto kCombWindows = std::size_t { 64 };
+constexpr auto kCombEntries = std::size_t { 16 };
+
+// wNAF window widths for verification. The generator table is shared by every
+// verification and can afford to be much wider than a per-key table.
+constexpr auto kGeneratorWindow = 8;
+constexpr auto kKeyWindow = 5;
+constexpr auto kGeneratorMultiples = std::size_t { 1 } << (kGeneratorWindow - 2);
+constexpr auto kKeyMultiples = std::size_t { 1 } << (kKeyWindow - 2);
+
+struct GeneratorTables {
+  std::array<std::array<Ge, kCombEntries>, kCombWindows> comb {};
+  std::array<Ge, kGeneratorMultiples> odd {};
+  std::array<Ge, kGeneratorMultiples> odd_lambda {};
+};
+
+auto BuildGeneratorTables() -> std::unique_ptr<GeneratorTables>
+{
+  auto tables = std::make_unique<GeneratorTables>();
+
+  auto entries = std::vector<Gej> {};
+  entries.reserve(kCombWindows * kCombEntries);
+  auto base = ToJacobian(kGenerator);
+  for (auto window = std::size_t { 0 }; window < kCombWindows; ++window) {
+    auto const base_affine = ToAffine(base);
+    auto offset = ToJacobian(kGenerator);
+    if (window + 1U == kCombWindows) {
+      auto const last = ToAffine(
+        MulVariable(kGenerator, Sc { Limbs { kCombWindows - 1U, 0U, 0U, 0U } }));
+      offset = ToJacobian(NegateAffine(last));
+    }
+    entries.push_back(offset);
+    for (auto digit = std::size_t { 1 }; digit < kCombEntries; ++digit) {
+      entries.push_back(AddAffine(entries.back(), base_affine));
+    }
+    for (auto step = 0; step < 4; ++step) {
+      base = Double(base);
+    }
+  }
+
+  auto affine = std::vector<Ge>(entries.size());
+  BatchToAffine(entries, affine);
+  for (auto window = std::size_t { 0 }; window < kCombWindows; ++window) {
+    std::copy_n(affine.begin() + static_cast<std::ptrdiff_t>(window * kCombEntries),
+      kCombEntries, tables->comb[window].begin());
+  }
+
+  BuildOddMultiples(kGenerator, tables->odd, tables->odd_lambda);
+  return tables;
+}
+
+auto Generator() -> GeneratorTables const&
+{
+  static auto const tables = BuildGeneratorTables();
+  return *tables;
+}
+
+// Scans the whole window so the memory access pattern does not depend on the
+// secret digit.
+auto SelectCombEntry(std::array<Ge, kCombEntries> const& window, std::uint64_t digit)
+  -> Ge
+{
+  auto result = Ge {};
+  for (auto index = std::uint64_t { 0 }; index < kCombEntries; ++index) {
+    auto const mask = MaskFrom(static_cast<std::uint64_t>(index == digit));
+    result.x.v = Select(mask, window[index].x.v, result.x.v);
+    result.y.v = Select(mask, window[index].y.v, result.y.v);
+  }
+  return result;
+}
+
+auto MulGenerator(Sc const& scalar) -> Gej
+{
+  auto const& comb = Generator().comb;
+  auto result = Gej {};
+  for (auto window = std::size_t { 0 }; window < kCombWindows; ++window) {
+    auto const digit = (scalar.v[window / 16U] >> ((window % 16U) * 4U)) & 0xFU;
+    result = AddAffine(result, SelectCombEntry(comb[window], digit));
+  }
+  return result;
+}
+
+// -- Verification ladder ------------------------------------------------------
+
+constexpr auto kMaxWnafLength = 258;
+
+struct Wnaf {
+  std::array<int, kMaxWnafLength> digits {};
+  int length { 0 };
+};
+
+// Width-w non-adjacent form: every non-zero digit is odd, below 2^(w-1) in
+// magnitude, and followed by at least w - 1 zeros.
+auto ComputeWnaf(Sc const& scalar, int window) -> Wnaf
+{
+  auto result = Wnaf {};
+  auto value = std::array<std::uint64_t, 5> {
+    scalar.v[0], scalar.v[1], scalar.v[2], scalar.v[3], 0U
+  };
+  auto const modulus = std::uint64_t { 1 } << window;
+  auto const half = modulus >> 1U;
+
+  while ((value[0] | value[1] | value[2] | value[3] | value[4]) != 0U) {
+    auto digit = 0;
+    if ((value[0] & 1U) != 0U) {
+      auto const low = value[0] & (modulus - 1U);
+      if (low >= half) {
+        digit = static_cast<int>(low) - static_cast<int>(modulus);
+        auto carry = std::uint64_t { 0 };
+        value[0] = AddCarry(value[0], modulus - low, carry);
+        for (auto index = std::size_t { 1 }; index < value.size(); ++index) {
+          value[index] = AddCarry(value[index], 0U, carry);
+        }
+      } else {
+        digit = static_cast<int>(low);
+        value[0] -= low;
+      }
+    }
+    result.digits[static_cast<std::size_t>(result.length++)] = digit;
+
+    for (auto index = std::size_t { 0 }; index < 4U; ++index) {
+      value[index] = (value[index] >> 1U) | (value[index + 1U] << 63U);
+    }
+    value[4] >>= 1U;
+  }
+  return result;
+}
+
+auto AddWnafDigit(Gej const& accumulator, int digit, bool negative,
+  std::span<Ge const> multiples) -> Gej
+{
+  if (digit == 0) {
+    return accumulator;
+  }
+  auto const index = static_cast<std::size_t>((digit > 0 ? digit : -digit) - 1) / 2U;
+  auto const& point = multiples[index];
+  return AddAffine(accumulator, ((digit < 0) != negative) ? NegateAffine(point) : point);
+}
+
+} // namespace
+
+struct PublicKeyContext::Tables {
+  PublicKeyBytes encoded {};
+  std::array<Ge, kKeyMultiples> odd {};
+  std::array<Ge, kKeyMultiples> odd_lambda {};
+};
+
+namespace {
+
+// Computes u1 * G + u2 * Q with four interleaved half-size wNAF expansions.
+auto MulAddGeneratorAndKey(
+  Sc const& u1, Sc const& u2, PublicKeyContext::Tables const& key) -> Gej
+{
+  auto const& generator = Generator();
+  auto g1 = HalfScalar {};
+  auto g2 = HalfScalar {};
+  auto q1 = HalfScalar {};
+  auto q2 = HalfScalar {};
+  SplitLambda(u1, g1, g2);
+  SplitLambda(u2, q1, q2);
+
+  auto const g1_wnaf = ComputeWnaf(g1.magnitude, kGeneratorWindow);
+  auto const g2_wnaf = ComputeWnaf(g2.magnitude, kGeneratorWindow);
+  auto const q1_wnaf = ComputeWnaf(q1.magnitude, kKeyWindow);
+  auto const q2_wnaf = ComputeWnaf(q2.magnitude, kKeyWindow);
+  auto const length = std::max(
+    { g1_wnaf.length, g2_wnaf.length, q1_wnaf.length, q2_wnaf.length });
+
+  auto const digit_at = [](Wnaf const& wnaf, int index) {
+    return index < wnaf.length ? wnaf.digits[static_cast<std::size_t>(index)] : 0;
+  };
+
+  auto result = Gej {};
+  for (auto index = length - 1; index >= 0; --index) {
+    result = Double(result);
+    result = AddWnafDigit(result, digit_at(g1_wnaf, index), g1.negative, generator.odd);
+    result = AddWnafDigit(
+      result, digit_at(g2_wnaf, index), g2.negative, generator.odd_lambda);
+    result = AddWnafDigit(result, digit_at(q1_wnaf, index), q1.negative, key.odd);
+    result = AddWnafDigit(result, digit_at(q2_wnaf, index), q2.negative, key.odd_lambda);
+  }
+  return result;
+}
+
+// HMAC-SHA256 based nonce generator from RFC 6979, section 3.2.
+class DeterministicNonce {
+public:
+  DeterministicNonce(std::uint8_t const* secret, std::uint8_t const* digest)
+  {
+    key_.fill(0x00U);
+    value_.fill(0x01U);
+    Reseed(0x00U, secret, digest);
+    Reseed(0x01U, secret, digest);
+  }
+
+  auto Next() -> Sc
+  {
+    for (;;) {
+      if (retry_) {
+        key_ = Mac(key_, { value_, std::array<std::uint8_t, 1> { 0x00U } });
+        value_ = Mac(key_, { value_ });
+      }
+      retry_ = true;
+      value_ = Mac(key_, { value_ });
+
+      auto overflow = false;
+      auto const candidate = ScFromBytes(value_.data(), overflow);
+      if (!overflow && !ScIsZero(candidate)) {
+        return candidate;
+      }
+    }
+  }
+
+  // A secret, non-zero scalar derived from the generator state without
+  // advancing it, so the RFC 6979 nonce sequence stays untouched.
+  [[nodiscard]] auto Blinding() const -> Sc
+  {
+    auto const block = Mac(key_, { value_, std::array<std::uint8_t, 1> { 0x02U } });
+    auto overflow = false;
+    auto const blind = ScFromBytes(block.data(), overflow);
+    return ScIsZero(blind) ? Sc { Limbs { 1U, 0U, 0U, 0U } } : blind;
+  }
+
+private:
+  using Block = std::array<std::uint8_t, 32>;
+
+  static auto Mac(Block const& key, std::initializer_list<std::span<std::uint8_t const>> parts)
+    -> Block
+  {
+    auto pad = std::array<std::uint8_t, nova::Sha256::kBlockSize> {};
+    std::copy(key.begin(), key.end(), pad.begin());
+
+    auto inner = nova::Sha256 {};
+    auto padded = pad;
+    for (auto& byte : padded) {
+      byte ^= 0x36U;
+    }
+    inner.Update(std::as_bytes(std::span(padded)));
+    for (auto const part : parts) {
+      inner.Update(std::as_bytes(part));
+    }
+    auto const inner_digest = inner.Finalize();
+
+    auto outer = nova::Sha256 {};
+    padded = pad;
+    for (auto& byte : padded) {
+      byte ^= 0x5CU;
+    }
+    outer.Update(std::as_bytes(std::span(padded)));
+    outer.Update(std::as_bytes(std::span(inner_digest)));
+    return outer.Finalize();
+  }
+
+  auto Reseed(std::uint8_t separator, std::uint8_t const* secret,
+    std::uint8_t const* digest) -> void
+  {
+    auto const tag = std::array<std::uint8_t, 1> { separator };
+    key_ = Mac(key_,
+      { value_, tag, std::span<std::uint8_t const>(secret, kScalarSize),
+        std::span<std::uint8_t const>(digest, kScalarSize) });
+    value_ = Mac(key_, { value_ });
+  }
+
+  Block key_ {};
+  Block value_ {};
+  bool retry_ { false };
+};
+
+} // namespace
+
+auto DerivePublicKey(std::span<std::uint8_t const, kScalarSize> secret)
+  -> std::optional<PublicKeyBytes>
+{
+  auto overflow = false;
+  auto const scalar = ScFromBytes(secret.data(), overflow);
+  if (overflow || ScIsZero(scalar)) {
+    return std::nullopt;
+  }
+
+  auto const point = ToAffine(MulGenerator(scalar));
+  auto encoded = PublicKeyBytes {};
+  FeToBytes(point.x, encoded.data());
+  FeToBytes(point.y, encoded.data() + kScalarSize);
+  return encoded;
+}
+
+auto SignDigest(std::span<std::uint8_t const, kScalarSize> secret,
+  std::span<std::uint8_t const, kScalarSize> digest) -> std::optional<CompactSignature>
+{
+  auto overflow = false;
+  auto const private_scalar = ScFromBytes(secret.data(), overflow);
+  if (overflow || ScIsZero(private_scalar)) {
+    return std::nullopt;
+  }
+  auto const message = ScFromBytes(digest.data(), overflow);
+  auto reduced_digest = Scalar {};
+  ScToBytes(message, reduced_digest.data());
+
+  auto nonces = DeterministicNonce(secret.data(), reduced_digest.data());
+  for (;;) {
+    auto const nonce = nonces.Next();
+    auto const point = ToAffine(MulGenerator(nonce));
+
+    auto x_bytes = Scalar {};
+    FeToBytes(point.x, x_bytes.data());
+    auto const r = ScFromBytes(x_bytes.data(), overflow);
+    if (ScIsZero(r)) {
+      continue;
+    }
+
+    // k^-1 = b * (k * b)^-1 for a secret blinding factor b, so the fast
+    // variable-time inversion never sees the nonce itself.
+    auto const blind = nonces.Blinding();
+    auto const nonce_inverse = ScMul(blind, ScInvertVariable(ScMul(nonce, blind)));
+    auto s = ScMul(nonce_inverse, ScAdd(message, ScMul(r, private_scalar)));
+    if (ScIsZero(s)) {
+      continue;
+    }
+    if (ScIsHigh(s)) {
+      s = ScNegate(s);
+    }
+
+    auto signature = CompactSignature {};
+    ScToBytes(r, signature.data());
+    ScToBytes(s, signature.data() + kScalarSize);
+    return signature;
+  }
+}
+
+PublicKeyContext::PublicKeyContext(std::shared_ptr<Tables const> tables)
+  : tables_(std::move(tables))
+{
+}
+
+auto PublicKeyContext::Parse(std::span<std::uint8_t const, kPublicKeySize> encoded)
+  -> std::optional<PublicKeyContext>
+{
+  auto point = Ge {};
+  if (!FeFromBytes(encoded.data(), point.x)
+    || !FeFromBytes(encoded.data() + kScalarSize, point.y) || !IsOnCurve(point)) {
+    return std::nullopt;
+  }
+
+  // The curve has cofactor 1, so every point on it lies in the prime-order
+  // group and no further subgroup check is needed.
+  auto tables = std::make_shared<Tables>();
+  std::copy(encoded.begin(), encoded.end(), tables->encoded.begin());
+  BuildOddMultiples(point, tables->odd, tables->odd_lambda);
+  return PublicKeyContext(std::move(tables));
+}
+
+auto PublicKeyContext::Encoded() const -> PublicKeyBytes const&
+{
+  return tables_->encoded;
+}
+
+auto PublicKeyContext::VerifyDigest(std::span<std::uint8_t const, kScalarSize> digest,
+  std::span<std::uint8_t const> signature) const -> bool
+{
+  if (signature.size() != kSignatureSize) {
+    return false;
+  }
+
+  auto overflow = false;
+  auto const r = ScFromBytes(signature.data(), overflow);
+  if (overflow || ScIsZero(r)) {
+    return false;
+  }
+  auto const s = ScFromBytes(signature.data() + kScalarSize, overflow);
+  if (overflow || ScIsZero(s)) {
+    return false;
+  }
+  auto const message = ScFromBytes(digest.data(), overflow);
+
+  auto const s_inverse = ScInvertVariable(s);
+  auto const point
+    = MulAddGeneratorAndKey(ScMul(message, s_inverse), ScMul(r, s_inverse), *tables_);
+  if (point.infinity) {
+    return false;
+  }
+
+  // Compare x(R) mod n against r without leaving Jacobian coordinates:
+  // x(R) = X / Z^2, and x(R) may be r or r + n since p > n.
+  auto const z2 = FeSqr(point.z);
+  if (FeEqual(FeMul(Fe { r.v }, z2), point.x)) {
+    return true;
+  }
+  if (!LessThan(r.v, kPMinusN)) {
+    return false;
+  }
+  auto carry = std::uint64_t { 0 };
+  auto const r_plus_n = Add4(r.v, kN, carry);
+  return FeEqual(FeMul(Fe { r_plus_n }, z2), point.x);
+}
+
+} // namespace blocxxi::crypto::secp256k1
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at https://opensource.org/licenses/BSD-3-Clause).
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <Blocxxi/Crypto/api_export.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+// Specialized secp256k1 arithmetic backing crypto/signature.h.
+//
+// Signing multiplies the generator through a fixed-base comb table with
+// constant-time lookups and derives nonces deterministically (RFC 6979).
+// Verification splits both scalars with the GLV endomorphism and evaluates
+// u1*G + u2*Q with an interleaved wNAF ladder over precomputed odd multiples.
+// Signatures use the same 64-byte r||s layout CryptoPP produces by default.
+namespace blocxxi::crypto::secp256k1 {
+
+inline constexpr std::size_t kScalarSize = 32;
+inline constexpr std::size_t kPublicKeySize = 64;
+inline constexpr std::size_t kSignatureSize = 64;
+
+using Scalar = std::array<std::uint8_t, kScalarSize>;
+using PublicKeyBytes = std::array<std::uint8_t, kPublicKeySize>;
+using CompactSignature = std::array<std::uint8_t, kSignatureSize>;
+
+// Returns the uncompressed x||y public key for `secret`, or nothing when the
+// secret is zero or not below the group order.
+[[nodiscard]] BLOCXXI_CRYPTO_API auto DerivePublicKey(
+  std::span<std::uint8_t const, kScalarSize> secret) -> std::optional<PublicKeyBytes>;
+
+// Signs a 32-byte message digest. The signature is normalized to low-s.
+[[nodiscard]] BLOCXXI_CRYPTO_API auto SignDigest(
+  std::span<std::uint8_t const, kScalarSize> secret,
+  std::span<std::uint8_t const, kScalarSize> digest) -> std::optional<CompactSignature>;
+
+// A validated public key together with its verification tables. Contexts are
+// immutable once built, so copies share the tables and can be used from
+// several threads at once.
+class PublicKeyContext {
+public:
+  [[nodiscard]] static BLOCXXI_CRYPTO_API auto Parse(
+    std::span<std::uint8_t const, kPublicKeySize> encoded)
+    -> std::optional<PublicKeyContext>;
+
+  [[nodiscard]] BLOCXXI_CRYPTO_API auto Encoded() const -> PublicKeyBytes const&;
+
+  // Accepts 64-byte r||s signatures with both components in [1, n).
+  [[nodiscard]] BLOCXXI_CRYPTO_API auto VerifyDigest(
+    std::span<std::uint8_t const, kScalarSize> digest,
+    std::span<std::uint8_t const> signature) const -> bool;
+
+  struct Tables;
+
+private:
+  explicit PublicKeyContext(std::shared_ptr<Tables const> tables);
+
+  std::shared_ptr<Tables const> tables_ {};
+};
+
+} // namespace blocxxi::crypto::secp256k1
@@ -6,61 +6,52 @@
 
 #include <Blocxxi/Crypto/signature.h>
 
+#include <algorithm>
 #include <stdexcept>
 
-#include <Nova/Base/Compilers.h>
-
-NOVA_DIAGNOSTIC_PUSH
-#if NOVA_GNUC_VERSION
-#pragma GCC diagnostic ignored "-Wshadow"
-#endif
-#include <cryptopp/eccrypto.h>
-#include <cryptopp/files.h>
-#include <cryptopp/oids.h>
-#include <cryptopp/osrng.h>
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-#include <cryptopp/sha.h>
-#include <cryptopp/queue.h>
-NOVA_DIAGNOSTIC_POP
+#include <Nova/Base/Sha256.h>
 
 #include <Blocxxi/Codec/base16.h>
+#include <Blocxxi/Crypto/secp256k1.h>
 
 namespace blocxxi::crypto {
 namespace {
 
-namespace cr = CryptoPP;
+// Verification contexts are expensive to build (point validation plus the
+// odd-multiple tables), so the free VerifyMessage() keeps the most recently
+// used ones per thread. Long-lived callers should hold a SignatureVerifier.
+constexpr auto kCachedKeyContexts = std::size_t { 16 };
 
-using PrivateKeyType = cr::ECDSA<cr::ECP, cr::SHA256>::PrivateKey;
-using PublicKeyType = cr::ECDSA<cr::ECP, cr::SHA256>::PublicKey;
-
-auto MakePrivateKey(KeyPair const& key_pair) -> PrivateKeyType
+auto CachedKeyContext(KeyPair::PublicKey const& public_key)
+  -> std::optional<secp256k1::PublicKeyContext>
 {
-  auto private_key = PrivateKeyType {};
-  auto const private_exponent = cr::Integer(key_pair.Secret().Data(),
-    KeyPair::PrivateKey::Size(), cr::Integer::UNSIGNED,
-    cr::ByteOrder::BIG_ENDIAN_ORDER);
-  private_key.Initialize(cr::ASN1::secp256k1(), private_exponent);
-  return private_key;
-}
+  thread_local auto contexts = std::vector<secp256k1::PublicKeyContext> {};
+
+  auto const encoded = std::span<std::uint8_t const, secp256k1::kPublicKeySize>(
+    public_key.Data(), secp256k1::kPublicKeySize);
+  auto const found = std::find_if(contexts.begin(), contexts.end(),
+    [&](secp256k1::PublicKeyContext const& context) {
+      return std::equal(encoded.begin(), encoded.end(), context.Encoded().begin());
+    });
+  if (found != contexts.end()) {
+    std::rotate(contexts.begin(), found, found + 1);
+    return contexts.front();
+  }
 
-auto MakePublicKey(KeyPair::PublicKey const& public_key_hash) -> PublicKeyType
-{
-  auto public_key = PublicKeyType {};
-  public_key.AccessGroupParameters().Initialize(cr::ASN1::secp256k1());
-  auto encoded = std::array<std::uint8_t, 65> {};
-  encoded.front() = 0x04U;
-  std::copy_n(public_key_hash.Data(), 64U, encoded.begin() + 1U);
-  auto point = cr::ECP::Point {};
-  if (!public_key.GetGroupParameters().GetCurve().DecodePoint(
-        point, encoded.data(), encoded.size())) {
-    throw std::invalid_argument("invalid secp256k1 public point encoding");
+  auto context = secp256k1::PublicKeyContext::Parse(encoded);
+  if (!context.has_value()) {
+    return std::nullopt;
   }
-  public_key.Initialize(cr::ASN1::secp256k1(), point);
-  auto prng = cr::AutoSeededRandomPool {};
-  if (!public_key.Validate(prng, 3)) {
-    throw std::invalid_argument("invalid secp256k1 public key");
+  if (contexts.size() == kCachedKeyContexts) {
+    contexts.pop_back();
   }
-  return public_key;
+  contexts.insert(contexts.begin(), *context);
+  return context;
+}
+
+auto MessageDigest(std::span<std::uint8_t const> message) -> nova::Sha256Digest
+{
+  return nova::ComputeSha256(std::as_bytes(message));
 }
 
 auto DecodeHex(std::string const& value) -> SignatureBytes
@@ -101,13 +92,15 @@ auto PublicKeyFromHex(std::string const& public_key_hex)
 auto SignMessage(KeyPair const& key_pair, std::span<std::uint8_t const> message)
   -> SignatureBytes
 {
-  auto signer = cr::ECDSA<cr::ECP, cr::SHA256>::Signer(MakePrivateKey(key_pair));
-  auto prng = cr::AutoSeededRandomPool {};
-  auto signature = SignatureBytes(signer.MaxSignatureLength());
-  auto const length = signer.SignMessage(
-    prng, message.data(), message.size(), signature.data());
-  signature.resize(length);
-  return signature;
+  auto const digest = MessageDigest(message);
+  auto const signature = secp256k1::SignDigest(
+    std::span<std::uint8_t const, secp256k1::kScalarSize>(
+      key_pair.Secret().Data(), secp256k1::kScalarSize),
+    digest);
+  if (!signature.has_value()) {
+    throw std::invalid_argument("invalid secp256k1 private key");
+  }
+  return SignatureBytes(signature->begin(), signature->end());
 }
 
 auto SignMessageHex(KeyPair const& key_pair, std::span<std::uint8_t const> message)
@@ -121,13 +114,11 @@ auto VerifyMessage(KeyPair::PublicKey const& public_key,
   std::span<std::uint8_t const> message, std::span<std::uint8_t const> signature)
   -> bool
 {
-  try {
-    auto verifier = cr::ECDSA<cr::ECP, cr::SHA256>::Verifier(MakePublicKey(public_key));
-    return verifier.VerifyMessage(
-      message.data(), message.size(), signature.data(), signature.size());
-  } catch (std::exception const&) {
+  auto const context = CachedKeyContext(public_key);
+  if (!context.has_value()) {
     return false;
   }
+  return context->VerifyDigest(MessageDigest(message), signature);
 }
 
 auto VerifyMessageHex(KeyPair::PublicKey const& public_key,
@@ -141,4 +132,71 @@ auto VerifyMessageHex(KeyPair::PublicKey const& public_key,
   }
 }
 
+struct SignatureVerifier::Impl {
+  secp256k1::PublicKeyContext context;
+};
+
+SignatureVerifier::SignatureVerifier(KeyPair::PublicKey const& public_key)
+{
+  auto context = secp256k1::PublicKeyContext::Parse(
+    std::span<std::uint8_t const, secp256k1::kPublicKeySize>(
+      public_key.Data(), secp256k1::kPublicKeySize));
+  if (!context.has_value()) {
+    throw std::invalid_argument("invalid secp256k1 public key");
+  }
+  impl_ = std::make_unique<Impl>(Impl { std::move(*context) });
+}
+
+SignatureVerifier::SignatureVerifier(SignatureVerifier const& other)
+  : impl_(std::make_unique<Impl>(*other.impl_))
+{
+}
+
+auto SignatureVerifier::operator=(SignatureVerifier const& rhs) -> SignatureVerifier&
+{
+  if (this != &rhs) {
+    impl_ = std::make_unique<Impl>(*rhs.impl_);
+  }
+  return *this;
+}
+
+SignatureVerifier::SignatureVerifier(SignatureVerifier&&) noexcept = default;
+
+auto SignatureVerifier::operator=(SignatureVerifier&&) noexcept
+  -> SignatureVerifier& = default;
+
+SignatureVerifier::~SignatureVerifier() = default;
+
+auto SignatureVerifier::FromHex(std::string const& public_key_hex)
+  -> std::optional<SignatureVerifier>
+{
+  auto const public_key = PublicKeyFromHex(public_key_hex);
+  if (!public_key.has_value()) {
+    return std::nullopt;
+  }
+
+  try {
+    return SignatureVerifier(*public_key);
+  } catch (std::exception const&) {
+    return std::nullopt;
+  }
+}
+
+auto SignatureVerifier::Verify(std::span<std::uint8_t const> message,
+  std::span<std::uint8_t const> signature) const -> bool
+{
+  return impl_->context.VerifyDigest(MessageDigest(message), signature);
+}
+
+auto SignatureVerifier::VerifyHex(std::span<std::uint8_t const> message,
+  std::string const& signature_hex) const -> bool
+{
+  try {
+    auto const signature = DecodeHex(signature_hex);
+    return Verify(message, signature);
+  } catch (std::exception const&) {
+    return false;
+  }
+}
+
 } // namespace blocxxi::crypto
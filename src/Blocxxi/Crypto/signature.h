@@ -8,6 +8,7 @@
 
 #include <Blocxxi/Crypto/api_export.h>
 
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -39,4 +40,34 @@ using SignatureBytes = std::vector<std::uint8_t>;
   KeyPair::PublicKey const& public_key, std::span<std::uint8_t const> message,
   std::string const& signature_hex) -> bool;
 
+// Verifier bound to a single public key. Validating the curve point and
+// building its multiplication tables is the expensive part of a verification,
+// so callers checking many signatures from the same signer should build one of
+// these and reuse it. The tables are immutable: copies share them, and a
+// verifier can be used concurrently from different threads.
+class SignatureVerifier {
+public:
+  // Throws std::invalid_argument when the key is not a valid secp256k1 point.
+  explicit BLOCXXI_CRYPTO_API SignatureVerifier(KeyPair::PublicKey const& public_key);
+
+  BLOCXXI_CRYPTO_API SignatureVerifier(SignatureVerifier const& other);
+  BLOCXXI_CRYPTO_API auto operator=(SignatureVerifier const& rhs) -> SignatureVerifier&;
+  BLOCXXI_CRYPTO_API SignatureVerifier(SignatureVerifier&&) noexcept;
+  BLOCXXI_CRYPTO_API auto operator=(SignatureVerifier&&) noexcept -> SignatureVerifier&;
+  BLOCXXI_CRYPTO_API ~SignatureVerifier();
+
+  [[nodiscard]] static BLOCXXI_CRYPTO_API auto FromHex(
+    std::string const& public_key_hex) -> std::optional<SignatureVerifier>;
+
+  [[nodiscard]] BLOCXXI_CRYPTO_API auto Verify(std::span<std::uint8_t const> message,
+    std::span<std::uint8_t const> signature) const -> bool;
+
+  [[nodiscard]] BLOCXXI_CRYPTO_API auto VerifyHex(std::span<std::uint8_t const> message,
+    std::string const& signature_hex) const -> bool;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 } // namespace blocxxi::crypto
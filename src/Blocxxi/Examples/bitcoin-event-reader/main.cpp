@@ -18,10 +18,12 @@ namespace {
 
 class ScriptedTransport final : public blocxxi::bitcoin::RpcTransport {
 public:
-  auto Call(std::string_view method, std::string_view, std::string& response_json)
-    -> blocxxi::core::Status override
+  auto Call(std::string_view method, std::string_view params_json,
+    std::string& response_json) -> blocxxi::core::Status override
   {
-    auto const found = responses_.find(std::string(method));
+    auto const found = responses_.find(method == "getmempoolentry"
+        ? std::string(method) + std::string(params_json)
+        : std::string(method));
     if (found == responses_.end()) {
       return blocxxi::core::Status::Failure(
         blocxxi::core::StatusCode::NotFound, "missing rpc response");
@@ -38,8 +40,9 @@ private:
     { "getnetworkinfo",
       R"({"result":{"connections":4,"relayfee":0.00001000,"warnings":"quiet"}})" },
     { "getblockchaininfo", R"({"result":{"initialblockdownload":false}})" },
-    { "getrawmempool",
-      R"({"result":{"tx-read":{"vsize":160,"weight":640,"fees":{"base":0.00015000}}}})" },
+    { "getrawmempool", R"({"result":["tx-read"]})" },
+    { R"(getmempoolentry["tx-read"])",
+      R"({"result":{"vsize":160,"weight":640,"fees":{"base":0.00015000}}})" },
     { "getblockstats", R"({"result":{"txs":12,"totalfee":0.00080000}})" },
   };
 };
@@ -128,10 +128,12 @@ auto ParseOptions(int argc, char** argv) -> AnalyzerOptions
 
 class ScriptedTransport final : public blocxxi::bitcoin::RpcTransport {
 public:
-  auto Call(std::string_view method, std::string_view, std::string& response_json)
-    -> blocxxi::core::Status override
+  auto Call(std::string_view method, std::string_view params_json,
+    std::string& response_json) -> blocxxi::core::Status override
   {
-    auto const found = responses_.find(std::string(method));
+    auto const found = responses_.find(method == "getmempoolentry"
+        ? std::string(method) + std::string(params_json)
+        : std::string(method));
     if (found == responses_.end()) {
       return blocxxi::core::Status::Failure(
         blocxxi::core::StatusCode::NotFound, "missing rpc response");
@@ -148,8 +150,11 @@ private:
     { "getnetworkinfo",
       R"({"result":{"connections":12,"relayfee":0.00001000,"warnings":"steady"}})" },
     { "getblockchaininfo", R"({"result":{"initialblockdownload":false}})" },
-    { "getrawmempool",
-      R"({"result":{"tx-large":{"vsize":400,"weight":1600,"fees":{"base":0.00045000}},"tx-mid":{"vsize":180,"weight":720,"fees":{"base":0.00018000}}}})" },
+    { "getrawmempool", R"({"result":["tx-large","tx-mid"]})" },
+    { R"(getmempoolentry["tx-large"])",
+      R"({"result":{"vsize":400,"weight":1600,"fees":{"base":0.00045000}}})" },
+    { R"(getmempoolentry["tx-mid"])",
+      R"({"result":{"vsize":180,"weight":720,"fees":{"base":0.00018000}}})" },
     { "getblockstats", R"({"result":{"txs":24,"totalfee":0.00320000}})" },
   };
 };
@@ -216,7 +221,7 @@ public:
       return blocxxi::core::Status::Success();
     };
 
-    for (auto const& observation : batch.mempool_transactions) {
+    for (auto const& observation : batch.added_transactions) {
       if (observation.base_fee_btc < 0.0003) {
         continue;
       }
@@ -83,8 +83,8 @@ auto main(int argc, char** argv) -> int
     std::cout << "live-protocol-version=" << result.protocol_version << '\n';
     std::cout << "live-headers=" << result.header_hashes.size() << '\n';
     if (!result.header_hashes.empty()) {
-      std::cout << "live-first-header=" << result.header_hashes.front() << '\n';
-      std::cout << "live-last-header=" << result.header_hashes.back() << '\n';
+      std::cout << "live-first-header=" << result.header_hashes.front().ToHex() << '\n';
+      std::cout << "live-last-header=" << result.header_hashes.back().ToHex() << '\n';
     }
     return 0;
   }
@@ -129,9 +129,9 @@ auto main(int argc, char** argv) -> int
     std::cout << "live-imported-heights=" << adapter.ImportedHeights().size() << '\n';
     std::cout << "live-kernel-height=" << node.Snapshot().height << '\n';
     if (!result.headers.empty()) {
-      std::cout << "live-import-first-header=" << result.headers.front().hash_hex
+      std::cout << "live-import-first-header=" << result.headers.front().hash.ToHex()
                 << '\n';
-      std::cout << "live-import-last-header=" << result.headers.back().hash_hex
+      std::cout << "live-import-last-header=" << result.headers.back().hash.ToHex()
                 << '\n';
     }
     return 0;
@@ -152,7 +152,7 @@ auto main(int argc, char** argv) -> int
     auto blocks = blocxxi::bitcoin::SignetBlocksResult {};
     auto const first_hash = headers.header_hashes.front();
     status = client.FetchBlocks(
-      std::span<std::string const>(&first_hash, 1U), blocks);
+      std::span(&first_hash, 1U), blocks);
     if (!status.ok()) {
       std::cerr << status.message << '\n';
       return 1;
@@ -162,13 +162,13 @@ auto main(int argc, char** argv) -> int
     std::cout << "live-block-count=" << blocks.blocks.size() << '\n';
     if (!blocks.blocks.empty()) {
       std::cout << "live-block-summary=peer,block,tx-count,output-total,first-tx\n";
-      std::cout << "live-block-hash=" << blocks.blocks.front().block_hash_hex << '\n';
+      std::cout << "live-block-hash=" << blocks.blocks.front().block_hash.ToHex() << '\n';
       std::cout << "live-block-bytes=" << blocks.blocks.front().payload.size() << '\n';
       std::cout << "live-block-tx-count=" << blocks.metadata.front().transaction_count
                 << '\n';
       std::cout << "live-block-output-total="
                 << blocks.metadata.front().total_output_value << '\n';
-      std::cout << "live-block-prev=" << blocks.metadata.front().previous_hash_hex
+      std::cout << "live-block-prev=" << blocks.metadata.front().previous_hash.ToHex()
                 << '\n';
       if (!blocks.metadata.front().transaction_sizes.empty()) {
         std::cout << "live-block-first-tx-bytes="
@@ -182,9 +182,9 @@ auto main(int argc, char** argv) -> int
         std::cout << "live-block-first-tx-output-total="
                   << blocks.metadata.front().transaction_output_values.front() << '\n';
         std::cout << "live-block-first-txid="
-                  << blocks.metadata.front().transaction_ids.front() << '\n';
+                  << blocks.metadata.front().transaction_ids.front().ToHex() << '\n';
         std::cout << "live-block-first-tx-wtxid="
-                  << blocks.metadata.front().transaction_witness_ids.front() << '\n';
+                  << blocks.metadata.front().transaction_witness_ids.front().ToHex() << '\n';
         std::cout << "live-block-first-tx-has-witness="
                   << (blocks.metadata.front().transaction_has_witness.front() ? 1 : 0)
                   << '\n';
@@ -210,7 +210,7 @@ auto main(int argc, char** argv) -> int
          ++index) {
       auto blocks = blocxxi::bitcoin::SignetBlocksResult {};
       auto const hash = headers.header_hashes[index];
-      status = client.FetchBlocks(std::span<std::string const>(&hash, 1U), blocks);
+      status = client.FetchBlocks(std::span(&hash, 1U), blocks);
       if (!status.ok() || blocks.metadata.empty()) {
         continue;
       }
@@ -222,11 +222,11 @@ auto main(int argc, char** argv) -> int
         }
 
         std::cout << "live-witness-block-peer=" << blocks.peer_address << '\n';
-        std::cout << "live-witness-block-hash=" << blocks.blocks.front().block_hash_hex
+        std::cout << "live-witness-block-hash=" << blocks.blocks.front().block_hash.ToHex()
                   << '\n';
         std::cout << "live-witness-tx-index=" << tx << '\n';
-        std::cout << "live-witness-txid=" << metadata.transaction_ids[tx] << '\n';
-        std::cout << "live-witness-wtxid=" << metadata.transaction_witness_ids[tx]
+        std::cout << "live-witness-txid=" << metadata.transaction_ids[tx].ToHex() << '\n';
+        std::cout << "live-witness-wtxid=" << metadata.transaction_witness_ids[tx].ToHex()
                   << '\n';
         return 0;
       }
@@ -257,14 +257,17 @@ auto main(int argc, char** argv) -> int
   auto const headers = std::array {
     blocxxi::bitcoin::Header {
       .height = 1,
-      .hash_hex = "0000000000000000000000000000000000000000000000000000000000000001",
-      .previous_hash_hex = "0000000000000000000000000000000000000000000000000000000000000000",
+      .hash = *blocxxi::bitcoin::BlockHash::FromHex(
+        "0000000000000000000000000000000000000000000000000000000000000001"),
+      .previous_hash = blocxxi::bitcoin::SignetGenesisHash(),
       .version = 0x20000000,
     },
     blocxxi::bitcoin::Header {
       .height = 2,
-      .hash_hex = "0000000000000000000000000000000000000000000000000000000000000002",
-      .previous_hash_hex = "0000000000000000000000000000000000000000000000000000000000000001",
+      .hash = *blocxxi::bitcoin::BlockHash::FromHex(
+        "0000000000000000000000000000000000000000000000000000000000000002"),
+      .previous_hash = *blocxxi::bitcoin::BlockHash::FromHex(
+        "0000000000000000000000000000000000000000000000000000000000000001"),
       .version = 0x20000000,
     },
   };
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+// Measures hex encode/decode throughput on 32-byte hashes and on large
+// buffers, against the byte-at-a-time stringstream parsing the Bitcoin adapter
+// used before.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Blocxxi/Codec/base16.h>
+
+namespace {
+
+constexpr std::size_t kTotalBytes = std::size_t { 64 } << 20U;
+
+// Keeps the optimizer from discarding the benchmarked work.
+volatile std::uint8_t g_sink = 0;
+
+auto StringStreamDecode(std::string const& hex, std::span<std::uint8_t> out)
+  -> bool
+{
+  for (auto index = std::size_t { 0 }; index < out.size(); ++index) {
+    auto parsed = std::uint32_t { 0 };
+    auto stream = std::stringstream {};
+    stream << std::hex << hex.substr(index * 2U, 2U);
+    stream >> parsed;
+    if (stream.fail()) {
+      return false;
+    }
+    out[index] = static_cast<std::uint8_t>(parsed);
+  }
+  return true;
+}
+
+// Runs `body` over `chunk`-byte pieces until kTotalBytes of binary data went
+// through it, and returns the throughput in GB/s of binary data.
+template <typename Body>
+auto Measure(std::size_t chunk, std::size_t total, Body&& body) -> double
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (auto done = std::size_t { 0 }; done < total; done += chunk) {
+    body();
+  }
+  const std::chrono::duration<double> elapsed
+    = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(total) / elapsed.count() / 1e9;
+}
+
+auto Run(std::size_t chunk) -> void
+{
+  namespace hex = blocxxi::codec::hex;
+
+  auto binary = std::vector<std::uint8_t>(chunk);
+  for (auto index = std::size_t { 0 }; index < chunk; ++index) {
+    binary[index] = static_cast<std::uint8_t>(index * 131U);
+  }
+  auto text = std::string(chunk * 2U, '\0');
+  hex::EncodeTo(binary, std::span(text), true);
+  auto decoded = std::vector<std::uint8_t>(chunk);
+
+  const auto encode = Measure(chunk, kTotalBytes, [&] {
+    hex::EncodeTo(binary, std::span(text), true);
+    g_sink = g_sink + static_cast<std::uint8_t>(text[0]);
+  });
+  const auto encode_reversed = Measure(chunk, kTotalBytes, [&] {
+    hex::EncodeReversedTo(binary, std::span(text), true);
+    g_sink = g_sink + static_cast<std::uint8_t>(text[0]);
+  });
+  hex::EncodeTo(binary, std::span(text), true);
+  const auto decode = Measure(chunk, kTotalBytes, [&] {
+    g_sink = g_sink + static_cast<std::uint8_t>(hex::TryDecode(text, decoded));
+  });
+  const auto decode_reversed = Measure(chunk, kTotalBytes, [&] {
+    g_sink = g_sink
+      + static_cast<std::uint8_t>(hex::TryDecodeReversed(text, decoded));
+  });
+  // The stringstream baseline is orders of magnitude slower; a small sample
+  // is enough.
+  const auto stream_decode = Measure(chunk, kTotalBytes / 256U, [&] {
+    g_sink = g_sink + static_cast<std::uint8_t>(StringStreamDecode(text, decoded));
+  });
+
+  std::printf("%10zu %10.2f %10.2f %10.2f %10.2f %12.4f\n", chunk, encode,
+    encode_reversed, decode, decode_reversed, stream_decode);
+}
+
+} // namespace
+
+auto main() -> int
+{
+  std::printf("Throughput in GB/s of binary data\n\n");
+  std::printf("%10s %10s %10s %10s %10s %12s\n", "bytes", "encode", "enc rev",
+    "decode", "dec rev", "stringstream");
+  for (const std::size_t chunk : { 32, 256, 4096, 65536 }) {
+    Run(chunk);
+  }
+  return 0;
+}
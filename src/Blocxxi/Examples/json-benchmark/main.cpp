@@ -0,0 +1,251 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+// Measures how fast the Bitcoin adapter reads a verbose getrawmempool
+// response: the structural index alone, the tape with a lookup of each
+// entry's fields, the streaming parser, and the byte-at-a-time lookups the
+// adapter used before. Pass a recorded response, as saved from
+// `bitcoin-cli getrawmempool true` wrapped in {"result":...}, to measure on
+// it instead of a generated one.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <Blocxxi/Bitcoin/json_stream.h>
+#include <Blocxxi/Bitcoin/json_tape.h>
+
+namespace {
+
+namespace bitcoin = blocxxi::bitcoin;
+
+constexpr std::size_t kGeneratedEntries = 50000;
+constexpr std::size_t kTotalBytes = std::size_t { 1 } << 30U;
+constexpr std::size_t kStreamPiece = 16U * 1024U;
+
+// Keeps the optimizer from discarding the benchmarked work.
+volatile std::uint64_t g_sink = 0;
+
+auto GenerateResponse(std::size_t entries) -> std::string
+{
+  auto text = std::string { R"({"result":{)" };
+  for (auto index = std::size_t { 0 }; index < entries; ++index) {
+    auto txid = std::string(64U, '0');
+    auto value = index * 2654435761U;
+    for (auto digit = std::size_t { 0 }; digit < 16U; ++digit, value >>= 4U) {
+      txid[digit] = "0123456789abcdef"[value & 0x0FU];
+    }
+    auto const vsize = std::to_string(141U + (index % 900U));
+    text += index == 0U ? "\"" : ",\"";
+    text += txid;
+    text += R"(":{"vsize":)" + vsize + R"(,"weight":)" + std::to_string(4U * (141U + (index % 900U)));
+    text += R"(,"time":1700000000,"height":820000,"descendantcount":1,"descendantsize":)"
+      + vsize;
+    text += R"(,"ancestorcount":1,"ancestorsize":)" + vsize;
+    text += R"(,"wtxid":")" + txid + R"(","fees":{"base":0.0000)"
+      + std::to_string(1000U + (index % 8999U));
+    text += R"(,"modified":0.00001410,"ancestor":0.00001410,"descendant":0.00001410},)";
+    text += R"("depends":[],"spentby":[],"bip125-replaceable":false,"unbroadcast":false})";
+  }
+  text += R"(},"error":null,"id":"blocxxi"})";
+  return text;
+}
+
+// The lookups the adapter made before the tape, scanning the text of an
+// object again for every key.
+namespace scan {
+
+auto SkipWhitespace(std::string_view text, std::size_t position) -> std::size_t
+{
+  while (position < text.size()
+    && (text[position] == ' ' || text[position] == '\n' || text[position] == '\t'
+      || text[position] == '\r')) {
+    ++position;
+  }
+  return position;
+}
+
+auto ConsumeString(std::string_view text, std::size_t position) -> std::optional<std::size_t>
+{
+  auto escaped = false;
+  for (auto index = position + 1U; index < text.size(); ++index) {
+    if (escaped) {
+      escaped = false;
+    } else if (text[index] == '\\') {
+      escaped = true;
+    } else if (text[index] == '"') {
+      return index + 1U;
+    }
+  }
+  return std::nullopt;
+}
+
+auto ConsumeValue(std::string_view text, std::size_t position) -> std::size_t
+{
+  if (text[position] == '"') {
+    return ConsumeString(text, position).value_or(text.size());
+  }
+  auto depth = std::size_t { 0 };
+  auto in_string = false;
+  auto escaped = false;
+  for (auto index = position; index < text.size(); ++index) {
+    auto const current = text[index];
+    if (in_string) {
+      if (escaped) {
+        escaped = false;
+      } else if (current == '\\') {
+        escaped = true;
+      } else if (current == '"') {
+        in_string = false;
+      }
+    } else if (current == '"') {
+      in_string = true;
+    } else if (current == '{' || current == '[') {
+      ++depth;
+    } else if (current == '}' || current == ']') {
+      if (depth == 0U) {
+        return index;
+      }
+      if (--depth == 0U) {
+        return index + 1U;
+      }
+    } else if (depth == 0U && current == ',') {
+      return index;
+    }
+  }
+  return text.size();
+}
+
+// Calls `visit` with each key and value of `object`.
+template <typename Visit>
+auto ForEachMember(std::string_view object, Visit&& visit) -> void
+{
+  auto position = std::size_t { 1 };
+  while (position + 1U < object.size()) {
+    position = SkipWhitespace(object, position);
+    if (object[position] == '}') {
+      return;
+    }
+    auto const key_end = ConsumeString(object, position).value_or(object.size());
+    auto const key = object.substr(position + 1U, key_end - position - 2U);
+    position = SkipWhitespace(object, SkipWhitespace(object, key_end) + 1U);
+    auto const value_end = ConsumeValue(object, position);
+    if (!visit(key, object.substr(position, value_end - position))) {
+      return;
+    }
+    position = SkipWhitespace(object, value_end) + 1U;
+  }
+}
+
+auto Find(std::string_view object, std::string_view key) -> std::string_view
+{
+  auto found = std::string_view {};
+  ForEachMember(object, [&](std::string_view member, std::string_view value) {
+    if (member == key) {
+      found = value;
+      return false;
+    }
+    return true;
+  });
+  return found;
+}
+
+} // namespace scan
+
+// Counts the numbers in a document.
+class CountingHandler final : public bitcoin::JsonHandler {
+public:
+  auto Number(std::string_view /*value*/) -> bool override
+  {
+    ++numbers;
+    return true;
+  }
+
+  std::uint64_t numbers { 0 };
+};
+
+// Runs `body` over `text` until kTotalBytes went through it, and returns the
+// throughput in MB/s.
+template <typename Body>
+auto Measure(std::string const& text, Body&& body) -> double
+{
+  auto const rounds = std::max<std::size_t>(1U, kTotalBytes / text.size());
+  auto const start = std::chrono::steady_clock::now();
+  for (auto round = std::size_t { 0 }; round < rounds; ++round) {
+    body();
+  }
+  std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(rounds * text.size()) / elapsed.count() / 1e6;
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+  auto text = std::string {};
+  if (argc > 1) {
+    auto input = std::ifstream(argv[1], std::ios::binary);
+    if (!input) {
+      std::fprintf(stderr, "cannot read %s\n", argv[1]);
+      return 1;
+    }
+    text.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  } else {
+    text = GenerateResponse(kGeneratedEntries);
+  }
+
+  auto const tape = bitcoin::JsonTape::Parse(text);
+  auto const result = tape ? tape->Find(tape->Root(), "result") : std::nullopt;
+  if (!result.has_value()) {
+    std::fprintf(stderr, "not a getrawmempool response\n");
+    return 1;
+  }
+  std::printf("%zu bytes, %zu entries\n\n", text.size(), tape->Children(*result).size());
+  std::printf("%-28s %10s\n", "", "MB/s");
+
+  auto const scanned = Measure(text, [&] {
+    auto const entries = scan::Find(text, "result");
+    scan::ForEachMember(entries, [](std::string_view, std::string_view entry) {
+      g_sink = g_sink + scan::Find(entry, "vsize").size() + scan::Find(entry, "weight").size()
+        + scan::Find(scan::Find(entry, "fees"), "base").size();
+      return true;
+    });
+  });
+  auto const indexed = Measure(text, [&] { g_sink = g_sink + bitcoin::BuildStructuralIndex(text).size(); });
+  auto const taped = Measure(text, [&] {
+    auto const parsed = bitcoin::JsonTape::Parse(text);
+    auto const entries = parsed->Find(parsed->Root(), "result");
+    for (auto const txid : parsed->Children(*entries)) {
+      auto const entry = txid + 1U;
+      g_sink = g_sink + parsed->FindText(entry, "vsize")->size()
+        + parsed->FindText(entry, "weight")->size();
+      if (auto const fees = parsed->Find(entry, "fees")) {
+        g_sink = g_sink + parsed->FindText(*fees, "base")->size();
+      }
+    }
+  });
+  auto const streamed = Measure(text, [&] {
+    auto handler = CountingHandler {};
+    auto parser = bitcoin::JsonStreamParser(handler);
+    for (auto offset = std::size_t { 0 }; offset < text.size(); offset += kStreamPiece) {
+      (void)parser.Feed(std::string_view(text).substr(offset, kStreamPiece));
+    }
+    g_sink = g_sink + handler.numbers + static_cast<std::uint64_t>(parser.Finish());
+  });
+
+  std::printf("%-28s %10.1f\n", "byte scan, lookups", scanned);
+  std::printf("%-28s %10.1f\n", "structural index", indexed);
+  std::printf("%-28s %10.1f\n", "tape, lookups", taped);
+  std::printf("%-28s %10.1f\n", "streaming parser", streamed);
+  return 0;
+}
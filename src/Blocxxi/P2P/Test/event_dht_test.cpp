@@ -8,7 +8,9 @@
 
 #include <chrono>
 
+#include <Blocxxi/Codec/bencode.h>
 #include <Blocxxi/Core/event_record.h>
+#include <Blocxxi/Core/signature_cache.h>
 #include <Blocxxi/P2P/event_dht.h>
 #include <Blocxxi/P2P/kademlia/channel.h>
 #include <Blocxxi/P2P/kademlia/mainline_node.h>
@@ -34,6 +36,35 @@ auto NextPortBase() -> std::uint16_t
   return current;
 }
 
+// A record the way bx_get_event replies carry it. Only records without
+// identifiers, attributes or payload are needed here.
+auto RecordValue(core::SignedEventRecord const& record) -> codec::bencode::Value
+{
+  using codec::bencode::Value;
+  auto const& envelope = record.envelope;
+  return Value(Value::DictionaryType {
+    { "envelope",
+      Value(Value::DictionaryType {
+        { "schema", Value(envelope.schema) },
+        { "event_type", Value(envelope.event_type) },
+        { "taxonomy", Value(envelope.taxonomy) },
+        { "source", Value(envelope.source) },
+        { "producer", Value(envelope.producer) },
+        { "window_start", Value(envelope.window.start_utc) },
+        { "window_end", Value(envelope.window.end_utc) },
+        { "observed_at", Value(envelope.observed_at_utc) },
+        { "published_at", Value(envelope.published_at_utc) },
+        { "identifiers", Value(Value::ListType {}) },
+        { "attributes", Value(Value::ListType {}) },
+        { "summary", Value(envelope.summary) },
+        { "payload", Value(std::string {}) },
+      }) },
+    { "signer_name", Value(record.signer_name) },
+    { "signer_public_key_hex", Value(record.signer_public_key_hex) },
+    { "signature_hex", Value(record.signature_hex) },
+  });
+}
+
 } // namespace
 
 TEST(EventDhtTest, PublishQueryAndDuplicateRepublishAreDeterministic)
@@ -93,6 +124,31 @@ TEST(EventDhtTest, PublishRejectsInvalidSignature)
   EXPECT_EQ(status.code, core::StatusCode::Rejected);
 }
 
+TEST(EventDhtTest, DuplicatePublishReusesVerifiedSignature)
+{
+  auto dht = MemoryEventDht();
+  auto const key_pair = blocxxi::crypto::KeyPair();
+  auto const record = core::SignEventRecord(core::EventEnvelope {
+      .event_type = "bitcoin.block.new",
+      .taxonomy = "block",
+      .source = "bitcoin.rpc",
+      .window = { .start_utc = 30, .end_utc = 31 },
+      .observed_at_utc = 30,
+      .published_at_utc = 31,
+    },
+    key_pair);
+  auto& cache = core::SharedSignatureCache();
+  cache.Clear();
+
+  ASSERT_TRUE(dht.Publish(record).ok());
+  ASSERT_TRUE(dht.Publish(record).ok());
+
+  auto const metrics = cache.Metrics();
+  EXPECT_EQ(metrics.insertions, 1U);
+  EXPECT_EQ(metrics.hits, 1U);
+  EXPECT_TRUE(dht.LastPublish()->duplicate);
+}
+
 TEST(EventDhtTest, PlatformPublishAndQueryHelpersKeepSigningOutOfTheApp)
 {
   auto dht = MemoryEventDht();
@@ -285,6 +341,88 @@ TEST(EventDhtTest, MainlineEventDhtQueriesDeterministicPeersAcrossSessions)
   server.Stop();
 }
 
+TEST(EventDhtTest, MainlineEventDhtDropsPeerRecordsThatFailVerification)
+{
+  auto io_context = asio::io_context {};
+  auto const port_base = NextPortBase();
+  auto const router = kademlia::IpEndpoint { "127.0.0.1", port_base };
+  auto server_channel
+    = kademlia::AsyncUdpChannel::ipv4(
+      io_context, "127.0.0.1", std::to_string(port_base));
+  auto publisher_channel
+    = kademlia::AsyncUdpChannel::ipv4(
+      io_context, "127.0.0.1", std::to_string(port_base + 1U));
+  auto querier_channel
+    = kademlia::AsyncUdpChannel::ipv4(
+      io_context, "127.0.0.1", std::to_string(port_base + 2U));
+
+  auto server = kademlia::Session(kademlia::MainlineDhtNode(io_context,
+    MakeTestNode("127.0.0.1", port_base), std::move(server_channel)));
+  auto publisher = kademlia::Session(kademlia::MainlineDhtNode(io_context,
+    MakeTestNode("127.0.0.1", static_cast<std::uint16_t>(port_base + 1U)),
+    std::move(publisher_channel)));
+  auto querier = kademlia::Session(kademlia::MainlineDhtNode(io_context,
+    MakeTestNode("127.0.0.1", static_cast<std::uint16_t>(port_base + 2U)),
+    std::move(querier_channel)));
+
+  server.Start();
+  publisher.Start();
+  querier.Start();
+
+  auto const options = MainlineEventDhtOptions {
+    .routers = { router },
+    .request_timeout = std::chrono::seconds { 2 },
+  };
+  auto publisher_dht = MainlineEventDht(io_context, publisher, options);
+  auto querier_dht = MainlineEventDht(io_context, querier, options);
+
+  auto const key_pair
+    = blocxxi::crypto::KeyPair("40C756697E6F60AC839FE53DD403F0B254D49A26243A196300CD4D515EE28062");
+  auto const record = core::SignEventRecord(core::EventEnvelope {
+      .event_type = "bitcoin.fee.forged",
+      .taxonomy = "fee-market",
+      .source = "bitcoin.rpc",
+      .producer = "blocxxi.publisher",
+      .window = { .start_utc = 70, .end_utc = 80 },
+      .observed_at_utc = 70,
+      .published_at_utc = 71,
+      .summary = "signed",
+    },
+    key_pair, "publisher");
+  ASSERT_TRUE(publisher_dht.Publish(record).ok());
+
+  // The publisher answers with its record and a copy altered after signing.
+  auto forged = record;
+  forged.envelope.summary = "forged";
+  publisher.OnCustomQuery([&](std::string_view method, kademlia::KrpcQuery const&,
+                            kademlia::IpEndpoint const&) {
+    if (method != "bx_get_event") {
+      return std::optional<codec::bencode::Value::DictionaryType> {};
+    }
+    return std::optional<codec::bencode::Value::DictionaryType> {
+      codec::bencode::Value::DictionaryType {
+        { "records",
+          codec::bencode::Value(
+            codec::bencode::Value::ListType { RecordValue(record), RecordValue(forged) }) },
+      }
+    };
+  });
+
+  auto query_result = EventQueryResult {};
+  ASSERT_TRUE(querier_dht.Query(EventQuery {
+                .deterministic_key = record.DeterministicKey(),
+                .limit = 8,
+              },
+                query_result)
+                .ok());
+  ASSERT_EQ(query_result.records.size(), 1U);
+  EXPECT_EQ(query_result.records.front().record.envelope.summary, "signed");
+
+  querier.Stop();
+  publisher.Stop();
+  server.Stop();
+}
+
 TEST(EventDhtTest, MainlineEventDhtRequiresRouterForPublish)
 {
   auto io_context = asio::io_context {};
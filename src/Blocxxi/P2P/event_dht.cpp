@@ -514,6 +514,7 @@ auto MainlineEventDht::QueryPeerRecords(std::string const& deterministic_key,
   auto done = false;
   auto status = core::Status::Failure(
     core::StatusCode::IOError, "peer record query timed out");
+  auto parsed_records = std::vector<core::SignedEventRecord> {};
 
   io_context_.restart();
   session_.AsyncQuery(
@@ -554,11 +555,7 @@ auto MainlineEventDht::QueryPeerRecords(std::string const& deterministic_key,
             core::StatusCode::Rejected, "peer query returned an invalid event record");
           return;
         }
-        records.push_back(PublishedEvent {
-          .dht_key = parsed->DeterministicKey(),
-          .info_hash = DeriveInfoHash(parsed->DeterministicKey()),
-          .record = std::move(*parsed),
-        });
+        parsed_records.push_back(std::move(*parsed));
       }
       status = core::Status::Success();
     });
@@ -567,6 +564,27 @@ auto MainlineEventDht::QueryPeerRecords(std::string const& deterministic_key,
     return core::Status::Failure(
       core::StatusCode::IOError, "peer record query timed out");
   }
+  if (!status.ok()) {
+    return status;
+  }
+
+  // Verified once the reply is in rather than in its handler, so the batch
+  // never holds up the io_context. Records relayed by several peers hit the
+  // verified-signature cache after the first copy has been checked; a record
+  // that fails verification is dropped and the rest of the reply is kept.
+  auto const verified = core::VerifyEventRecords(parsed_records);
+  for (auto index = std::size_t { 0 }; index < parsed_records.size(); ++index) {
+    if (!verified[index]) {
+      continue;
+    }
+    auto key = parsed_records[index].DeterministicKey();
+    auto info_hash = DeriveInfoHash(key);
+    records.push_back(PublishedEvent {
+      .dht_key = std::move(key),
+      .info_hash = info_hash,
+      .record = std::move(parsed_records[index]),
+    });
+  }
   return status;
 }
 
@@ -31,6 +31,37 @@ TEST(StorageTest, InMemoryStorePreservesBlockOrder)
   EXPECT_EQ(chain.back().header.height, 1);
 }
 
+TEST(StorageTest, StoresServeInclusionProofs)
+{
+  auto const root = std::filesystem::temp_directory_path() / "blocxxi-proof-test";
+  std::filesystem::remove_all(root);
+
+  auto block = core::Block::MakeNext(core::BlockId {}, 0,
+    { core::Transaction::FromText("demo.tx", "a"),
+      core::Transaction::FromText("demo.tx", "b"),
+      core::Transaction::FromText("demo.tx", "c") },
+    "demo");
+  auto const missing = core::Transaction::FromText("demo.tx", "d");
+
+  for (auto const& store : { MakeInMemoryBlockStore(), MakeFileBlockStore(root) }) {
+    EXPECT_FALSE(store->ProveInclusion(block.header.id, missing.id).has_value());
+    ASSERT_TRUE(store->PutBlock(block).ok());
+    // Twice per transaction: the first proof builds the cached tree, the
+    // second is served from it.
+    for (auto pass = 0; pass < 2; ++pass) {
+      for (auto const& transaction : block.transactions) {
+        auto const proof = store->ProveInclusion(block.header.id, transaction.id);
+        ASSERT_TRUE(proof.has_value());
+        EXPECT_EQ(*proof, *block.ProveInclusion(transaction.id));
+        EXPECT_TRUE(core::VerifyInclusion(*proof, block.header));
+      }
+    }
+    EXPECT_FALSE(store->ProveInclusion(block.header.id, missing.id).has_value());
+  }
+
+  std::filesystem::remove_all(root);
+}
+
 TEST(StorageTest, FileStoresRoundTripBlocksAndSnapshots)
 {
   auto const root = std::filesystem::temp_directory_path() / "blocxxi-storage-test";
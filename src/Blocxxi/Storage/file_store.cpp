@@ -11,6 +11,7 @@
 #include <system_error>
 
 #include <Blocxxi/Codec/base16.h>
+#include <Blocxxi/Storage/merkle_tree_cache.h>
 
 namespace blocxxi::storage {
 namespace {
@@ -26,10 +27,14 @@ public:
   [[nodiscard]] auto GetBlock(core::BlockId const& id) const
     -> std::optional<core::Block> override;
   [[nodiscard]] auto GetChain() const -> std::vector<core::Block> override;
+  [[nodiscard]] auto ProveInclusion(core::BlockId const& block_id,
+    core::TransactionId const& transaction_id) const
+    -> std::optional<core::MerkleProof> override;
 
 private:
   [[nodiscard]] auto BlocksDirectory() const -> std::filesystem::path;
   std::filesystem::path root_directory_ {};
+  mutable MerkleTreeCache proof_cache_ {};
 };
 
 class FileSnapshotStore final : public chain::SnapshotStore {
@@ -125,6 +130,10 @@ private:
       block.header.id = core::BlockId::FromHex(value);
     } else if (key == "previous") {
       block.header.previous_id = core::BlockId::FromHex(value);
+    } else if (key == "merkle") {
+      block.header.merkle_root = core::BlockId::FromHex(value);
+    } else if (key == "tx_count") {
+      block.header.transaction_count = std::stoull(value);
     } else if (key == "height") {
       block.header.height = static_cast<core::Height>(std::stoull(value));
     } else if (key == "timestamp") {
@@ -163,6 +172,8 @@ auto FileBlockStore::PutBlock(core::Block const& block) -> core::Status
 
   output << "id=" << block.header.id.ToHex() << '\n';
   output << "previous=" << block.header.previous_id.ToHex() << '\n';
+  output << "merkle=" << block.header.merkle_root.ToHex() << '\n';
+  output << "tx_count=" << block.header.transaction_count << '\n';
   output << "height=" << block.header.height << '\n';
   output << "timestamp=" << block.header.timestamp_utc << '\n';
   output << "source=" << EncodeString(block.header.source) << '\n';
@@ -227,6 +238,17 @@ auto FileBlockStore::GetChain() const -> std::vector<core::Block>
   }
   return chain;
 }
+
+auto FileBlockStore::ProveInclusion(core::BlockId const& block_id,
+  core::TransactionId const& transaction_id) const
+  -> std::optional<core::MerkleProof>
+{
+  // A miss scans the blocks directory; the cache spares repeated proofs
+  // against the same block both the scan and the rehash.
+  return proof_cache_.Prove(
+    block_id, transaction_id, [&] { return GetBlock(block_id); });
+}
+
 auto FileSnapshotStore::SnapshotPath() const -> std::filesystem::path
 {
   return root_directory_ / "snapshot.txt";
@@ -6,6 +6,8 @@
 
 #include <Blocxxi/Storage/in_memory_store.h>
 
+#include <Blocxxi/Storage/merkle_tree_cache.h>
+
 namespace blocxxi::storage {
 namespace {
 
@@ -43,9 +45,18 @@ public:
     return chain;
   }
 
+  [[nodiscard]] auto ProveInclusion(core::BlockId const& block_id,
+    core::TransactionId const& transaction_id) const
+    -> std::optional<core::MerkleProof> override
+  {
+    return proof_cache_.Prove(
+      block_id, transaction_id, [&] { return GetBlock(block_id); });
+  }
+
 private:
   std::map<std::string, core::Block> blocks_ {};
   std::vector<std::string> order_ {};
+  mutable MerkleTreeCache proof_cache_ {};
 };
 
 class InMemorySnapshotStore final : public chain::SnapshotStore {
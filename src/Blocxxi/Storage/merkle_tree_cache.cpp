@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Blocxxi/Storage/merkle_tree_cache.h>
+
+#include <utility>
+#include <vector>
+
+namespace blocxxi::storage {
+
+auto MerkleTreeCache::Prove(core::BlockId const& block_id,
+  core::TransactionId const& transaction_id, BlockLoader const& load)
+  -> std::optional<core::MerkleProof>
+{
+  auto entry = Find(block_id);
+  if (!entry) {
+    auto const block = load();
+    if (!block) {
+      return std::nullopt;
+    }
+    // Hash outside the lock; a concurrent miss on the same block only costs a
+    // duplicate build.
+    auto built = std::make_shared<Entry>();
+    auto leaves = std::vector<core::MerkleHash> {};
+    leaves.reserve(block->transactions.size());
+    for (auto const& transaction : block->transactions) {
+      built->leaf_index.try_emplace(transaction.id, leaves.size());
+      leaves.push_back(transaction.id);
+    }
+    built->tree = core::MerkleTree(leaves);
+    entry = built;
+    Insert(block_id, std::move(built));
+  }
+
+  auto const found = entry->leaf_index.find(transaction_id);
+  if (found == entry->leaf_index.end()) {
+    return std::nullopt;
+  }
+  return entry->tree.Prove(found->second);
+}
+
+auto MerkleTreeCache::Find(core::BlockId const& block_id)
+  -> std::shared_ptr<Entry const>
+{
+  auto const lock = std::lock_guard(mutex_);
+  auto const found = slots_.find(block_id);
+  if (found == slots_.end()) {
+    return nullptr;
+  }
+  order_.splice(order_.begin(), order_, found->second.position);
+  return found->second.entry;
+}
+
+auto MerkleTreeCache::Insert(
+  core::BlockId const& block_id, std::shared_ptr<Entry const> entry) -> void
+{
+  auto const lock = std::lock_guard(mutex_);
+  if (slots_.contains(block_id)) {
+    return;
+  }
+  if (slots_.size() >= capacity_) {
+    slots_.erase(order_.back());
+    order_.pop_back();
+  }
+  order_.push_front(block_id);
+  slots_.emplace(block_id, Slot { std::move(entry), order_.begin() });
+}
+
+} // namespace blocxxi::storage
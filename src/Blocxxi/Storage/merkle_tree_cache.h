@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <Blocxxi/Core/merkle.h>
+#include <Blocxxi/Core/primitives.h>
+
+namespace blocxxi::storage {
+
+// Keeps the full merkle tree of recently proven blocks, so that repeated
+// proofs against the same block read O(log n) stored nodes instead of loading
+// and rehashing the block. Bounded, least recently used first out, and safe to
+// use from the const methods of a store.
+class MerkleTreeCache {
+public:
+  static constexpr auto kDefaultCapacity = std::size_t { 64 };
+
+  using BlockLoader = std::function<std::optional<core::Block>()>;
+
+  explicit MerkleTreeCache(std::size_t capacity = kDefaultCapacity)
+    : capacity_(capacity == 0U ? 1U : capacity)
+  {
+  }
+
+  // Proves from the cached tree of `block_id`, building it from `load()` on a
+  // miss.
+  [[nodiscard]] auto Prove(core::BlockId const& block_id,
+    core::TransactionId const& transaction_id, BlockLoader const& load)
+    -> std::optional<core::MerkleProof>;
+
+private:
+  struct Entry {
+    core::MerkleTree tree {};
+    std::unordered_map<core::TransactionId, std::uint64_t> leaf_index {};
+  };
+  using Order = std::list<core::BlockId>;
+  struct Slot {
+    std::shared_ptr<Entry const> entry {};
+    Order::iterator position {};
+  };
+
+  [[nodiscard]] auto Find(core::BlockId const& block_id)
+    -> std::shared_ptr<Entry const>;
+  auto Insert(core::BlockId const& block_id, std::shared_ptr<Entry const> entry)
+    -> void;
+
+  std::mutex mutex_ {};
+  std::size_t capacity_;
+  Order order_ {};
+  std::unordered_map<core::BlockId, Slot> slots_ {};
+};
+
+} // namespace blocxxi::storage
@@ -0,0 +1,158 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Internal header shared by Sha256.cpp and the multi-buffer kernels. Each
+// kernel lives in its own translation unit so that it can be compiled with the
+// instruction set flags it needs while the rest of the library stays portable.
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace nova::detail::sha256 {
+
+//! Largest lane count of any kernel; sizes the scheduler's scratch state.
+inline constexpr size_t kMaxLanes = 16;
+
+//! Compresses one 64-byte block per lane.
+/*!
+ `state` holds the eight working words of every lane in structure-of-arrays
+ order: word `i` of lane `l` is at `state[i * lanes + l]`. `blocks[l]` points
+ at the block to mix into lane `l`.
+*/
+using CompressLanesFn
+  = void (*)(uint32_t* state, const std::byte* const* blocks) noexcept;
+
+auto CompressLanesSse2(uint32_t* state, const std::byte* const* blocks) noexcept
+  -> void;
+auto CompressLanesAvx2(uint32_t* state, const std::byte* const* blocks) noexcept
+  -> void;
+auto CompressLanesAvx512(
+  uint32_t* state, const std::byte* const* blocks) noexcept -> void;
+
+alignas(64) inline constexpr std::array<uint32_t, 64> kRoundConstants = {
+  0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U,
+  0x923f82a4U, 0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U,
+  0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U,
+  0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+  0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U,
+  0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U,
+  0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
+  0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+  0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU,
+  0x5b9cca4fU, 0x682e6ff3U, 0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U,
+  0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U,
+};
+
+//! Generic lane-parallel compression function.
+/*!
+ `V` wraps one SIMD register type and provides `kLanes`, `Load`, `Store`,
+ `Set1`, `Add`, `Xor`, `And`, `AndNot` (`~a & b`), `Or`, `Shr<N>`, `RotR<N>`,
+ and `LoadMessageWord` (big-endian word `j` of every lane's block). It may
+ also provide fused `Ch` and `Maj`.
+
+ Only instantiate this from a kernel translation unit, with a `V` that has
+ internal linkage there, so differently compiled copies never get merged.
+*/
+template <typename V>
+inline auto CompressLanes(
+  uint32_t* state, const std::byte* const* blocks) noexcept -> void
+{
+  using R = typename V::Register;
+  constexpr size_t kLanes = V::kLanes;
+
+  const auto ch = [](R e, R f, R g) -> R {
+    if constexpr (requires { V::Ch(e, f, g); }) {
+      return V::Ch(e, f, g);
+    } else {
+      return V::Xor(V::And(e, f), V::AndNot(e, g));
+    }
+  };
+  const auto maj = [](R a, R b, R c) -> R {
+    if constexpr (requires { V::Maj(a, b, c); }) {
+      return V::Maj(a, b, c);
+    } else {
+      return V::Or(V::And(a, b), V::And(c, V::Or(a, b)));
+    }
+  };
+
+  // A plain array: std::array would drop the vector type's alignment
+  // attributes.
+  R w[16]; // NOLINT(*-avoid-c-arrays)
+  for (size_t j = 0; j < 16; ++j) {
+    w[j] = V::LoadMessageWord(blocks, j);
+  }
+
+  R a = V::Load(state + (0 * kLanes));
+  R b = V::Load(state + (1 * kLanes));
+  R c = V::Load(state + (2 * kLanes));
+  R d = V::Load(state + (3 * kLanes));
+  R e = V::Load(state + (4 * kLanes));
+  R f = V::Load(state + (5 * kLanes));
+  R g = V::Load(state + (6 * kLanes));
+  R h = V::Load(state + (7 * kLanes));
+
+  for (size_t i = 0; i < 64; ++i) {
+    if (i >= 16) {
+      const R w2 = w[(i - 2) & 15U];
+      const R w15 = w[(i - 15) & 15U];
+      const R s1 = V::Xor(
+        V::Xor(V::template RotR<17>(w2), V::template RotR<19>(w2)),
+        V::template Shr<10>(w2));
+      const R s0 = V::Xor(
+        V::Xor(V::template RotR<7>(w15), V::template RotR<18>(w15)),
+        V::template Shr<3>(w15));
+      w[i & 15U] = V::Add(V::Add(w[i & 15U], s0), V::Add(w[(i - 7) & 15U], s1));
+    }
+
+    const R big_s1 = V::Xor(
+      V::Xor(V::template RotR<6>(e), V::template RotR<11>(e)),
+      V::template RotR<25>(e));
+    const R t1 = V::Add(V::Add(h, big_s1),
+      V::Add(ch(e, f, g), V::Add(V::Set1(kRoundConstants[i]), w[i & 15U])));
+    const R big_s0 = V::Xor(
+      V::Xor(V::template RotR<2>(a), V::template RotR<13>(a)),
+      V::template RotR<22>(a));
+    const R t2 = V::Add(big_s0, maj(a, b, c));
+    h = g;
+    g = f;
+    f = e;
+    e = V::Add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = V::Add(t1, t2);
+  }
+
+  V::Store(state + (0 * kLanes), V::Add(a, V::Load(state + (0 * kLanes))));
+  V::Store(state + (1 * kLanes), V::Add(b, V::Load(state + (1 * kLanes))));
+  V::Store(state + (2 * kLanes), V::Add(c, V::Load(state + (2 * kLanes))));
+  V::Store(state + (3 * kLanes), V::Add(d, V::Load(state + (3 * kLanes))));
+  V::Store(state + (4 * kLanes), V::Add(e, V::Load(state + (4 * kLanes))));
+  V::Store(state + (5 * kLanes), V::Add(f, V::Load(state + (5 * kLanes))));
+  V::Store(state + (6 * kLanes), V::Add(g, V::Load(state + (6 * kLanes))));
+  V::Store(state + (7 * kLanes), V::Add(h, V::Load(state + (7 * kLanes))));
+}
+
+//! Reads big-endian word `j` of a block.
+/*!
+ Internal linkage on purpose: every kernel translation unit gets its own copy,
+ compiled with that kernel's instruction set flags.
+*/
+[[nodiscard]] static inline auto LoadMessageWordBE(
+  const std::byte* block, size_t j) noexcept -> uint32_t
+{
+  const auto* p = block + (j * 4);
+  return (static_cast<uint32_t>(p[0]) << 24U)
+    | (static_cast<uint32_t>(p[1]) << 16U) | (static_cast<uint32_t>(p[2]) << 8U)
+    | static_cast<uint32_t>(p[3]);
+}
+
+} // namespace nova::detail::sha256
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Nova/Base/Detail/Sha256Lanes.h>
+
+#include <immintrin.h>
+
+// Compiled with AVX2 enabled; only reached after a runtime CPU check.
+// NOLINTBEGIN(portability-simd-intrinsics,*-reinterpret-cast,*-magic-numbers)
+namespace nova::detail::sha256 {
+
+namespace {
+
+  //! Eight lanes in one AVX2 register.
+  struct Avx2 {
+    using Register = __m256i;
+    static constexpr size_t kLanes = 8;
+
+    static auto Load(const uint32_t* p) noexcept -> Register
+    {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static auto Store(uint32_t* p, Register v) noexcept -> void
+    {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static auto Set1(uint32_t x) noexcept -> Register
+    {
+      return _mm256_set1_epi32(static_cast<int>(x));
+    }
+    static auto Add(Register a, Register b) noexcept -> Register
+    {
+      return _mm256_add_epi32(a, b);
+    }
+    static auto Xor(Register a, Register b) noexcept -> Register
+    {
+      return _mm256_xor_si256(a, b);
+    }
+    static auto And(Register a, Register b) noexcept -> Register
+    {
+      return _mm256_and_si256(a, b);
+    }
+    static auto AndNot(Register a, Register b) noexcept -> Register
+    {
+      return _mm256_andnot_si256(a, b);
+    }
+    static auto Or(Register a, Register b) noexcept -> Register
+    {
+      return _mm256_or_si256(a, b);
+    }
+    template <int N> static auto Shr(Register v) noexcept -> Register
+    {
+      return _mm256_srli_epi32(v, N);
+    }
+    template <int N> static auto RotR(Register v) noexcept -> Register
+    {
+      return _mm256_or_si256(
+        _mm256_srli_epi32(v, N), _mm256_slli_epi32(v, 32 - N));
+    }
+    static auto LoadMessageWord(
+      const std::byte* const* blocks, size_t j) noexcept -> Register
+    {
+      return _mm256_setr_epi32(
+        static_cast<int>(LoadMessageWordBE(blocks[0], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[1], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[2], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[3], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[4], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[5], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[6], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[7], j)));
+    }
+  };
+
+} // namespace
+
+auto CompressLanesAvx2(uint32_t* state, const std::byte* const* blocks) noexcept
+  -> void
+{
+  CompressLanes<Avx2>(state, blocks);
+}
+
+} // namespace nova::detail::sha256
+// NOLINTEND(portability-simd-intrinsics,*-reinterpret-cast,*-magic-numbers)
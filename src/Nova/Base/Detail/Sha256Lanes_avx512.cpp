@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Nova/Base/Detail/Sha256Lanes.h>
+
+#include <array>
+
+#include <Nova/Base/Compilers.h>
+
+#include <immintrin.h>
+
+// Compiled with AVX-512F enabled; only reached after a runtime CPU check.
+// NOLINTBEGIN(portability-simd-intrinsics,*-reinterpret-cast,*-magic-numbers)
+namespace nova::detail::sha256 {
+
+namespace {
+
+// GCC flags the deliberately undefined pass-through operand that the AVX-512
+// intrinsic headers use for unmasked operations.
+#if NOVA_GNUC_VERSION && !NOVA_CLANG_VERSION
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wuninitialized"
+#  pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+  //! Sixteen lanes in one AVX-512 register, with native rotates and
+  //! ternary-logic Ch/Maj.
+  struct Avx512 {
+    using Register = __m512i;
+    static constexpr size_t kLanes = 16;
+
+    static auto Load(const uint32_t* p) noexcept -> Register
+    {
+      return _mm512_loadu_si512(p);
+    }
+    static auto Store(uint32_t* p, Register v) noexcept -> void
+    {
+      _mm512_storeu_si512(p, v);
+    }
+    static auto Set1(uint32_t x) noexcept -> Register
+    {
+      return _mm512_set1_epi32(static_cast<int>(x));
+    }
+    static auto Add(Register a, Register b) noexcept -> Register
+    {
+      return _mm512_add_epi32(a, b);
+    }
+    static auto Xor(Register a, Register b) noexcept -> Register
+    {
+      return _mm512_xor_si512(a, b);
+    }
+    static auto And(Register a, Register b) noexcept -> Register
+    {
+      return _mm512_and_si512(a, b);
+    }
+    static auto AndNot(Register a, Register b) noexcept -> Register
+    {
+      return _mm512_andnot_si512(a, b);
+    }
+    static auto Or(Register a, Register b) noexcept -> Register
+    {
+      return _mm512_or_si512(a, b);
+    }
+    template <int N> static auto Shr(Register v) noexcept -> Register
+    {
+      return _mm512_srli_epi32(v, N);
+    }
+    template <int N> static auto RotR(Register v) noexcept -> Register
+    {
+      return _mm512_ror_epi32(v, N);
+    }
+    // (e & f) ^ (~e & g)
+    static auto Ch(Register e, Register f, Register g) noexcept -> Register
+    {
+      return _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+    }
+    // (a & b) | (a & c) | (b & c)
+    static auto Maj(Register a, Register b, Register c) noexcept -> Register
+    {
+      return _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+    }
+    static auto LoadMessageWord(
+      const std::byte* const* blocks, size_t j) noexcept -> Register
+    {
+      alignas(64) std::array<uint32_t, kLanes> words {};
+      for (size_t lane = 0; lane < kLanes; ++lane) {
+        words[lane] = LoadMessageWordBE(blocks[lane], j);
+      }
+      return _mm512_load_si512(words.data());
+    }
+  };
+
+#if NOVA_GNUC_VERSION && !NOVA_CLANG_VERSION
+#  pragma GCC diagnostic pop
+#endif
+
+} // namespace
+
+auto CompressLanesAvx512(
+  uint32_t* state, const std::byte* const* blocks) noexcept -> void
+{
+  CompressLanes<Avx512>(state, blocks);
+}
+
+} // namespace nova::detail::sha256
+// NOLINTEND(portability-simd-intrinsics,*-reinterpret-cast,*-magic-numbers)
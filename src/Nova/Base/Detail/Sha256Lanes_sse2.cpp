@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+#include <Nova/Base/Detail/Sha256Lanes.h>
+
+#include <emmintrin.h>
+
+// NOLINTBEGIN(portability-simd-intrinsics,*-reinterpret-cast)
+namespace nova::detail::sha256 {
+
+namespace {
+
+  //! Four lanes in one SSE2 register.
+  struct Sse2 {
+    using Register = __m128i;
+    static constexpr size_t kLanes = 4;
+
+    static auto Load(const uint32_t* p) noexcept -> Register
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static auto Store(uint32_t* p, Register v) noexcept -> void
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+    static auto Set1(uint32_t x) noexcept -> Register
+    {
+      return _mm_set1_epi32(static_cast<int>(x));
+    }
+    static auto Add(Register a, Register b) noexcept -> Register
+    {
+      return _mm_add_epi32(a, b);
+    }
+    static auto Xor(Register a, Register b) noexcept -> Register
+    {
+      return _mm_xor_si128(a, b);
+    }
+    static auto And(Register a, Register b) noexcept -> Register
+    {
+      return _mm_and_si128(a, b);
+    }
+    static auto AndNot(Register a, Register b) noexcept -> Register
+    {
+      return _mm_andnot_si128(a, b);
+    }
+    static auto Or(Register a, Register b) noexcept -> Register
+    {
+      return _mm_or_si128(a, b);
+    }
+    template <int N> static auto Shr(Register v) noexcept -> Register
+    {
+      return _mm_srli_epi32(v, N);
+    }
+    template <int N> static auto RotR(Register v) noexcept -> Register
+    {
+      return _mm_or_si128(_mm_srli_epi32(v, N), _mm_slli_epi32(v, 32 - N));
+    }
+    static auto LoadMessageWord(
+      const std::byte* const* blocks, size_t j) noexcept -> Register
+    {
+      return _mm_setr_epi32(static_cast<int>(LoadMessageWordBE(blocks[0], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[1], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[2], j)),
+        static_cast<int>(LoadMessageWordBE(blocks[3], j)));
+    }
+  };
+
+} // namespace
+
+auto CompressLanesSse2(uint32_t* state, const std::byte* const* blocks) noexcept
+  -> void
+{
+  CompressLanes<Sse2>(state, blocks);
+}
+
+} // namespace nova::detail::sha256
+// NOLINTEND(portability-simd-intrinsics,*-reinterpret-cast)
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+// Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+// copy at <https://opensource.org/licenses/BSD-3-Clause>.
+// SPDX-License-Identifier: BSD-3-Clause
+//===----------------------------------------------------------------------===//
+
+// Compares the single-stream SHA-256 path with the multi-buffer kernels on
+// batches of small messages, the shape of txid, merkle node and header
+// hashing workloads.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include <Nova/Base/Sha256.h>
+
+namespace {
+
+constexpr size_t kMessagesPerBatch = 4096;
+constexpr int kRounds = 50;
+
+auto NanosecondsPerMessage(const std::vector<std::span<const std::byte>>& inputs,
+  std::vector<nova::Sha256Digest>& outputs, size_t lanes) -> double
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    if (lanes == 0) {
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        outputs[i] = nova::ComputeSha256(inputs[i]);
+      }
+    } else {
+      nova::ComputeSha256Many(inputs, outputs, lanes);
+    }
+  }
+  const std::chrono::duration<double, std::nano> elapsed
+    = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(kRounds * inputs.size());
+}
+
+auto NanosecondsPerNode(const std::vector<std::byte>& layer,
+  std::vector<nova::Sha256Digest>& outputs, size_t lanes) -> double
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    nova::ComputeSha256d64Many(layer, outputs, lanes);
+  }
+  const std::chrono::duration<double, std::nano> elapsed
+    = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(kRounds * outputs.size());
+}
+
+} // namespace
+
+auto main() -> int
+{
+  std::printf("SHA-NI: %s, widest multi-buffer kernel: %zu lanes\n\n",
+    nova::Sha256::HasHardwareSupport() ? "yes" : "no",
+    nova::Sha256::MaxLaneCount());
+  std::printf("%8s %12s %12s %12s %12s\n", "bytes", "single", "4 lanes",
+    "8 lanes", "16 lanes");
+
+  for (const size_t size : { 32, 64, 80, 200, 1000 }) {
+    std::vector<std::byte> storage(size * kMessagesPerBatch);
+    for (size_t i = 0; i < storage.size(); ++i) {
+      storage[i] = static_cast<std::byte>(i * 131U);
+    }
+    std::vector<std::span<const std::byte>> inputs;
+    for (size_t i = 0; i < kMessagesPerBatch; ++i) {
+      inputs.emplace_back(storage.data() + (i * size), size);
+    }
+    std::vector<nova::Sha256Digest> outputs(inputs.size());
+
+    std::printf("%8zu", size);
+    for (const size_t lanes : { 0, 4, 8, 16 }) {
+      if (lanes > nova::Sha256::MaxLaneCount()) {
+        std::printf(" %12s", "n/a");
+        continue;
+      }
+      std::printf(
+        " %9.1f ns", NanosecondsPerMessage(inputs, outputs, lanes));
+    }
+    std::printf("\n");
+  }
+
+  // Merkle layer: SHA256d of 64-byte sibling pairs.
+  std::vector<std::byte> layer(64 * kMessagesPerBatch);
+  for (size_t i = 0; i < layer.size(); ++i) {
+    layer[i] = static_cast<std::byte>(i * 37U);
+  }
+  std::vector<nova::Sha256Digest> nodes(kMessagesPerBatch);
+  std::printf("%8s", "d64");
+  for (const size_t lanes : { 1, 4, 8, 16 }) {
+    if (lanes > nova::Sha256::MaxLaneCount()) {
+      std::printf(" %12s", "n/a");
+      continue;
+    }
+    std::printf(" %9.1f ns", NanosecondsPerNode(layer, nodes, lanes));
+  }
+  std::printf("\n");
+  return 0;
+}
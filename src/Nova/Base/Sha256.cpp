@@ -6,6 +6,8 @@
 
 #include <Nova/Base/Sha256.h>
 
+#include <Nova/Base/Detail/Sha256Lanes.h>
+
 #include <algorithm>
 #include <array>
 #include <cstddef>
@@ -14,16 +16,34 @@
 #include <fstream>
 #include <stdexcept>
 
-// SHA-NI intrinsics are intentional here for the Windows x86/x64 fast path.
+// SHA-NI intrinsics are intentional here for the x86/x64 fast path.
 // NOLINTBEGIN(*-magic-numbers,portability-simd-intrinsics,*-reinterpret-cast)
 #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
 #  include <immintrin.h>
 #  include <intrin.h>
 #  define NOVA_SHA_HAS_SHANI 1
+#  define NOVA_SHA_TARGET_SHANI
+#elif (defined(__GNUC__) || defined(__clang__))                                \
+  && (defined(__x86_64__) || defined(__i386__))
+#  include <cpuid.h>
+#  include <immintrin.h>
+#  define NOVA_SHA_HAS_SHANI 1
+// Only this function is compiled for SHA-NI; callers check the CPU first.
+#  define NOVA_SHA_TARGET_SHANI __attribute__((target("sha,ssse3")))
 #else
 #  define NOVA_SHA_HAS_SHANI 0
 #endif
 
+// The multi-buffer kernels are only built for x86-64 (see CMakeLists.txt),
+// which then defines NOVA_SHA256_LANES.
+#if !defined(NOVA_SHA256_LANES)
+#  define NOVA_SHA256_LANES 0
+#endif
+#if NOVA_SHA256_LANES && defined(_MSC_VER)
+#  include <immintrin.h>
+#  include <intrin.h>
+#endif
+
 namespace nova {
 
 namespace {
@@ -182,6 +202,17 @@ namespace {
   // Cached CPU feature detection
   [[nodiscard]] auto DetectShaNi() noexcept -> bool
   {
+#  if !defined(_MSC_VER)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+      return false;
+    }
+    // SHA-NI is bit 29 of EBX
+    return (ebx & (1U << 29U)) != 0;
+#  else
     int cpu_info[4] = {};
     __cpuid(cpu_info, 0);
     const int max_leaf = cpu_info[0];
@@ -191,6 +222,7 @@ namespace {
     __cpuidex(cpu_info, 7, 0);
     // SHA-NI is bit 29 of EBX
     return (cpu_info[1] & (1 << 29)) != 0;
+#  endif
   }
 
   [[nodiscard]] auto HasShaNi() noexcept -> bool
@@ -200,6 +232,183 @@ namespace {
   }
 #endif
 
+#if NOVA_SHA256_LANES
+  [[nodiscard]] auto DetectMaxLaneCount() noexcept -> size_t
+  {
+#  if defined(_MSC_VER)
+    int cpu_info[4] = {};
+    __cpuid(cpu_info, 0);
+    if (cpu_info[0] < 7) {
+      return 4;
+    }
+    __cpuid(cpu_info, 1);
+    const bool os_saves_ymm = (cpu_info[2] & (1 << 27)) != 0
+      && (cpu_info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6U) == 0x6U;
+    if (!os_saves_ymm) {
+      return 4;
+    }
+    __cpuidex(cpu_info, 7, 0);
+    // AVX-512F is bit 16 of EBX and needs the OS to save opmask and ZMM state.
+    if ((cpu_info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6U) == 0xE6U) {
+      return 16;
+    }
+    // AVX2 is bit 5 of EBX
+    return (cpu_info[1] & (1 << 5)) != 0 ? 8 : 4;
+#  else
+    // These builtins also verify that the OS saves the extended registers.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return 16;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return 8;
+    }
+    return 4;
+#  endif
+  }
+#endif
+
+  [[nodiscard]] auto MaxLanes() noexcept -> size_t
+  {
+#if NOVA_SHA256_LANES
+    static const size_t kMaxLanes = DetectMaxLaneCount();
+    return kMaxLanes;
+#else
+    return 1;
+#endif
+  }
+
+  //! Messages with more blocks than this are hashed on their own: a lane
+  //! kept busy by one long message would leave the other lanes idle.
+  constexpr uint64_t kMaxBlocksPerLane = 16;
+
+  //! Feeds independent messages through a lane-parallel compression kernel.
+  /*!
+   Each lane walks the full blocks of its message straight from the caller's
+   buffer, then one or two padded tail blocks. When a lane finishes, its
+   digest is written out and the lane picks up the next pending message, so
+   batches of messages with different lengths keep every lane busy.
+  */
+  class LaneScheduler {
+  public:
+    LaneScheduler(detail::sha256::CompressLanesFn compress, size_t lanes,
+      std::span<const std::span<const std::byte>> inputs,
+      std::span<Sha256Digest> outputs) noexcept
+      : compress_(compress)
+      , lanes_(lanes)
+      , inputs_(inputs)
+      , outputs_(outputs)
+    {
+    }
+
+    auto Run() noexcept -> void
+    {
+      size_t active = 0;
+      for (size_t lane = 0; lane < lanes_; ++lane) {
+        active += StartNext(lane) ? 1 : 0;
+      }
+
+      std::array<const std::byte*, detail::sha256::kMaxLanes> blocks {};
+      while (active != 0) {
+        for (size_t lane = 0; lane < lanes_; ++lane) {
+          blocks[lane] = lanes_state_[lane].busy ? NextBlock(lane)
+                                                 : idle_block_.data();
+        }
+        compress_(state_.data(), blocks.data());
+        for (size_t lane = 0; lane < lanes_; ++lane) {
+          auto& slot = lanes_state_[lane];
+          if (!slot.busy || --slot.blocks_left != 0) {
+            continue;
+          }
+          WriteDigest(lane);
+          if (!StartNext(lane)) {
+            --active;
+          }
+        }
+      }
+    }
+
+  private:
+    struct Lane {
+      size_t message = 0;
+      const std::byte* next = nullptr;
+      uint64_t full_blocks = 0;
+      uint64_t tail_blocks = 0;
+      uint64_t blocks_left = 0;
+      bool busy = false;
+      alignas(16) std::array<std::byte, 2 * Sha256::kBlockSize> tail {};
+    };
+
+    auto StartNext(size_t lane) noexcept -> bool
+    {
+      auto& slot = lanes_state_[lane];
+      while (next_message_ < outputs_.size()) {
+        const auto index = next_message_++;
+        const auto input = inputs_[index];
+        const uint64_t full_blocks = input.size() / Sha256::kBlockSize;
+        if (full_blocks > kMaxBlocksPerLane) {
+          outputs_[index] = ComputeSha256(input);
+          continue;
+        }
+
+        const size_t remainder = input.size() % Sha256::kBlockSize;
+        const uint64_t tail_blocks = remainder + 9 <= Sha256::kBlockSize ? 1 : 2;
+        slot.tail.fill(std::byte { 0 });
+        if (remainder != 0) {
+          std::memcpy(slot.tail.data(),
+            input.data() + (full_blocks * Sha256::kBlockSize), remainder);
+        }
+        slot.tail[remainder] = std::byte { 0x80 };
+        StoreBE64(reinterpret_cast<uint8_t*>(slot.tail.data()
+                    + (tail_blocks * Sha256::kBlockSize) - 8),
+          static_cast<uint64_t>(input.size()) * 8);
+
+        slot.message = index;
+        slot.next = input.data();
+        slot.full_blocks = full_blocks;
+        slot.tail_blocks = tail_blocks;
+        slot.blocks_left = full_blocks + tail_blocks;
+        slot.busy = true;
+        for (size_t word = 0; word < kInitState.size(); ++word) {
+          state_[(word * lanes_) + lane] = kInitState[word];
+        }
+        return true;
+      }
+      slot.busy = false;
+      return false;
+    }
+
+    auto NextBlock(size_t lane) noexcept -> const std::byte*
+    {
+      auto& slot = lanes_state_[lane];
+      if (slot.full_blocks != 0) {
+        --slot.full_blocks;
+        const auto* block = slot.next;
+        slot.next += Sha256::kBlockSize;
+        return block;
+      }
+      const auto tail_index = slot.tail_blocks - slot.blocks_left;
+      return slot.tail.data() + (tail_index * Sha256::kBlockSize);
+    }
+
+    auto WriteDigest(size_t lane) noexcept -> void
+    {
+      auto& digest = outputs_[lanes_state_[lane].message];
+      for (size_t word = 0; word < kInitState.size(); ++word) {
+        StoreBE32(digest.data() + (word * 4), state_[(word * lanes_) + lane]);
+      }
+    }
+
+    detail::sha256::CompressLanesFn compress_;
+    size_t lanes_;
+    std::span<const std::span<const std::byte>> inputs_;
+    std::span<Sha256Digest> outputs_;
+    size_t next_message_ = 0;
+    alignas(64) std::array<uint32_t, 8 * detail::sha256::kMaxLanes> state_ {};
+    std::array<Lane, detail::sha256::kMaxLanes> lanes_state_ {};
+    std::array<std::byte, Sha256::kBlockSize> idle_block_ {};
+  };
+
   // One SHA-256 round (software)
   inline auto Round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d,
     uint32_t& e, uint32_t& f, uint32_t& g, uint32_t& h, uint32_t k,
@@ -217,6 +426,474 @@ namespace {
     a = t1 + t2;
   }
 
+  // Optimized software implementation with partial loop unrolling
+  auto ProcessBlocksSoftware(std::array<uint32_t, 8>& state,
+    const std::byte* data, size_t block_count) noexcept -> void
+  {
+    alignas(64) std::array<uint32_t, 64> w {};
+
+    for (size_t blk = 0; blk < block_count; ++blk) {
+      const std::byte* block = data + (blk * Sha256::kBlockSize);
+
+      // Load and expand message schedule
+      for (size_t i = 0; i < 16; ++i) {
+        w[i] = LoadBE32(block + (i * 4));
+      }
+      for (size_t i = 16; i < 64; ++i) {
+        w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
+      }
+
+      // Initialize working variables
+      uint32_t a = state[0];
+      uint32_t b = state[1];
+      uint32_t c = state[2];
+      uint32_t d = state[3];
+      uint32_t e = state[4];
+      uint32_t f = state[5];
+      uint32_t g = state[6];
+      uint32_t h = state[7];
+
+      // 64 rounds, unrolled 8 at a time
+      for (size_t i = 0; i < 64; i += 8) {
+        Round(a, b, c, d, e, f, g, h, kK[i + 0], w[i + 0]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 1], w[i + 1]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 2], w[i + 2]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 3], w[i + 3]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 4], w[i + 4]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 5], w[i + 5]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 6], w[i + 6]);
+        Round(a, b, c, d, e, f, g, h, kK[i + 7], w[i + 7]);
+      }
+
+      // Add compressed chunk to current hash value
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+      state[5] += f;
+      state[6] += g;
+      state[7] += h;
+    }
+  }
+
+#if NOVA_SHA_HAS_SHANI
+  // Intel SHA-NI hardware-accelerated implementation
+  NOVA_SHA_TARGET_SHANI auto ProcessBlocksShaNi(std::array<uint32_t, 8>& state,
+    const std::byte* data, size_t block_count) noexcept -> void
+  {
+    // SHA-NI requires these constants for byte shuffling to big-endian
+    const __m128i kShufMask
+      = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Load initial state: state[0..7] = A B C D E F G H
+    // In memory as 128-bit loads:
+    //   tmp0 = lanes[3][2][1][0] = D C B A
+    //   tmp1 = lanes[3][2][1][0] = H G F E
+    __m128i tmp0
+      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.data()));
+    __m128i tmp1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+    // SHA-NI expects: STATE0 = [A][B][E][F], STATE1 = [C][D][G][H] in lanes
+    // [3][2][1][0] Swap pairs: DCBA -> CDAB, HGFE -> GHEF
+    tmp0 = _mm_shuffle_epi32(tmp0, 0xB1); // C D A B
+    tmp1 = _mm_shuffle_epi32(tmp1, 0xB1); // G H E F
+
+    // Interleave: STATE0 gets [A][B] from tmp0 lower and [E][F] from tmp1 lower
+    //             STATE1 gets [C][D] from tmp0 upper and [G][H] from tmp1 upper
+    __m128i state0 = _mm_unpacklo_epi64(tmp1, tmp0); // [A][B][E][F]
+    __m128i state1 = _mm_unpackhi_epi64(tmp1, tmp0); // [C][D][G][H]
+    __m128i tmp;
+
+    for (size_t blk = 0; blk < block_count; ++blk) {
+      const __m128i* msg_ptr
+        = reinterpret_cast<const __m128i*>(data + (blk * Sha256::kBlockSize));
+
+      // Save current state
+      const __m128i save_state0 = state0;
+      const __m128i save_state1 = state1;
+
+      // Load message and convert to big-endian
+      __m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 0), kShufMask);
+      __m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 1), kShufMask);
+      __m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 2), kShufMask);
+      __m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 3), kShufMask);
+
+      // Rounds 0-3
+      __m128i msg = _mm_add_epi32(
+        msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kK.data())));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      // Rounds 4-7
+      msg = _mm_add_epi32(
+        msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[4])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+      // Rounds 8-11
+      msg = _mm_add_epi32(
+        msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[8])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+      // Rounds 12-15
+      msg = _mm_add_epi32(
+        msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[12])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg3, msg2, 4);
+      msg0 = _mm_add_epi32(msg0, tmp);
+      msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+      // Rounds 16-19
+      msg = _mm_add_epi32(
+        msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[16])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg0, msg3, 4);
+      msg1 = _mm_add_epi32(msg1, tmp);
+      msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+      // Rounds 20-23
+      msg = _mm_add_epi32(
+        msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[20])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg1, msg0, 4);
+      msg2 = _mm_add_epi32(msg2, tmp);
+      msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+      // Rounds 24-27
+      msg = _mm_add_epi32(
+        msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[24])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg2, msg1, 4);
+      msg3 = _mm_add_epi32(msg3, tmp);
+      msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+      // Rounds 28-31
+      msg = _mm_add_epi32(
+        msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[28])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg3, msg2, 4);
+      msg0 = _mm_add_epi32(msg0, tmp);
+      msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+      // Rounds 32-35
+      msg = _mm_add_epi32(
+        msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[32])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg0, msg3, 4);
+      msg1 = _mm_add_epi32(msg1, tmp);
+      msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+      // Rounds 36-39
+      msg = _mm_add_epi32(
+        msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[36])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg1, msg0, 4);
+      msg2 = _mm_add_epi32(msg2, tmp);
+      msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+      // Rounds 40-43
+      msg = _mm_add_epi32(
+        msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[40])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg2, msg1, 4);
+      msg3 = _mm_add_epi32(msg3, tmp);
+      msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+      // Rounds 44-47
+      msg = _mm_add_epi32(
+        msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[44])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg3, msg2, 4);
+      msg0 = _mm_add_epi32(msg0, tmp);
+      msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+      // Rounds 48-51
+      msg = _mm_add_epi32(
+        msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[48])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg0, msg3, 4);
+      msg1 = _mm_add_epi32(msg1, tmp);
+      msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+      // Rounds 52-55
+      msg = _mm_add_epi32(
+        msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[52])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg1, msg0, 4);
+      msg2 = _mm_add_epi32(msg2, tmp);
+      msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      // Rounds 56-59
+      msg = _mm_add_epi32(
+        msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[56])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      tmp = _mm_alignr_epi8(msg2, msg1, 4);
+      msg3 = _mm_add_epi32(msg3, tmp);
+      msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      // Rounds 60-63
+      msg = _mm_add_epi32(
+        msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[60])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+      // Add saved state
+      state0 = _mm_add_epi32(state0, save_state0);
+      state1 = _mm_add_epi32(state1, save_state1);
+    }
+
+    // Convert back: STATE0 = [A][B][E][F], STATE1 = [C][D][G][H]
+    // Need: tmp0 = [D][C][B][A], tmp1 = [H][G][F][E] for storage
+    // First get [C][D][A][B] and [G][H][E][F]
+    tmp0 = _mm_unpackhi_epi64(state0, state1); // [C][D][A][B]
+    tmp1 = _mm_unpacklo_epi64(state0, state1); // [G][H][E][F]
+
+    // Swap pairs back: [C][D][A][B] -> [D][C][B][A], [G][H][E][F] -> [H][G][F][E]
+    tmp0 = _mm_shuffle_epi32(tmp0, 0xB1); // D C B A
+    tmp1 = _mm_shuffle_epi32(tmp1, 0xB1); // H G F E
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), tmp0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), tmp1);
+  }
+#endif
+
+  auto ProcessBlocks(std::array<uint32_t, 8>& state, const std::byte* data,
+    size_t block_count) noexcept -> void
+  {
+#if NOVA_SHA_HAS_SHANI
+    if (HasShaNi()) {
+      ProcessBlocksShaNi(state, data, block_count);
+      return;
+    }
+#endif
+    ProcessBlocksSoftware(state, data, block_count);
+  }
+
+  //! Lanes used when the caller does not cap them. With SHA-NI a single
+  //! stream beats every kernel except the 16-lane one.
+  [[nodiscard]] auto PreferredLanes() noexcept -> size_t
+  {
+    const auto lanes = MaxLanes();
+#if NOVA_SHA_HAS_SHANI
+    if (HasShaNi() && lanes < detail::sha256::kMaxLanes) {
+      return 1;
+    }
+#endif
+    return lanes;
+  }
+
+  struct LaneKernel {
+    detail::sha256::CompressLanesFn compress = nullptr;
+    size_t lanes = 1;
+  };
+
+  //! Widest kernel supported by the CPU that is not wider than `max_lanes`.
+  //! `compress` is null when the single-stream path should be used.
+  [[nodiscard]] auto SelectKernel(size_t max_lanes) noexcept -> LaneKernel
+  {
+    const size_t lanes = std::min(max_lanes, MaxLanes());
+#if NOVA_SHA256_LANES
+    if (lanes >= 16) {
+      return { .compress = &detail::sha256::CompressLanesAvx512, .lanes = 16 };
+    }
+    if (lanes >= 8) {
+      return { .compress = &detail::sha256::CompressLanesAvx2, .lanes = 8 };
+    }
+    if (lanes >= 4) {
+      return { .compress = &detail::sha256::CompressLanesSse2, .lanes = 4 };
+    }
+#else
+    (void)lanes;
+#endif
+    return {};
+  }
+
+  [[nodiscard]] auto StateToDigest(const std::array<uint32_t, 8>& state) noexcept
+    -> Sha256Digest
+  {
+    Sha256Digest digest = {};
+    for (size_t i = 0; i < 8; ++i) {
+      StoreBE32(digest.data() + (i * 4), state[i]);
+    }
+    return digest;
+  }
+
+  //! Second block of a 64-byte message: the 0x80 marker and a 512-bit length.
+  alignas(16) constexpr std::array<std::byte, Sha256::kBlockSize> kPadding64
+    = [] {
+        std::array<std::byte, Sha256::kBlockSize> block {};
+        block[0] = std::byte { 0x80 };
+        block[62] = std::byte { 0x02 };
+        return block;
+      }();
+
+  //! Message schedule of kPadding64 with the round constants folded in.
+  constexpr std::array<uint32_t, 64> kPadding64Schedule = [] {
+    std::array<uint32_t, 64> w {};
+    w[0] = 0x80000000U;
+    w[15] = 512U;
+    for (size_t i = 16; i < 64; ++i) {
+      w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
+    }
+    for (size_t i = 0; i < 64; ++i) {
+      w[i] += kK[i];
+    }
+    return w;
+  }();
+
+  //! Mixes kPadding64 into `state`. The software path skips the message
+  //! expansion since the schedule is a compile-time constant.
+  auto ProcessPadding64(std::array<uint32_t, 8>& state) noexcept -> void
+  {
+#if NOVA_SHA_HAS_SHANI
+    if (HasShaNi()) {
+      ProcessBlocksShaNi(state, kPadding64.data(), 1);
+      return;
+    }
+#endif
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    for (size_t i = 0; i < 64; i += 8) {
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 0], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 1], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 2], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 3], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 4], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 5], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 6], 0);
+      Round(a, b, c, d, e, f, g, h, kPadding64Schedule[i + 7], 0);
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+
+  //! Writes the single padded block hashing a 32-byte digest.
+  auto MakeOuterBlock(std::byte* block) noexcept -> void
+  {
+    std::memset(block + 32, 0, Sha256::kBlockSize - 32);
+    block[32] = std::byte { 0x80 };
+    block[62] = std::byte { 0x01 }; // 256-bit length
+  }
+
+  //! The outer pass of SHA256d: SHA-256 of a 32-byte inner digest.
+  [[nodiscard]] auto HashInnerDigest(const Sha256Digest& inner) noexcept
+    -> Sha256Digest
+  {
+    alignas(16) std::array<std::byte, Sha256::kBlockSize> block {};
+    std::memcpy(block.data(), inner.data(), inner.size());
+    MakeOuterBlock(block.data());
+    auto state = kInitState;
+    ProcessBlocks(state, block.data(), 1);
+    return StateToDigest(state);
+  }
+
+  //! Writes the block holding the last 16 bytes of an 80-byte header.
+  auto MakeHeaderTailBlock(const std::byte* suffix, std::byte* block) noexcept
+    -> void
+  {
+    std::memcpy(block, suffix, Sha256dHeaderMidstate::kSuffixSize);
+    std::memset(block + Sha256dHeaderMidstate::kSuffixSize, 0,
+      Sha256::kBlockSize - Sha256dHeaderMidstate::kSuffixSize);
+    block[Sha256dHeaderMidstate::kSuffixSize] = std::byte { 0x80 };
+    // 640-bit length
+    block[62] = std::byte { 0x02 };
+    block[63] = std::byte { 0x80 };
+  }
+
+  //! Lane-interleaved state for one group of SHA256d computations.
+  struct DoubleLanes {
+    alignas(64) std::array<uint32_t, 8 * detail::sha256::kMaxLanes> state {};
+    std::array<const std::byte*, detail::sha256::kMaxLanes> blocks {};
+    alignas(64) std::array<std::array<std::byte, Sha256::kBlockSize>,
+      detail::sha256::kMaxLanes> scratch {};
+
+    auto Reset(size_t lanes) noexcept -> void
+    {
+      for (size_t word = 0; word < kInitState.size(); ++word) {
+        std::fill_n(state.begin() + static_cast<std::ptrdiff_t>(word * lanes),
+          lanes, kInitState[word]);
+      }
+    }
+
+    //! Runs the outer pass over the inner states and writes the first
+    //! `active` digests.
+    auto FinishOuter(const LaneKernel& kernel, size_t active,
+      Sha256Digest* outputs) noexcept -> void
+    {
+      for (size_t lane = 0; lane < kernel.lanes; ++lane) {
+        auto* block = scratch[lane].data();
+        for (size_t word = 0; word < kInitState.size(); ++word) {
+          StoreBE32(reinterpret_cast<uint8_t*>(block + (word * 4)),
+            state[(word * kernel.lanes) + lane]);
+        }
+        MakeOuterBlock(block);
+        blocks[lane] = block;
+      }
+      Reset(kernel.lanes);
+      kernel.compress(state.data(), blocks.data());
+      for (size_t lane = 0; lane < active; ++lane) {
+        for (size_t word = 0; word < kInitState.size(); ++word) {
+          StoreBE32(outputs[lane].data() + (word * 4),
+            state[(word * kernel.lanes) + lane]);
+        }
+      }
+    }
+  };
+
 } // namespace
 
 Sha256::Sha256() noexcept
@@ -254,7 +931,7 @@ auto Sha256::Update(std::span<const std::byte> data) noexcept -> void
     remaining -= take;
 
     if (buffer_size_ == kBlockSize) {
-      ProcessBlocks_(buffer_.data(), 1);
+      ProcessBlocks(state_, buffer_.data(), 1);
       buffer_size_ = 0;
     }
   }
@@ -262,7 +939,7 @@ auto Sha256::Update(std::span<const std::byte> data) noexcept -> void
   // Process complete blocks directly from input
   if (remaining >= kBlockSize) {
     const size_t blocks = remaining / kBlockSize;
-    ProcessBlocks_(ptr, blocks);
+    ProcessBlocks(state_, ptr, blocks);
     const size_t processed = blocks * kBlockSize;
     ptr += processed;
     remaining -= processed;
@@ -286,14 +963,14 @@ auto Sha256::Finalize() noexcept -> Sha256Digest
   // If not enough room for length, pad and process
   if (buffer_size_ > 56) {
     std::memset(buffer_.data() + buffer_size_, 0, kBlockSize - buffer_size_);
-    ProcessBlocks_(buffer_.data(), 1);
+    ProcessBlocks(state_, buffer_.data(), 1);
     buffer_size_ = 0;
   }
 
   // Pad to 56 bytes and append length
   std::memset(buffer_.data() + buffer_size_, 0, 56 - buffer_size_);
   StoreBE64(reinterpret_cast<uint8_t*>(buffer_.data() + 56), total_bits);
-  ProcessBlocks_(buffer_.data(), 1);
+  ProcessBlocks(state_, buffer_.data(), 1);
 
   // Output digest
   Sha256Digest digest = {};
@@ -309,296 +986,150 @@ auto Sha256::Finalize() noexcept -> Sha256Digest
   return digest;
 }
 
-auto Sha256::ProcessBlocks_(const std::byte* data, size_t block_count) noexcept
-  -> void
+auto ComputeSha256(std::span<const std::byte> data) noexcept -> Sha256Digest
 {
-#if NOVA_SHA_HAS_SHANI
-  if (HasShaNi()) {
-    ProcessBlocksShaNi_(data, block_count);
+  Sha256 hasher;
+  hasher.Update(data);
+  return hasher.Finalize();
+}
+
+auto Sha256::MaxLaneCount() noexcept -> size_t { return MaxLanes(); }
+
+auto ComputeSha256Many(std::span<const std::span<const std::byte>> inputs,
+  std::span<Sha256Digest> outputs) noexcept -> void
+{
+  ComputeSha256Many(inputs, outputs, PreferredLanes());
+}
+
+auto ComputeSha256Many(std::span<const std::span<const std::byte>> inputs,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void
+{
+  const auto count = std::min(inputs.size(), outputs.size());
+  inputs = inputs.first(count);
+  outputs = outputs.first(count);
+
+  const auto kernel = SelectKernel(max_lanes);
+  // A single message, or no SIMD kernel: nothing to interleave.
+  if (kernel.compress == nullptr || count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      outputs[i] = ComputeSha256(inputs[i]);
+    }
     return;
   }
-#endif
-  ProcessBlocksSoftware_(data, block_count);
+  LaneScheduler(kernel.compress, kernel.lanes, inputs, outputs).Run();
 }
 
-// Optimized software implementation with partial loop unrolling
-auto Sha256::ProcessBlocksSoftware_(
-  const std::byte* data, size_t block_count) noexcept -> void
+auto ComputeSha256d(std::span<const std::byte> data) noexcept -> Sha256Digest
 {
-  alignas(64) std::array<uint32_t, 64> w {};
+  return HashInnerDigest(ComputeSha256(data));
+}
 
-  for (size_t blk = 0; blk < block_count; ++blk) {
-    const std::byte* block = data + (blk * kBlockSize);
+auto ComputeSha256d64(std::span<const std::byte, Sha256::kBlockSize> data) noexcept
+  -> Sha256Digest
+{
+  auto state = kInitState;
+  ProcessBlocks(state, data.data(), 1);
+  ProcessPadding64(state);
+  return HashInnerDigest(StateToDigest(state));
+}
 
-    // Load and expand message schedule
-    for (size_t i = 0; i < 16; ++i) {
-      w[i] = LoadBE32(block + (i * 4));
-    }
-    for (size_t i = 16; i < 64; ++i) {
-      w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
+auto ComputeSha256d64Many(std::span<const std::byte> blocks,
+  std::span<Sha256Digest> outputs) noexcept -> void
+{
+  ComputeSha256d64Many(blocks, outputs, PreferredLanes());
+}
+
+auto ComputeSha256d64Many(std::span<const std::byte> blocks,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void
+{
+  const auto count = std::min(blocks.size() / Sha256::kBlockSize, outputs.size());
+  const auto kernel = SelectKernel(max_lanes);
+  size_t done = 0;
+  if (kernel.compress != nullptr && count >= 2) {
+    DoubleLanes lanes;
+    for (; done < count; done += kernel.lanes) {
+      const auto active = std::min(kernel.lanes, count - done);
+      lanes.Reset(kernel.lanes);
+      for (size_t lane = 0; lane < kernel.lanes; ++lane) {
+        // Idle lanes hash the padding block; their results are dropped.
+        lanes.blocks[lane] = lane < active
+          ? blocks.data() + ((done + lane) * Sha256::kBlockSize)
+          : kPadding64.data();
+      }
+      kernel.compress(lanes.state.data(), lanes.blocks.data());
+      lanes.blocks.fill(kPadding64.data());
+      kernel.compress(lanes.state.data(), lanes.blocks.data());
+      lanes.FinishOuter(kernel, active, outputs.data() + done);
     }
+  }
+  for (; done < count; ++done) {
+    outputs[done] = ComputeSha256d64(
+      blocks.subspan(done * Sha256::kBlockSize).first<Sha256::kBlockSize>());
+  }
+}
 
-    // Initialize working variables
-    uint32_t a = state_[0];
-    uint32_t b = state_[1];
-    uint32_t c = state_[2];
-    uint32_t d = state_[3];
-    uint32_t e = state_[4];
-    uint32_t f = state_[5];
-    uint32_t g = state_[6];
-    uint32_t h = state_[7];
+auto ComputeSha256d80(
+  std::span<const std::byte, kSha256dHeaderSize> header) noexcept
+  -> Sha256Digest
+{
+  return Sha256dHeaderMidstate(header.first<Sha256::kBlockSize>())
+    .Finish(header.last<Sha256dHeaderMidstate::kSuffixSize>());
+}
 
-    // 64 rounds, unrolled 8 at a time
-    for (size_t i = 0; i < 64; i += 8) {
-      Round(a, b, c, d, e, f, g, h, kK[i + 0], w[i + 0]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 1], w[i + 1]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 2], w[i + 2]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 3], w[i + 3]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 4], w[i + 4]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 5], w[i + 5]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 6], w[i + 6]);
-      Round(a, b, c, d, e, f, g, h, kK[i + 7], w[i + 7]);
-    }
-
-    // Add compressed chunk to current hash value
-    state_[0] += a;
-    state_[1] += b;
-    state_[2] += c;
-    state_[3] += d;
-    state_[4] += e;
-    state_[5] += f;
-    state_[6] += g;
-    state_[7] += h;
+auto ComputeSha256d80Many(
+  std::span<const std::span<const std::byte, kSha256dHeaderSize>> headers,
+  std::span<Sha256Digest> outputs) noexcept -> void
+{
+  ComputeSha256d80Many(headers, outputs, PreferredLanes());
+}
+
+auto ComputeSha256d80Many(
+  std::span<const std::span<const std::byte, kSha256dHeaderSize>> headers,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void
+{
+  const auto count = std::min(headers.size(), outputs.size());
+  const auto kernel = SelectKernel(max_lanes);
+  size_t done = 0;
+  if (kernel.compress != nullptr && count >= 2) {
+    DoubleLanes lanes;
+    for (; done < count; done += kernel.lanes) {
+      const auto active = std::min(kernel.lanes, count - done);
+      lanes.Reset(kernel.lanes);
+      for (size_t lane = 0; lane < kernel.lanes; ++lane) {
+        // Idle lanes rehash the group's first header; results are dropped.
+        const auto& header = headers[done + (lane < active ? lane : 0)];
+        lanes.blocks[lane] = header.data();
+        MakeHeaderTailBlock(
+          header.data() + Sha256::kBlockSize, lanes.scratch[lane].data());
+      }
+      kernel.compress(lanes.state.data(), lanes.blocks.data());
+      for (size_t lane = 0; lane < kernel.lanes; ++lane) {
+        lanes.blocks[lane] = lanes.scratch[lane].data();
+      }
+      kernel.compress(lanes.state.data(), lanes.blocks.data());
+      lanes.FinishOuter(kernel, active, outputs.data() + done);
+    }
+  }
+  for (; done < count; ++done) {
+    outputs[done] = ComputeSha256d80(headers[done]);
   }
 }
 
-#if NOVA_SHA_HAS_SHANI
-// Intel SHA-NI hardware-accelerated implementation
-auto Sha256::ProcessBlocksShaNi_(
-  const std::byte* data, size_t block_count) noexcept -> void
+Sha256dHeaderMidstate::Sha256dHeaderMidstate(
+  std::span<const std::byte, Sha256::kBlockSize> prefix) noexcept
+  : state_(kInitState)
 {
-  // SHA-NI requires these constants for byte shuffling to big-endian
-  const __m128i kShufMask
-    = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
-
-  // Load initial state: state_[0..7] = A B C D E F G H
-  // In memory as 128-bit loads:
-  //   tmp0 = lanes[3][2][1][0] = D C B A
-  //   tmp1 = lanes[3][2][1][0] = H G F E
-  __m128i tmp0
-    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state_.data()));
-  __m128i tmp1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state_[4]));
-
-  // SHA-NI expects: STATE0 = [A][B][E][F], STATE1 = [C][D][G][H] in lanes
-  // [3][2][1][0] Swap pairs: DCBA -> CDAB, HGFE -> GHEF
-  tmp0 = _mm_shuffle_epi32(tmp0, 0xB1); // C D A B
-  tmp1 = _mm_shuffle_epi32(tmp1, 0xB1); // G H E F
-
-  // Interleave: STATE0 gets [A][B] from tmp0 lower and [E][F] from tmp1 lower
-  //             STATE1 gets [C][D] from tmp0 upper and [G][H] from tmp1 upper
-  __m128i state0 = _mm_unpacklo_epi64(tmp1, tmp0); // [A][B][E][F]
-  __m128i state1 = _mm_unpackhi_epi64(tmp1, tmp0); // [C][D][G][H]
-  __m128i tmp;
-
-  for (size_t blk = 0; blk < block_count; ++blk) {
-    const __m128i* msg_ptr
-      = reinterpret_cast<const __m128i*>(data + (blk * kBlockSize));
-
-    // Save current state
-    const __m128i save_state0 = state0;
-    const __m128i save_state1 = state1;
-
-    // Load message and convert to big-endian
-    __m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 0), kShufMask);
-    __m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 1), kShufMask);
-    __m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 2), kShufMask);
-    __m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(msg_ptr + 3), kShufMask);
-
-    // Rounds 0-3
-    __m128i msg = _mm_add_epi32(
-      msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kK.data())));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-
-    // Rounds 4-7
-    msg = _mm_add_epi32(
-      msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[4])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
-
-    // Rounds 8-11
-    msg = _mm_add_epi32(
-      msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[8])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
-
-    // Rounds 12-15
-    msg = _mm_add_epi32(
-      msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[12])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg3, msg2, 4);
-    msg0 = _mm_add_epi32(msg0, tmp);
-    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
-
-    // Rounds 16-19
-    msg = _mm_add_epi32(
-      msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[16])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg0, msg3, 4);
-    msg1 = _mm_add_epi32(msg1, tmp);
-    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
-
-    // Rounds 20-23
-    msg = _mm_add_epi32(
-      msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[20])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg1, msg0, 4);
-    msg2 = _mm_add_epi32(msg2, tmp);
-    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
-
-    // Rounds 24-27
-    msg = _mm_add_epi32(
-      msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[24])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg2, msg1, 4);
-    msg3 = _mm_add_epi32(msg3, tmp);
-    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
-
-    // Rounds 28-31
-    msg = _mm_add_epi32(
-      msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[28])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg3, msg2, 4);
-    msg0 = _mm_add_epi32(msg0, tmp);
-    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
-
-    // Rounds 32-35
-    msg = _mm_add_epi32(
-      msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[32])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg0, msg3, 4);
-    msg1 = _mm_add_epi32(msg1, tmp);
-    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
-
-    // Rounds 36-39
-    msg = _mm_add_epi32(
-      msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[36])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg1, msg0, 4);
-    msg2 = _mm_add_epi32(msg2, tmp);
-    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg0 = _mm_sha256msg1_epu32(msg0, msg1);
-
-    // Rounds 40-43
-    msg = _mm_add_epi32(
-      msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[40])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg2, msg1, 4);
-    msg3 = _mm_add_epi32(msg3, tmp);
-    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg1 = _mm_sha256msg1_epu32(msg1, msg2);
-
-    // Rounds 44-47
-    msg = _mm_add_epi32(
-      msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[44])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg3, msg2, 4);
-    msg0 = _mm_add_epi32(msg0, tmp);
-    msg0 = _mm_sha256msg2_epu32(msg0, msg3);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg2 = _mm_sha256msg1_epu32(msg2, msg3);
-
-    // Rounds 48-51
-    msg = _mm_add_epi32(
-      msg0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[48])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg0, msg3, 4);
-    msg1 = _mm_add_epi32(msg1, tmp);
-    msg1 = _mm_sha256msg2_epu32(msg1, msg0);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-    msg3 = _mm_sha256msg1_epu32(msg3, msg0);
-
-    // Rounds 52-55
-    msg = _mm_add_epi32(
-      msg1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[52])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg1, msg0, 4);
-    msg2 = _mm_add_epi32(msg2, tmp);
-    msg2 = _mm_sha256msg2_epu32(msg2, msg1);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-
-    // Rounds 56-59
-    msg = _mm_add_epi32(
-      msg2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[56])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    tmp = _mm_alignr_epi8(msg2, msg1, 4);
-    msg3 = _mm_add_epi32(msg3, tmp);
-    msg3 = _mm_sha256msg2_epu32(msg3, msg2);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-
-    // Rounds 60-63
-    msg = _mm_add_epi32(
-      msg3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kK[60])));
-    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
-    msg = _mm_shuffle_epi32(msg, 0x0E);
-    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
-
-    // Add saved state
-    state0 = _mm_add_epi32(state0, save_state0);
-    state1 = _mm_add_epi32(state1, save_state1);
-  }
-
-  // Convert back: STATE0 = [A][B][E][F], STATE1 = [C][D][G][H]
-  // Need: tmp0 = [D][C][B][A], tmp1 = [H][G][F][E] for storage
-  // First get [C][D][A][B] and [G][H][E][F]
-  tmp0 = _mm_unpackhi_epi64(state0, state1); // [C][D][A][B]
-  tmp1 = _mm_unpacklo_epi64(state0, state1); // [G][H][E][F]
-
-  // Swap pairs back: [C][D][A][B] -> [D][C][B][A], [G][H][E][F] -> [H][G][F][E]
-  tmp0 = _mm_shuffle_epi32(tmp0, 0xB1); // D C B A
-  tmp1 = _mm_shuffle_epi32(tmp1, 0xB1); // H G F E
-
-  _mm_storeu_si128(reinterpret_cast<__m128i*>(state_.data()), tmp0);
-  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state_[4]), tmp1);
+  ProcessBlocks(state_, prefix.data(), 1);
 }
-#endif
 
-auto ComputeSha256(std::span<const std::byte> data) noexcept -> Sha256Digest
+auto Sha256dHeaderMidstate::Finish(
+  std::span<const std::byte, kSuffixSize> suffix) const noexcept -> Sha256Digest
 {
-  Sha256 hasher;
-  hasher.Update(data);
-  return hasher.Finalize();
+  alignas(16) std::array<std::byte, Sha256::kBlockSize> block {};
+  MakeHeaderTailBlock(suffix.data(), block.data());
+  auto state = state_;
+  ProcessBlocks(state, block.data(), 1);
+  return HashInnerDigest(StateToDigest(state));
 }
 
 auto IsAllZero(const Sha256Digest& digest) noexcept -> bool
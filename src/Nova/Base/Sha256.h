@@ -43,16 +43,14 @@ public:
   //! Check if hardware SHA-NI acceleration is available on this CPU.
   NOVA_BASE_NDAPI static auto HasHardwareSupport() noexcept -> bool;
 
-private:
-  auto ProcessBlocks_(const std::byte* data, size_t block_count) noexcept
-    -> void;
-  auto ProcessBlocksSoftware_(
-    const std::byte* data, size_t block_count) noexcept -> void;
-#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
-  auto ProcessBlocksShaNi_(const std::byte* data, size_t block_count) noexcept
-    -> void;
-#endif
+  //! Widest multi-buffer kernel usable on this CPU, in lanes.
+  /*!
+   1 when no SIMD kernel is available, otherwise 4 (SSE2), 8 (AVX2) or 16
+   (AVX-512).
+  */
+  NOVA_BASE_NDAPI static auto MaxLaneCount() noexcept -> size_t;
 
+private:
   uint64_t total_bytes_ = 0;
   std::array<std::byte, kBlockSize> buffer_ = {};
   size_t buffer_size_ = 0;
@@ -64,6 +62,98 @@ private:
 NOVA_BASE_NDAPI auto ComputeSha256(std::span<const std::byte> data) noexcept
   -> Sha256Digest;
 
+//! Compute SHA-256 of many independent messages in one call.
+/*!
+ Hashes `inputs[i]` into `outputs[i]`. Messages are interleaved across the
+ lanes of the widest SIMD kernel the CPU supports, so batches of small inputs
+ (transaction ids, merkle nodes, block headers) cost a fraction of hashing them
+ one by one. Long messages are hashed with the single-stream path.
+
+ Only the first `min(inputs.size(), outputs.size())` messages are hashed.
+*/
+NOVA_BASE_API auto ComputeSha256Many(
+  std::span<const std::span<const std::byte>> inputs,
+  std::span<Sha256Digest> outputs) noexcept -> void;
+
+//! Same as above, but never uses a kernel wider than `max_lanes`.
+/*!
+ Intended for tests and benchmarks that compare kernels. A `max_lanes` of 1
+ hashes every message with the single-stream implementation.
+*/
+NOVA_BASE_API auto ComputeSha256Many(
+  std::span<const std::span<const std::byte>> inputs,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void;
+
+//! Compute double SHA-256 (SHA-256 of the SHA-256 digest), as used by Bitcoin
+//! for transaction ids, block hashes and message checksums.
+NOVA_BASE_NDAPI auto ComputeSha256d(std::span<const std::byte> data) noexcept
+  -> Sha256Digest;
+
+//! Double SHA-256 of exactly one 64-byte block, e.g. two concatenated merkle
+//! nodes. The padding of both passes is precomputed.
+NOVA_BASE_NDAPI auto ComputeSha256d64(
+  std::span<const std::byte, Sha256::kBlockSize> data) noexcept -> Sha256Digest;
+
+//! Double SHA-256 of consecutive 64-byte blocks.
+/*!
+ Hashes block `i` (bytes `[64 * i, 64 * i + 64)` of `blocks`) into
+ `outputs[i]`, for as many complete blocks as there are outputs. A merkle tree
+ layer stored as contiguous digests can be passed as is: each pair of siblings
+ is one block.
+*/
+NOVA_BASE_API auto ComputeSha256d64Many(std::span<const std::byte> blocks,
+  std::span<Sha256Digest> outputs) noexcept -> void;
+
+//! Same as above, but never uses a kernel wider than `max_lanes`.
+NOVA_BASE_API auto ComputeSha256d64Many(std::span<const std::byte> blocks,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void;
+
+//! Size of a Bitcoin block header.
+inline constexpr size_t kSha256dHeaderSize = 80;
+
+//! Double SHA-256 of an 80-byte block header.
+NOVA_BASE_NDAPI auto ComputeSha256d80(
+  std::span<const std::byte, kSha256dHeaderSize> header) noexcept
+  -> Sha256Digest;
+
+//! Double SHA-256 of many 80-byte block headers.
+/*!
+ Only the first `min(headers.size(), outputs.size())` headers are hashed.
+*/
+NOVA_BASE_API auto ComputeSha256d80Many(
+  std::span<const std::span<const std::byte, kSha256dHeaderSize>> headers,
+  std::span<Sha256Digest> outputs) noexcept -> void;
+
+//! Same as above, but never uses a kernel wider than `max_lanes`.
+NOVA_BASE_API auto ComputeSha256d80Many(
+  std::span<const std::span<const std::byte, kSha256dHeaderSize>> headers,
+  std::span<Sha256Digest> outputs, size_t max_lanes) noexcept -> void;
+
+//! Double SHA-256 of 80-byte headers that share their first 64 bytes.
+/*!
+ The first 64 bytes of a header (version, previous block hash and most of the
+ merkle root) are compressed once into a midstate. Each call to `Finish` then
+ costs one compression for the remaining 16 bytes (end of the merkle root,
+ time, bits, nonce) plus one for the outer hash, which is what checking many
+ nonces or timestamps against a proof-of-work target needs.
+*/
+class Sha256dHeaderMidstate final {
+public:
+  static constexpr size_t kSuffixSize
+    = kSha256dHeaderSize - Sha256::kBlockSize;
+
+  NOVA_BASE_API explicit Sha256dHeaderMidstate(
+    std::span<const std::byte, Sha256::kBlockSize> prefix) noexcept;
+
+  //! Hash of the header made of the cached prefix followed by `suffix`.
+  NOVA_BASE_NDAPI auto Finish(
+    std::span<const std::byte, kSuffixSize> suffix) const noexcept
+    -> Sha256Digest;
+
+private:
+  std::array<uint32_t, 8> state_ = {};
+};
+
 //! Compute SHA-256 of a file.
 NOVA_BASE_NDAPI auto ComputeFileSha256(const std::filesystem::path& path)
   -> Sha256Digest;
@@ -6,6 +6,7 @@
 
 #include <Nova/Base/Sha256.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -27,6 +28,13 @@ using ::testing::SizeIs;
 
 using nova::ComputeFileSha256;
 using nova::ComputeSha256;
+using nova::ComputeSha256Many;
+using nova::ComputeSha256d;
+using nova::ComputeSha256d64;
+using nova::ComputeSha256d64Many;
+using nova::ComputeSha256d80;
+using nova::ComputeSha256d80Many;
+using nova::Sha256dHeaderMidstate;
 using nova::IsAllZero;
 using nova::Sha256;
 using nova::Sha256Digest;
@@ -656,6 +664,293 @@ NOLINT_TEST(Sha256HardwareSupport, HasHardwareSupportDoesNotCrash)
   SUCCEED();
 }
 
+// ---------------------------------------------------------------------------
+// Multi-Buffer Tests
+// ---------------------------------------------------------------------------
+
+//! Builds messages of the given sizes filled with reproducible random bytes.
+class Sha256ManyTest : public ::testing::TestWithParam<size_t> {
+protected:
+  auto MakeMessages(const std::vector<size_t>& sizes) -> void
+  {
+    std::mt19937 rng(static_cast<uint32_t>(sizes.size()));
+    storage_.clear();
+    inputs_.clear();
+    for (const auto size : sizes) {
+      auto& bytes = storage_.emplace_back(size);
+      for (auto& byte : bytes) {
+        byte = static_cast<std::byte>(rng());
+      }
+    }
+    for (const auto& bytes : storage_) {
+      inputs_.emplace_back(bytes.data(), bytes.size());
+    }
+  }
+
+  auto ExpectMatchesSingleStream() -> void
+  {
+    std::vector<Sha256Digest> outputs(inputs_.size());
+    ComputeSha256Many(inputs_, outputs, GetParam());
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      EXPECT_EQ(DigestToHex(outputs[i]), DigestToHex(ComputeSha256(inputs_[i])))
+        << "message " << i << " of " << inputs_[i].size() << " bytes";
+    }
+  }
+
+  std::vector<std::vector<std::byte>> storage_;
+  std::vector<std::span<const std::byte>> inputs_;
+};
+
+//! Verify the reference vectors through every kernel.
+NOLINT_TEST_P(Sha256ManyTest, MatchesReferenceVectors)
+{
+  // Arrange
+  std::vector<std::span<const std::byte>> inputs;
+  for (const auto& vector : kTestVectors) {
+    inputs.push_back(ToBytes(vector.input));
+  }
+  std::vector<Sha256Digest> outputs(inputs.size());
+
+  // Act
+  ComputeSha256Many(inputs, outputs, GetParam());
+
+  // Assert
+  for (size_t i = 0; i < kTestVectors.size(); ++i) {
+    EXPECT_EQ(DigestToHex(outputs[i]), kTestVectors[i].expected_hex);
+  }
+}
+
+//! Verify every padding layout, including 55/56/63/64 byte boundaries.
+NOLINT_TEST_P(Sha256ManyTest, EveryLengthUpToThreeBlocksMatches)
+{
+  // Arrange
+  std::vector<size_t> sizes(193);
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    sizes[i] = i;
+  }
+  MakeMessages(sizes);
+
+  // Act & Assert
+  ExpectMatchesSingleStream();
+}
+
+//! Verify lanes are refilled correctly when message lengths differ widely,
+//! including messages long enough to bypass the lanes.
+NOLINT_TEST_P(Sha256ManyTest, MixedLengthsMatch)
+{
+  // Arrange
+  MakeMessages({ 80, 1, 2000, 64, 0, 32, 5000, 119, 64, 64, 64, 80, 300, 1025,
+    33, 56, 55, 1088, 1089, 7 });
+
+  // Act & Assert
+  ExpectMatchesSingleStream();
+}
+
+//! Verify batches that do not fill the last group of lanes.
+NOLINT_TEST_P(Sha256ManyTest, PartialBatchesMatch)
+{
+  for (size_t count = 0; count <= 37; ++count) {
+    // Arrange
+    MakeMessages(std::vector<size_t>(count, 64));
+
+    // Act & Assert
+    ExpectMatchesSingleStream();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Lanes, Sha256ManyTest,
+  ::testing::Values(size_t { 1 }, size_t { 4 }, size_t { 8 }, size_t { 16 }));
+
+//! Verify only as many digests as there are outputs are written.
+NOLINT_TEST(Sha256Many, ShorterOutputLimitsWork)
+{
+  // Arrange
+  const std::array<std::span<const std::byte>, 3> inputs
+    = { ToBytes("a"), ToBytes("abc"), ToBytes("") };
+  std::array<Sha256Digest, 2> outputs {};
+
+  // Act
+  ComputeSha256Many(inputs, outputs);
+
+  // Assert
+  EXPECT_EQ(DigestToHex(outputs[0]), kTestVectors[4].expected_hex);
+  EXPECT_EQ(DigestToHex(outputs[1]), kTestVectors[1].expected_hex);
+}
+
+//! Verify the reported lane count is one of the supported kernel widths.
+NOLINT_TEST(Sha256Many, MaxLaneCountIsAKernelWidth)
+{
+  const auto lanes = Sha256::MaxLaneCount();
+
+  EXPECT_TRUE(lanes == 1 || lanes == 4 || lanes == 8 || lanes == 16) << lanes;
+}
+
+// ---------------------------------------------------------------------------
+// Double SHA-256 Tests
+// ---------------------------------------------------------------------------
+
+//! Bitcoin mainnet genesis block header.
+constexpr std::string_view kGenesisHeaderHex
+  = "0100000000000000000000000000000000000000000000000000000000000000000000"
+    "003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a29ab"
+    "5f49ffff001d1dac2b7c";
+//! Its hash, in the usual reversed display order.
+constexpr std::string_view kGenesisHashHex
+  = "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f";
+
+[[nodiscard]] auto HexToBytes(std::string_view hex) -> std::vector<std::byte>
+{
+  std::vector<std::byte> bytes(hex.size() / 2);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<std::byte>(
+      std::stoul(std::string(hex.substr(i * 2, 2)), nullptr, 16));
+  }
+  return bytes;
+}
+
+[[nodiscard]] auto ReferenceSha256d(std::span<const std::byte> data)
+  -> Sha256Digest
+{
+  const auto first = ComputeSha256(data);
+  return ComputeSha256(std::as_bytes(std::span(first)));
+}
+
+[[nodiscard]] auto RandomBytes(size_t size, uint32_t seed)
+  -> std::vector<std::byte>
+{
+  std::mt19937 rng(seed);
+  std::vector<std::byte> bytes(size);
+  for (auto& byte : bytes) {
+    byte = static_cast<std::byte>(rng());
+  }
+  return bytes;
+}
+
+//! Verify SHA256d of a well-known input.
+NOLINT_TEST(Sha256d, HelloMatchesKnownDigest)
+{
+  const auto result = ComputeSha256d(ToBytes("hello"));
+
+  EXPECT_EQ(DigestToHex(result),
+    "9595c9df90075148eb06860365df33584b75bff782a510c6cd4883a419833d50");
+}
+
+//! Verify the header path against the Bitcoin genesis block hash.
+NOLINT_TEST(Sha256d, GenesisHeaderHash)
+{
+  // Arrange
+  const auto header = HexToBytes(kGenesisHeaderHex);
+  ASSERT_EQ(header.size(), nova::kSha256dHeaderSize);
+
+  // Act
+  auto digest = ComputeSha256d80(
+    std::span<const std::byte, nova::kSha256dHeaderSize>(header.data(), 80));
+  std::reverse(digest.begin(), digest.end());
+
+  // Assert
+  EXPECT_EQ(DigestToHex(digest), kGenesisHashHex);
+}
+
+//! Verify the fixed-size paths agree with two generic passes.
+NOLINT_TEST(Sha256d, FixedSizePathsMatchGenericPath)
+{
+  for (uint32_t seed = 0; seed < 16; ++seed) {
+    const auto data = RandomBytes(80, seed);
+    const auto bytes = std::span<const std::byte>(data);
+
+    EXPECT_EQ(DigestToHex(ComputeSha256d(bytes)),
+      DigestToHex(ReferenceSha256d(bytes)));
+    EXPECT_EQ(DigestToHex(ComputeSha256d64(bytes.first<64>())),
+      DigestToHex(ReferenceSha256d(bytes.first(64))));
+    EXPECT_EQ(DigestToHex(ComputeSha256d80(bytes.first<80>())),
+      DigestToHex(ReferenceSha256d(bytes)));
+  }
+}
+
+//! Verify a cached midstate hashes every suffix like the full header.
+NOLINT_TEST(Sha256d, MidstateMatchesFullHeader)
+{
+  // Arrange
+  auto header = HexToBytes(kGenesisHeaderHex);
+  const Sha256dHeaderMidstate midstate(
+    std::span<const std::byte, 64>(header.data(), 64));
+
+  for (uint32_t nonce = 0; nonce < 64; ++nonce) {
+    // Act
+    std::memcpy(header.data() + 76, &nonce, sizeof(nonce));
+    const auto from_midstate = midstate.Finish(
+      std::span<const std::byte, 16>(header.data() + 64, 16));
+
+    // Assert
+    EXPECT_EQ(DigestToHex(from_midstate),
+      DigestToHex(ReferenceSha256d(std::span<const std::byte>(header))));
+  }
+}
+
+class Sha256dManyTest : public ::testing::TestWithParam<size_t> { };
+
+//! Verify merkle-node batching for every kernel and partial group sizes.
+NOLINT_TEST_P(Sha256dManyTest, SixtyFourByteBlocksMatch)
+{
+  for (size_t count = 0; count <= 37; ++count) {
+    // Arrange
+    const auto data = RandomBytes(count * 64, static_cast<uint32_t>(count));
+    std::vector<Sha256Digest> outputs(count);
+
+    // Act
+    ComputeSha256d64Many(data, outputs, GetParam());
+
+    // Assert
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(DigestToHex(outputs[i]),
+        DigestToHex(ReferenceSha256d(std::span(data).subspan(i * 64, 64))))
+        << "block " << i << " of " << count;
+    }
+  }
+}
+
+//! Verify header batching for every kernel and partial group sizes.
+NOLINT_TEST_P(Sha256dManyTest, HeadersMatch)
+{
+  for (size_t count = 0; count <= 37; ++count) {
+    // Arrange
+    // Headers are 81 bytes apart, as in a `headers` message.
+    const auto data = RandomBytes(count * 81, static_cast<uint32_t>(count));
+    std::vector<std::span<const std::byte, 80>> headers;
+    for (size_t i = 0; i < count; ++i) {
+      headers.emplace_back(data.data() + (i * 81), 80);
+    }
+    std::vector<Sha256Digest> outputs(count);
+
+    // Act
+    ComputeSha256d80Many(headers, outputs, GetParam());
+
+    // Assert
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(DigestToHex(outputs[i]),
+        DigestToHex(ReferenceSha256d(headers[i])))
+        << "header " << i << " of " << count;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Lanes, Sha256dManyTest,
+  ::testing::Values(size_t { 1 }, size_t { 4 }, size_t { 8 }, size_t { 16 }));
+
+//! Verify the default lane selection on a merkle-sized layer.
+NOLINT_TEST(Sha256dMany, DefaultKernelMatches)
+{
+  const auto data = RandomBytes(1000 * 64, 7);
+  std::vector<Sha256Digest> outputs(1000);
+
+  ComputeSha256d64Many(data, outputs);
+
+  for (size_t i = 0; i < outputs.size(); i += 97) {
+    EXPECT_EQ(DigestToHex(outputs[i]),
+      DigestToHex(ReferenceSha256d(std::span(data).subspan(i * 64, 64))));
+  }
+}
+
 // ---------------------------------------------------------------------------
 // Edge Case Tests
 // ---------------------------------------------------------------------------